@@ -78,6 +78,16 @@ Item {
      */
     property alias captureMode: coordinateConvController.captureMode
 
+    /*!
+      \qmlproperty bool hoverMode
+      \brief Whether the tool converts the point under the mouse cursor as it moves.
+
+      Conversions are made at most once per rendered frame, and only when
+      the cursor leaves the precision of the current notations.
+      The default value is \c false.
+     */
+    property alias hoverMode: coordinateConvController.hoverMode
+
     /*!
       \qmlproperty real backgroundOpacity
       \brief The opacity of the background rectangle.
@@ -32,6 +32,9 @@ android: {
   }
 }
 
+# the toolkit uses QtConcurrent for batch conversions
+QT += concurrent
+
 INCLUDEPATH += $$PWD/include \
                $$PWD/include/CoordinateConversion
 
@@ -17,7 +17,7 @@
 TARGET = $$qtLibraryTarget(ArcGISRuntimeToolkitCppApi$${ToolkitPrefix})
 TEMPLATE = lib
 
-QT += core gui opengl network positioning sensors qml quick
+QT += core gui opengl network positioning sensors qml quick concurrent
 CONFIG += c++11 plugin
 
 DEFINES += QTRUNTIME_TOOLKIT_BUILD
@@ -0,0 +1,58 @@
+################################################################################
+#  Copyright 2012-2018 Esri
+#
+#  Licensed under the Apache License, Version 2.0 (the "License");
+#  you may not use this file except in compliance with the License.
+#  You may obtain a copy of the License at
+#
+#  http://www.apache.org/licenses/LICENSE-2.0
+#
+#  Unless required by applicable law or agreed to in writing, software
+#  distributed under the License is distributed on an "AS IS" BASIS,
+#  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+#  See the License for the specific language governing permissions and
+#  limitations under the License.
+################################################################################
+
+# Headless bulk conversion of notation files, and of GPX, GeoJSON or CSV point
+# files, with the coordinate conversion tool. Build ArcGISRuntimeToolkit.pro
+# first: this links against its output.
+
+TARGET = CoordinateConversionCli
+TEMPLATE = app
+
+QT += core concurrent
+CONFIG += c++11 console
+CONFIG -= app_bundle
+
+HEADERS += $$PWD/tools/EngineCommandLine.h
+
+SOURCES += $$PWD/cli/CoordinateConversionCli.cpp \
+           $$PWD/tools/EngineCommandLine.cpp
+
+INCLUDEPATH += $$PWD/tools
+
+RUNTIME_PRI = arcgis_runtime_qml_cpp.pri
+ARCGIS_RUNTIME_VERSION = 100.4
+
+!CONFIG(daily) {
+  include($$PWD/arcgisruntime.pri)
+} else {
+  include($$PWD/dev_build_config.pri)
+}
+
+include($$PWD/ArcGISRuntimeToolkit.pri)
+
+unix:!macx:!android:!ios: {
+  LIBS += -lstdc++
+}
+
+CONFIG(release, debug|release) {
+  BUILDTYPE = release
+} else {
+  BUILDTYPE = debug
+}
+
+DESTDIR = $$PWD/output/$$PLATFORM_OUTPUT
+OBJECTS_DIR = $$DESTDIR/$$BUILDTYPE/cli/obj
+MOC_DIR = $$DESTDIR/$$BUILDTYPE/cli/moc
@@ -0,0 +1,61 @@
+################################################################################
+#  Copyright 2012-2018 Esri
+#
+#  Licensed under the Apache License, Version 2.0 (the "License");
+#  you may not use this file except in compliance with the License.
+#  You may obtain a copy of the License at
+#
+#  http://www.apache.org/licenses/LICENSE-2.0
+#
+#  Unless required by applicable law or agreed to in writing, software
+#  distributed under the License is distributed on an "AS IS" BASIS,
+#  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+#  See the License for the specific language governing permissions and
+#  limitations under the License.
+################################################################################
+
+# Serves coordinate conversions to the processes of one machine over a local
+# socket. Build ArcGISRuntimeToolkit.pro first: this links against its output.
+
+TARGET = CoordinateConversionService
+TEMPLATE = app
+
+QT += core concurrent network
+CONFIG += c++11 console
+CONFIG -= app_bundle
+
+HEADERS += $$PWD/service/ConversionService.h \
+           $$PWD/service/ConversionServiceProtocol.h \
+           $$PWD/tools/EngineCommandLine.h
+
+SOURCES += $$PWD/service/ConversionService.cpp \
+           $$PWD/service/CoordinateConversionService.cpp \
+           $$PWD/tools/EngineCommandLine.cpp
+
+INCLUDEPATH += $$PWD/service \
+               $$PWD/tools
+
+RUNTIME_PRI = arcgis_runtime_qml_cpp.pri
+ARCGIS_RUNTIME_VERSION = 100.4
+
+!CONFIG(daily) {
+  include($$PWD/arcgisruntime.pri)
+} else {
+  include($$PWD/dev_build_config.pri)
+}
+
+include($$PWD/ArcGISRuntimeToolkit.pri)
+
+unix:!macx:!android:!ios: {
+  LIBS += -lstdc++
+}
+
+CONFIG(release, debug|release) {
+  BUILDTYPE = release
+} else {
+  BUILDTYPE = debug
+}
+
+DESTDIR = $$PWD/output/$$PLATFORM_OUTPUT
+OBJECTS_DIR = $$DESTDIR/$$BUILDTYPE/service/obj
+MOC_DIR = $$DESTDIR/$$BUILDTYPE/service/moc
@@ -0,0 +1,664 @@
+/*******************************************************************************
+ *  Copyright 2012-2018 Esri
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ******************************************************************************/
+
+// Measures the coordinate conversion pipeline, one case per operation and
+// format: convertPoint, convertNotation, pointFromNotation,
+// CoordinateConversionResults::setResults and screenCoordinate.
+//
+// Every case times each operation on its own and reports the mean ns/op,
+// the median and 99th percentile latencies and the heap allocations per
+// operation. Points are drawn from a fixed seed and outnumber the result
+// cache, so conversions are measured as cache misses.
+//
+// The benchmark runs headless: the platform defaults to "offscreen", and
+// screenCoordinate is measured against a map view in an offscreen window
+// holding an empty WGS 84 map, which needs no basemap or network. If that
+// view cannot be set up, the case is reported as skipped.
+//
+// Results can be saved as a JSON baseline and compared against one later;
+// the exit status is 1 if any case regressed by more than the threshold.
+//
+// With --verify-native nothing is timed: the native grid and cell kernels
+// are compared with CoordinateFormatter over a global grid of points that
+// includes the poles, the antimeridian and both sides of the Norway and
+// Svalbard zone exceptions, and the exit status is 3 on any difference.
+
+// toolkit headers
+#include "CoordinateConversionConstants.h"
+#include "CoordinateConversionController.h"
+#include "CoordinateConversionEngine.h"
+#include "CoordinateConversionOptions.h"
+#include "CoordinateConversionResults.h"
+#include "CoordinateFormatFactory.h"
+#include "GarsCodec.h"
+#include "GeorefCodec.h"
+#include "NativeConversionSupport.h"
+#include "TransverseMercatorGrid.h"
+
+// C++ API headers
+#include "CoordinateFormatter.h"
+#include "Map.h"
+#include "MapQuickView.h"
+#include "SpatialReference.h"
+
+// Qt headers
+#include <QCommandLineParser>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QGuiApplication>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QQuickWindow>
+#include <QTextStream>
+
+// STL headers
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <functional>
+#include <new>
+#include <random>
+#include <vector>
+
+namespace
+{
+
+std::atomic<unsigned long long> allocationCount(0);
+
+} // namespace
+
+// Every heap allocation is counted. With glibc the C allocator itself is
+// wrapped, which also catches Qt's containers; elsewhere only operator new is.
+#if defined(__GLIBC__)
+
+extern "C"
+{
+
+void* __libc_malloc(std::size_t size);
+void* __libc_calloc(std::size_t count, std::size_t size);
+void* __libc_realloc(void* pointer, std::size_t size);
+
+void* malloc(std::size_t size)
+{
+  allocationCount.fetch_add(1, std::memory_order_relaxed);
+  return __libc_malloc(size);
+}
+
+void* calloc(std::size_t count, std::size_t size)
+{
+  allocationCount.fetch_add(1, std::memory_order_relaxed);
+  return __libc_calloc(count, size);
+}
+
+void* realloc(void* pointer, std::size_t size)
+{
+  allocationCount.fetch_add(1, std::memory_order_relaxed);
+  return __libc_realloc(pointer, size);
+}
+
+} // extern "C"
+
+#else
+
+void* operator new(std::size_t size)
+{
+  allocationCount.fetch_add(1, std::memory_order_relaxed);
+  if (void* pointer = std::malloc(size ? size : 1))
+    return pointer;
+
+  throw std::bad_alloc();
+}
+
+void operator delete(void* pointer) noexcept
+{
+  std::free(pointer);
+}
+
+#endif
+
+using namespace Esri::ArcGISRuntime;
+using namespace Esri::ArcGISRuntime::Toolkit;
+
+namespace
+{
+
+using Clock = std::chrono::steady_clock;
+
+constexpr int defaultIterations = 20000;
+constexpr int warmupIterations = 1000;
+constexpr double defaultThreshold = 10.0;
+
+// more points than the result cache holds, so conversions miss it
+constexpr int pointPoolSize = 1 << 16;
+constexpr unsigned int pointSeed = 20180801;
+
+// how long to wait for the offscreen map view to be ready
+constexpr int viewReadyTimeout = 5000;
+
+// process exit codes
+constexpr int exitSuccess = 0;
+constexpr int exitRegression = 1;
+constexpr int exitFailure = 2;
+constexpr int exitMismatch = 3;
+
+// the verification grid: every degree, and this far either side of the
+// lines where the grid and cell notations change their rules
+constexpr double verificationStep = 1.0;
+constexpr double verificationOffset = 1e-7;
+constexpr int verificationMgrsPrecision = 5;
+constexpr int verificationGeorefPrecision = 4;
+
+// the most differences printed before only counting them
+constexpr int reportedMismatches = 20;
+
+struct Measurement
+{
+  QString name;
+  int iterations = 0;
+  double nsPerOp = 0.0;
+  double p50 = 0.0;
+  double p99 = 0.0;
+  double allocationsPerOp = 0.0;
+  bool skipped = false;
+};
+
+QTextStream& outputStream()
+{
+  static QTextStream stream(stdout);
+  return stream;
+}
+
+QTextStream& errorStream()
+{
+  static QTextStream stream(stderr);
+  return stream;
+}
+
+const QStringList& defaultFormats()
+{
+  static const QStringList formats{CoordinateConversionConstants::DECIMAL_DEGREES_FORMAT,
+                                   CoordinateConversionConstants::DEGREES_DECIMAL_MINUTES_FORMAT,
+                                   CoordinateConversionConstants::DEGREES_MINUTES_SECONDS_FORMAT,
+                                   CoordinateConversionConstants::MGRS_FORMAT,
+                                   CoordinateConversionConstants::USNG_FORMAT,
+                                   CoordinateConversionConstants::UTM_FORMAT,
+                                   CoordinateConversionConstants::GARS_FORMAT};
+  return formats;
+}
+
+// points within the UTM latitude limits, so every format can express them
+QList<Point> makePoints()
+{
+  std::mt19937 generator(pointSeed);
+  std::uniform_real_distribution<double> latitudes(-79.9, 83.9);
+  std::uniform_real_distribution<double> longitudes(-180.0, 180.0);
+
+  QList<Point> points;
+  points.reserve(pointPoolSize);
+  for (int i = 0; i < pointPoolSize; ++i)
+  {
+    const double latitude = latitudes(generator);
+    points.append(Point(longitudes(generator), latitude, SpatialReference::wgs84()));
+  }
+
+  return points;
+}
+
+void addFormats(CoordinateConversionController& controller, const QStringList& formats)
+{
+  controller.setSpatialReference(SpatialReference::wgs84());
+  for (const QString& format : formats)
+    controller.addOption(CoordinateFormatFactory::createFormat(format, controller.formatDefaults(), &controller));
+}
+
+// the same options as the controller gets, so that decoding can be measured
+// without the controller around it
+void addFormats(CoordinateConversionEngine& engine, const QStringList& formats)
+{
+  engine.setSpatialReference(SpatialReference::wgs84());
+  for (const QString& format : formats)
+    engine.addOption(CoordinateFormatFactory::createFormatOption(format, engine.formatDefaults()));
+}
+
+// times operation(i) for each iteration, after an untimed setup(i)
+Measurement measure(const QString& name, int iterations, const std::function<void(int)>& setup,
+                    const std::function<void(int)>& operation)
+{
+  for (int i = 0; i < warmupIterations; ++i)
+  {
+    setup(i);
+    operation(i);
+  }
+
+  std::vector<double> latencies(iterations);
+  unsigned long long allocations = 0;
+  double total = 0.0;
+
+  for (int i = 0; i < iterations; ++i)
+  {
+    setup(warmupIterations + i);
+
+    const unsigned long long allocationsBefore = allocationCount.load(std::memory_order_relaxed);
+    const Clock::time_point start = Clock::now();
+    operation(warmupIterations + i);
+    const Clock::time_point end = Clock::now();
+    allocations += allocationCount.load(std::memory_order_relaxed) - allocationsBefore;
+
+    latencies[i] = std::chrono::duration<double, std::nano>(end - start).count();
+    total += latencies[i];
+  }
+
+  std::sort(latencies.begin(), latencies.end());
+
+  Measurement measurement;
+  measurement.name = name;
+  measurement.iterations = iterations;
+  measurement.nsPerOp = total / iterations;
+  measurement.p50 = latencies[iterations / 2];
+  measurement.p99 = latencies[std::min(iterations - 1, iterations * 99 / 100)];
+  measurement.allocationsPerOp = static_cast<double>(allocations) / iterations;
+  return measurement;
+}
+
+Measurement skipped(const QString& name)
+{
+  Measurement measurement;
+  measurement.name = name;
+  measurement.skipped = true;
+  return measurement;
+}
+
+void benchmarkFormat(const QString& format, const QList<Point>& points, int iterations, const QString& filter,
+                     QList<Measurement>& measurements)
+{
+  const int pointCount = points.size();
+
+  // convertPoint converts to the one format
+  const QString convertPointName = QStringLiteral("convertPoint/") + format;
+  if (convertPointName.contains(filter))
+  {
+    CoordinateConversionController controller;
+    controller.setRunConversion(false);
+    addFormats(controller, QStringList{format});
+
+    measurements.append(measure(convertPointName, iterations,
+                                [&](int i) { controller.setPointToConvert(points.at(i % pointCount)); },
+                                [&](int) { controller.convertPoint(); }));
+  }
+
+  // decoding reads notations of the format and converts the point to every format
+  const QString convertNotationName = QStringLiteral("convertNotation/") + format;
+  const QString pointFromNotationName = QStringLiteral("pointFromNotation/") + format;
+  if (convertNotationName.contains(filter) || pointFromNotationName.contains(filter))
+  {
+    CoordinateConversionController controller;
+    addFormats(controller, defaultFormats());
+    controller.setInputFormat(format);
+
+    const CoordinateConversionBatchResult batch = controller.convertPoints(points);
+    const QVector<QString> notations = batch.column(batch.columnIndex(format));
+
+    if (convertNotationName.contains(filter))
+    {
+      measurements.append(measure(convertNotationName, iterations, [](int) {},
+                                  [&](int i) { controller.convertNotation(notations.at(i % pointCount)); }));
+    }
+
+    if (pointFromNotationName.contains(filter))
+    {
+      CoordinateConversionEngine engine;
+      addFormats(engine, defaultFormats());
+      engine.setInputFormat(format);
+      measurements.append(measure(pointFromNotationName, iterations, [](int) {},
+                                  [&](int i) { engine.pointFromNotation(notations.at(i % pointCount)); }));
+    }
+  }
+
+  // setResults replaces the one row of the model with another notation
+  const QString setResultsName = QStringLiteral("setResults/") + format;
+  if (setResultsName.contains(filter))
+  {
+    CoordinateConversionController controller;
+    controller.setRunConversion(false);
+    addFormats(controller, QStringList{format});
+    const CoordinateConversionBatchResult batch = controller.convertPoints(points);
+    const QVector<QString> notations = batch.column(0);
+    const int type = static_cast<int>(CoordinateFormatFactory::createFormat(format, controller.formatDefaults(), &controller)->outputMode());
+
+    CoordinateConversionResults results;
+    QList<Result> rows;
+    measurements.append(measure(setResultsName, iterations, [&](int i)
+    {
+      rows.clear();
+      rows.append(Result(format, notations.at(i % pointCount), type));
+    },
+    [&](int) { results.setResults(std::move(rows)); }));
+  }
+}
+
+// a map view over an empty WGS 84 map in an offscreen window
+Measurement benchmarkScreenCoordinate(const QList<Point>& points, int iterations)
+{
+  const QString name = QStringLiteral("screenCoordinate");
+
+  QQuickWindow window;
+  window.resize(1280, 800);
+
+  MapQuickView* mapView = new MapQuickView(window.contentItem());
+  mapView->setWidth(window.width());
+  mapView->setHeight(window.height());
+  mapView->setMap(new Map(SpatialReference::wgs84(), mapView));
+  window.show();
+
+  QElapsedTimer timer;
+  timer.start();
+  while ((mapView->map()->loadStatus() != LoadStatus::Loaded || mapView->widthInPixels() <= 0) &&
+         timer.elapsed() < viewReadyTimeout)
+  {
+    QGuiApplication::processEvents(QEventLoop::AllEvents, 50);
+  }
+
+  if (mapView->map()->loadStatus() != LoadStatus::Loaded || mapView->widthInPixels() <= 0)
+    return skipped(name);
+
+  CoordinateConversionController controller;
+  controller.setRunConversion(false);
+  addFormats(controller, defaultFormats());
+  controller.setGeoView(mapView);
+
+  const int pointCount = points.size();
+  return measure(name, iterations, [&](int i) { controller.setPointToConvert(points.at(i % pointCount)); },
+                 [&](int) { controller.screenCoordinate(); });
+}
+
+// degree values from -limit to limit, plus each edge approached from both sides
+std::vector<double> verificationValues(double limit, const std::vector<double>& edges)
+{
+  std::vector<double> values;
+  for (double value = -limit; value <= limit; value += verificationStep)
+    values.push_back(value);
+
+  for (double edge : edges)
+  {
+    values.push_back(std::max(-limit, edge - verificationOffset));
+    values.push_back(std::min(limit, edge + verificationOffset));
+  }
+
+  return values;
+}
+
+// compares the native and the SDK notation of one point; the native
+// kernels decline points they do not handle, which are not compared
+bool sameNotation(const char* buffer, int length, const QString& sdkNotation, const QString& name, const Point& point,
+                  int& mismatchCount)
+{
+  if (length <= 0 || sdkNotation == QLatin1String(buffer, length))
+    return true;
+
+  if (mismatchCount++ < reportedMismatches)
+  {
+    errorStream() << name << " at " << point.y() << ", " << point.x() << ": native "
+                  << QLatin1String(buffer, length) << ", SDK " << sdkNotation << endl;
+  }
+
+  return false;
+}
+
+// the 180 degree zone the engine passes the native grid for mode, for WGS 84 points
+bool mgrsZone60At180(MgrsConversionMode mode)
+{
+  return mode != MgrsConversionMode::New180InZone01 && mode != MgrsConversionMode::Old180InZone01;
+}
+
+// compares every native grid and cell kernel with CoordinateFormatter;
+// returns the number of differences
+int verifyNativeKernels()
+{
+  const std::vector<double> latitudes = verificationValues(90.0, {-80.0, 0.0, 56.0, 64.0, 72.0, 84.0});
+  const std::vector<double> longitudes = verificationValues(180.0, {-180.0, 0.0, 3.0, 6.0, 9.0, 12.0, 21.0, 33.0, 42.0, 180.0});
+  const MgrsConversionMode mgrsModes[] = {MgrsConversionMode::Automatic, MgrsConversionMode::New180InZone01,
+                                          MgrsConversionMode::New180InZone60, MgrsConversionMode::Old180InZone01,
+                                          MgrsConversionMode::Old180InZone60};
+
+  int comparisonCount = 0;
+  int mismatchCount = 0;
+  char buffer[TransverseMercatorGrid::bufferSize];
+  for (double latitude : latitudes)
+  {
+    for (double longitude : longitudes)
+    {
+      const Point point(longitude, latitude, SpatialReference::wgs84());
+      TransverseMercatorGrid::GridPosition position;
+
+      for (MgrsConversionMode mode : mgrsModes)
+      {
+        int length = 0;
+        if (TransverseMercatorGrid::toGridPosition(latitude, longitude, mgrsZone60At180(mode), position))
+        {
+          length = TransverseMercatorGrid::formatMgrs(position, NativeConversionSupport::mgrsLetteringScheme(mode),
+                                                      verificationMgrsPrecision, true, buffer);
+        }
+
+        sameNotation(buffer, length, CoordinateFormatter::toMgrs(point, mode, verificationMgrsPrecision, true),
+                     QStringLiteral("MGRS"), point, mismatchCount);
+        ++comparisonCount;
+      }
+
+      const bool inUtmLimits = TransverseMercatorGrid::toGridPosition(latitude, longitude, true, position);
+      int length = inUtmLimits ? TransverseMercatorGrid::formatUtm(position, TransverseMercatorGrid::ZoneIndicator::LatitudeBand,
+                                                                   true, buffer) : 0;
+      sameNotation(buffer, length, CoordinateFormatter::toUtm(point, UtmConversionMode::LatitudeBandIndicators, true),
+                   QStringLiteral("UTM"), point, mismatchCount);
+
+      length = inUtmLimits ? TransverseMercatorGrid::formatUtm(position, TransverseMercatorGrid::ZoneIndicator::Hemisphere,
+                                                               true, buffer) : 0;
+      sameNotation(buffer, length, CoordinateFormatter::toUtm(point, UtmConversionMode::NorthSouthIndicators, true),
+                   QStringLiteral("UTM"), point, mismatchCount);
+
+      length = GarsCodec::encode(latitude, longitude, buffer);
+      sameNotation(buffer, length, CoordinateFormatter::toGars(point), QStringLiteral("GARS"), point, mismatchCount);
+
+      length = GeorefCodec::encode(latitude, longitude, verificationGeorefPrecision, buffer);
+      sameNotation(buffer, length, CoordinateFormatter::toGeoRef(point, verificationGeorefPrecision),
+                   QStringLiteral("GEOREF"), point, mismatchCount);
+
+      comparisonCount += 4;
+    }
+  }
+
+  outputStream() << "compared " << comparisonCount << " notations, " << mismatchCount << " differed" << endl;
+  return mismatchCount;
+}
+
+QJsonObject toJson(const QList<Measurement>& measurements)
+{
+  QJsonObject cases;
+  for (const Measurement& measurement : measurements)
+  {
+    if (measurement.skipped)
+      continue;
+
+    QJsonObject values;
+    values.insert(QStringLiteral("nsPerOp"), measurement.nsPerOp);
+    values.insert(QStringLiteral("p50"), measurement.p50);
+    values.insert(QStringLiteral("p99"), measurement.p99);
+    values.insert(QStringLiteral("allocationsPerOp"), measurement.allocationsPerOp);
+    cases.insert(measurement.name, values);
+  }
+
+  QJsonObject root;
+  root.insert(QStringLiteral("cases"), cases);
+  return root;
+}
+
+QString percentChange(double value, double baseline)
+{
+  if (baseline <= 0.0)
+    return value > 0.0 ? QStringLiteral("new") : QStringLiteral("0%");
+
+  const double change = 100.0 * (value - baseline) / baseline;
+  return (change >= 0.0 ? QStringLiteral("+") : QString()) + QString::number(change, 'f', 1) + QLatin1Char('%');
+}
+
+bool regressed(double value, double baseline, double threshold)
+{
+  // fractions of an allocation come from cache evictions and warm-up effects
+  if (baseline <= 0.0)
+    return value >= 1.0;
+
+  return value > baseline * (1.0 + threshold / 100.0);
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+  if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM"))
+    qputenv("QT_QPA_PLATFORM", "offscreen");
+
+  QGuiApplication application(argc, argv);
+  QGuiApplication::setApplicationName(QStringLiteral("CoordinateConversionBenchmark"));
+
+  QCommandLineParser parser;
+  parser.setApplicationDescription(QStringLiteral(
+    "Measures the coordinate conversion tool: ns/op, p50 and p99 latency and allocations/op per case.\n"
+    "Exits with status 1 if a case regressed against the baseline by more than the threshold."));
+  parser.addHelpOption();
+
+  const QCommandLineOption iterationsOption(QStringLiteral("iterations"),
+                                            QStringLiteral("Timed operations per case."),
+                                            QStringLiteral("count"), QString::number(defaultIterations));
+  const QCommandLineOption filterOption(QStringLiteral("filter"),
+                                        QStringLiteral("Only run the cases whose name contains <text>."),
+                                        QStringLiteral("text"));
+  const QCommandLineOption saveBaselineOption(QStringLiteral("save-baseline"),
+                                              QStringLiteral("Write the results to <file> as a JSON baseline."),
+                                              QStringLiteral("file"));
+  const QCommandLineOption baselineOption(QStringLiteral("baseline"),
+                                          QStringLiteral("Compare the results against the JSON baseline in <file>."),
+                                          QStringLiteral("file"));
+  const QCommandLineOption thresholdOption(QStringLiteral("threshold"),
+                                           QStringLiteral("The percentage slowdown, or allocation increase, counted as a regression."),
+                                           QStringLiteral("percent"), QString::number(defaultThreshold));
+  const QCommandLineOption verifyNativeOption(QStringLiteral("verify-native"),
+                                              QStringLiteral("Compare the native kernels with the SDK over a global grid instead of timing."));
+  parser.addOptions({iterationsOption, filterOption, saveBaselineOption, baselineOption, thresholdOption,
+                     verifyNativeOption});
+  parser.process(application);
+
+  if (parser.isSet(verifyNativeOption))
+    return verifyNativeKernels() > 0 ? exitMismatch : exitSuccess;
+
+  bool ok = true;
+  const int iterations = parser.value(iterationsOption).toInt(&ok);
+  if (!ok || iterations <= 0)
+  {
+    errorStream() << "Invalid iteration count: " << parser.value(iterationsOption) << endl;
+    return exitFailure;
+  }
+
+  const double threshold = parser.value(thresholdOption).toDouble(&ok);
+  if (!ok || threshold < 0.0)
+  {
+    errorStream() << "Invalid threshold: " << parser.value(thresholdOption) << endl;
+    return exitFailure;
+  }
+
+  QJsonObject baseline;
+  if (parser.isSet(baselineOption))
+  {
+    QFile file(parser.value(baselineOption));
+    if (!file.open(QIODevice::ReadOnly))
+    {
+      errorStream() << "Cannot open " << file.fileName() << ": " << file.errorString() << endl;
+      return exitFailure;
+    }
+
+    baseline = QJsonDocument::fromJson(file.readAll()).object().value(QStringLiteral("cases")).toObject();
+  }
+
+  const QString filter = parser.value(filterOption);
+  const QList<Point> points = makePoints();
+
+  QList<Measurement> measurements;
+  for (const QString& format : defaultFormats())
+    benchmarkFormat(format, points, iterations, filter, measurements);
+
+  if (QStringLiteral("screenCoordinate").contains(filter))
+    measurements.append(benchmarkScreenCoordinate(points, iterations));
+
+  QTextStream& out = outputStream();
+  out << qSetFieldWidth(44) << left << "case" << qSetFieldWidth(12) << right
+      << "ns/op" << "p50" << "p99" << "allocs/op";
+  if (!baseline.isEmpty())
+    out << "ns/op chg" << "p99 chg" << "allocs chg";
+  out << qSetFieldWidth(0) << endl;
+
+  int regressionCount = 0;
+  for (const Measurement& measurement : measurements)
+  {
+    out << qSetFieldWidth(44) << left << measurement.name << qSetFieldWidth(12) << right;
+    if (measurement.skipped)
+    {
+      out << "skipped" << qSetFieldWidth(0) << endl;
+      continue;
+    }
+
+    out << QString::number(measurement.nsPerOp, 'f', 0) << QString::number(measurement.p50, 'f', 0)
+        << QString::number(measurement.p99, 'f', 0) << QString::number(measurement.allocationsPerOp, 'f', 1);
+
+    const QJsonObject reference = baseline.value(measurement.name).toObject();
+    if (!reference.isEmpty())
+    {
+      const double baselineNs = reference.value(QStringLiteral("nsPerOp")).toDouble();
+      const double baselineP99 = reference.value(QStringLiteral("p99")).toDouble();
+      const double baselineAllocations = reference.value(QStringLiteral("allocationsPerOp")).toDouble();
+
+      const bool slower = regressed(measurement.nsPerOp, baselineNs, threshold) ||
+                          regressed(measurement.p99, baselineP99, threshold) ||
+                          regressed(measurement.allocationsPerOp, baselineAllocations, threshold);
+      if (slower)
+        ++regressionCount;
+
+      out << percentChange(measurement.nsPerOp, baselineNs) << percentChange(measurement.p99, baselineP99)
+          << percentChange(measurement.allocationsPerOp, baselineAllocations) << qSetFieldWidth(0)
+          << (slower ? "  REGRESSED" : "");
+    }
+
+    out << qSetFieldWidth(0) << endl;
+  }
+
+  if (parser.isSet(saveBaselineOption))
+  {
+    QFile file(parser.value(saveBaselineOption));
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+    {
+      errorStream() << "Cannot write " << file.fileName() << ": " << file.errorString() << endl;
+      return exitFailure;
+    }
+
+    file.write(QJsonDocument(toJson(measurements)).toJson());
+  }
+
+  if (regressionCount > 0)
+  {
+    errorStream() << regressionCount << " case(s) regressed by more than " << threshold << "%" << endl;
+    return exitRegression;
+  }
+
+  return exitSuccess;
+}
@@ -0,0 +1,535 @@
+/*******************************************************************************
+ *  Copyright 2012-2018 Esri
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ******************************************************************************/
+
+// Converts a file of notations, one per line or one per CSV row, to a CSV
+// table with one column per output format.
+//
+// The input is memory mapped and cut into line-aligned chunks which are
+// converted in parallel by CoordinateConversionEngine::convertNotations.
+// Chunk outputs are written in input order, and at most two chunks per
+// thread are in flight at once, so memory use does not grow with the size
+// of the input. The first failed write cancels the chunks in flight and
+// ends the run with a non-zero exit status. No QML engine or GeoView is
+// created.
+//
+// With --points the input is instead a GPX, GeoJSON or CSV file of points,
+// streamed through a PointStreamConverter a batch at a time.
+
+// toolkit headers
+#include "CoordinateConversionEngine.h"
+#include "EngineCommandLine.h"
+#include "PointStreamConverter.h"
+#include "PointStreamReader.h"
+#include "PointStreamWriter.h"
+
+// C++ API headers
+#include "SpatialReference.h"
+
+// Qt headers
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QFuture>
+#include <QQueue>
+#include <QTextStream>
+#include <QThreadPool>
+#include <QtConcurrentRun>
+
+// STL headers
+#include <atomic>
+#include <cstring>
+#include <memory>
+
+using namespace Esri::ArcGISRuntime;
+using namespace Esri::ArcGISRuntime::Toolkit;
+
+namespace
+{
+
+constexpr qint64 defaultChunkSize = 4 * 1024 * 1024;
+
+// chunks queued or being converted, per thread
+constexpr int chunksInFlightPerThread = 2;
+
+// line numbers of error rows listed in the report
+constexpr int maximumReportedErrors = 10;
+
+// process exit codes
+constexpr int exitSuccess = 0;
+constexpr int exitFailure = 1;
+constexpr int exitErrorRows = 2;
+
+struct InputSettings
+{
+  int column = -1; // -1 reads whole lines
+  char delimiter = ',';
+};
+
+struct Chunk
+{
+  const char* begin = nullptr;
+  const char* end = nullptr;
+};
+
+struct ChunkResult
+{
+  QByteArray output;
+  int lineCount = 0;
+  int rowCount = 0;
+  QVector<int> errorLines; // zero based, counted from the start of the chunk
+};
+
+QTextStream& errorStream()
+{
+  return EngineCommandLine::errorStream();
+}
+
+// returns the trimmed field at column of a CSV line, or the whole trimmed line
+QByteArray inputField(const char* begin, const char* end, const InputSettings& settings)
+{
+  if (settings.column < 0)
+    return QByteArray(begin, static_cast<int>(end - begin)).trimmed();
+
+  QByteArray field;
+  int column = 0;
+  bool quoted = false;
+  for (const char* c = begin; c != end; ++c)
+  {
+    if (*c == '"')
+    {
+      // a doubled quote inside a quoted field is a literal quote
+      if (quoted && c + 1 != end && c[1] == '"')
+      {
+        if (column == settings.column)
+          field.append('"');
+
+        ++c;
+      }
+      else
+      {
+        quoted = !quoted;
+      }
+
+      continue;
+    }
+
+    if (*c == settings.delimiter && !quoted)
+    {
+      if (column == settings.column)
+        break;
+
+      ++column;
+      continue;
+    }
+
+    if (column == settings.column)
+      field.append(*c);
+  }
+
+  return field.trimmed();
+}
+
+void appendCsvField(QByteArray& output, const QByteArray& field, char delimiter)
+{
+  if (field.indexOf(delimiter) == -1 && field.indexOf('"') == -1)
+  {
+    output.append(field);
+    return;
+  }
+
+  QByteArray escaped = field;
+  escaped.replace("\"", "\"\"");
+  output.append('"');
+  output.append(escaped);
+  output.append('"');
+}
+
+// converts the lines of chunk, or nothing once canceled is set
+ChunkResult convertChunk(const CoordinateConversionEngine& engine, const Chunk& chunk,
+                         const InputSettings& settings, const std::atomic<bool>& canceled)
+{
+  ChunkResult result;
+  if (canceled.load())
+    return result;
+
+  QList<QByteArray> inputs;
+  QStringList notations;
+  QVector<int> rowLines;
+
+  const char* line = chunk.begin;
+  while (line < chunk.end)
+  {
+    const void* newline = std::memchr(line, '\n', static_cast<std::size_t>(chunk.end - line));
+    const char* lineEnd = newline ? static_cast<const char*>(newline) : chunk.end;
+    const char* textEnd = lineEnd;
+    if (textEnd != line && textEnd[-1] == '\r')
+      --textEnd;
+
+    // blank lines produce no row
+    if (textEnd != line)
+    {
+      inputs.append(inputField(line, textEnd, settings));
+      notations.append(QString::fromUtf8(inputs.last()));
+      rowLines.append(result.lineCount);
+    }
+
+    ++result.lineCount;
+    line = lineEnd + 1;
+  }
+
+  if (canceled.load())
+    return result;
+
+  const CoordinateConversionBatchResult batch = engine.convertNotations(notations);
+  result.rowCount = batch.rowCount();
+  for (const int row : batch.errorRows())
+    result.errorLines.append(rowLines.at(row));
+
+  result.output.reserve(static_cast<int>(chunk.end - chunk.begin) + result.rowCount * batch.columnCount() * 24);
+  for (int row = 0; row < batch.rowCount(); ++row)
+  {
+    appendCsvField(result.output, inputs.at(row), settings.delimiter);
+    for (int column = 0; column < batch.columnCount(); ++column)
+    {
+      result.output.append(settings.delimiter);
+      appendCsvField(result.output, batch.notation(row, column).toUtf8(), settings.delimiter);
+    }
+
+    result.output.append('\n');
+  }
+
+  return result;
+}
+
+// converts a GPX, GeoJSON or CSV file of points, writing them with their
+// notations in the format of the output file's extension, or as CSV to the
+// standard output
+int convertPointFile(const CoordinateConversionEngine& engine, const QString& inputFileName,
+                     const QString& outputFileName)
+{
+  QFile input(inputFileName);
+  std::unique_ptr<PointStreamReader> reader = PointStreamReader::create(pointFileFormat(inputFileName), &input);
+  if (!reader)
+  {
+    errorStream() << "Unknown point file format: " << inputFileName << endl;
+    return exitFailure;
+  }
+
+  if (!input.open(QIODevice::ReadOnly))
+  {
+    errorStream() << "Could not open " << input.fileName() << ": " << input.errorString() << endl;
+    return exitFailure;
+  }
+
+  QFile output;
+  PointFileFormat outputFormat = PointFileFormat::Csv;
+  bool outputOpened = false;
+  if (!outputFileName.isEmpty())
+  {
+    outputFormat = pointFileFormat(outputFileName);
+    output.setFileName(outputFileName);
+    outputOpened = outputFormat != PointFileFormat::Unknown && output.open(QIODevice::WriteOnly | QIODevice::Truncate);
+  }
+  else
+  {
+    outputOpened = output.open(stdout, QIODevice::WriteOnly);
+  }
+
+  std::unique_ptr<PointStreamWriter> writer = PointStreamWriter::create(outputFormat, &output);
+  if (!writer)
+  {
+    errorStream() << "Unknown point file format: " << outputFileName << endl;
+    return exitFailure;
+  }
+
+  if (!outputOpened)
+  {
+    errorStream() << "Could not open the output: " << output.errorString() << endl;
+    return exitFailure;
+  }
+
+  QElapsedTimer timer;
+  timer.start();
+
+  const PointStreamConverter::Result result = PointStreamConverter::convert(engine, engine.options(), *reader, *writer);
+  output.flush();
+  if (!result.errorString.isEmpty())
+  {
+    errorStream() << result.errorString << endl;
+    return exitFailure;
+  }
+
+  const double seconds = timer.nsecsElapsed() / 1.0e9;
+  const double pointsPerSecond = seconds > 0.0 ? result.pointCount / seconds : 0.0;
+  errorStream() << result.pointCount << " points converted in " << QString::number(seconds, 'f', 3) << " s ("
+                << QString::number(pointsPerSecond, 'f', 0) << " points/s)" << endl;
+
+  return exitSuccess;
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+  QCoreApplication application(argc, argv);
+  QCoreApplication::setApplicationName(QStringLiteral("CoordinateConversionCli"));
+
+  QCommandLineParser parser;
+  parser.setApplicationDescription(QStringLiteral(
+    "Converts each notation in <input> to a CSV row holding the input and its notation in every output format.\n"
+    "Exits with status 2 if any row could not be decoded."));
+  parser.addHelpOption();
+  parser.addPositionalArgument(QStringLiteral("input"), QStringLiteral("The file of notations to convert."));
+
+  const QCommandLineOption outputOption(QStringList{QStringLiteral("o"), QStringLiteral("output")},
+                                        QStringLiteral("Write to <file> instead of the standard output."),
+                                        QStringLiteral("file"));
+  const EngineCommandLine engineCommandLine(QStringLiteral("The format of the input notations."));
+  const QCommandLineOption columnOption(QStringLiteral("column"),
+                                        QStringLiteral("Read notations from the zero based CSV <column> instead of whole lines."),
+                                        QStringLiteral("column"));
+  const QCommandLineOption delimiterOption(QStringLiteral("delimiter"),
+                                           QStringLiteral("The CSV field delimiter."),
+                                           QStringLiteral("character"), QStringLiteral(","));
+  const QCommandLineOption skipHeaderOption(QStringLiteral("skip-header"),
+                                            QStringLiteral("Ignore the first line of the input."));
+  const QCommandLineOption noHeaderOption(QStringLiteral("no-header"),
+                                          QStringLiteral("Do not write a header row."));
+  const QCommandLineOption chunkSizeOption(QStringLiteral("chunk-size"),
+                                           QStringLiteral("Bytes of input converted by each task."),
+                                           QStringLiteral("bytes"), QString::number(defaultChunkSize));
+  const QCommandLineOption pointsOption(QStringLiteral("points"),
+                                        QStringLiteral("Read points from a GPX, GeoJSON or CSV <input> and write them with their "
+                                                       "notations in the format of the --output extension, CSV by default."));
+  const QCommandLineOption threadsOption(QStringLiteral("threads"),
+                                         QStringLiteral("Number of conversion threads. Defaults to one per core."),
+                                         QStringLiteral("count"));
+  parser.addOption(outputOption);
+  engineCommandLine.addOptions(parser);
+  parser.addOptions({columnOption, delimiterOption, skipHeaderOption, noHeaderOption, chunkSizeOption, pointsOption,
+                     threadsOption});
+  parser.process(application);
+
+  if (parser.positionalArguments().size() != 1)
+    parser.showHelp(exitFailure);
+
+  InputSettings settings;
+  const QString delimiter = parser.value(delimiterOption);
+  if (delimiter.size() != 1 || delimiter.at(0).unicode() > 0x7f)
+  {
+    errorStream() << "The delimiter must be a single ASCII character." << endl;
+    return exitFailure;
+  }
+  settings.delimiter = delimiter.at(0).toLatin1();
+
+  bool ok = true;
+  if (parser.isSet(columnOption))
+  {
+    settings.column = parser.value(columnOption).toInt(&ok);
+    if (!ok || settings.column < 0)
+    {
+      errorStream() << "Invalid column: " << parser.value(columnOption) << endl;
+      return exitFailure;
+    }
+  }
+
+  const qint64 chunkSize = parser.value(chunkSizeOption).toLongLong(&ok);
+  if (!ok || chunkSize <= 0)
+  {
+    errorStream() << "Invalid chunk size: " << parser.value(chunkSizeOption) << endl;
+    return exitFailure;
+  }
+
+  const bool pointInput = parser.isSet(pointsOption);
+  CoordinateConversionEngine engine;
+  if (!engineCommandLine.configureEngine(parser, !pointInput, engine, &application))
+    return exitFailure;
+
+  if (pointInput)
+  {
+    // the engine converts each batch of points on the global pool
+    if (parser.isSet(threadsOption))
+    {
+      const int threadCount = parser.value(threadsOption).toInt(&ok);
+      if (!ok || threadCount <= 0)
+      {
+        errorStream() << "Invalid thread count: " << parser.value(threadsOption) << endl;
+        return exitFailure;
+      }
+      QThreadPool::globalInstance()->setMaxThreadCount(threadCount);
+    }
+
+    return convertPointFile(engine, parser.positionalArguments().first(), parser.value(outputOption));
+  }
+
+  QFile input(parser.positionalArguments().first());
+  if (!input.open(QIODevice::ReadOnly))
+  {
+    errorStream() << "Could not open " << input.fileName() << ": " << input.errorString() << endl;
+    return exitFailure;
+  }
+
+  // pages of the mapping are read on demand and can be dropped again by the
+  // system, so the whole file is mapped at once
+  const qint64 inputSize = input.size();
+  const char* data = nullptr;
+  if (inputSize > 0)
+  {
+    data = reinterpret_cast<const char*>(input.map(0, inputSize));
+    if (!data)
+    {
+      errorStream() << "Could not map " << input.fileName() << ": " << input.errorString() << endl;
+      return exitFailure;
+    }
+  }
+
+  QFile output;
+  bool outputOpened = false;
+  if (parser.isSet(outputOption))
+  {
+    output.setFileName(parser.value(outputOption));
+    outputOpened = output.open(QIODevice::WriteOnly | QIODevice::Truncate);
+  }
+  else
+  {
+    outputOpened = output.open(stdout, QIODevice::WriteOnly);
+  }
+
+  if (!outputOpened)
+  {
+    errorStream() << "Could not open the output: " << output.errorString() << endl;
+    return exitFailure;
+  }
+
+  QElapsedTimer timer;
+  timer.start();
+
+  if (!parser.isSet(noHeaderOption))
+  {
+    QByteArray header("input");
+    for (const CoordinateFormatOption& option : engine.options())
+    {
+      header.append(settings.delimiter);
+      appendCsvField(header, option.name().toUtf8(), settings.delimiter);
+    }
+    header.append('\n');
+    if (output.write(header) != header.size())
+    {
+      errorStream() << "Could not write the output: " << output.errorString() << endl;
+      return exitFailure;
+    }
+  }
+
+  const char* position = data;
+  const char* const end = data + inputSize;
+  qint64 lineNumber = 1;
+  if (parser.isSet(skipHeaderOption) && position != end)
+  {
+    const void* newline = std::memchr(position, '\n', static_cast<std::size_t>(end - position));
+    position = newline ? static_cast<const char*>(newline) + 1 : end;
+    ++lineNumber;
+  }
+
+  QThreadPool pool;
+  if (parser.isSet(threadsOption))
+  {
+    const int threadCount = parser.value(threadsOption).toInt(&ok);
+    if (!ok || threadCount <= 0)
+    {
+      errorStream() << "Invalid thread count: " << parser.value(threadsOption) << endl;
+      return exitFailure;
+    }
+    pool.setMaxThreadCount(threadCount);
+  }
+
+  const int maximumChunksInFlight = chunksInFlightPerThread * pool.maxThreadCount();
+  QQueue<QFuture<ChunkResult>> chunksInFlight;
+  qint64 rowCount = 0;
+  qint64 errorCount = 0;
+  QVector<qint64> reportedErrorLines;
+  std::atomic<bool> writeFailed(false);
+
+  // writes the oldest chunk, waiting for it if needed; after a failed write
+  // the chunks still in flight stop early and are only waited for
+  auto writeNextChunk = [&]()
+  {
+    const ChunkResult result = chunksInFlight.dequeue().result();
+    if (writeFailed.load())
+      return;
+
+    if (output.write(result.output) != result.output.size())
+    {
+      writeFailed.store(true);
+      return;
+    }
+
+    for (const int line : result.errorLines)
+    {
+      if (reportedErrorLines.size() < maximumReportedErrors)
+        reportedErrorLines.append(lineNumber + line);
+    }
+
+    rowCount += result.rowCount;
+    errorCount += result.errorLines.size();
+    lineNumber += result.lineCount;
+  };
+
+  while (position < end && !writeFailed.load())
+  {
+    // extend each chunk to the end of the line it stops in
+    const char* chunkEnd = end;
+    if (end - position > chunkSize)
+    {
+      const char* searchStart = position + chunkSize - 1;
+      const void* newline = std::memchr(searchStart, '\n', static_cast<std::size_t>(end - searchStart));
+      chunkEnd = newline ? static_cast<const char*>(newline) + 1 : end;
+    }
+
+    if (chunksInFlight.size() == maximumChunksInFlight)
+      writeNextChunk();
+
+    Chunk chunk;
+    chunk.begin = position;
+    chunk.end = chunkEnd;
+    chunksInFlight.enqueue(QtConcurrent::run(&pool, [&engine, &settings, chunk, &writeFailed]()
+    {
+      return convertChunk(engine, chunk, settings, writeFailed);
+    }));
+
+    position = chunkEnd;
+  }
+
+  while (!chunksInFlight.isEmpty())
+    writeNextChunk();
+
+  if (writeFailed.load() || !output.flush())
+  {
+    errorStream() << "Could not write the output: " << output.errorString() << endl;
+    return exitFailure;
+  }
+
+  const double seconds = timer.nsecsElapsed() / 1.0e9;
+  const double rowsPerSecond = seconds > 0.0 ? rowCount / seconds : 0.0;
+  errorStream() << rowCount << " rows converted in " << QString::number(seconds, 'f', 3) << " s ("
+                << QString::number(rowsPerSecond, 'f', 0) << " rows/s), " << errorCount << " error rows" << endl;
+  for (const qint64 line : reportedErrorLines)
+    errorStream() << "  line " << line << ": the notation could not be decoded" << endl;
+  if (errorCount > reportedErrorLines.size())
+    errorStream() << "  ..." << endl;
+
+  return errorCount > 0 ? exitErrorRows : exitSuccess;
+}
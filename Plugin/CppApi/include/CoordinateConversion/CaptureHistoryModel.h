@@ -0,0 +1,107 @@
+/*******************************************************************************
+ *  Copyright 2012-2018 Esri
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ******************************************************************************/
+
+#ifndef CAPTUREHISTORYMODEL_H
+#define CAPTUREHISTORYMODEL_H
+
+#include "ToolkitCommon.h"
+
+// C++ API headers
+#include "Point.h"
+
+// Qt headers
+#include <QAbstractListModel>
+#include <QHash>
+#include <QStringList>
+#include <QVector>
+
+namespace Esri
+{
+namespace ArcGISRuntime
+{
+namespace Toolkit
+{
+
+class TOOLKIT_EXPORT CaptureHistoryModel : public QAbstractListModel
+{
+  Q_OBJECT
+
+  // the most captures kept; the oldest is dropped to make room for a new one
+  Q_PROPERTY(int capacity READ capacity WRITE setCapacity NOTIFY capacityChanged)
+  Q_PROPERTY(int count READ count NOTIFY countChanged)
+
+public:
+  enum CaptureHistoryRoles
+  {
+    CaptureHistoryXRole = Qt::UserRole + 1,
+    CaptureHistoryYRole = Qt::UserRole + 2,
+    CaptureHistoryFormatsRole = Qt::UserRole + 3,
+    CaptureHistoryNotationsRole = Qt::UserRole + 4
+  };
+
+  static constexpr int defaultCapacity = 1000;
+
+  // remove every capture
+  Q_INVOKABLE void clear();
+
+  // the notation of the capture at row in the named format
+  Q_INVOKABLE QString notation(int row, const QString& formatName) const;
+
+signals:
+  void capacityChanged();
+  void countChanged();
+
+public:
+  explicit CaptureHistoryModel(QObject* parent = nullptr);
+  ~CaptureHistoryModel();
+
+  int capacity() const;
+  void setCapacity(int capacity);
+
+  int count() const;
+
+  void append(const Esri::ArcGISRuntime::Point& point, const QStringList& formatNames, const QStringList& notations);
+  Esri::ArcGISRuntime::Point point(int row) const;
+
+  int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+
+  QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+
+protected:
+  QHash<int, QByteArray> roleNames() const override;
+
+private:
+  struct Capture
+  {
+    Esri::ArcGISRuntime::Point point;
+    QStringList formatNames; // shared between captures made with the same options
+    QStringList notations;
+  };
+
+  int slot(int row) const;
+  void setupRoles();
+
+  QHash<int, QByteArray> m_roles;
+  QVector<Capture> m_captures;
+  int m_first = 0;
+  int m_count = 0;
+};
+
+} // Toolkit
+} // ArcGISRuntime
+} // Esri
+
+#endif // CAPTUREHISTORYMODEL_H
@@ -0,0 +1,92 @@
+/*******************************************************************************
+ *  Copyright 2012-2018 Esri
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ******************************************************************************/
+
+#ifndef CONVERSIONRESULTCACHE_H
+#define CONVERSIONRESULTCACHE_H
+
+#include "ToolkitCommon.h"
+
+// Qt headers
+#include <QCache>
+#include <QString>
+
+namespace Esri
+{
+namespace ArcGISRuntime
+{
+
+class Point;
+
+namespace Toolkit
+{
+
+class CoordinateFormatOption;
+
+// the cell of a point for an option, plus the option's settings packed into 64 bits
+struct ConversionCacheKey
+{
+  qint64 latitudeIndex = 0;
+  qint64 longitudeIndex = 0;
+  quint64 optionSettings = 0;
+};
+
+inline bool operator==(const ConversionCacheKey& key1, const ConversionCacheKey& key2)
+{
+  return key1.latitudeIndex == key2.latitudeIndex &&
+      key1.longitudeIndex == key2.longitudeIndex &&
+      key1.optionSettings == key2.optionSettings;
+}
+
+inline uint qHash(const ConversionCacheKey& key, uint seed = 0)
+{
+  return ::qHash(key.latitudeIndex, seed) ^ (::qHash(key.longitudeIndex, seed) * 31u) ^ (::qHash(key.optionSettings, seed) * 131u);
+}
+
+class TOOLKIT_EXPORT ConversionResultCache
+{
+public:
+  static constexpr int defaultCapacity = 1024;
+
+  explicit ConversionResultCache(int capacity = defaultCapacity);
+  ~ConversionResultCache();
+
+  bool find(const CoordinateFormatOption& option, const Point& point, QString& notation);
+  void insert(const CoordinateFormatOption& option, const Point& point, const QString& notation);
+  void clear();
+
+  bool sameCell(const CoordinateFormatOption& option, const Point& point1, const Point& point2) const;
+
+  int capacity() const;
+  void setCapacity(int capacity);
+
+  quint64 hitCount() const;
+  quint64 missCount() const;
+
+private:
+  Q_DISABLE_COPY(ConversionResultCache)
+
+  bool makeKey(const CoordinateFormatOption& option, const Point& point, ConversionCacheKey& key) const;
+
+  QCache<ConversionCacheKey, QString> m_entries;
+  quint64 m_hitCount = 0;
+  quint64 m_missCount = 0;
+};
+
+} // Toolkit
+} // ArcGISRuntime
+} // Esri
+
+#endif // CONVERSIONRESULTCACHE_H
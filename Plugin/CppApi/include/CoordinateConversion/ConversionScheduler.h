@@ -0,0 +1,105 @@
+/*******************************************************************************
+ *  Copyright 2012-2018 Esri
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ******************************************************************************/
+
+#ifndef CONVERSIONSCHEDULER_H
+#define CONVERSIONSCHEDULER_H
+
+#include "ToolkitCommon.h"
+
+// C++ API headers
+#include "Point.h"
+
+// Qt headers
+#include <QElapsedTimer>
+#include <QObject>
+#include <QPointer>
+
+class QQuickWindow;
+class QTimer;
+
+namespace Esri
+{
+namespace ArcGISRuntime
+{
+namespace Toolkit
+{
+
+class TOOLKIT_EXPORT ConversionScheduler : public QObject
+{
+  Q_OBJECT
+
+  // the most points passed on per second; 0 passes every point on immediately
+  Q_PROPERTY(double maximumRate READ maximumRate WRITE setMaximumRate NOTIFY maximumRateChanged)
+
+  // pass on at most one point per rendered frame of the window instead
+  Q_PROPERTY(bool frameSynced READ isFrameSynced WRITE setFrameSynced NOTIFY frameSyncedChanged)
+
+  Q_PROPERTY(int processedCount READ processedCount NOTIFY countsChanged)
+  Q_PROPERTY(int droppedCount READ droppedCount NOTIFY countsChanged)
+
+public:
+  static constexpr double defaultMaximumRate = 10.0;
+
+  // forget the counts so far
+  Q_INVOKABLE void resetCounts();
+
+signals:
+  void maximumRateChanged();
+  void frameSyncedChanged();
+  void countsChanged();
+  void pointReady(const Esri::ArcGISRuntime::Point& point);
+
+public:
+  explicit ConversionScheduler(QObject* parent = nullptr);
+  ~ConversionScheduler();
+
+  double maximumRate() const;
+  void setMaximumRate(double maximumRate);
+
+  bool isFrameSynced() const;
+  void setFrameSynced(bool frameSynced);
+
+  void setWindow(QQuickWindow* window);
+
+  int processedCount() const;
+  int droppedCount() const;
+
+  void submit(const Esri::ArcGISRuntime::Point& point);
+  void flush();
+  void discard();
+
+private:
+  void schedule();
+  void dispatch();
+  void connectWindow();
+
+  Esri::ArcGISRuntime::Point m_pendingPoint;
+  bool m_hasPendingPoint = false;
+  double m_maximumRate = defaultMaximumRate;
+  bool m_frameSynced = false;
+  QElapsedTimer m_sinceDispatch;
+  QTimer* m_timer = nullptr;
+  QPointer<QQuickWindow> m_window;
+  QMetaObject::Connection m_frameConnection;
+  int m_processedCount = 0;
+  int m_droppedCount = 0;
+};
+
+} // Toolkit
+} // ArcGISRuntime
+} // Esri
+
+#endif // CONVERSIONSCHEDULER_H
@@ -0,0 +1,72 @@
+/*******************************************************************************
+ *  Copyright 2012-2018 Esri
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ******************************************************************************/
+
+#ifndef COORDINATECONVERSIONBATCHRESULT_H
+#define COORDINATECONVERSIONBATCHRESULT_H
+
+#include "ToolkitCommon.h"
+
+#include <QStringList>
+#include <QVariantMap>
+#include <QVector>
+
+namespace Esri
+{
+namespace ArcGISRuntime
+{
+namespace Toolkit
+{
+
+class TOOLKIT_EXPORT CoordinateConversionBatchResult
+{
+public:
+  CoordinateConversionBatchResult() = default;
+  CoordinateConversionBatchResult(const QStringList& formatNames, int rowCount);
+  ~CoordinateConversionBatchResult() = default;
+
+  int rowCount() const;
+  int columnCount() const;
+
+  QStringList formatNames() const;
+  int columnIndex(const QString& formatName) const;
+
+  QVector<QString> column(int column) const;
+  QString notation(int row, int column) const;
+
+  bool isCanceled() const;
+
+  QVector<int> errorRows() const;
+
+  QVariantMap toVariantMap() const;
+
+private:
+  friend class CoordinateConversionController;
+  friend class CoordinateConversionEngine;
+
+  QString* columnData(int column);
+
+  QStringList m_formatNames;
+  QVector<QVector<QString>> m_columns;
+  int m_rowCount = 0;
+  bool m_canceled = false;
+  QVector<int> m_errorRows;
+};
+
+} // Toolkit
+} // ArcGISRuntime
+} // Esri
+
+#endif // COORDINATECONVERSIONBATCHRESULT_H
@@ -39,6 +39,11 @@ public:
   static const QString UTM_FORMAT;
   static const QString GARS_FORMAT;
   static const QString GEOREF_FORMAT;
+  static const QString ECEF_FORMAT;
+  static const QString ENU_FORMAT;
+  static const QString GEOHASH_FORMAT;
+  static const QString OPEN_LOCATION_CODE_FORMAT;
+  static const QString CELL_ID_FORMAT;
   static const QString LATLON;
   static const QString COORDINATE_FORMAT_PROPERTY;
 };
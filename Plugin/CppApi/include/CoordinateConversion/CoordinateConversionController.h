@@ -20,17 +20,35 @@
 
 // toolkit headers
 #include "AbstractTool.h"
+#include "CaptureHistoryModel.h"
+#include "ConversionResultCache.h"
+#include "ConversionScheduler.h"
+#include "CoordinateConversionBatchResult.h"
+#include "CoordinateConversionEngine.h"
+#include "CoordinateFormatDefaults.h"
+#include "CoordinateFormatOption.h"
+#include "PointStreamConverter.h"
+#include "TrackTableModel.h"
 
 // C++ API headers
 #include "GeometryTypes.h"
 #include "Point.h"
+#include "Polyline.h"
 #include "SpatialReference.h"
 
 // Qt headers
 #include <QAbstractListModel>
+#include <QHash>
 #include <QPointF>
+#include <QSet>
+
+// STL headers
+#include <atomic>
+#include <memory>
 
 class QMouseEvent;
+class QThreadPool;
+template <typename T> class QFutureWatcher;
 
 namespace Esri
 {
@@ -45,6 +63,7 @@ namespace Toolkit
 
 class CoordinateConversionOptions;
 class CoordinateConversionResults;
+class Result;
 
 class TOOLKIT_EXPORT CoordinateConversionController : public AbstractTool
 {
@@ -68,6 +87,30 @@ class TOOLKIT_EXPORT CoordinateConversionController : public AbstractTool
   // whether the tool is in "capture mode" (sets the target to a clicked point) or "live" mode (uses current location)
   Q_PROPERTY(bool captureMode READ isCaptureMode WRITE setCaptureMode NOTIFY captureModeChanged)
 
+  // whether convertNotation recognizes the format of each notation instead of using inputFormat
+  Q_PROPERTY(bool autoDetectInputFormat READ autoDetectInputFormat WRITE setAutoDetectInputFormat NOTIFY autoDetectInputFormatChanged)
+
+  // whether convertPoint and convertNotation run on worker threads
+  Q_PROPERTY(bool asynchronous READ isAsynchronous WRITE setAsynchronous NOTIFY asynchronousChanged)
+
+  // paces the conversion of live location updates
+  Q_PROPERTY(ConversionScheduler* locationScheduler READ locationScheduler CONSTANT)
+
+  // whether the point under the mouse cursor is converted as it moves
+  Q_PROPERTY(bool hoverMode READ isHoverMode WRITE setHoverMode NOTIFY hoverModeChanged)
+
+  // paces the conversion of points under the mouse cursor, once per frame by default
+  Q_PROPERTY(ConversionScheduler* hoverScheduler READ hoverScheduler CONSTANT)
+
+  // the points captured in capture mode, with their notations
+  Q_PROPERTY(CaptureHistoryModel* captureHistory READ captureHistory CONSTANT)
+
+  // whether each captured point and location update is appended to the track table
+  Q_PROPERTY(bool trackMode READ isTrackMode WRITE setTrackMode NOTIFY trackModeChanged)
+
+  // the points recorded in track mode, with one column per format
+  Q_PROPERTY(TrackTableModel* trackTable READ trackTable CONSTANT)
+
 public:
 
   // convert the following notation using the input options specified
@@ -96,6 +139,25 @@ public:
 
   Q_INVOKABLE void setGeoView(QObject* geoView);
 
+  // convert a list of QPointF (x/y in the current spatial reference) to every format, in the background
+  Q_INVOKABLE void convertPoints(const QVariantList& points);
+
+  // stop the running background batch conversion, if any
+  Q_INVOKABLE void cancelBatchConversion();
+
+  // convert every point of a GPX, GeoJSON or CSV file to every format, in the background,
+  // writing the points and notations to a file in the format of its extension
+  Q_INVOKABLE void convertFile(const QString& inputFileName, const QString& outputFileName);
+
+  // stop the running background file conversion, if any
+  Q_INVOKABLE void cancelFileConversion();
+
+  // the names of the formats the notation could be in, most likely first
+  Q_INVOKABLE QStringList detectFormats(const QString& notation) const;
+
+  // detectFormats for each notation in the list
+  Q_INVOKABLE QVariantList detectFormatsForNotations(const QStringList& notations) const;
+
 signals:
   void optionsChanged();
   void resultsChanged();
@@ -106,6 +168,13 @@ signals:
   void coordinateFormatsChanged();
   void inputFormatChanged();
   void captureModeChanged();
+  void autoDetectInputFormatChanged();
+  void asynchronousChanged();
+  void hoverModeChanged();
+  void trackModeChanged();
+  void batchConversionProgress(int convertedCount, int totalCount);
+  void batchConversionCompleted(const QVariantMap& results);
+  void fileConversionCompleted(qint64 pointCount, bool canceled, const QString& errorString);
 
 public:
   CoordinateConversionController(QObject* parent = nullptr);
@@ -114,6 +183,9 @@ public:
   void setSpatialReference(const Esri::ArcGISRuntime::SpatialReference& spatialReference);
   void setPointToConvert(const Esri::ArcGISRuntime::Point& point);
 
+  CoordinateConversionBatchResult convertPoints(const QList<Esri::ArcGISRuntime::Point>& points) const;
+  CoordinateConversionBatchResult convertNotations(const QStringList& notations) const;
+
   bool runConversion() const;
   void setRunConversion(bool runConversion);
 
@@ -136,18 +208,69 @@ public:
   bool isCaptureMode() const;
   void setCaptureMode(bool captureMode);
 
+  bool autoDetectInputFormat() const;
+  void setAutoDetectInputFormat(bool autoDetectInputFormat);
+
+  bool isAsynchronous() const;
+  void setAsynchronous(bool asynchronous);
+
+  ConversionScheduler* locationScheduler() const;
+
+  bool isHoverMode() const;
+  void setHoverMode(bool hoverMode);
+
+  ConversionScheduler* hoverScheduler() const;
+
+  CaptureHistoryModel* captureHistory() const;
+
+  bool isTrackMode() const;
+  void setTrackMode(bool trackMode);
+
+  TrackTableModel* trackTable() const;
+
+  quint64 resultCacheHitCount() const;
+  quint64 resultCacheMissCount() const;
+
+  // the settings of the options created by addCoordinateFormat and format detection
+  CoordinateFormatDefaults formatDefaults() const;
+  void setFormatDefaults(const CoordinateFormatDefaults& formatDefaults);
+
 public slots:
   void onMouseClicked(QMouseEvent& mouseEvent);
   void onLocationChanged(const Esri::ArcGISRuntime::Point& location);
+  void onMouseMovedPoint(const Esri::ArcGISRuntime::Point& point);
 
 private:
+  struct AsyncConversion;
+  struct BatchConversion;
+
   CoordinateConversionResults* resultsInternal();
   bool setGeoViewInternal(GeoView* geoView);
+  void updateSchedulerWindow();
+  void onHoverPointReady(const Esri::ArcGISRuntime::Point& point);
+  void onLocationPointReady(const Esri::ArcGISRuntime::Point& point);
+  void recordCapture(const Esri::ArcGISRuntime::Point& point);
+  void recordTrackPoint(const Esri::ArcGISRuntime::Point& point);
+  void recordPointAsync(const Esri::ArcGISRuntime::Point& point, bool capture, bool track);
+  void appendFinishedRecords();
+  void watchViewBoundary();
+  void invalidateViewBoundary();
+  const Esri::ArcGISRuntime::Polyline& viewBoundary(double padding, double screenWidth, double screenHeight) const;
+  Esri::ArcGISRuntime::Point findValidTopPoint(double x, double screenHeight) const;
   Esri::ArcGISRuntime::Point pointFromNotation(const QString& incomingNotation);
-  QString convertPointInternal(CoordinateConversionOptions* option, const Esri::ArcGISRuntime::Point& point) const;
-
-  bool isInputFormat(CoordinateConversionOptions* option) const;
-  bool isFormat(CoordinateConversionOptions* option, const QString& formatName) const;
+  QString cachedConversion(const CoordinateFormatOption& option, const Esri::ArcGISRuntime::Point& point) const;
+
+  bool isInputFormat(const CoordinateFormatOption& option) const;
+  CoordinateConversionOptions* optionForFormat(int formatId) const;
+  void rebuildFormatIndex();
+  void updateEngineOptions();
+  void scheduleConversion(CoordinateConversionOptions* dirtyOption);
+  void runScheduledConversion();
+  void startAsyncConversion(const Esri::ArcGISRuntime::Point& point, const QString& notation,
+                            bool capture = false, bool track = false);
+  void runAsyncConversion(AsyncConversion& conversion) const;
+  void finishAsyncConversion(AsyncConversion& conversion);
+  void applyResults(QList<Result>&& results);
 
   Esri::ArcGISRuntime::Point m_pointToConvert;
   Esri::ArcGISRuntime::SpatialReference m_spatialReference;
@@ -155,12 +278,37 @@ private:
 
   QList<CoordinateConversionOptions*> m_options;
   bool m_runConversion = true;
+  QSet<CoordinateConversionOptions*> m_dirtyOptions;
+  bool m_fullConversionPending = false;
+  bool m_conversionScheduled = false;
 
   QStringList m_coordinateFormats;
   QString m_inputFormat;
+  int m_inputFormatId = -1;
+  QHash<int, CoordinateConversionOptions*> m_optionsByFormatId;
   bool m_captureMode = false;
+  bool m_autoDetectInputFormat = false;
   Esri::ArcGISRuntime::MapQuickView* m_mapView = nullptr;
   Esri::ArcGISRuntime::SceneQuickView* m_sceneView = nullptr;
+  ConversionScheduler* m_locationScheduler = nullptr;
+  ConversionScheduler* m_hoverScheduler = nullptr;
+  bool m_hoverMode = false;
+  CaptureHistoryModel* m_captureHistory = nullptr;
+  TrackTableModel* m_trackTable = nullptr;
+  bool m_trackMode = false;
+  QList<QMetaObject::Connection> m_viewBoundaryConnections;
+  mutable Esri::ArcGISRuntime::Polyline m_viewBoundary;
+  mutable bool m_viewBoundaryValid = false;
+  mutable Esri::ArcGISRuntime::Point m_projectedPointToConvert;
+  mutable bool m_projectedPointValid = false;
+  bool m_asynchronous = false;
+  QThreadPool* m_conversionPool = nullptr;
+  std::atomic<quint64> m_conversionGeneration{0};
+  QList<std::shared_ptr<AsyncConversion>> m_pendingRecords;
+  QFutureWatcher<void>* m_batchWatcher = nullptr;
+  std::shared_ptr<std::atomic<bool>> m_fileConversionCanceled;
+  CoordinateConversionEngine m_engine;
+  mutable ConversionResultCache m_resultCache;
 };
 
 } // Toolkit
@@ -0,0 +1,149 @@
+/*******************************************************************************
+ *  Copyright 2012-2018 Esri
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ******************************************************************************/
+
+#ifndef COORDINATECONVERSIONENGINE_H
+#define COORDINATECONVERSIONENGINE_H
+
+// toolkit headers
+#include "CoordinateConversionBatchResult.h"
+#include "CoordinateFormatDefaults.h"
+#include "CoordinateFormatOption.h"
+#include "NativeConversionSupport.h"
+
+// C++ API headers
+#include "Point.h"
+#include "Polygon.h"
+#include "SpatialReference.h"
+
+// Qt headers
+#include <QList>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+namespace Esri
+{
+namespace ArcGISRuntime
+{
+namespace Toolkit
+{
+
+class TOOLKIT_EXPORT CoordinateConversionEngine
+{
+public:
+  // number of points converted by a single task of a batch conversion
+  static constexpr int batchChunkSize = 256;
+
+  CoordinateConversionEngine();
+  explicit CoordinateConversionEngine(const CoordinateFormatDefaults& formatDefaults);
+  ~CoordinateConversionEngine();
+
+  // the option set converted by convertPoint and the batch conversions
+  QList<CoordinateFormatOption> options() const;
+  void setOptions(const QList<CoordinateFormatOption>& options);
+  void addOption(const CoordinateFormatOption& option);
+  void clearOptions();
+
+  QString inputFormat() const;
+  void setInputFormat(const QString& inputFormat);
+
+  // the first option of the input format; invalid if there is none
+  CoordinateFormatOption inputOption() const;
+
+  bool autoDetectInputFormat() const;
+  void setAutoDetectInputFormat(bool autoDetectInputFormat);
+
+  Esri::ArcGISRuntime::SpatialReference spatialReference() const;
+  void setSpatialReference(const Esri::ArcGISRuntime::SpatialReference& spatialReference);
+
+  // the settings of the options used to decode recognized notations with no option in the set
+  CoordinateFormatDefaults formatDefaults() const;
+  void setFormatDefaults(const CoordinateFormatDefaults& formatDefaults);
+
+  // conversions with the option set
+  QStringList convertPoint(const Esri::ArcGISRuntime::Point& point) const;
+  Esri::ArcGISRuntime::Point pointFromNotation(const QString& notation) const;
+  CoordinateConversionBatchResult convertPoints(const QList<Esri::ArcGISRuntime::Point>& points) const;
+  CoordinateConversionBatchResult convertNotations(const QStringList& notations) const;
+
+  // conversions with explicit options, which may be called from any thread
+  QString convert(const CoordinateFormatOption& option, const Esri::ArcGISRuntime::Point& point) const;
+  CoordinateConversionBatchResult convertPoints(const QList<CoordinateFormatOption>& options,
+                                                const QList<Esri::ArcGISRuntime::Point>& points) const;
+  Esri::ArcGISRuntime::Point pointFromNotation(const CoordinateFormatOption& option, const QString& notation,
+                                               const Esri::ArcGISRuntime::SpatialReference& spatialReference) const;
+  Esri::ArcGISRuntime::Point detectedPointFromNotation(const QString& notation, const QList<CoordinateFormatOption>& options,
+                                                       const CoordinateFormatDefaults& formatDefaults,
+                                                       const Esri::ArcGISRuntime::SpatialReference& spatialReference) const;
+  QStringList detectFormats(const QString& notation) const;
+
+  // the cell of a cell id notation; empty if it cannot be decoded
+  Esri::ArcGISRuntime::Polygon cellIdPolygon(const CoordinateFormatOption& option, const QString& notation,
+                                             const Esri::ArcGISRuntime::SpatialReference& spatialReference) const;
+
+  // the first row of each chunk of a batch of rowCount points
+  static QVector<int> batchChunks(int rowCount);
+
+  // converts the chunk of points starting at firstRow with each option into the matching column
+  void convertBatchChunk(const QList<CoordinateFormatOption>& options, const QList<Esri::ArcGISRuntime::Point>& points,
+                         int firstRow, const QVector<QString*>& columns) const;
+
+private:
+  Q_DISABLE_COPY(CoordinateConversionEngine)
+
+  QString toLatitudeLongitude(const CoordinateFormatOption& option, const Esri::ArcGISRuntime::Point& point) const;
+  QString toGridNotation(const CoordinateFormatOption& option, const Esri::ArcGISRuntime::Point& point) const;
+  void convertGridChunk(const CoordinateFormatOption& option, const QList<Esri::ArcGISRuntime::Point>& points,
+                        int firstRow, int lastRow, QString* notations) const;
+  Esri::ArcGISRuntime::Point gridPointFromNotation(const CoordinateFormatOption& option, const QString& notation,
+                                                   const Esri::ArcGISRuntime::SpatialReference& spatialReference) const;
+  QString toCellNotation(const CoordinateFormatOption& option, const Esri::ArcGISRuntime::Point& point) const;
+  void convertCellChunk(const CoordinateFormatOption& option, const QList<Esri::ArcGISRuntime::Point>& points,
+                        int firstRow, int lastRow, QString* notations) const;
+  Esri::ArcGISRuntime::Point cellPointFromNotation(const CoordinateFormatOption& option, const QString& notation,
+                                                   const Esri::ArcGISRuntime::SpatialReference& spatialReference) const;
+  QString toGeocentricNotation(const CoordinateFormatOption& option, const Esri::ArcGISRuntime::Point& point) const;
+  Esri::ArcGISRuntime::Point geocentricPointFromNotation(const CoordinateFormatOption& option, const QString& notation,
+                                                         const Esri::ArcGISRuntime::SpatialReference& spatialReference) const;
+  void convertGeocentricChunk(const CoordinateFormatOption& option, const QList<Esri::ArcGISRuntime::Point>& points,
+                              int firstRow, int lastRow, QString* notations) const;
+  QString toGeocodeNotation(const CoordinateFormatOption& option, const Esri::ArcGISRuntime::Point& point) const;
+  Esri::ArcGISRuntime::Point geocodePointFromNotation(const CoordinateFormatOption& option, const QString& notation,
+                                                      const Esri::ArcGISRuntime::SpatialReference& spatialReference) const;
+  void convertGeocodeChunk(const CoordinateFormatOption& option, const QList<Esri::ArcGISRuntime::Point>& points,
+                           int firstRow, int lastRow, QString* notations) const;
+  QString toCellIdNotation(const CoordinateFormatOption& option, const Esri::ArcGISRuntime::Point& point) const;
+  Esri::ArcGISRuntime::Point cellIdPointFromNotation(const CoordinateFormatOption& option, const QString& notation,
+                                                     const Esri::ArcGISRuntime::SpatialReference& spatialReference) const;
+  void convertCellIdChunk(const CoordinateFormatOption& option, const QList<Esri::ArcGISRuntime::Point>& points,
+                          int firstRow, int lastRow, QString* notations) const;
+
+  QList<CoordinateFormatOption> m_options;
+  QString m_inputFormat;
+  int m_inputFormatId = -1;
+  bool m_autoDetectInputFormat = false;
+  Esri::ArcGISRuntime::SpatialReference m_spatialReference;
+  CoordinateFormatDefaults m_formatDefaults;
+  NativeConversionGate m_latLonGate;
+  NativeConversionGate m_gridGate;
+  NativeConversionGate m_cellGate;
+};
+
+} // Toolkit
+} // ArcGISRuntime
+} // Esri
+
+#endif // COORDINATECONVERSIONENGINE_H
@@ -30,6 +30,8 @@ namespace ArcGISRuntime
 namespace Toolkit
 {
 
+class CoordinateFormatOption;
+
 class TOOLKIT_EXPORT CoordinateConversionOptions : public QObject
 {
   Q_OBJECT
@@ -44,6 +46,15 @@ class TOOLKIT_EXPORT CoordinateConversionOptions : public QObject
   Q_PROPERTY(LatitudeLongitudeFormat latLonFormat READ latLonFormat WRITE setLatLonFormat NOTIFY latLonFormatChanged)
   Q_PROPERTY(UtmConversionMode utmConversionMode READ utmConversionMode WRITE setUtmConversionMode NOTIFY utmConversionModeChanged)
 
+  // the origin of ENU coordinates: WGS 84 degrees and ellipsoidal height in metres
+  Q_PROPERTY(double enuOriginLatitude READ enuOriginLatitude WRITE setEnuOriginLatitude NOTIFY enuOriginLatitudeChanged)
+  Q_PROPERTY(double enuOriginLongitude READ enuOriginLongitude WRITE setEnuOriginLongitude NOTIFY enuOriginLongitudeChanged)
+  Q_PROPERTY(double enuOriginHeight READ enuOriginHeight WRITE setEnuOriginHeight NOTIFY enuOriginHeightChanged)
+
+  // the level of cell ids, and whether they are written as tokens or integers
+  Q_PROPERTY(int level READ level WRITE setLevel NOTIFY levelChanged)
+  Q_PROPERTY(CellIdNotation cellIdNotation READ cellIdNotation WRITE setCellIdNotation NOTIFY cellIdNotationChanged)
+
   Q_PROPERTY(QStringList coordinateTypeNames READ coordinateTypeNames CONSTANT)
 
 public:
@@ -54,7 +65,18 @@ public:
     CoordinateTypeLatLon,
     CoordinateTypeMgrs,
     CoordinateTypeUsng,
-    CoordinateTypeUtm
+    CoordinateTypeUtm,
+    CoordinateTypeEcef,
+    CoordinateTypeEnu,
+    CoordinateTypeGeohash,
+    CoordinateTypeOpenLocationCode,
+    CoordinateTypeCellId
+  };
+
+  enum CellIdNotation
+  {
+    CellIdToken,
+    CellIdInteger
   };
 
   // static qml methods
@@ -72,6 +94,11 @@ signals:
   void latLonFormatChanged();
   void utmConversionModeChanged();
   void garsConversionModeChanged();
+  void enuOriginLatitudeChanged();
+  void enuOriginLongitudeChanged();
+  void enuOriginHeightChanged();
+  void levelChanged();
+  void cellIdNotationChanged();
 
 public:
   CoordinateConversionOptions(QObject* parent = nullptr);
@@ -80,6 +107,9 @@ public:
   QString name() const;
   void setName(const QString& name);
 
+  // the interned id of the name, see CoordinateFormatRegistry
+  int formatId() const;
+
   CoordinateType outputMode() const;
   void setOutputMode(CoordinateType outputMode);
 
@@ -104,8 +134,28 @@ public:
   GarsConversionMode garsConvesrionMode() const;
   void setGarsConversionMode(GarsConversionMode conversionMode);
 
+  double enuOriginLatitude() const;
+  void setEnuOriginLatitude(double enuOriginLatitude);
+
+  double enuOriginLongitude() const;
+  void setEnuOriginLongitude(double enuOriginLongitude);
+
+  double enuOriginHeight() const;
+  void setEnuOriginHeight(double enuOriginHeight);
+
+  int level() const;
+  void setLevel(int level);
+
+  CellIdNotation cellIdNotation() const;
+  void setCellIdNotation(CellIdNotation cellIdNotation);
+
+  // a snapshot of the settings as a plain value, and assigning all of them from one
+  CoordinateFormatOption formatOption() const;
+  void setFormatOption(const CoordinateFormatOption& formatOption);
+
 private:
   QString m_name;
+  int m_formatId = -1;
   CoordinateType m_outputMode = CoordinateTypeUsng;
   bool m_addSpaces = true;
   int m_precision = 8;
@@ -115,6 +165,11 @@ private:
   LatitudeLongitudeFormat m_latLonFormat = LatitudeLongitudeFormat::DecimalDegrees;
   UtmConversionMode m_utmConversionMode = UtmConversionMode::LatitudeBandIndicators;
   GarsConversionMode m_garsConvesrionMode = GarsConversionMode::Center;
+  double m_enuOriginLatitude = 0.0;
+  double m_enuOriginLongitude = 0.0;
+  double m_enuOriginHeight = 0.0;
+  int m_level = 16;
+  CellIdNotation m_cellIdNotation = CellIdToken;
 };
 
 } // Toolkit
@@ -122,5 +177,6 @@ private:
 } // Esri
 
 Q_DECLARE_METATYPE(Esri::ArcGISRuntime::Toolkit::CoordinateConversionOptions::CoordinateType)
+Q_DECLARE_METATYPE(Esri::ArcGISRuntime::Toolkit::CoordinateConversionOptions::CellIdNotation)
 
 #endif // COORDINATECONVERSIONOPTIONS_H
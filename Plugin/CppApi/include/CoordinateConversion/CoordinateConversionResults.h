@@ -46,6 +46,9 @@ class TOOLKIT_EXPORT CoordinateConversionResults : public QAbstractListModel
 {
   Q_OBJECT
 
+  // the number of rows inserted, removed, moved or changed by the last update
+  Q_PROPERTY(int lastUpdateChangeCount READ lastUpdateChangeCount NOTIFY lastUpdateChangeCountChanged)
+
 public:
   enum CoordinateConversionResultsRoles
   {
@@ -64,8 +67,11 @@ public:
 
   QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
 
+  int lastUpdateChangeCount() const;
+
 signals:
   void resultsChanged();
+  void lastUpdateChangeCountChanged();
 
 protected:
   QHash<int, QByteArray> roleNames() const override;
@@ -74,12 +80,17 @@ private:
   friend class CoordinateConversionController;
 
   void setResults(QList<Result>&& results);
+  bool updateResults(QList<Result>&& results);
   void removeResult(const QString& name);
   void clearResults();
   void setupRoles();
+  int indexOf(const QString& name, int from) const;
+  void updateRow(int row, Result&& result);
+  void setLastUpdateChangeCount(int changeCount);
 
   QHash<int, QByteArray> m_roles;
   QList<Result> m_results;
+  int m_lastUpdateChangeCount = 0;
 };
 
 } // Toolkit
@@ -0,0 +1,99 @@
+/*******************************************************************************
+ *  Copyright 2012-2018 Esri
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ******************************************************************************/
+
+#ifndef COORDINATEFORMATDEFAULTS_H
+#define COORDINATEFORMATDEFAULTS_H
+
+#include "ToolkitCommon.h"
+#include "CoordinateConversionOptions.h"
+
+namespace Esri
+{
+namespace ArcGISRuntime
+{
+
+enum class GarsConversionMode;
+enum class MgrsConversionMode;
+enum class UtmConversionMode;
+
+namespace Toolkit
+{
+
+// the settings given to the options created by CoordinateFormatFactory; a
+// value type which cannot be changed once built, so copies can be shared
+// between threads freely
+class TOOLKIT_EXPORT CoordinateFormatDefaults
+{
+public:
+  CoordinateFormatDefaults();
+
+  int degreesMinutesSecondsDecimalPlaces() const;
+  int usngPrecision() const;
+  bool usngUseSpaces() const;
+  MgrsConversionMode mgrsConversionMode() const;
+  UtmConversionMode utmConversionMode() const;
+  bool utmUseSpaces() const;
+  GarsConversionMode garsConversionMode() const;
+
+  // the WGS 84 origin of ENU notations
+  double enuOriginLatitude() const;
+  double enuOriginLongitude() const;
+  double enuOriginHeight() const;
+
+  int geohashPrecision() const;
+  int openLocationCodePrecision() const;
+  int cellIdLevel() const;
+  CoordinateConversionOptions::CellIdNotation cellIdNotation() const;
+
+  // each returns a copy with one setting changed
+  CoordinateFormatDefaults withDegreesMinutesSecondsDecimalPlaces(int decimalPlaces) const;
+  CoordinateFormatDefaults withUsngPrecision(int precision) const;
+  CoordinateFormatDefaults withUsngUseSpaces(bool useSpaces) const;
+  CoordinateFormatDefaults withMgrsConversionMode(MgrsConversionMode conversionMode) const;
+  CoordinateFormatDefaults withUtmConversionMode(UtmConversionMode conversionMode) const;
+  CoordinateFormatDefaults withUtmUseSpaces(bool useSpaces) const;
+  CoordinateFormatDefaults withGarsConversionMode(GarsConversionMode conversionMode) const;
+  CoordinateFormatDefaults withEnuOrigin(double latitude, double longitude, double height) const;
+  CoordinateFormatDefaults withGeohashPrecision(int precision) const;
+  CoordinateFormatDefaults withOpenLocationCodePrecision(int precision) const;
+  CoordinateFormatDefaults withCellIdLevel(int level) const;
+  CoordinateFormatDefaults withCellIdNotation(CoordinateConversionOptions::CellIdNotation cellIdNotation) const;
+
+  bool operator==(const CoordinateFormatDefaults& other) const;
+  bool operator!=(const CoordinateFormatDefaults& other) const;
+
+private:
+  int m_dmsDecimalPlaces;
+  int m_usngPrecision;
+  bool m_usngSpaces;
+  MgrsConversionMode m_mgrsConversionMode;
+  UtmConversionMode m_utmConversionMode;
+  bool m_utmSpaces;
+  GarsConversionMode m_garsConversionMode;
+  double m_enuOriginLatitude;
+  double m_enuOriginLongitude;
+  double m_enuOriginHeight;
+  int m_geohashPrecision;
+  int m_openLocationCodePrecision;
+  int m_cellIdLevel;
+  CoordinateConversionOptions::CellIdNotation m_cellIdNotation;
+};
+
+} // Toolkit
+} // ArcGISRuntime
+} // Esri
+
+#endif // COORDINATEFORMATDEFAULTS_H
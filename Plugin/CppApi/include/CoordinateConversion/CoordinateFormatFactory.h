@@ -18,6 +18,7 @@
 #define COORDINATEFORMATFACTORY_H
 
 #include "ToolkitCommon.h"
+#include "CoordinateFormatDefaults.h"
 
 class QObject;
 
@@ -25,21 +26,29 @@ namespace Esri
 {
 namespace ArcGISRuntime
 {
-
-enum class GarsConversionMode;
-enum class MgrsConversionMode;
-enum class UtmConversionMode;
-
 namespace Toolkit
 {
 
 class CoordinateConversionOptions;
+class CoordinateFormatOption;
 
 class TOOLKIT_EXPORT CoordinateFormatFactory
 {
 public:
+  // depends only on its arguments, so it can be called from any thread
+  static CoordinateConversionOptions* createFormat(const QString& formatName, const CoordinateFormatDefaults& defaults,
+                                                   QObject* parent);
+
+  // the same settings as a value; invalid if formatName is not known
+  static CoordinateFormatOption createFormatOption(const QString& formatName, const CoordinateFormatDefaults& defaults);
+
+  // uses the process wide defaults below
   static CoordinateConversionOptions* createFormat(const QString& formatName, QObject* parent);
 
+  // the process wide defaults, copied by each new CoordinateConversionController
+  static CoordinateFormatDefaults defaults();
+  static void setDefaults(const CoordinateFormatDefaults& defaults);
+
   static void setDegreesMinutesSecondsDecimalPlaces(int decimalPlaces);
   static int degreesMinutesSecondsDecimalPlaces();
 
@@ -59,14 +68,24 @@ public:
   static void setGarsConversionMode(GarsConversionMode conversionMode);
   static GarsConversionMode garsConversionMode();
 
+  static void setEnuOrigin(double latitude, double longitude, double height);
+  static double enuOriginLatitude();
+  static double enuOriginLongitude();
+  static double enuOriginHeight();
+
+  static void setGeohashPrecision(int precision);
+  static int geohashPrecision();
+
+  static void setOpenLocationCodePrecision(int precision);
+  static int openLocationCodePrecision();
+
+  static void setCellIdLevel(int level);
+  static int cellIdLevel();
+  static void setCellIdNotation(CoordinateConversionOptions::CellIdNotation cellIdNotation);
+  static CoordinateConversionOptions::CellIdNotation cellIdNotation();
+
 private:
-  static int DMS_DECIMALPLACES;
-  static MgrsConversionMode MGRS_CONVERSION_MODE;
-  static int USNG_PRECISION;
-  static bool USNG_SPACES;
-  static UtmConversionMode UTM_CONVERSION_MODE;
-  static bool UTM_SPACES;
-  static GarsConversionMode GARS_CONVERSION_MODE;
+  CoordinateFormatFactory() = delete;
 };
 
 } // Toolkit
@@ -0,0 +1,120 @@
+/*******************************************************************************
+ *  Copyright 2012-2018 Esri
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ******************************************************************************/
+
+#ifndef COORDINATEFORMATOPTION_H
+#define COORDINATEFORMATOPTION_H
+
+// toolkit headers
+#include "CoordinateConversionOptions.h"
+
+// C++ API headers
+#include "GeometryTypes.h"
+
+// Qt headers
+#include <QString>
+
+namespace Esri
+{
+namespace ArcGISRuntime
+{
+namespace Toolkit
+{
+
+// the settings of one output format as a plain value, used by
+// CoordinateConversionEngine; CoordinateConversionOptions wraps one for QML
+class TOOLKIT_EXPORT CoordinateFormatOption
+{
+public:
+  using CoordinateType = CoordinateConversionOptions::CoordinateType;
+  using CellIdNotation = CoordinateConversionOptions::CellIdNotation;
+
+  CoordinateFormatOption() = default;
+  explicit CoordinateFormatOption(const CoordinateConversionOptions& options);
+
+  bool isValid() const;
+
+  QString name() const;
+  void setName(const QString& name);
+
+  // the interned id of the name, see CoordinateFormatRegistry
+  int formatId() const;
+
+  CoordinateType outputMode() const;
+  void setOutputMode(CoordinateType outputMode);
+
+  bool addSpaces() const;
+  void setAddSpaces(bool addSpaces);
+
+  int precision() const;
+  void setPrecision(int precision);
+
+  int decimalPlaces() const;
+  void setDecimalPlaces(int decimalPlaces);
+
+  MgrsConversionMode mgrsConversionMode() const;
+  void setMgrsConversionMode(MgrsConversionMode mgrsConversionMode);
+
+  LatitudeLongitudeFormat latLonFormat() const;
+  void setLatLonFormat(LatitudeLongitudeFormat latLonFormat);
+
+  UtmConversionMode utmConversionMode() const;
+  void setUtmConversionMode(UtmConversionMode utmConversionMode);
+
+  GarsConversionMode garsConversionMode() const;
+  void setGarsConversionMode(GarsConversionMode garsConversionMode);
+
+  // the origin of ENU coordinates: WGS 84 degrees and ellipsoidal height in metres
+  double enuOriginLatitude() const;
+  void setEnuOriginLatitude(double enuOriginLatitude);
+
+  double enuOriginLongitude() const;
+  void setEnuOriginLongitude(double enuOriginLongitude);
+
+  double enuOriginHeight() const;
+  void setEnuOriginHeight(double enuOriginHeight);
+
+  int level() const;
+  void setLevel(int level);
+
+  CellIdNotation cellIdNotation() const;
+  void setCellIdNotation(CellIdNotation cellIdNotation);
+
+  bool operator==(const CoordinateFormatOption& other) const;
+  bool operator!=(const CoordinateFormatOption& other) const;
+
+private:
+  QString m_name;
+  int m_formatId = -1;
+  CoordinateType m_outputMode = CoordinateConversionOptions::CoordinateTypeUsng;
+  bool m_addSpaces = true;
+  int m_precision = 8;
+  int m_decimalPlaces = 6;
+  MgrsConversionMode m_mgrsConversionMode = MgrsConversionMode::Automatic;
+  LatitudeLongitudeFormat m_latLonFormat = LatitudeLongitudeFormat::DecimalDegrees;
+  UtmConversionMode m_utmConversionMode = UtmConversionMode::LatitudeBandIndicators;
+  GarsConversionMode m_garsConversionMode = GarsConversionMode::Center;
+  double m_enuOriginLatitude = 0.0;
+  double m_enuOriginLongitude = 0.0;
+  double m_enuOriginHeight = 0.0;
+  int m_level = 16;
+  CellIdNotation m_cellIdNotation = CoordinateConversionOptions::CellIdToken;
+};
+
+} // Toolkit
+} // ArcGISRuntime
+} // Esri
+
+#endif // COORDINATEFORMATOPTION_H
@@ -0,0 +1,76 @@
+/*******************************************************************************
+ *  Copyright 2012-2018 Esri
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ******************************************************************************/
+
+#ifndef COORDINATEFORMATREGISTRY_H
+#define COORDINATEFORMATREGISTRY_H
+
+#include "ToolkitCommon.h"
+
+#include <QString>
+
+namespace Esri
+{
+namespace ArcGISRuntime
+{
+namespace Toolkit
+{
+
+class TOOLKIT_EXPORT CoordinateFormatRegistry
+{
+public:
+  // the formats of CoordinateConversionConstants always have these ids
+  enum BuiltInFormatId
+  {
+    InvalidFormatId = -1,
+    DecimalDegreesFormatId = 0,
+    DegreesDecimalMinutesFormatId,
+    DegreesMinutesSecondsFormatId,
+    MgrsFormatId,
+    UsngFormatId,
+    UtmFormatId,
+    GarsFormatId,
+    GeoRefFormatId,
+    EcefFormatId,
+    EnuFormatId,
+    GeohashFormatId,
+    OpenLocationCodeFormatId,
+    CellIdFormatId,
+    BuiltInFormatCount
+  };
+
+  // interns formatName (case insensitively), returning its id
+  static int formatId(const QString& formatName);
+
+  // the id of a built-in formatName, otherwise InvalidFormatId; never locks
+  static int builtInFormatId(const QString& formatName);
+
+  // the id of formatName if it has been interned, otherwise InvalidFormatId
+  static int findFormatId(const QString& formatName);
+
+  // the name formatId was first interned with
+  static QString formatName(int formatId);
+
+  static int formatCount();
+
+private:
+  CoordinateFormatRegistry() = delete;
+};
+
+} // Toolkit
+} // ArcGISRuntime
+} // Esri
+
+#endif // COORDINATEFORMATREGISTRY_H
@@ -0,0 +1,58 @@
+/*******************************************************************************
+ *  Copyright 2012-2018 Esri
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ******************************************************************************/
+
+#ifndef GARSCODEC_H
+#define GARSCODEC_H
+
+#include "ToolkitCommon.h"
+
+// STL headers
+#include <cstddef>
+
+namespace Esri
+{
+namespace ArcGISRuntime
+{
+namespace Toolkit
+{
+
+class TOOLKIT_EXPORT GarsCodec
+{
+public:
+  // the point of a cell returned when decoding
+  enum class CellPosition
+  {
+    LowerLeft,
+    Center
+  };
+
+  // a full GARS reference: 30 minute cell, 15 minute quadrant and 5 minute keypad
+  static constexpr int notationLength = 7;
+
+  static int encode(double latitude, double longitude, char* buffer);
+  static void encode(const double* latitudes, const double* longitudes, std::size_t count, char* buffer);
+
+  static bool decode(const char* text, int length, CellPosition position, double& latitude, double& longitude);
+
+private:
+  GarsCodec() = delete;
+};
+
+} // Toolkit
+} // ArcGISRuntime
+} // Esri
+
+#endif // GARSCODEC_H
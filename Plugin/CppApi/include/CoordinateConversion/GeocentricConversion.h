@@ -0,0 +1,78 @@
+/*******************************************************************************
+ *  Copyright 2012-2018 Esri
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ******************************************************************************/
+
+#ifndef GEOCENTRICCONVERSION_H
+#define GEOCENTRICCONVERSION_H
+
+#include "ToolkitCommon.h"
+
+// STL headers
+#include <cstddef>
+
+namespace Esri
+{
+namespace ArcGISRuntime
+{
+namespace Toolkit
+{
+
+// WGS 84 geodetic to Earth-centred Earth-fixed (ECEF) and local
+// East-North-Up (ENU) coordinates, in metres
+class TOOLKIT_EXPORT GeocentricConversion
+{
+public:
+  // an ENU frame: its origin in ECEF and the rotation into it
+  struct EnuFrame
+  {
+    double originX = 0.0;
+    double originY = 0.0;
+    double originZ = 0.0;
+    double sinLatitude = 0.0;
+    double cosLatitude = 1.0;
+    double sinLongitude = 0.0;
+    double cosLongitude = 1.0;
+  };
+
+  // large enough for any notation written by format
+  static constexpr int bufferSize = 96;
+
+  static constexpr int maximumDecimalPlaces = 6;
+
+  static EnuFrame enuFrame(double latitude, double longitude, double height);
+
+  static void toEcef(double latitude, double longitude, double height, double& x, double& y, double& z);
+  static void toEcef(const double* latitudes, const double* longitudes, const double* heights, std::size_t count,
+                     double* x, double* y, double* z);
+  static void fromEcef(double x, double y, double z, double& latitude, double& longitude, double& height);
+
+  static void toEnu(const EnuFrame& frame, double x, double y, double z, double& east, double& north, double& up);
+  static void toEnu(const EnuFrame& frame, const double* x, const double* y, const double* z, std::size_t count,
+                    double* east, double* north, double* up);
+  static void fromEnu(const EnuFrame& frame, double east, double north, double up, double& x, double& y, double& z);
+
+  // three coordinates separated by spaces, or by commas without addSpaces
+  static int format(double first, double second, double third, int decimalPlaces, bool addSpaces, char* buffer);
+  static bool parse(const char* text, int length, double& first, double& second, double& third);
+
+private:
+  GeocentricConversion() = delete;
+};
+
+} // Toolkit
+} // ArcGISRuntime
+} // Esri
+
+#endif // GEOCENTRICCONVERSION_H
@@ -0,0 +1,59 @@
+/*******************************************************************************
+ *  Copyright 2012-2018 Esri
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ******************************************************************************/
+
+
+#ifndef GEOHASHCODEC_H
+#define GEOHASHCODEC_H
+
+#include "ToolkitCommon.h"
+
+// STL headers
+#include <cstddef>
+
+namespace Esri
+{
+namespace ArcGISRuntime
+{
+namespace Toolkit
+{
+
+class TOOLKIT_EXPORT GeohashCodec
+{
+public:
+  // characters of the longest geohash; 60 bits of interleaved longitude and latitude
+  static constexpr int maximumPrecision = 12;
+
+  static constexpr int bufferSize = maximumPrecision;
+
+  static int encode(double latitude, double longitude, int precision, char* buffer);
+  static int encode(const double* latitudes, const double* longitudes, std::size_t count, int precision, char* buffer);
+
+  // the centre of the cell, or its bounds
+  static bool decode(const char* text, int length, double& latitude, double& longitude);
+  static bool decode(const char* text, int length, double& south, double& west, double& north, double& east);
+
+  // fixed-width geohashes as written by the batch encode; invalid ones decode to NaN
+  static std::size_t decode(const char* buffer, std::size_t count, int precision, double* latitudes, double* longitudes);
+
+private:
+  GeohashCodec() = delete;
+};
+
+} // Toolkit
+} // ArcGISRuntime
+} // Esri
+
+#endif // GEOHASHCODEC_H
@@ -0,0 +1,55 @@
+/*******************************************************************************
+ *  Copyright 2012-2018 Esri
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ******************************************************************************/
+
+#ifndef GEOREFCODEC_H
+#define GEOREFCODEC_H
+
+#include "ToolkitCommon.h"
+
+// STL headers
+#include <cstddef>
+
+namespace Esri
+{
+namespace ArcGISRuntime
+{
+namespace Toolkit
+{
+
+class TOOLKIT_EXPORT GeorefCodec
+{
+public:
+  static constexpr int maximumPrecision = 9;
+
+  // large enough for a reference at the maximum precision
+  static constexpr int bufferSize = 4 + 2 * maximumPrecision;
+
+  static int notationLength(int precision);
+
+  static int encode(double latitude, double longitude, int precision, char* buffer);
+  static int encode(const double* latitudes, const double* longitudes, std::size_t count, int precision, char* buffer);
+
+  static bool decode(const char* text, int length, double& latitude, double& longitude);
+
+private:
+  GeorefCodec() = delete;
+};
+
+} // Toolkit
+} // ArcGISRuntime
+} // Esri
+
+#endif // GEOREFCODEC_H
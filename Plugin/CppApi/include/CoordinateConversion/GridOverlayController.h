@@ -0,0 +1,146 @@
+/*******************************************************************************
+ *  Copyright 2012-2018 Esri
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ******************************************************************************/
+
+#ifndef GRIDOVERLAYCONTROLLER_H
+#define GRIDOVERLAYCONTROLLER_H
+
+// toolkit headers
+#include "AbstractTool.h"
+#include "GridOverlayGenerator.h"
+
+// C++ API headers
+#include "GeometryTypes.h"
+#include "Point.h"
+#include "Polyline.h"
+
+// Qt headers
+#include <QCache>
+#include <QHash>
+#include <QList>
+#include <QStringList>
+
+namespace Esri
+{
+namespace ArcGISRuntime
+{
+  class GeoView;
+  class Graphic;
+  class GraphicsOverlay;
+  class MapQuickView;
+  class SimpleLineSymbol;
+  class Symbol;
+
+namespace Toolkit
+{
+
+inline uint qHash(const GridOverlayGenerator::TileKey& key, uint seed = 0)
+{
+  const uint packed = (static_cast<uint>(key.zone) << 24) ^ (static_cast<uint>(key.level) << 20) ^
+      (static_cast<uint>(key.column) << 10) ^ static_cast<uint>(key.row);
+  return ::qHash(packed, seed);
+}
+
+class TOOLKIT_EXPORT GridOverlayController : public AbstractTool
+{
+  Q_OBJECT
+
+  // the grid drawn: MGRS, USNG or UTM
+  Q_PROPERTY(QString gridFormat READ gridFormat WRITE setGridFormat NOTIFY gridFormatChanged)
+
+  // the MGRS conversion mode of the option the grid is shown for, which picks the square lettering
+  Q_PROPERTY(MgrsConversionMode mgrsConversionMode READ mgrsConversionMode WRITE setMgrsConversionMode
+             NOTIFY mgrsConversionModeChanged)
+
+  // the level of detail drawn for the visible area, 0 for zone lines only
+  Q_PROPERTY(int level READ level NOTIFY levelChanged)
+
+  // the number of grid line vertices displayed
+  Q_PROPERTY(int vertexCount READ vertexCount NOTIFY vertexCountChanged)
+
+public:
+  // draw the grid over geoView, which must be a MapQuickView
+  Q_INVOKABLE void setGeoView(QObject* geoView);
+
+signals:
+  void gridFormatChanged();
+  void mgrsConversionModeChanged();
+  void levelChanged();
+  void vertexCountChanged();
+
+public:
+  explicit GridOverlayController(QObject* parent = nullptr);
+  ~GridOverlayController();
+
+  QString toolName() const override;
+
+  void setActive(bool active) override;
+
+  QString gridFormat() const;
+  void setGridFormat(const QString& gridFormat);
+
+  MgrsConversionMode mgrsConversionMode() const;
+  void setMgrsConversionMode(MgrsConversionMode mgrsConversionMode);
+
+  int level() const;
+  int vertexCount() const;
+
+private slots:
+  void scheduleUpdate();
+  void updateGrid();
+
+private:
+  struct CachedTile
+  {
+    Esri::ArcGISRuntime::Polyline lines;
+    int vertexCount = 0;
+    QList<Esri::ArcGISRuntime::Point> labelPositions;
+    QStringList labelTexts;
+  };
+
+  struct DisplayedTile
+  {
+    QList<Esri::ArcGISRuntime::Graphic*> graphics;
+    QList<Esri::ArcGISRuntime::Symbol*> symbols;
+    int vertexCount = 0;
+    bool labelled = false;
+  };
+
+  bool setGeoViewInternal(Esri::ArcGISRuntime::GeoView* geoView);
+  void attachToMapView(Esri::ArcGISRuntime::MapQuickView* mapView);
+
+  const CachedTile* cachedTile(const GridOverlayGenerator::TileKey& key);
+  void showTile(const GridOverlayGenerator::TileKey& key, bool labelled);
+  void removeTile(const GridOverlayGenerator::TileKey& key);
+  void clearGrid();
+
+  Esri::ArcGISRuntime::MapQuickView* m_mapView = nullptr;
+  Esri::ArcGISRuntime::GraphicsOverlay* m_graphicsOverlay = nullptr;
+  QList<Esri::ArcGISRuntime::SimpleLineSymbol*> m_lineSymbols;
+  QList<QMetaObject::Connection> m_viewConnections;
+  QCache<GridOverlayGenerator::TileKey, CachedTile> m_tileCache;
+  QHash<GridOverlayGenerator::TileKey, DisplayedTile> m_displayedTiles;
+  QString m_gridFormat;
+  MgrsConversionMode m_mgrsConversionMode = MgrsConversionMode::Automatic;
+  int m_level = 0;
+  int m_vertexCount = 0;
+  bool m_updateScheduled = false;
+};
+
+} // Toolkit
+} // ArcGISRuntime
+} // Esri
+
+#endif // GRIDOVERLAYCONTROLLER_H
@@ -0,0 +1,102 @@
+/*******************************************************************************
+ *  Copyright 2012-2018 Esri
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ******************************************************************************/
+
+#ifndef GRIDOVERLAYGENERATOR_H
+#define GRIDOVERLAYGENERATOR_H
+
+#include "ToolkitCommon.h"
+#include "TransverseMercatorGrid.h"
+
+// STL headers
+#include <cstddef>
+#include <vector>
+
+namespace Esri
+{
+namespace ArcGISRuntime
+{
+namespace Toolkit
+{
+
+class TOOLKIT_EXPORT GridOverlayGenerator
+{
+public:
+  // level 0 holds the zone and latitude band lines, level 1 the 100 km squares
+  // and each further level lines ten times closer together
+  static constexpr int maximumLevel = 5;
+
+  // grid lines per tile side
+  static constexpr int linesPerTile = 10;
+
+  // the most grid lines across the visible area chosen by levelForWidth
+  static constexpr int maximumLinesAcross = 20;
+
+  static constexpr int labelSize = 8;
+
+  // level 0 tiles are one zone in one latitude band (row); other levels are
+  // squares of linesPerTile lines, indexed by easting and signed northing
+  struct TileKey
+  {
+    int zone = 0;
+    int level = 0;
+    int column = 0;
+    int row = 0;
+  };
+
+  struct Vertex
+  {
+    double latitude = 0.0;
+    double longitude = 0.0;
+  };
+
+  struct Label
+  {
+    Vertex position;
+    char text[labelSize] = {};
+    int length = 0;
+  };
+
+  // WGS 84 polylines, each running from its lineStarts entry to the next one
+  struct Tile
+  {
+    std::vector<Vertex> vertices;
+    std::vector<std::size_t> lineStarts;
+    std::vector<Label> labels;
+  };
+
+  static double spacing(int level);
+  static int levelForWidth(double widthInMetres);
+
+  static bool visibleTiles(double south, double west, double north, double east, int level,
+                           std::size_t maximumTileCount, std::vector<TileKey>& tiles);
+
+  static void generateTile(const TileKey& key, bool squareIdentifiers,
+                           TransverseMercatorGrid::LetteringScheme scheme, Tile& tile);
+
+private:
+  GridOverlayGenerator() = delete;
+};
+
+inline bool operator==(const GridOverlayGenerator::TileKey& key1, const GridOverlayGenerator::TileKey& key2)
+{
+  return key1.zone == key2.zone && key1.level == key2.level && key1.column == key2.column && key1.row == key2.row;
+}
+
+} // Toolkit
+} // ArcGISRuntime
+} // Esri
+
+#endif // GRIDOVERLAYGENERATOR_H
@@ -0,0 +1,54 @@
+/*******************************************************************************
+ *  Copyright 2012-2018 Esri
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ******************************************************************************/
+
+#ifndef LATITUDELONGITUDEFORMATTER_H
+#define LATITUDELONGITUDEFORMATTER_H
+
+#include "ToolkitCommon.h"
+
+namespace Esri
+{
+namespace ArcGISRuntime
+{
+namespace Toolkit
+{
+
+class TOOLKIT_EXPORT LatitudeLongitudeFormatter
+{
+public:
+  enum class Style
+  {
+    DecimalDegrees,
+    DegreesDecimalMinutes,
+    DegreesMinutesSeconds
+  };
+
+  // large enough for any notation produced by format
+  static constexpr int bufferSize = 64;
+
+  static bool supports(Style style, int decimalPlaces);
+
+  static int format(double latitude, double longitude, Style style, int decimalPlaces, char* buffer);
+
+private:
+  LatitudeLongitudeFormatter() = delete;
+};
+
+} // Toolkit
+} // ArcGISRuntime
+} // Esri
+
+#endif // LATITUDELONGITUDEFORMATTER_H
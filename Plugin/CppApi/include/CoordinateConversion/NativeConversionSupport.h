@@ -0,0 +1,87 @@
+/*******************************************************************************
+ *  Copyright 2012-2018 Esri
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ******************************************************************************/
+
+#ifndef NATIVECONVERSIONSUPPORT_H
+#define NATIVECONVERSIONSUPPORT_H
+
+#include "ToolkitCommon.h"
+#include "TransverseMercatorGrid.h"
+
+// C++ API headers
+#include "GeometryTypes.h"
+
+// STL headers
+#include <atomic>
+#include <memory>
+
+class QString;
+
+namespace Esri
+{
+namespace ArcGISRuntime
+{
+
+class Point;
+class SpatialReference;
+
+namespace Toolkit
+{
+
+class TOOLKIT_EXPORT NativeConversionSupport
+{
+public:
+  static bool toGeographic(const Point& point, double& latitude, double& longitude);
+  static bool fromGeographic(double latitude, double longitude, const SpatialReference& spatialReference, Point& point);
+  static bool sameLocation(const Point& point1, const Point& point2);
+
+  static TransverseMercatorGrid::LetteringScheme mgrsLetteringScheme(MgrsConversionMode mode);
+
+  static int toLatin1(const QString& text, char* buffer, int bufferSize);
+
+private:
+  NativeConversionSupport() = delete;
+};
+
+class TOOLKIT_EXPORT NativeConversionGate
+{
+public:
+  // coarse areas of the globe in which each key earns trust separately
+  static constexpr int regionCount = 64;
+
+  explicit NativeConversionGate(int keyCount);
+  ~NativeConversionGate();
+
+  static int regionAt(double latitude, double longitude);
+
+  bool isTrusted(int key, int region) const;
+  bool isVerified(int key, int region) const;
+  bool isRejected(int key) const;
+  void recordComparison(int key, int region, bool matched) const;
+
+private:
+  Q_DISABLE_COPY(NativeConversionGate)
+
+  int m_keyCount = 0;
+  std::unique_ptr<std::atomic<int>[]> m_matches;
+  std::unique_ptr<std::atomic<bool>[]> m_rejected;
+  std::unique_ptr<std::atomic<unsigned>[]> m_trustedUses;
+};
+
+} // Toolkit
+} // ArcGISRuntime
+} // Esri
+
+#endif // NATIVECONVERSIONSUPPORT_H
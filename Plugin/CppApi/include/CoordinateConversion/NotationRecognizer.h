@@ -0,0 +1,70 @@
+/*******************************************************************************
+ *  Copyright 2012-2018 Esri
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ******************************************************************************/
+
+#ifndef NOTATIONRECOGNIZER_H
+#define NOTATIONRECOGNIZER_H
+
+#include "ToolkitCommon.h"
+
+// STL headers
+#include <cstddef>
+
+namespace Esri
+{
+namespace ArcGISRuntime
+{
+namespace Toolkit
+{
+
+class TOOLKIT_EXPORT NotationRecognizer
+{
+public:
+  enum class Notation
+  {
+    DecimalDegrees,
+    DegreesDecimalMinutes,
+    DegreesMinutesSeconds,
+    Mgrs,
+    Usng,
+    Utm,
+    Gars,
+    GeoRef
+  };
+
+  static constexpr int notationCount = 8;
+
+  struct Candidate
+  {
+    Notation notation = Notation::DecimalDegrees;
+    int score = 0; // 1 to 100, higher is more likely
+  };
+
+  // writes up to notationCount candidates, best first, and returns how many
+  static int recognize(const char* text, int length, Candidate* candidates);
+
+  // candidates for text i start at candidates[i * notationCount]
+  static void recognize(const char* const* texts, const int* lengths, std::size_t count,
+                        Candidate* candidates, int* candidateCounts);
+
+private:
+  NotationRecognizer() = delete;
+};
+
+} // Toolkit
+} // ArcGISRuntime
+} // Esri
+
+#endif // NOTATIONRECOGNIZER_H
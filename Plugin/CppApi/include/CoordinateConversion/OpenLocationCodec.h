@@ -0,0 +1,69 @@
+/*******************************************************************************
+ *  Copyright 2012-2018 Esri
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ******************************************************************************/
+
+
+#ifndef OPENLOCATIONCODEC_H
+#define OPENLOCATIONCODEC_H
+
+#include "ToolkitCommon.h"
+
+// STL headers
+#include <cstddef>
+
+namespace Esri
+{
+namespace ArcGISRuntime
+{
+namespace Toolkit
+{
+
+// Open Location Codes (Plus Codes); only full codes, not codes shortened
+// against a reference location
+class TOOLKIT_EXPORT OpenLocationCodec
+{
+public:
+  // code lengths in digits: 2, 4, 6, 8, and 10 to 15
+  static constexpr int minimumPrecision = 2;
+  static constexpr int pairPrecision = 10;
+  static constexpr int maximumPrecision = 15;
+
+  // the digits and the separator
+  static constexpr int bufferSize = maximumPrecision + 1;
+
+  static bool isValidPrecision(int precision);
+
+  // codes shorter than 8 digits are padded with zeros up to the separator
+  static int notationLength(int precision);
+
+  static int encode(double latitude, double longitude, int precision, char* buffer);
+  static int encode(const double* latitudes, const double* longitudes, std::size_t count, int precision, char* buffer);
+
+  // the centre of the cell, or its bounds
+  static bool decode(const char* text, int length, double& latitude, double& longitude);
+  static bool decode(const char* text, int length, double& south, double& west, double& north, double& east);
+
+  // fixed-width codes as written by the batch encode; invalid ones decode to NaN
+  static std::size_t decode(const char* buffer, std::size_t count, int precision, double* latitudes, double* longitudes);
+
+private:
+  OpenLocationCodec() = delete;
+};
+
+} // Toolkit
+} // ArcGISRuntime
+} // Esri
+
+#endif // OPENLOCATIONCODEC_H
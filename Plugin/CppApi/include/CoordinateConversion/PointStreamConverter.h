@@ -0,0 +1,73 @@
+/*******************************************************************************
+ *  Copyright 2012-2018 Esri
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ******************************************************************************/
+
+#ifndef POINTSTREAMCONVERTER_H
+#define POINTSTREAMCONVERTER_H
+
+// toolkit headers
+#include "CoordinateFormatOption.h"
+
+// Qt headers
+#include <QList>
+#include <QString>
+
+// STL headers
+#include <atomic>
+
+namespace Esri
+{
+namespace ArcGISRuntime
+{
+namespace Toolkit
+{
+
+class CoordinateConversionEngine;
+class PointStreamReader;
+class PointStreamWriter;
+
+// converts every point of a reader to each option, writing the points and
+// notations to a writer one batch at a time
+class TOOLKIT_EXPORT PointStreamConverter
+{
+public:
+  // points read, converted and written at a time
+  static constexpr int defaultBatchSize = 4096;
+
+  struct Result
+  {
+    qint64 pointCount = 0;
+    bool canceled = false;
+    QString errorString; // empty on success
+  };
+
+  static Result convert(const CoordinateConversionEngine& engine, const QList<CoordinateFormatOption>& options,
+                        PointStreamReader& reader, PointStreamWriter& writer, int batchSize = defaultBatchSize,
+                        const std::atomic<bool>* canceled = nullptr);
+
+  // opens both files, choosing their formats from their extensions
+  static Result convertFile(const CoordinateConversionEngine& engine, const QList<CoordinateFormatOption>& options,
+                            const QString& inputFileName, const QString& outputFileName,
+                            int batchSize = defaultBatchSize, const std::atomic<bool>* canceled = nullptr);
+
+private:
+  PointStreamConverter() = delete;
+};
+
+} // Toolkit
+} // ArcGISRuntime
+} // Esri
+
+#endif // POINTSTREAMCONVERTER_H
@@ -0,0 +1,85 @@
+/*******************************************************************************
+ *  Copyright 2012-2018 Esri
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ******************************************************************************/
+
+#ifndef POINTSTREAMREADER_H
+#define POINTSTREAMREADER_H
+
+#include "ToolkitCommon.h"
+
+// C++ API headers
+#include "Point.h"
+
+// Qt headers
+#include <QList>
+#include <QString>
+
+// STL headers
+#include <memory>
+
+class QIODevice;
+
+namespace Esri
+{
+namespace ArcGISRuntime
+{
+namespace Toolkit
+{
+
+enum class PointFileFormat
+{
+  Unknown,
+  Gpx,
+  GeoJson,
+  Csv
+};
+
+// the format of a file, from the extension of fileName
+TOOLKIT_EXPORT PointFileFormat pointFileFormat(const QString& fileName);
+
+// reads WGS 84 points from a GPX, GeoJSON or CSV stream a batch at a time,
+// holding no more of the stream in memory than the point being read
+class TOOLKIT_EXPORT PointStreamReader
+{
+public:
+  // a reader of format from device, which must be open; nullptr for an unknown format
+  static std::unique_ptr<PointStreamReader> create(PointFileFormat format, QIODevice* device);
+
+  virtual ~PointStreamReader();
+
+  // appends up to maximumCount points and returns the number appended, 0 at the end or on error
+  virtual int readPoints(int maximumCount, QList<Esri::ArcGISRuntime::Point>& points) = 0;
+
+  bool hasError() const;
+  QString errorString() const;
+
+protected:
+  explicit PointStreamReader(QIODevice* device);
+
+  QIODevice* device() const;
+  void setErrorString(const QString& errorString);
+
+private:
+  Q_DISABLE_COPY(PointStreamReader)
+
+  QIODevice* m_device = nullptr;
+  QString m_errorString;
+};
+
+} // Toolkit
+} // ArcGISRuntime
+} // Esri
+
+#endif // POINTSTREAMREADER_H
@@ -0,0 +1,91 @@
+/*******************************************************************************
+ *  Copyright 2012-2018 Esri
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ******************************************************************************/
+
+#ifndef POINTSTREAMWRITER_H
+#define POINTSTREAMWRITER_H
+
+// toolkit headers
+#include "CoordinateConversionBatchResult.h"
+#include "PointStreamReader.h"
+
+// C++ API headers
+#include "Point.h"
+
+// Qt headers
+#include <QByteArray>
+#include <QList>
+#include <QString>
+#include <QStringList>
+
+// STL headers
+#include <memory>
+
+class QIODevice;
+
+namespace Esri
+{
+namespace ArcGISRuntime
+{
+namespace Toolkit
+{
+
+// writes WGS 84 points with their notations to a GPX, GeoJSON or CSV stream
+// a batch at a time
+class TOOLKIT_EXPORT PointStreamWriter
+{
+public:
+  // a writer of format to device, which must be open; nullptr for an unknown format
+  static std::unique_ptr<PointStreamWriter> create(PointFileFormat format, QIODevice* device);
+
+  virtual ~PointStreamWriter();
+
+  // call once before the first batch, with the names of the notation columns
+  bool writeHeader(const QStringList& formatNames);
+
+  // row i of notations holds the notations of points[i]
+  bool writePoints(const QList<Esri::ArcGISRuntime::Point>& points, const CoordinateConversionBatchResult& notations);
+
+  // call once after the last batch
+  bool writeFooter();
+
+  bool hasError() const;
+  QString errorString() const;
+
+protected:
+  explicit PointStreamWriter(QIODevice* device);
+
+  const QStringList& formatNames() const;
+
+  virtual void appendHeader(QByteArray& output) = 0;
+  virtual void appendPoint(QByteArray& output, const Esri::ArcGISRuntime::Point& point,
+                           const CoordinateConversionBatchResult& notations, int row) = 0;
+  virtual void appendFooter(QByteArray& output) = 0;
+
+private:
+  Q_DISABLE_COPY(PointStreamWriter)
+
+  bool write(const QByteArray& output);
+
+  QIODevice* m_device = nullptr;
+  QStringList m_formatNames;
+  QString m_errorString;
+};
+
+} // Toolkit
+} // ArcGISRuntime
+} // Esri
+
+#endif // POINTSTREAMWRITER_H
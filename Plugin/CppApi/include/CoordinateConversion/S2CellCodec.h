@@ -0,0 +1,72 @@
+/*******************************************************************************
+ *  Copyright 2012-2018 Esri
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ******************************************************************************/
+
+
+#ifndef S2CELLCODEC_H
+#define S2CELLCODEC_H
+
+#include "ToolkitCommon.h"
+
+// STL headers
+#include <cstddef>
+#include <cstdint>
+
+namespace Esri
+{
+namespace ArcGISRuntime
+{
+namespace Toolkit
+{
+
+// 64-bit hierarchical cell ids laid out as S2 cell ids: a cube face, then
+// the position along a Hilbert curve over the face, then a trailing 1 bit
+// marking the level
+class TOOLKIT_EXPORT S2CellCodec
+{
+public:
+  static constexpr int maximumLevel = 30;
+
+  // 20 decimal digits of an integer; a token has at most 16 hexadecimal digits
+  static constexpr int bufferSize = 20;
+
+  // 0, which is not a valid id, for an invalid coordinate or level
+  static std::uint64_t cellId(double latitude, double longitude, int level);
+  static void cellIds(const double* latitudes, const double* longitudes, std::size_t count, int level, std::uint64_t* ids);
+
+  static bool isValid(std::uint64_t id);
+  static int level(std::uint64_t id);
+
+  static void center(std::uint64_t id, double& latitude, double& longitude);
+
+  // the four corners of the cell in counterclockwise order
+  static void vertices(std::uint64_t id, double* latitudes, double* longitudes);
+
+  // the id in hexadecimal without trailing zeros, or as a decimal integer
+  static int formatToken(std::uint64_t id, char* buffer);
+  static int formatInteger(std::uint64_t id, char* buffer);
+
+  static bool parseToken(const char* text, int length, std::uint64_t& id);
+  static bool parseInteger(const char* text, int length, std::uint64_t& id);
+
+private:
+  S2CellCodec() = delete;
+};
+
+} // Toolkit
+} // ArcGISRuntime
+} // Esri
+
+#endif // S2CELLCODEC_H
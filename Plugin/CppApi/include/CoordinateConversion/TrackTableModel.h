@@ -0,0 +1,110 @@
+/*******************************************************************************
+ *  Copyright 2012-2018 Esri
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ******************************************************************************/
+
+#ifndef TRACKTABLEMODEL_H
+#define TRACKTABLEMODEL_H
+
+// toolkit headers
+#include "CoordinateFormatOption.h"
+
+// C++ API headers
+#include "Point.h"
+
+// Qt headers
+#include <QAbstractTableModel>
+#include <QHash>
+#include <QList>
+#include <QStringList>
+#include <QVector>
+
+namespace Esri
+{
+namespace ArcGISRuntime
+{
+namespace Toolkit
+{
+
+class CoordinateConversionEngine;
+
+class TOOLKIT_EXPORT TrackTableModel : public QAbstractTableModel
+{
+  Q_OBJECT
+
+  Q_PROPERTY(int count READ count NOTIFY countChanged)
+
+  // the names of the formats, one per column
+  Q_PROPERTY(QStringList formatNames READ formatNames NOTIFY formatNamesChanged)
+
+public:
+  enum TrackTableRoles
+  {
+    TrackTableNotationRole = Qt::UserRole + 1,
+    TrackTableXRole = Qt::UserRole + 2,
+    TrackTableYRole = Qt::UserRole + 3
+  };
+
+  // remove every row
+  Q_INVOKABLE void clear();
+
+signals:
+  void countChanged();
+  void formatNamesChanged();
+
+public:
+  TrackTableModel(const CoordinateConversionEngine& engine, QObject* parent = nullptr);
+  ~TrackTableModel();
+
+  int count() const;
+  QStringList formatNames() const;
+
+  // one column per option; columns whose option changed are reconverted as they are read
+  void setOptions(const QList<CoordinateFormatOption>& options);
+
+  // notations holds the notation for each column, or is empty to convert when read
+  void append(const Esri::ArcGISRuntime::Point& point, const QStringList& notations);
+  Esri::ArcGISRuntime::Point point(int row) const;
+
+  int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+  int columnCount(const QModelIndex& parent = QModelIndex()) const override;
+
+  QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+  QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+
+protected:
+  QHash<int, QByteArray> roleNames() const override;
+
+private:
+  struct Column
+  {
+    CoordinateFormatOption option;
+    QVector<QString> notations;
+    QVector<bool> stale;
+  };
+
+  const QString& notation(int row, int column) const;
+  void setupRoles();
+
+  const CoordinateConversionEngine& m_engine;
+  QHash<int, QByteArray> m_roles;
+  QVector<Esri::ArcGISRuntime::Point> m_points;
+  mutable QVector<Column> m_columns;
+};
+
+} // Toolkit
+} // ArcGISRuntime
+} // Esri
+
+#endif // TRACKTABLEMODEL_H
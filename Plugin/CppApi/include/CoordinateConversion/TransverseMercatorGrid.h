@@ -0,0 +1,95 @@
+/*******************************************************************************
+ *  Copyright 2012-2018 Esri
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ******************************************************************************/
+
+#ifndef TRANSVERSEMERCATORGRID_H
+#define TRANSVERSEMERCATORGRID_H
+
+#include "ToolkitCommon.h"
+
+// STL headers
+#include <cstddef>
+#include <cstdint>
+
+namespace Esri
+{
+namespace ArcGISRuntime
+{
+namespace Toolkit
+{
+
+class TOOLKIT_EXPORT TransverseMercatorGrid
+{
+public:
+  // MGRS 100 km square lettering: AA (new) or AL (old)
+  enum class LetteringScheme
+  {
+    New,
+    Old
+  };
+
+  // the letter written after the UTM zone number
+  enum class ZoneIndicator
+  {
+    LatitudeBand,
+    Hemisphere
+  };
+
+  struct GridPosition
+  {
+    int zone = 0;          // 1 to 60, 0 when outside the UTM latitude limits
+    char band = 0;         // latitude band letter, C to X
+    bool north = true;
+    double easting = 0.0;  // metres, including the 500 km false easting
+    double northing = 0.0; // metres, including the 10000 km false northing in the south
+  };
+
+  // large enough for any notation produced by the format functions
+  static constexpr int bufferSize = 64;
+
+  static constexpr int maximumMgrsPrecision = 8;
+
+  // latitude bands C to X, 8 degrees tall from 80S except X, which reaches 84N
+  static constexpr int bandCount = 20;
+
+  static bool toGridPosition(double latitude, double longitude, bool zone60At180, GridPosition& position);
+  static void toGridPositions(const double* latitudes, const double* longitudes, std::size_t count,
+                              bool zone60At180, GridPosition* positions);
+  static bool toZonePosition(double latitude, double longitude, int zone, GridPosition& position);
+  static bool fromGridPosition(const GridPosition& position, double& latitude, double& longitude);
+  static bool zoneLongitudes(int zone, double latitude, double& west, double& east);
+  static char bandLetter(int band);
+  static bool bandLatitudes(int band, double& south, double& north);
+
+  // the cell a notation is written from; positions in the same zone, band
+  // and cell have the same notation
+  static bool utmCell(const GridPosition& position, std::int64_t& column, std::int64_t& row);
+  static bool mgrsCell(const GridPosition& position, int precision, std::int64_t& column, std::int64_t& row);
+
+  static int formatUtm(const GridPosition& position, ZoneIndicator indicator, bool addSpaces, char* buffer);
+  static int formatMgrs(const GridPosition& position, LetteringScheme scheme, int precision, bool addSpaces, char* buffer);
+
+  static bool parseUtm(const char* text, int length, ZoneIndicator indicator, GridPosition& position);
+  static bool parseMgrs(const char* text, int length, LetteringScheme scheme, GridPosition& position);
+
+private:
+  TransverseMercatorGrid() = delete;
+};
+
+} // Toolkit
+} // ArcGISRuntime
+} // Esri
+
+#endif // TRANSVERSEMERCATORGRID_H
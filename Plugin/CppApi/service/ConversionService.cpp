@@ -0,0 +1,520 @@
+/*******************************************************************************
+ *  Copyright 2012-2018 Esri
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ******************************************************************************/
+
+#include "ConversionService.h"
+#include "ConversionServiceProtocol.h"
+
+// toolkit headers
+#include "ConversionResultCache.h"
+#include "CoordinateConversionEngine.h"
+#include "CoordinateFormatOption.h"
+
+// C++ API headers
+#include "Point.h"
+#include "SpatialReference.h"
+
+// Qt headers
+#include <QFutureWatcher>
+#include <QLocalServer>
+#include <QLocalSocket>
+#include <QQueue>
+#include <QThreadPool>
+#include <QThreadStorage>
+#include <QtConcurrentRun>
+#include <QtEndian>
+
+// STL headers
+#include <cstring>
+
+namespace Esri
+{
+namespace ArcGISRuntime
+{
+namespace Toolkit
+{
+
+using namespace ConversionServiceProtocol;
+
+constexpr int ConversionService::defaultMaximumPendingRequests;
+
+namespace
+{
+
+constexpr int frameHeaderSize = 4;
+
+// stop accepting requests from a client while this much of its output is unsent
+constexpr qint64 maximumBufferedOutput = 16 * 1024 * 1024;
+
+// notations kept by each worker thread across requests
+constexpr int workerCacheCapacity = 16384;
+
+constexpr int pointSize = 2 * 8;
+
+class FrameReader
+{
+public:
+  explicit FrameReader(const QByteArray& payload) :
+    m_data(payload.constData()),
+    m_remaining(payload.size())
+  {
+  }
+
+  bool isValid() const { return m_valid; }
+  bool atEnd() const { return m_remaining == 0; }
+  int remaining() const { return m_remaining; }
+
+  quint8 readUInt8()
+  {
+    const uchar* data = take(1);
+    return data ? *data : 0;
+  }
+
+  quint32 readUInt32()
+  {
+    const uchar* data = take(4);
+    return data ? qFromLittleEndian<quint32>(data) : 0;
+  }
+
+  qint32 readInt32()
+  {
+    return static_cast<qint32>(readUInt32());
+  }
+
+  double readDouble()
+  {
+    const uchar* data = take(8);
+    if (!data)
+      return 0.0;
+
+    const quint64 bits = qFromLittleEndian<quint64>(data);
+    double value = 0.0;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+  }
+
+  QString readString()
+  {
+    const uchar* sizeData = take(2);
+    if (!sizeData)
+      return QString();
+
+    const int size = qFromLittleEndian<quint16>(sizeData);
+    const uchar* data = take(size);
+    return data ? QString::fromUtf8(reinterpret_cast<const char*>(data), size) : QString();
+  }
+
+private:
+  const uchar* take(int size)
+  {
+    if (!m_valid || size > m_remaining)
+    {
+      m_valid = false;
+      return nullptr;
+    }
+
+    const uchar* data = reinterpret_cast<const uchar*>(m_data);
+    m_data += size;
+    m_remaining -= size;
+    return data;
+  }
+
+  const char* m_data = nullptr;
+  int m_remaining = 0;
+  bool m_valid = true;
+};
+
+class FrameWriter
+{
+public:
+  explicit FrameWriter(MessageType type)
+  {
+    m_frame.resize(frameHeaderSize);
+    appendUInt8(static_cast<quint8>(type));
+  }
+
+  void appendUInt8(quint8 value)
+  {
+    m_frame.append(static_cast<char>(value));
+  }
+
+  void appendUInt32(quint32 value)
+  {
+    uchar data[4];
+    qToLittleEndian(value, data);
+    m_frame.append(reinterpret_cast<const char*>(data), sizeof(data));
+  }
+
+  // strings longer than a quint16 count are cut at that many bytes
+  void appendString(const QString& value)
+  {
+    QByteArray utf8 = value.toUtf8();
+    if (utf8.size() > 0xffff)
+      utf8.truncate(0xffff);
+
+    uchar size[2];
+    qToLittleEndian(static_cast<quint16>(utf8.size()), size);
+    m_frame.append(reinterpret_cast<const char*>(size), sizeof(size));
+    m_frame.append(utf8);
+  }
+
+  int payloadSize() const
+  {
+    return m_frame.size() - frameHeaderSize;
+  }
+
+  QByteArray frame()
+  {
+    qToLittleEndian(static_cast<quint32>(m_frame.size() - frameHeaderSize), reinterpret_cast<uchar*>(m_frame.data()));
+    return m_frame;
+  }
+
+private:
+  QByteArray m_frame;
+};
+
+QByteArray errorFrame(quint32 requestId, ErrorCode code, const QString& message)
+{
+  FrameWriter writer(MessageType::Error);
+  writer.appendUInt32(requestId);
+  writer.appendUInt8(static_cast<quint8>(code));
+  writer.appendString(message);
+  return writer.frame();
+}
+
+// each worker thread keeps its own cache, so warm entries serve every client
+ConversionResultCache& workerCache()
+{
+  static QThreadStorage<ConversionResultCache*> caches;
+  if (!caches.hasLocalData())
+    caches.setLocalData(new ConversionResultCache(workerCacheCapacity));
+
+  return *caches.localData();
+}
+
+// Runs on a worker thread: decodes the request in payload, converts it with
+// every option and returns the encoded reply.
+QByteArray processRequest(const CoordinateConversionEngine& engine, const QList<CoordinateFormatOption>& options,
+                          const QByteArray& payload)
+{
+  FrameReader reader(payload);
+  const auto type = static_cast<MessageType>(reader.readUInt8());
+  const quint32 requestId = reader.readUInt32();
+  if (!reader.isValid())
+    return errorFrame(0, ErrorCode::MalformedRequest, QStringLiteral("The request is truncated."));
+
+  // the reply must fit in a single frame
+  const auto tooManyCells = [&options](quint32 count)
+  {
+    return static_cast<quint64>(count) * static_cast<quint64>(options.size()) > maximumResultCells;
+  };
+  const QString tooManyCellsMessage = QStringLiteral("The reply would hold more than %1 notations; split the request.")
+      .arg(maximumResultCells);
+
+  QList<Point> points;
+  QVector<quint32> errorRows;
+  switch (type)
+  {
+  case MessageType::ConvertPoints:
+  {
+    const SpatialReference spatialReference(reader.readInt32());
+    const quint32 count = reader.readUInt32();
+    if (!reader.isValid() || count > static_cast<quint32>(reader.remaining() / pointSize))
+      return errorFrame(requestId, ErrorCode::MalformedRequest, QStringLiteral("The point count does not match the request size."));
+
+    if (tooManyCells(count))
+      return errorFrame(requestId, ErrorCode::MalformedRequest, tooManyCellsMessage);
+
+    points.reserve(static_cast<int>(count));
+    for (quint32 row = 0; row < count; ++row)
+    {
+      const double x = reader.readDouble();
+      const double y = reader.readDouble();
+      points.append(Point(x, y, spatialReference));
+    }
+    break;
+  }
+  case MessageType::ConvertNotations:
+  {
+    const quint32 count = reader.readUInt32();
+    if (!reader.isValid() || count > static_cast<quint32>(reader.remaining() / 2))
+      return errorFrame(requestId, ErrorCode::MalformedRequest, QStringLiteral("The notation count does not match the request size."));
+
+    if (tooManyCells(count))
+      return errorFrame(requestId, ErrorCode::MalformedRequest, tooManyCellsMessage);
+
+    points.reserve(static_cast<int>(count));
+    for (quint32 row = 0; row < count; ++row)
+    {
+      const QString notation = reader.readString();
+      if (!reader.isValid())
+        break;
+
+      const Point point = engine.pointFromNotation(notation);
+      if (point.isEmpty())
+        errorRows.append(row);
+
+      points.append(point);
+    }
+    break;
+  }
+  default:
+  {
+    return errorFrame(requestId, ErrorCode::UnknownMessageType, QStringLiteral("The message type is not a request."));
+  }
+  }
+
+  if (!reader.isValid() || !reader.atEnd())
+    return errorFrame(requestId, ErrorCode::MalformedRequest, QStringLiteral("The request size does not match its contents."));
+
+  ConversionResultCache& cache = workerCache();
+  FrameWriter writer(MessageType::Results);
+  writer.appendUInt32(requestId);
+  writer.appendUInt32(static_cast<quint32>(points.size()));
+  writer.appendUInt32(static_cast<quint32>(options.size()));
+  for (const Point& point : points)
+  {
+    for (const CoordinateFormatOption& option : options)
+    {
+      QString notation;
+      if (!point.isEmpty() && !cache.find(option, point, notation))
+      {
+        notation = engine.convert(option, point);
+        if (!notation.isEmpty())
+          cache.insert(option, point, notation);
+      }
+
+      writer.appendString(notation);
+    }
+  }
+
+  writer.appendUInt32(static_cast<quint32>(errorRows.size()));
+  for (const quint32 row : errorRows)
+    writer.appendUInt32(row);
+
+  if (static_cast<quint32>(writer.payloadSize()) > maximumFrameSize)
+    return errorFrame(requestId, ErrorCode::MalformedRequest, tooManyCellsMessage);
+
+  return writer.frame();
+}
+
+// One client. Requests are converted concurrently on the pool and replies
+// written in request order; reading stops while too many requests are
+// pending or too much output is unsent, which pushes back on the client.
+class ServiceConnection : public QObject
+{
+public:
+  ServiceConnection(QLocalSocket* socket, const CoordinateConversionEngine& engine, QThreadPool* threadPool,
+                    int maximumPendingRequests, QObject* parent) :
+    QObject(parent),
+    m_socket(socket),
+    m_engine(engine),
+    m_options(engine.options()),
+    m_threadPool(threadPool),
+    m_maximumPendingRequests(maximumPendingRequests)
+  {
+    m_socket->setParent(this);
+    m_socket->setReadBufferSize(frameHeaderSize + maximumFrameSize);
+
+    connect(m_socket, &QLocalSocket::readyRead, this, [this]() { readRequests(); });
+    connect(m_socket, &QLocalSocket::bytesWritten, this, [this]() { readRequests(); });
+    connect(m_socket, &QLocalSocket::disconnected, this, &QObject::deleteLater);
+
+    readRequests();
+  }
+
+private:
+  void readRequests()
+  {
+    while (m_socket->state() == QLocalSocket::ConnectedState && m_pending.size() < m_maximumPendingRequests &&
+           m_socket->bytesToWrite() < maximumBufferedOutput && m_socket->bytesAvailable() >= frameHeaderSize)
+    {
+      uchar header[frameHeaderSize];
+      m_socket->peek(reinterpret_cast<char*>(header), frameHeaderSize);
+      const quint32 size = qFromLittleEndian<quint32>(header);
+      if (size > maximumFrameSize)
+      {
+        m_socket->write(errorFrame(0, ErrorCode::MalformedRequest, QStringLiteral("The frame is too large.")));
+        m_socket->disconnectFromServer();
+        return;
+      }
+
+      if (m_socket->bytesAvailable() < frameHeaderSize + static_cast<qint64>(size))
+        return;
+
+      m_socket->skip(frameHeaderSize);
+      const QByteArray payload = m_socket->read(size);
+
+      auto watcher = new QFutureWatcher<QByteArray>(this);
+      connect(watcher, &QFutureWatcher<QByteArray>::finished, this, [this]() { writeReplies(); });
+
+      const CoordinateConversionEngine& engine = m_engine;
+      const QList<CoordinateFormatOption> options = m_options;
+      const QFuture<QByteArray> reply = QtConcurrent::run(m_threadPool, [&engine, options, payload]()
+      {
+        return processRequest(engine, options, payload);
+      });
+      watcher->setFuture(reply);
+      m_pending.enqueue(watcher);
+    }
+  }
+
+  void writeReplies()
+  {
+    while (!m_pending.isEmpty() && m_pending.head()->isFinished())
+    {
+      QFutureWatcher<QByteArray>* watcher = m_pending.dequeue();
+      m_socket->write(watcher->result());
+      watcher->deleteLater();
+    }
+
+    readRequests();
+  }
+
+  QLocalSocket* m_socket = nullptr;
+  const CoordinateConversionEngine& m_engine;
+  const QList<CoordinateFormatOption> m_options;
+  QThreadPool* m_threadPool = nullptr;
+  const int m_maximumPendingRequests;
+  QQueue<QFutureWatcher<QByteArray>*> m_pending;
+};
+
+} // namespace
+
+/*!
+  \class Esri::ArcGISRuntime::Toolkit::ConversionService
+  \internal
+  \brief Serves coordinate conversions over a local socket.
+
+  Every client shares the one \l CoordinateConversionEngine given to the
+  constructor, and the notations each worker thread has already produced,
+  so a single warmed process can convert for all local clients.
+
+  Clients may pipeline requests: each request is converted on the service's
+  thread pool as soon as it arrives, while replies are written in the order
+  the requests were received. The engine must not be modified while the
+  service is listening.
+ */
+
+/*!
+  \brief Constructs a service converting with \a engine, with an optional \a parent.
+ */
+ConversionService::ConversionService(const CoordinateConversionEngine& engine, QObject* parent) :
+  QObject(parent),
+  m_engine(engine),
+  m_server(new QLocalServer(this)),
+  m_threadPool(new QThreadPool(this))
+{
+  // the worker caches live in thread-local storage, so idle threads must
+  // not expire and take their warm caches with them
+  m_threadPool->setExpiryTimeout(-1);
+
+  connect(m_server, &QLocalServer::newConnection, this, &ConversionService::onNewConnection);
+}
+
+/*!
+  \brief The destructor, which waits for the requests being converted.
+ */
+ConversionService::~ConversionService()
+{
+  m_server->close();
+  m_threadPool->waitForDone();
+}
+
+/*!
+  \brief Starts listening for clients on the local socket \a name.
+
+  A socket left behind by a service which did not exit cleanly is removed.
+  Returns \c false if the service could not listen.
+ */
+bool ConversionService::listen(const QString& name)
+{
+  FrameWriter writer(MessageType::Hello);
+  const QList<CoordinateFormatOption> options = m_engine.options();
+  writer.appendUInt32(version);
+  writer.appendUInt32(static_cast<quint32>(options.size()));
+  for (const CoordinateFormatOption& option : options)
+    writer.appendString(option.name());
+  m_hello = writer.frame();
+
+  if (m_server->listen(name))
+    return true;
+
+  if (m_server->serverError() != QAbstractSocket::AddressInUseError)
+    return false;
+
+  QLocalServer::removeServer(name);
+  return m_server->listen(name);
+}
+
+/*!
+  \brief Returns a description of the last error from \l listen.
+ */
+QString ConversionService::errorString() const
+{
+  return m_server->errorString();
+}
+
+/*!
+  \brief Returns the full path of the socket clients connect to.
+ */
+QString ConversionService::fullServerName() const
+{
+  return m_server->fullServerName();
+}
+
+/*!
+  \brief Returns the number of requests accepted from each client before
+  its earliest reply has been written.
+ */
+int ConversionService::maximumPendingRequests() const
+{
+  return m_maximumPendingRequests;
+}
+
+/*!
+  \brief Sets the number of requests accepted from each client before its
+  earliest reply has been written to \a maximumPendingRequests. Applies to
+  clients connecting afterwards.
+ */
+void ConversionService::setMaximumPendingRequests(int maximumPendingRequests)
+{
+  m_maximumPendingRequests = qMax(1, maximumPendingRequests);
+}
+
+/*!
+  \brief Returns the thread pool requests are converted on.
+ */
+QThreadPool* ConversionService::threadPool() const
+{
+  return m_threadPool;
+}
+
+/*!
+  \internal
+ */
+void ConversionService::onNewConnection()
+{
+  while (m_server->hasPendingConnections())
+  {
+    QLocalSocket* socket = m_server->nextPendingConnection();
+    socket->write(m_hello);
+    new ServiceConnection(socket, m_engine, m_threadPool, m_maximumPendingRequests, this);
+  }
+}
+
+} // Toolkit
+} // ArcGISRuntime
+} // Esri
@@ -0,0 +1,77 @@
+/*******************************************************************************
+ *  Copyright 2012-2018 Esri
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ******************************************************************************/
+
+#ifndef CONVERSIONSERVICE_H
+#define CONVERSIONSERVICE_H
+
+// Qt headers
+#include <QByteArray>
+#include <QObject>
+#include <QString>
+
+class QLocalServer;
+class QThreadPool;
+
+namespace Esri
+{
+namespace ArcGISRuntime
+{
+namespace Toolkit
+{
+
+class CoordinateConversionEngine;
+
+// serves conversions with one engine to every client of a local socket,
+// see ConversionServiceProtocol.h for the wire format
+class ConversionService : public QObject
+{
+  Q_OBJECT
+
+public:
+  // requests accepted from each client before its earliest reply is written
+  static constexpr int defaultMaximumPendingRequests = 8;
+
+  explicit ConversionService(const CoordinateConversionEngine& engine, QObject* parent = nullptr);
+  ~ConversionService();
+
+  bool listen(const QString& name);
+  QString errorString() const;
+  QString fullServerName() const;
+
+  int maximumPendingRequests() const;
+  void setMaximumPendingRequests(int maximumPendingRequests);
+
+  // the pool requests are converted on
+  QThreadPool* threadPool() const;
+
+private slots:
+  void onNewConnection();
+
+private:
+  Q_DISABLE_COPY(ConversionService)
+
+  const CoordinateConversionEngine& m_engine;
+  QLocalServer* m_server = nullptr;
+  QThreadPool* m_threadPool = nullptr;
+  QByteArray m_hello;
+  int m_maximumPendingRequests = defaultMaximumPendingRequests;
+};
+
+} // Toolkit
+} // ArcGISRuntime
+} // Esri
+
+#endif // CONVERSIONSERVICE_H
@@ -0,0 +1,86 @@
+/*******************************************************************************
+ *  Copyright 2012-2018 Esri
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ******************************************************************************/
+
+#ifndef CONVERSIONSERVICEPROTOCOL_H
+#define CONVERSIONSERVICEPROTOCOL_H
+
+// The wire format of the coordinate conversion service.
+//
+// Every message is a frame: a quint32 payload size followed by the payload,
+// whose first byte is the MessageType. Integers and doubles are little
+// endian, and strings are a quint16 byte count followed by UTF-8.
+//
+// On connecting, the server sends Hello:
+//   quint32 version, quint32 formatCount, formatCount strings
+//
+// Clients then send any number of requests without waiting for replies:
+//   ConvertPoints:    quint32 requestId, qint32 wkid, quint32 count, count x (double x, double y)
+//   ConvertNotations: quint32 requestId, quint32 count, count strings
+//
+// and receive exactly one reply per request, in the order the requests
+// were sent:
+//   Results: quint32 requestId, quint32 rowCount, quint32 columnCount,
+//            rowCount x columnCount strings in row order,
+//            quint32 errorRowCount, errorRowCount x quint32 row
+//   Error:   quint32 requestId, quint8 ErrorCode, string message
+//
+// The columns are the formats listed in Hello. A frame larger than
+// maximumFrameSize closes the connection. A request whose reply would hold
+// more than maximumResultCells notations (rowCount x columnCount) gets a
+// MalformedRequest error instead; clients split larger inputs into several
+// requests.
+
+// Qt headers
+#include <QtGlobal>
+
+namespace Esri
+{
+namespace ArcGISRuntime
+{
+namespace Toolkit
+{
+namespace ConversionServiceProtocol
+{
+
+constexpr quint32 version = 1;
+
+constexpr quint32 maximumFrameSize = 64 * 1024 * 1024;
+
+// 256 bytes per notation, well above the longest any format produces, so
+// that a Results frame always fits in maximumFrameSize
+constexpr quint32 maximumResultCells = maximumFrameSize / 256;
+
+enum class MessageType : quint8
+{
+  Hello = 0,
+  ConvertPoints = 1,
+  ConvertNotations = 2,
+  Results = 3,
+  Error = 4
+};
+
+enum class ErrorCode : quint8
+{
+  MalformedRequest = 1,
+  UnknownMessageType = 2
+};
+
+} // ConversionServiceProtocol
+} // Toolkit
+} // ArcGISRuntime
+} // Esri
+
+#endif // CONVERSIONSERVICEPROTOCOL_H
@@ -0,0 +1,113 @@
+/*******************************************************************************
+ *  Copyright 2012-2018 Esri
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ******************************************************************************/
+
+// Runs the coordinate conversion engine as a local socket service, so that
+// several processes on one machine share a single warmed engine instead of
+// each converting on its own. See ConversionServiceProtocol.h for the wire
+// format; the formats and their settings are chosen on the command line,
+// as for CoordinateConversionCli.
+
+// toolkit headers
+#include "ConversionService.h"
+#include "CoordinateConversionEngine.h"
+#include "EngineCommandLine.h"
+
+// Qt headers
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QTextStream>
+#include <QThreadPool>
+
+using namespace Esri::ArcGISRuntime;
+using namespace Esri::ArcGISRuntime::Toolkit;
+
+namespace
+{
+
+// process exit codes
+constexpr int exitSuccess = 0;
+constexpr int exitFailure = 1;
+
+QTextStream& errorStream()
+{
+  return EngineCommandLine::errorStream();
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+  QCoreApplication application(argc, argv);
+  QCoreApplication::setApplicationName(QStringLiteral("CoordinateConversionService"));
+
+  QCommandLineParser parser;
+  parser.setApplicationDescription(QStringLiteral(
+    "Converts points and notations for local clients, which connect to the local socket <name>."));
+  parser.addHelpOption();
+
+  const QCommandLineOption nameOption(QStringList{QStringLiteral("n"), QStringLiteral("name")},
+                                      QStringLiteral("The name of the local socket."),
+                                      QStringLiteral("name"), QStringLiteral("CoordinateConversionService"));
+  const EngineCommandLine engineCommandLine(QStringLiteral("The format of the notations clients send."));
+  const QCommandLineOption threadsOption(QStringLiteral("threads"),
+                                         QStringLiteral("Number of conversion threads. Defaults to one per core."),
+                                         QStringLiteral("count"));
+  const QCommandLineOption pendingOption(QStringLiteral("max-pending"),
+                                         QStringLiteral("Requests accepted from a client ahead of its replies."),
+                                         QStringLiteral("count"),
+                                         QString::number(ConversionService::defaultMaximumPendingRequests));
+  parser.addOption(nameOption);
+  engineCommandLine.addOptions(parser);
+  parser.addOptions({threadsOption, pendingOption});
+  parser.process(application);
+
+  CoordinateConversionEngine engine;
+  if (!engineCommandLine.configureEngine(parser, true, engine, &application))
+    return exitFailure;
+
+  ConversionService service(engine);
+
+  bool ok = true;
+  if (parser.isSet(threadsOption))
+  {
+    const int threadCount = parser.value(threadsOption).toInt(&ok);
+    if (!ok || threadCount <= 0)
+    {
+      errorStream() << "Invalid thread count: " << parser.value(threadsOption) << endl;
+      return exitFailure;
+    }
+    service.threadPool()->setMaxThreadCount(threadCount);
+  }
+
+  const int maximumPendingRequests = parser.value(pendingOption).toInt(&ok);
+  if (!ok || maximumPendingRequests <= 0)
+  {
+    errorStream() << "Invalid pending request count: " << parser.value(pendingOption) << endl;
+    return exitFailure;
+  }
+  service.setMaximumPendingRequests(maximumPendingRequests);
+
+  if (!service.listen(parser.value(nameOption)))
+  {
+    errorStream() << "Could not listen on " << parser.value(nameOption) << ": " << service.errorString() << endl;
+    return exitFailure;
+  }
+
+  errorStream() << "Listening on " << service.fullServerName() << " with " << service.threadPool()->maxThreadCount()
+                << " threads" << endl;
+
+  return application.exec() == 0 ? exitSuccess : exitFailure;
+}
@@ -19,8 +19,12 @@
 #include <QtQml>
 
 #include "ArcGISCompassController.h"
+#include "CaptureHistoryModel.h"
+#include "ConversionScheduler.h"
 #include "CoordinateConversionController.h"
+#include "GridOverlayController.h"
 #include "TimeSliderController.h"
+#include "TrackTableModel.h"
 
 namespace Esri
 {
@@ -83,6 +87,13 @@ void ArcGISRuntimeToolkit::registerToolkitTypes(const char* uri)
   qmlRegisterType<CoordinateConversionController>(uri, s_versionMajor100, s_versionMinorUpdate2, "CoordinateConversionController");
   qmlRegisterType<ArcGISCompassController>(uri, s_versionMajor100, s_versionMinorUpdate2, "ArcGISCompassController");
   qmlRegisterType<TimeSliderController>(uri, s_versionMajor100, s_versionMinorUpdate3, "TimeSliderController");
+  qmlRegisterType<GridOverlayController>(uri, s_versionMajor100, s_versionMinorUpdate4, "GridOverlayController");
+  qmlRegisterUncreatableType<ConversionScheduler>(uri, s_versionMajor100, s_versionMinorUpdate4, "ConversionScheduler",
+                                                  "ConversionScheduler is provided by CoordinateConversionController");
+  qmlRegisterUncreatableType<CaptureHistoryModel>(uri, s_versionMajor100, s_versionMinorUpdate4, "CaptureHistoryModel",
+                                                  "CaptureHistoryModel is provided by CoordinateConversionController");
+  qmlRegisterUncreatableType<TrackTableModel>(uri, s_versionMajor100, s_versionMinorUpdate4, "TrackTableModel",
+                                              "TrackTableModel is provided by CoordinateConversionController");
 }
 
 } // Toolkit
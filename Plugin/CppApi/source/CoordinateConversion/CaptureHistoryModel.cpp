@@ -0,0 +1,317 @@
+/*******************************************************************************
+ *  Copyright 2012-2018 Esri
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ******************************************************************************/
+
+#include "CaptureHistoryModel.h"
+
+// STL headers
+#include <utility>
+
+namespace Esri
+{
+namespace ArcGISRuntime
+{
+namespace Toolkit
+{
+
+/*!
+  \class Esri::ArcGISRuntime::Toolkit::CaptureHistoryModel
+  \ingroup ToolCoordinateConversion
+  \inmodule ArcGISQtToolkit
+  \brief A bounded history of captured points and their notations.
+  \since Esri::ArcGISRuntime 100.4
+
+  The history is a ring buffer of \l capacity captures, allocated up front.
+  Appending a capture takes constant time: once the buffer is full the
+  oldest capture is removed to make room. Views are told only about the
+  inserted and removed rows, and role data is built when a view asks for it.
+
+  Rows are in capture order, the oldest first.
+
+  The following roles are available:
+  \table
+    \header
+        \li Role
+        \li Type
+        \li Description
+    \row
+        \li x
+        \li double
+        \li The x coordinate of the captured point.
+    \row
+        \li y
+        \li double
+        \li The y coordinate of the captured point.
+    \row
+        \li formats
+        \li QStringList
+        \li The names of the formats the point was converted to.
+    \row
+        \li notations
+        \li QStringList
+        \li The notation of the point in each of the formats.
+  \endtable
+ */
+
+/*!
+  \brief Constructor taking an optional \a parent.
+ */
+CaptureHistoryModel::CaptureHistoryModel(QObject* parent) :
+  QAbstractListModel(parent),
+  m_captures(defaultCapacity)
+{
+  setupRoles();
+}
+
+/*!
+  \brief The destructor.
+ */
+CaptureHistoryModel::~CaptureHistoryModel()
+{
+}
+
+/*!
+  \property CaptureHistoryModel::capacity
+  \brief The most captures kept in the history.
+
+  The default is 1000.
+ */
+int CaptureHistoryModel::capacity() const
+{
+  return m_captures.size();
+}
+
+/*!
+  \brief Sets the most captures kept in the history to \a capacity.
+
+  If the history holds more captures than \a capacity, the oldest ones are
+  removed.
+ */
+void CaptureHistoryModel::setCapacity(int capacity)
+{
+  if (capacity < 1)
+    capacity = 1;
+
+  if (capacity == m_captures.size())
+    return;
+
+  const int droppedCount = qMax(0, m_count - capacity);
+  if (droppedCount > 0)
+    beginRemoveRows(QModelIndex(), 0, droppedCount - 1);
+
+  QVector<Capture> captures(capacity);
+  const int keptCount = m_count - droppedCount;
+  for (int row = 0; row < keptCount; ++row)
+    captures[row] = std::move(m_captures[slot(row + droppedCount)]);
+
+  m_captures = std::move(captures);
+  m_first = 0;
+  m_count = keptCount;
+
+  if (droppedCount > 0)
+  {
+    endRemoveRows();
+    emit countChanged();
+  }
+
+  emit capacityChanged();
+}
+
+/*!
+  \property CaptureHistoryModel::count
+  \brief The number of captures in the history.
+ */
+int CaptureHistoryModel::count() const
+{
+  return m_count;
+}
+
+/*!
+  \brief Removes every capture from the history.
+ */
+void CaptureHistoryModel::clear()
+{
+  if (m_count == 0)
+    return;
+
+  beginRemoveRows(QModelIndex(), 0, m_count - 1);
+  for (int row = 0; row < m_count; ++row)
+    m_captures[slot(row)] = Capture();
+
+  m_first = 0;
+  m_count = 0;
+  endRemoveRows();
+
+  emit countChanged();
+}
+
+/*!
+  \brief Appends \a point, with its \a notations in the formats named by
+  \a formatNames, as the newest capture.
+
+  If the history is full the oldest capture is removed first.
+ */
+void CaptureHistoryModel::append(const Point& point, const QStringList& formatNames, const QStringList& notations)
+{
+  const bool full = m_count == m_captures.size();
+  if (full)
+  {
+    beginRemoveRows(QModelIndex(), 0, 0);
+    m_captures[m_first] = Capture();
+    m_first = (m_first + 1) % m_captures.size();
+    --m_count;
+    endRemoveRows();
+  }
+
+  beginInsertRows(QModelIndex(), m_count, m_count);
+  Capture& capture = m_captures[slot(m_count)];
+  capture.point = point;
+  capture.notations = notations;
+
+  // share the list of names with the previous capture while the options stay the same
+  const int previousRow = m_count - 1;
+  if (previousRow >= 0 && m_captures.at(slot(previousRow)).formatNames == formatNames)
+    capture.formatNames = m_captures.at(slot(previousRow)).formatNames;
+  else
+    capture.formatNames = formatNames;
+
+  ++m_count;
+  endInsertRows();
+
+  if (!full)
+    emit countChanged();
+}
+
+/*!
+  \brief Returns the point of the capture at \a row.
+ */
+Point CaptureHistoryModel::point(int row) const
+{
+  if (row < 0 || row >= m_count)
+    return Point();
+
+  return m_captures.at(slot(row)).point;
+}
+
+/*!
+  \brief Returns the notation of the capture at \a row in the format named
+  \a formatName, or an empty string if it was not converted to that format.
+ */
+QString CaptureHistoryModel::notation(int row, const QString& formatName) const
+{
+  if (row < 0 || row >= m_count)
+    return QString();
+
+  const Capture& capture = m_captures.at(slot(row));
+  for (int i = 0; i < capture.formatNames.size() && i < capture.notations.size(); ++i)
+  {
+    if (capture.formatNames.at(i).compare(formatName, Qt::CaseInsensitive) == 0)
+      return capture.notations.at(i);
+  }
+
+  return QString();
+}
+
+/*!
+  \internal
+ */
+int CaptureHistoryModel::rowCount(const QModelIndex& parent) const
+{
+  if (parent.isValid())
+    return 0;
+
+  return m_count;
+}
+
+/*!
+  \internal
+ */
+QVariant CaptureHistoryModel::data(const QModelIndex& index, int role) const
+{
+  const int row = index.row();
+  if (row < 0 || row >= m_count)
+    return QVariant();
+
+  const Capture& capture = m_captures.at(slot(row));
+
+  switch (role)
+  {
+  case CaptureHistoryXRole:
+    return QVariant(capture.point.x());
+  case CaptureHistoryYRole:
+    return QVariant(capture.point.y());
+  case CaptureHistoryFormatsRole:
+    return QVariant(capture.formatNames);
+  case CaptureHistoryNotationsRole:
+    return QVariant(capture.notations);
+  default:
+    break;
+  }
+
+  return QVariant();
+}
+
+/*!
+  \internal
+ */
+QHash<int, QByteArray> CaptureHistoryModel::roleNames() const
+{
+  return m_roles;
+}
+
+/*!
+  \internal
+
+  Returns the index in the ring buffer of \a row.
+ */
+int CaptureHistoryModel::slot(int row) const
+{
+  return (m_first + row) % m_captures.size();
+}
+
+/*!
+  \internal
+ */
+void CaptureHistoryModel::setupRoles()
+{
+  m_roles[CaptureHistoryXRole] = "x";
+  m_roles[CaptureHistoryYRole] = "y";
+  m_roles[CaptureHistoryFormatsRole] = "formats";
+  m_roles[CaptureHistoryNotationsRole] = "notations";
+}
+
+/*!
+  \fn void CaptureHistoryModel::capacityChanged();
+  \brief Signal emitted when the \l capacity changes.
+ */
+
+/*!
+  \fn void CaptureHistoryModel::countChanged();
+  \brief Signal emitted when the number of captures changes.
+ */
+
+/*!
+  \enum CaptureHistoryModel::CaptureHistoryRoles
+  \brief Enumeration of roles used to access captures in the list model.
+
+  \value CaptureHistoryXRole The x coordinate of the captured point.
+  \value CaptureHistoryYRole The y coordinate of the captured point.
+  \value CaptureHistoryFormatsRole The names of the formats converted to.
+  \value CaptureHistoryNotationsRole The notation in each format.
+ */
+
+} // Toolkit
+} // ArcGISRuntime
+} // Esri
@@ -0,0 +1,376 @@
+/*******************************************************************************
+ *  Copyright 2012-2018 Esri
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ******************************************************************************/
+
+#include "ConversionResultCache.h"
+
+// toolkit headers
+#include "CoordinateFormatOption.h"
+#include "GeohashCodec.h"
+#include "NativeConversionSupport.h"
+#include "OpenLocationCodec.h"
+#include "TransverseMercatorGrid.h"
+
+// C++ API headers
+#include "Point.h"
+
+// STL headers
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+namespace Esri
+{
+namespace ArcGISRuntime
+{
+namespace Toolkit
+{
+
+namespace
+{
+
+// grid cells are counted from the zone origin in fewer than 40 bits; the
+// zone, band and hemisphere go above them
+constexpr int gridCellBits = 40;
+
+// below this the indices could overflow
+constexpr double smallestQuantum = 1e-12;
+
+// decimal places and precision are packed into 8 bits each
+constexpr int largestPackedSetting = 255;
+
+// Returns the size, in degrees, of the cells within which option produces
+// the same notation. Rounded notations (latitude-longitude) are keyed on the
+// nearest multiple of the quantum, truncated ones on the cell below. Grid
+// notations are keyed by gridKey instead.
+bool quantization(const CoordinateFormatOption& option, double& quantum, bool& rounded)
+{
+  rounded = false;
+  switch (option.outputMode())
+  {
+  case CoordinateConversionOptions::CoordinateTypeLatLon:
+  {
+    const int decimalPlaces = option.decimalPlaces();
+    if (decimalPlaces < 0)
+      return false;
+
+    double unitsPerDegree = 1.0;
+    if (option.latLonFormat() == LatitudeLongitudeFormat::DegreesDecimalMinutes)
+      unitsPerDegree = 60.0;
+    else if (option.latLonFormat() == LatitudeLongitudeFormat::DegreesMinutesSeconds)
+      unitsPerDegree = 3600.0;
+
+    rounded = true;
+    quantum = std::pow(10.0, -decimalPlaces) / unitsPerDegree;
+    break;
+  }
+  case CoordinateConversionOptions::CoordinateTypeGars:
+  {
+    quantum = 1.0 / 12.0;
+    break;
+  }
+  case CoordinateConversionOptions::CoordinateTypeGeoRef:
+  {
+    const int precision = option.precision();
+    if (precision < 0)
+      return false;
+
+    quantum = precision == 0 ? 1.0 : std::pow(10.0, 2 - precision) / 60.0;
+    break;
+  }
+  case CoordinateConversionOptions::CoordinateTypeGeohash:
+  {
+    const int precision = option.precision();
+    if (precision < 1 || precision > GeohashCodec::maximumPrecision)
+      return false;
+
+    // longitude takes the extra bit of an odd bit count; both cell sizes are
+    // powers of two times 45 degrees, so the smaller divides the larger
+    const int bits = 5 * precision;
+    quantum = std::min(std::ldexp(360.0, -((bits + 1) / 2)), std::ldexp(180.0, -(bits / 2)));
+    break;
+  }
+  case CoordinateConversionOptions::CoordinateTypeOpenLocationCode:
+  {
+    const int precision = option.precision();
+    if (!OpenLocationCodec::isValidPrecision(precision))
+      return false;
+
+    // grid digits make cells of 5 rows by 4 columns, which both divide a
+    // cell of 20 by 20
+    quantum = precision <= OpenLocationCodec::pairPrecision ?
+          std::pow(20.0, 2 - precision / 2) : std::pow(20.0, 10 - precision) / 8000.0;
+    break;
+  }
+  case CoordinateConversionOptions::CoordinateTypeEcef:
+  case CoordinateConversionOptions::CoordinateTypeEnu:
+  {
+    // these depend on the height and the ENU origin, which keys do not hold
+    return false;
+  }
+  case CoordinateConversionOptions::CoordinateTypeCellId:
+  {
+    // cube face cells do not line up with degrees
+    return false;
+  }
+  default:
+    return false;
+  }
+
+  return quantum >= smallestQuantum;
+}
+
+bool isGrid(const CoordinateFormatOption& option)
+{
+  return option.outputMode() == CoordinateConversionOptions::CoordinateTypeMgrs ||
+      option.outputMode() == CoordinateConversionOptions::CoordinateTypeUsng ||
+      option.outputMode() == CoordinateConversionOptions::CoordinateTypeUtm;
+}
+
+// Keys an MGRS, USNG or UTM notation on the zone, band and hemisphere and on
+// the grid cell the notation is written from, so that every point with the
+// key has the same notation. Points outside the UTM limits are not keyed.
+bool gridKey(const CoordinateFormatOption& option, double latitude, double longitude, ConversionCacheKey& key)
+{
+  const CoordinateFormatOption::CoordinateType type = option.outputMode();
+  const MgrsConversionMode mgrsMode = option.mgrsConversionMode();
+  const bool zone60At180 = type != CoordinateConversionOptions::CoordinateTypeMgrs ||
+      (mgrsMode != MgrsConversionMode::New180InZone01 && mgrsMode != MgrsConversionMode::Old180InZone01);
+
+  TransverseMercatorGrid::GridPosition position;
+  if (!TransverseMercatorGrid::toGridPosition(latitude, longitude, zone60At180, position))
+    return false;
+
+  std::int64_t column = 0;
+  std::int64_t row = 0;
+  if (type == CoordinateConversionOptions::CoordinateTypeUtm)
+  {
+    if (!TransverseMercatorGrid::utmCell(position, column, row))
+      return false;
+  }
+  else
+  {
+    // the controller passes decimalPlaces as the MGRS precision
+    const int precision = type == CoordinateConversionOptions::CoordinateTypeMgrs ? option.decimalPlaces() : option.precision();
+    if (!TransverseMercatorGrid::mgrsCell(position, precision, column, row))
+      return false;
+  }
+
+  if (column < 0 || row < 0 || column >= (std::int64_t(1) << gridCellBits) || row >= (std::int64_t(1) << gridCellBits))
+    return false;
+
+  const qint64 zone = static_cast<qint64>(position.zone) << 8 | static_cast<unsigned char>(position.band);
+  key.longitudeIndex = zone << gridCellBits | column;
+  key.latitudeIndex = static_cast<qint64>(position.north ? 1 : 0) << gridCellBits | row;
+  return true;
+}
+
+// every setting which affects the notation, so that keys never collide
+bool packSettings(const CoordinateFormatOption& option, quint64& settings)
+{
+  const int decimalPlaces = option.decimalPlaces();
+  const int precision = option.precision();
+  if (decimalPlaces < 0 || decimalPlaces > largestPackedSetting || precision < 0 || precision > largestPackedSetting)
+    return false;
+
+  settings = static_cast<quint64>(option.outputMode());
+  settings = (settings << 4) | static_cast<quint64>(option.latLonFormat());
+  settings = (settings << 8) | static_cast<quint64>(decimalPlaces);
+  settings = (settings << 8) | static_cast<quint64>(precision);
+  settings = (settings << 1) | (option.addSpaces() ? 1u : 0u);
+  settings = (settings << 4) | static_cast<quint64>(option.mgrsConversionMode());
+  settings = (settings << 4) | static_cast<quint64>(option.utmConversionMode());
+  settings = (settings << 4) | static_cast<quint64>(option.garsConversionMode());
+  return true;
+}
+
+} // namespace
+
+/*!
+  \class Esri::ArcGISRuntime::Toolkit::ConversionResultCache
+  \ingroup ToolCoordinateConversion
+  \inmodule ArcGISQtToolkit
+  \brief A bounded least recently used cache of converted notations.
+  \since Esri::ArcGISRuntime 100.4
+
+  Entries are keyed on the point quantized to the resolution of the option
+  and on the option's settings. A point which moves by less than the
+  precision of a notation therefore finds the notation already computed.
+
+  Latitude-longitude notations are keyed on the same rounding the
+  notation applies, and GARS, GEOREF, geohashes and Open Location Codes
+  on the cell they truncate to. MGRS, USNG and UTM notations are keyed on
+  their zone, latitude band and hemisphere and on the
+  \l TransverseMercatorGrid cell they are written from. Formats without
+  such cells, and grid points outside the UTM latitude limits, are not
+  cached.
+
+  The cells are those of the native kernels, which \c CoordinateFormatter
+  does not share: it projects and rounds on its own. A point within a
+  rounding error of a cell edge, nanometres for the grid formats, can
+  therefore be served a notation which differs from the SDK's for that
+  point in its last digit.
+
+  Only WGS 84 and Web Mercator points are cached; others always miss. The
+  cache is not thread safe.
+ */
+
+/*!
+  \brief Constructs a cache holding at most \a capacity notations.
+ */
+ConversionResultCache::ConversionResultCache(int capacity) :
+  m_entries(capacity)
+{
+}
+
+/*!
+  \brief The destructor.
+ */
+ConversionResultCache::~ConversionResultCache()
+{
+}
+
+/*!
+  \brief Looks up the notation of \a point for \a option.
+
+  Returns \c true and sets \a notation on a hit. Every call counts as a hit
+  or a miss.
+ */
+bool ConversionResultCache::find(const CoordinateFormatOption& option, const Point& point, QString& notation)
+{
+  ConversionCacheKey key;
+  const QString* entry = makeKey(option, point, key) ? m_entries.object(key) : nullptr;
+  if (!entry)
+  {
+    ++m_missCount;
+    return false;
+  }
+
+  ++m_hitCount;
+  notation = *entry;
+  return true;
+}
+
+/*!
+  \brief Stores \a notation as the notation of \a point for \a option,
+  evicting the least recently used entry if the cache is full.
+ */
+void ConversionResultCache::insert(const CoordinateFormatOption& option, const Point& point, const QString& notation)
+{
+  ConversionCacheKey key;
+  if (makeKey(option, point, key))
+    m_entries.insert(key, new QString(notation));
+}
+
+/*!
+  \brief Removes every entry. The hit and miss counts are kept.
+ */
+void ConversionResultCache::clear()
+{
+  m_entries.clear();
+}
+
+/*!
+  \brief Returns the maximum number of notations held.
+ */
+int ConversionResultCache::capacity() const
+{
+  return m_entries.maxCost();
+}
+
+/*!
+  \brief Sets the maximum number of notations held to \a capacity.
+ */
+void ConversionResultCache::setCapacity(int capacity)
+{
+  m_entries.setMaxCost(capacity);
+}
+
+/*!
+  \brief Returns whether \a point1 and \a point2 share an entry for
+  \a option, and therefore have the same notation.
+
+  Keys are the native kernels' cells, so the points' notations are the
+  same except, as for any cache hit, within a rounding error of a cell
+  edge. Returns \c false whenever either point cannot be cached, which
+  includes every format without such cells (ECEF, ENU and cell ids) and
+  grid points outside the UTM latitude limits.
+ */
+bool ConversionResultCache::sameCell(const CoordinateFormatOption& option, const Point& point1, const Point& point2) const
+{
+  ConversionCacheKey key1;
+  ConversionCacheKey key2;
+  return makeKey(option, point1, key1) && makeKey(option, point2, key2) && key1 == key2;
+}
+
+/*!
+  \brief Returns the number of lookups which found a notation.
+ */
+quint64 ConversionResultCache::hitCount() const
+{
+  return m_hitCount;
+}
+
+/*!
+  \brief Returns the number of lookups which did not find a notation.
+ */
+quint64 ConversionResultCache::missCount() const
+{
+  return m_missCount;
+}
+
+/*!
+  \internal
+ */
+bool ConversionResultCache::makeKey(const CoordinateFormatOption& option, const Point& point, ConversionCacheKey& key) const
+{
+  double latitude = 0.0;
+  double longitude = 0.0;
+  if (!packSettings(option, key.optionSettings) ||
+      !NativeConversionSupport::toGeographic(point, latitude, longitude) ||
+      !std::isfinite(latitude) || !std::isfinite(longitude) || std::fabs(latitude) > 90.0)
+  {
+    return false;
+  }
+
+  // keep the indices in range for any longitude
+  if (longitude < -180.0 || longitude > 180.0)
+    longitude = std::remainder(longitude, 360.0);
+
+  if (isGrid(option))
+    return gridKey(option, latitude, longitude, key);
+
+  double quantum = 0.0;
+  bool rounded = false;
+  if (!quantization(option, quantum, rounded))
+    return false;
+
+  if (rounded)
+  {
+    key.latitudeIndex = std::llround(latitude / quantum);
+    key.longitudeIndex = std::llround(longitude / quantum);
+  }
+  else
+  {
+    key.latitudeIndex = static_cast<qint64>(std::floor((latitude + 90.0) / quantum));
+    key.longitudeIndex = static_cast<qint64>(std::floor((longitude + 180.0) / quantum));
+  }
+
+  return true;
+}
+
+} // Toolkit
+} // ArcGISRuntime
+} // Esri
@@ -0,0 +1,279 @@
+/*******************************************************************************
+ *  Copyright 2012-2018 Esri
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ******************************************************************************/
+
+#include "ConversionScheduler.h"
+
+// Qt headers
+#include <QQuickWindow>
+#include <QTimer>
+
+namespace Esri
+{
+namespace ArcGISRuntime
+{
+namespace Toolkit
+{
+
+/*!
+  \class Esri::ArcGISRuntime::Toolkit::ConversionScheduler
+  \ingroup ToolCoordinateConversion
+  \inmodule ArcGISQtToolkit
+  \brief Coalesces bursts of points so that only the newest is converted.
+  \since Esri::ArcGISRuntime 100.4
+
+  Points are handed to \l submit as they arrive, for example from a GNSS feed
+  running at 20 to 50 Hz. The scheduler keeps only the newest one and emits
+  \l pointReady at most \l maximumRate times per second, or once per rendered
+  frame of the window when \l frameSynced is set. Every submitted point which
+  is replaced before being passed on counts as dropped.
+
+  The first point after a quiet period is passed on immediately, so
+  coalescing only adds latency while points arrive faster than the rate.
+ */
+
+/*!
+  \brief Constructor taking an optional \a parent.
+ */
+ConversionScheduler::ConversionScheduler(QObject* parent) :
+  QObject(parent),
+  m_timer(new QTimer(this))
+{
+  m_timer->setSingleShot(true);
+  connect(m_timer, &QTimer::timeout, this, &ConversionScheduler::dispatch);
+}
+
+/*!
+  \brief The destructor.
+ */
+ConversionScheduler::~ConversionScheduler()
+{
+}
+
+/*!
+  \property ConversionScheduler::maximumRate
+  \brief The most points passed on per second.
+
+  \c 0 passes every point on as soon as it is submitted. The default is 10.
+ */
+double ConversionScheduler::maximumRate() const
+{
+  return m_maximumRate;
+}
+
+/*!
+  \brief Sets the most points passed on per second to \a maximumRate.
+ */
+void ConversionScheduler::setMaximumRate(double maximumRate)
+{
+  if (maximumRate < 0.0)
+    maximumRate = 0.0;
+
+  if (qFuzzyCompare(maximumRate + 1.0, m_maximumRate + 1.0))
+    return;
+
+  m_maximumRate = maximumRate;
+  m_timer->stop();
+  if (m_hasPendingPoint)
+    schedule();
+
+  emit maximumRateChanged();
+}
+
+/*!
+  \property ConversionScheduler::frameSynced
+  \brief Whether points are passed on once per rendered frame.
+
+  When set, and a window has been given with \l setWindow, the newest point
+  is passed on as the window prepares each frame and \l maximumRate is not
+  used. Submitting a point requests a frame. Without a window the
+  scheduler falls back to \l maximumRate.
+ */
+bool ConversionScheduler::isFrameSynced() const
+{
+  return m_frameSynced;
+}
+
+/*!
+  \brief Sets whether points are passed on once per rendered frame to \a frameSynced.
+ */
+void ConversionScheduler::setFrameSynced(bool frameSynced)
+{
+  if (frameSynced == m_frameSynced)
+    return;
+
+  m_frameSynced = frameSynced;
+  connectWindow();
+  if (m_hasPendingPoint)
+    schedule();
+
+  emit frameSyncedChanged();
+}
+
+/*!
+  \brief Sets the window whose frames pace the scheduler in
+  \l frameSynced mode to \a window.
+ */
+void ConversionScheduler::setWindow(QQuickWindow* window)
+{
+  if (window == m_window)
+    return;
+
+  m_window = window;
+  connectWindow();
+}
+
+/*!
+  \property ConversionScheduler::processedCount
+  \brief The number of points passed on with \l pointReady.
+ */
+int ConversionScheduler::processedCount() const
+{
+  return m_processedCount;
+}
+
+/*!
+  \property ConversionScheduler::droppedCount
+  \brief The number of submitted points replaced by a newer one before
+  being passed on.
+ */
+int ConversionScheduler::droppedCount() const
+{
+  return m_droppedCount;
+}
+
+/*!
+  \brief Sets the processed and dropped counts back to zero.
+ */
+void ConversionScheduler::resetCounts()
+{
+  m_processedCount = 0;
+  m_droppedCount = 0;
+  emit countsChanged();
+}
+
+/*!
+  \brief Submits \a point, replacing any point still waiting to be passed on.
+ */
+void ConversionScheduler::submit(const Point& point)
+{
+  if (m_hasPendingPoint)
+    ++m_droppedCount;
+
+  m_pendingPoint = point;
+  m_hasPendingPoint = true;
+
+  schedule();
+  emit countsChanged();
+}
+
+/*!
+  \brief Passes on the waiting point, if any, immediately.
+ */
+void ConversionScheduler::flush()
+{
+  m_timer->stop();
+  dispatch();
+}
+
+/*!
+  \brief Drops the waiting point, if any, without passing it on.
+ */
+void ConversionScheduler::discard()
+{
+  m_timer->stop();
+  if (!m_hasPendingPoint)
+    return;
+
+  m_hasPendingPoint = false;
+  m_pendingPoint = Point();
+  ++m_droppedCount;
+  emit countsChanged();
+}
+
+/*!
+  \internal
+ */
+void ConversionScheduler::schedule()
+{
+  if (m_frameSynced && m_window)
+  {
+    m_window->update();
+    return;
+  }
+
+  if (m_maximumRate <= 0.0)
+  {
+    dispatch();
+    return;
+  }
+
+  const qint64 interval = qRound64(1000.0 / m_maximumRate);
+  const qint64 elapsed = m_sinceDispatch.isValid() ? m_sinceDispatch.elapsed() : interval;
+  if (elapsed >= interval)
+    dispatch();
+  else if (!m_timer->isActive())
+    m_timer->start(static_cast<int>(interval - elapsed));
+}
+
+/*!
+  \internal
+ */
+void ConversionScheduler::dispatch()
+{
+  if (!m_hasPendingPoint)
+    return;
+
+  const Point point = m_pendingPoint;
+  m_hasPendingPoint = false;
+  m_pendingPoint = Point();
+  ++m_processedCount;
+  m_sinceDispatch.start();
+
+  emit countsChanged();
+  emit pointReady(point);
+}
+
+/*!
+  \internal
+
+  \c afterAnimating is emitted on the GUI thread at the start of every
+  frame, whichever render loop is in use.
+ */
+void ConversionScheduler::connectWindow()
+{
+  disconnect(m_frameConnection);
+  m_frameConnection = QMetaObject::Connection();
+
+  if (m_frameSynced && m_window)
+  {
+    m_timer->stop();
+    m_frameConnection = connect(m_window.data(), &QQuickWindow::afterAnimating, this, &ConversionScheduler::dispatch);
+  }
+}
+
+/*!
+  \fn void ConversionScheduler::pointReady(const Esri::ArcGISRuntime::Point& point);
+  \brief Signal emitted when the newest submitted \a point should be converted.
+ */
+
+/*!
+  \fn void ConversionScheduler::countsChanged();
+  \brief Signal emitted when the \l processedCount or \l droppedCount changes.
+ */
+
+} // Toolkit
+} // ArcGISRuntime
+} // Esri
@@ -0,0 +1,171 @@
+/*******************************************************************************
+ *  Copyright 2012-2018 Esri
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ******************************************************************************/
+
+#include "CoordinateConversionBatchResult.h"
+
+namespace Esri
+{
+namespace ArcGISRuntime
+{
+namespace Toolkit
+{
+
+/*!
+  \class Esri::ArcGISRuntime::Toolkit::CoordinateConversionBatchResult
+  \ingroup ToolCoordinateConversion
+  \inmodule ArcGISQtToolkit
+  \brief A columnar table of notations produced by a batch conversion.
+  \since Esri::ArcGISRuntime 100.4
+
+  The table has one column per \l CoordinateConversionOptions and one row per
+  converted point. Each column is stored contiguously so that a single format
+  can be read (or written to disk) without touching the others.
+
+  \sa CoordinateConversionController::convertPoints
+ */
+
+/*!
+  \brief Constructs an empty table with one column for each name in
+  \a formatNames and \a rowCount rows.
+ */
+CoordinateConversionBatchResult::CoordinateConversionBatchResult(const QStringList& formatNames, int rowCount) :
+  m_formatNames(formatNames),
+  m_columns(formatNames.size(), QVector<QString>(rowCount)),
+  m_rowCount(rowCount)
+{
+}
+
+/*!
+  \brief Returns the number of converted points.
+ */
+int CoordinateConversionBatchResult::rowCount() const
+{
+  return m_rowCount;
+}
+
+/*!
+  \brief Returns the number of formats in the table.
+ */
+int CoordinateConversionBatchResult::columnCount() const
+{
+  return m_columns.size();
+}
+
+/*!
+  \brief Returns the format names, in column order.
+ */
+QStringList CoordinateConversionBatchResult::formatNames() const
+{
+  return m_formatNames;
+}
+
+/*!
+  \brief Returns the column index for \a formatName, or \c -1 if the
+  format is not part of the table.
+ */
+int CoordinateConversionBatchResult::columnIndex(const QString& formatName) const
+{
+  for (int i = 0; i < m_formatNames.size(); ++i)
+  {
+    if (m_formatNames.at(i).compare(formatName, Qt::CaseInsensitive) == 0)
+      return i;
+  }
+
+  return -1;
+}
+
+/*!
+  \brief Returns all notations for \a column, in row order.
+ */
+QVector<QString> CoordinateConversionBatchResult::column(int column) const
+{
+  if (column < 0 || column >= m_columns.size())
+    return QVector<QString>();
+
+  return m_columns.at(column);
+}
+
+/*!
+  \brief Returns the notation at \a row and \a column.
+ */
+QString CoordinateConversionBatchResult::notation(int row, int column) const
+{
+  if (column < 0 || column >= m_columns.size() || row < 0 || row >= m_rowCount)
+    return QString();
+
+  return m_columns.at(column).at(row);
+}
+
+/*!
+  \brief Returns whether the batch was canceled before all rows were converted.
+
+  Rows which were not reached before cancellation contain empty notations.
+ */
+bool CoordinateConversionBatchResult::isCanceled() const
+{
+  return m_canceled;
+}
+
+/*!
+  \brief Returns the rows, in ascending order, whose input could not be
+  decoded.
+
+  Only \l CoordinateConversionController::convertNotations reports errors;
+  the notations of these rows are empty.
+ */
+QVector<int> CoordinateConversionBatchResult::errorRows() const
+{
+  return m_errorRows;
+}
+
+/*!
+  \brief Returns the table as a map suitable for QML.
+
+  The map contains a \c formats string list, a \c rowCount, a \c columns
+  list holding one string list per format, the \c canceled flag and an
+  \c errorRowCount.
+ */
+QVariantMap CoordinateConversionBatchResult::toVariantMap() const
+{
+  QVariantList columns;
+  columns.reserve(m_columns.size());
+  for (const auto& column : m_columns)
+    columns.append(QStringList(column.toList()));
+
+  QVariantMap map;
+  map.insert(QStringLiteral("formats"), m_formatNames);
+  map.insert(QStringLiteral("rowCount"), m_rowCount);
+  map.insert(QStringLiteral("columns"), columns);
+  map.insert(QStringLiteral("canceled"), m_canceled);
+  map.insert(QStringLiteral("errorRowCount"), m_errorRows.size());
+  return map;
+}
+
+/*!
+  \internal
+
+  Returns a pointer to the first row of \a column. The column is detached
+  here, once, so that worker threads can then write disjoint rows through the
+  returned pointer without any further copy-on-write checks.
+ */
+QString* CoordinateConversionBatchResult::columnData(int column)
+{
+  return m_columns[column].data();
+}
+
+} // Toolkit
+} // ArcGISRuntime
+} // Esri
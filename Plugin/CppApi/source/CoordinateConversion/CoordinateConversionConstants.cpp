@@ -31,6 +31,11 @@ const QString CoordinateConversionConstants::USNG_FORMAT = QStringLiteral("USGS"
 const QString CoordinateConversionConstants::UTM_FORMAT = QStringLiteral("UTM");
 const QString CoordinateConversionConstants::GARS_FORMAT = QStringLiteral("GARS");
 const QString CoordinateConversionConstants::GEOREF_FORMAT = QStringLiteral("GeoRef");
+const QString CoordinateConversionConstants::ECEF_FORMAT = QStringLiteral("ECEF");
+const QString CoordinateConversionConstants::ENU_FORMAT = QStringLiteral("ENU");
+const QString CoordinateConversionConstants::GEOHASH_FORMAT = QStringLiteral("Geohash");
+const QString CoordinateConversionConstants::OPEN_LOCATION_CODE_FORMAT = QStringLiteral("OLC");
+const QString CoordinateConversionConstants::CELL_ID_FORMAT = QStringLiteral("S2");
 const QString CoordinateConversionConstants::LATLON = QStringLiteral("LatLon");
 const QString CoordinateConversionConstants::COORDINATE_FORMAT_PROPERTY = QStringLiteral("CoordinateFormat");
 
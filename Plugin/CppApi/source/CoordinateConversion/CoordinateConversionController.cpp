@@ -21,11 +21,12 @@
 #include "CoordinateConversionOptions.h"
 #include "CoordinateConversionResults.h"
 #include "CoordinateFormatFactory.h"
+#include "CoordinateFormatRegistry.h"
+#include "PointStreamConverter.h"
 #include "ToolManager.h"
 #include "ToolResourceProvider.h"
 
 // C++ API headers
-#include "CoordinateFormatter.h"
 #include "GeoView.h"
 #include "GeometryEngine.h"
 #include "MapQuickView.h"
@@ -34,7 +35,13 @@
 
 // Qt headers
 #include <QClipboard>
+#include <QFutureWatcher>
 #include <QGuiApplication>
+#include <QThreadPool>
+#include <QTimer>
+#include <QUrl>
+#include <QtConcurrentMap>
+#include <QtConcurrentRun>
 
 // STL headers
 #include <cmath>
@@ -56,6 +63,10 @@
   coordinate notation and options that apply to that notation (decimal places,
   use of spaces, and so on).
 
+  The conversions themselves are made by a \l CoordinateConversionEngine,
+  which the controller keeps in step with its options, input format and
+  spatial reference.
+
   \sa {Coordinate Conversion Tool}
  */
 
@@ -66,6 +77,70 @@ namespace ArcGISRuntime
 namespace Toolkit
 {
 
+namespace
+{
+
+// hover conversions are paced by frames; this rate applies until the view has a window
+constexpr double hoverFallbackRate = 60.0;
+
+// asynchronous conversions have their own small pool so that they never
+// queue behind the tasks of a large batch conversion in the global pool
+constexpr int asyncConversionThreadCount = 2;
+
+// file names from QML may be file URLs
+QString localFileName(const QString& fileName)
+{
+  const QUrl url(fileName);
+  return url.isLocalFile() ? url.toLocalFile() : fileName;
+}
+
+} // namespace
+
+/*!
+  \internal
+
+  State owned by a background batch conversion. The options are value
+  copies so that the user can keep editing the controller's options while
+  the batch is running.
+ */
+struct CoordinateConversionController::BatchConversion
+{
+  QList<Point> points;
+  QList<CoordinateFormatOption> options;
+  QVector<int> chunks;
+  QVector<QString*> columns;
+  CoordinateConversionBatchResult result;
+};
+
+/*!
+  \internal
+
+  A single asynchronous conversion. The options are a snapshot taken when
+  the conversion was requested; the worker fills in the point (when
+  decoding a notation) and the notations. A conversion which records a
+  capture or track point converts every option, the input format included,
+  and is never skipped for being stale.
+ */
+struct CoordinateConversionController::AsyncConversion
+{
+  quint64 generation = 0;
+  bool decode = false;
+  bool convert = true;
+  bool autoDetect = false;
+  bool capture = false;
+  bool track = false;
+  bool finished = false;
+  QString notation;
+  Point point;
+  SpatialReference spatialReference;
+  CoordinateFormatDefaults formatDefaults;
+  QList<CoordinateFormatOption> options;
+  int inputIndex = -1;
+  QVector<bool> outputs;
+  QVector<bool> converted;
+  QVector<QString> notations;
+};
+
 /*!
   \brief A constructor that accepts an optional \a parent.
  */
@@ -81,6 +156,20 @@ CoordinateConversionController::CoordinateConversionController(QObject* parent):
 {
   ToolManager::instance().addTool(this);
 
+  m_conversionPool = new QThreadPool(this);
+  m_conversionPool->setMaxThreadCount(asyncConversionThreadCount);
+
+  m_locationScheduler = new ConversionScheduler(this);
+  connect(m_locationScheduler, &ConversionScheduler::pointReady, this, &CoordinateConversionController::onLocationPointReady);
+
+  m_hoverScheduler = new ConversionScheduler(this);
+  m_hoverScheduler->setMaximumRate(hoverFallbackRate);
+  m_hoverScheduler->setFrameSynced(true);
+  connect(m_hoverScheduler, &ConversionScheduler::pointReady, this, &CoordinateConversionController::onHoverPointReady);
+
+  m_captureHistory = new CaptureHistoryModel(this);
+  m_trackTable = new TrackTableModel(m_engine, this);
+
   auto geoView = ToolResourceProvider::instance()->geoView();
   if (geoView)
     setSpatialReference(geoView->spatialReference());
@@ -94,6 +183,8 @@ CoordinateConversionController::CoordinateConversionController(QObject* parent):
 
   connect(ToolResourceProvider::instance(), &ToolResourceProvider::locationChanged, this, &CoordinateConversionController::onLocationChanged);
 
+  connect(ToolResourceProvider::instance(), &ToolResourceProvider::mouseMovedPoint, this, &CoordinateConversionController::onMouseMovedPoint);
+
   connect(ToolResourceProvider::instance(), &ToolResourceProvider::geoViewChanged, this, [this]()
   {
     setGeoViewInternal(Toolkit::ToolResourceProvider::instance()->geoView());
@@ -102,7 +193,7 @@ CoordinateConversionController::CoordinateConversionController(QObject* parent):
   connect(this, &CoordinateConversionController::optionsChanged, this,
           [this]()
   {
-    convertPoint();
+    scheduleConversion(nullptr);
   });
 }
 
@@ -111,14 +202,28 @@ CoordinateConversionController::CoordinateConversionController(QObject* parent):
  */
 CoordinateConversionController::~CoordinateConversionController()
 {
+  // running asynchronous conversions stop at their next check
+  ++m_conversionGeneration;
+  m_conversionPool->waitForDone();
+
+  if (m_batchWatcher)
+    m_batchWatcher->cancel();
+
+  if (m_fileConversionCanceled)
+    *m_fileConversionCanceled = true;
+
+  // canceled batches and file conversions may still be finishing
+  for (QFutureWatcherBase* watcher : findChildren<QFutureWatcherBase*>(QString(), Qt::FindDirectChildrenOnly))
+    watcher->waitForFinished();
 }
 
 /*!
   \brief Converts \a notation and updates the \l results property.
 
   Before calling this method, set the \l inputFormat property to the
-  desired format, and set the \l spatialReference property
-  to the spatial reference of the notation's coordinates.
+  desired format, or set \l autoDetectInputFormat, and set the
+  \l spatialReference property to the spatial reference of the notation's
+  coordinates.
 
   \note Converting between some notation formats can result in loss
   of precision due to the number of decimal places expressed in the
@@ -127,6 +232,15 @@ CoordinateConversionController::~CoordinateConversionController()
  */
 void CoordinateConversionController::convertNotation(const QString& notation)
 {
+  if (m_asynchronous)
+  {
+    if (m_spatialReference.isEmpty())
+      qWarning("The spatial reference property is empty: conversions will fail.");
+
+    startAsyncConversion(Point(), notation);
+    return;
+  }
+
   setPointToConvert(pointFromNotation(notation));
 }
 
@@ -138,297 +252,1214 @@ Point CoordinateConversionController::pointFromNotation(const QString& incomingN
   if (m_spatialReference.isEmpty())
     qWarning("The spatial reference property is empty: conversions will fail.");
 
-  CoordinateConversionOptions* inputOption = nullptr;
+  return m_engine.pointFromNotation(incomingNotation);
+}
+
+/*!
+  \brief Returns the names of the formats \a notation could be written in,
+  most likely first.
+
+  The list is empty if \a notation does not look like any supported format.
+  More than one name is returned for ambiguous notations, such as MGRS and
+  USNG which share a syntax.
+ */
+QStringList CoordinateConversionController::detectFormats(const QString& notation) const
+{
+  return m_engine.detectFormats(notation);
+}
+
+/*!
+  \brief Returns the result of \l detectFormats for each of \a notations,
+  as a list of string lists in the same order.
+ */
+QVariantList CoordinateConversionController::detectFormatsForNotations(const QStringList& notations) const
+{
+  QVariantList formats;
+  formats.reserve(notations.size());
+  for (const QString& notation : notations)
+    formats.append(detectFormats(notation));
+
+  return formats;
+}
+
+/*!
+  \brief Converts the last point assigned with \l setPointToConvert to all the
+  notations specified in the options.
+ */
+void CoordinateConversionController::convertPoint()
+{
+  if (m_asynchronous)
+  {
+    m_dirtyOptions.clear();
+    m_fullConversionPending = false;
+
+    startAsyncConversion(m_pointToConvert, QString());
+    return;
+  }
+
+  // a full conversion covers every scheduled one
+  m_dirtyOptions.clear();
+  m_fullConversionPending = false;
+
+  // supersede any asynchronous conversion still running
+  ++m_conversionGeneration;
+
+  QList<Result> results;
+  const QList<CoordinateFormatOption> options = m_engine.options();
+  for (const CoordinateFormatOption& option : options)
+  {
+    if (isInputFormat(option))
+      continue;
+
+    results.append(Result(option.name(), cachedConversion(option, m_pointToConvert), option.outputMode()));
+  }
+
+  applyResults(std::move(results));
+}
+
+/*!
+  \internal
+ */
+void CoordinateConversionController::applyResults(QList<Result>&& results)
+{
+  if (results.isEmpty())
+    resultsInternal()->clearResults();
+  else
+    resultsInternal()->setResults(std::move(results));
+}
+
+/*!
+  \internal
+
+  Starts converting \a point, or decoding \a notation when it is not null
+  and then converting the decoded point, on the conversion pool.
+
+  The request takes the next generation number, which makes every earlier
+  request stale: stale requests stop at their next check on the worker and
+  their results are dropped before reaching the results model. Notations
+  already in the result cache are filled in here, and if every notation is
+  cached the results are applied without involving a worker at all.
+
+  When \a capture or \a track is set, \a point is also appended to the
+  \l captureHistory or the \l trackTable once its notations are ready.
+  Such a request converts every option and runs to completion even after it
+  has become stale.
+ */
+void CoordinateConversionController::startAsyncConversion(const Point& point, const QString& notation,
+                                                          bool capture, bool track)
+{
+  auto conversion = std::make_shared<AsyncConversion>();
+  conversion->generation = ++m_conversionGeneration;
+  conversion->decode = !notation.isNull();
+  conversion->convert = conversion->decode ? m_runConversion : (m_runConversion || !(capture || track));
+  conversion->capture = capture;
+  conversion->track = track;
+  conversion->autoDetect = m_autoDetectInputFormat;
+  conversion->notation = notation;
+  conversion->point = point;
+  conversion->spatialReference = m_spatialReference;
+  conversion->formatDefaults = m_engine.formatDefaults();
+  conversion->options = m_engine.options();
+
+  bool pending = conversion->decode;
+  for (const CoordinateFormatOption& option : qAsConst(conversion->options))
+  {
+    const bool input = isInputFormat(option);
+    if (input && conversion->inputIndex < 0)
+      conversion->inputIndex = conversion->outputs.size();
+
+    const bool needed = !input || capture || track;
+    QString cachedNotation;
+    const bool cached = needed && !conversion->decode && m_resultCache.find(option, point, cachedNotation);
+    pending = pending || (needed && !cached);
+
+    conversion->outputs.append(!input);
+    conversion->converted.append(cached);
+    conversion->notations.append(cachedNotation);
+  }
+
+  // recorded points are appended in the order they were captured
+  if (capture || track)
+    m_pendingRecords.append(conversion);
+
+  if (!pending)
+  {
+    finishAsyncConversion(*conversion);
+    return;
+  }
+
+  auto watcher = new QFutureWatcher<void>(this);
+  connect(watcher, &QFutureWatcher<void>::finished, this, [this, watcher, conversion]()
+  {
+    watcher->deleteLater();
+    finishAsyncConversion(*conversion);
+  });
+
+  watcher->setFuture(QtConcurrent::run(m_conversionPool, [this, conversion]()
+  {
+    runAsyncConversion(*conversion);
+  }));
+}
+
+/*!
+  \internal
+
+  Runs on a worker thread. Only the snapshot in \a conversion and the
+  engine's thread safe conversions are used.
+ */
+void CoordinateConversionController::runAsyncConversion(AsyncConversion& conversion) const
+{
+  const bool record = conversion.capture || conversion.track;
+  if (!record && conversion.generation != m_conversionGeneration.load())
+    return;
+
+  if (conversion.decode)
+  {
+    if (conversion.autoDetect)
+      conversion.point = m_engine.detectedPointFromNotation(conversion.notation, conversion.options, conversion.formatDefaults,
+                                                            conversion.spatialReference);
+    else if (conversion.inputIndex >= 0)
+      conversion.point = m_engine.pointFromNotation(conversion.options.at(conversion.inputIndex), conversion.notation,
+                                                    conversion.spatialReference);
+  }
+
+  if (!conversion.convert && !record)
+    return;
+
+  for (int i = 0; i < conversion.options.size(); ++i)
+  {
+    if ((!conversion.outputs.at(i) && !record) || conversion.converted.at(i))
+      continue;
+
+    if (!record && conversion.generation != m_conversionGeneration.load())
+      return;
+
+    conversion.notations[i] = m_engine.convert(conversion.options.at(i), conversion.point);
+    conversion.converted[i] = true;
+  }
+}
+
+/*!
+  \internal
+
+  Back on the GUI thread: records \a conversion's point if it was captured,
+  then applies \a conversion unless a newer request has superseded it.
+ */
+void CoordinateConversionController::finishAsyncConversion(AsyncConversion& conversion)
+{
+  if (conversion.capture || conversion.track)
+  {
+    // every option was converted for the record, so all of them are cached
+    for (int i = 0; i < conversion.options.size(); ++i)
+    {
+      if (conversion.converted.at(i) && !conversion.notations.at(i).isEmpty())
+        m_resultCache.insert(conversion.options.at(i), conversion.point, conversion.notations.at(i));
+    }
+
+    conversion.finished = true;
+    appendFinishedRecords();
+  }
+
+  if (conversion.generation != m_conversionGeneration.load())
+    return;
+
+  // as in setPointToConvert, a new point invalidates its screen projection
+  const bool pointChanged = conversion.decode && !(conversion.point == m_pointToConvert);
+  if (pointChanged)
+  {
+    m_pointToConvert = conversion.point;
+    m_projectedPointValid = false;
+  }
+
+  if (conversion.convert)
+  {
+    QList<Result> results;
+    for (int i = 0; i < conversion.options.size(); ++i)
+    {
+      if (!conversion.outputs.at(i))
+        continue;
+
+      const CoordinateFormatOption& option = conversion.options.at(i);
+      const QString& notation = conversion.notations.at(i);
+      if (!notation.isEmpty() && !conversion.capture && !conversion.track)
+        m_resultCache.insert(option, conversion.point, notation);
+
+      results.append(Result(option.name(), notation, option.outputMode()));
+    }
+
+    applyResults(std::move(results));
+  }
+
+  if (pointChanged)
+    emit pointToConvertChanged();
+}
+
+/*!
+  \internal
+
+  Appends the captured and tracked points whose asynchronous conversions
+  have finished, stopping at the first which is still running so that the
+  \l captureHistory and \l trackTable keep the order of capture.
+ */
+void CoordinateConversionController::appendFinishedRecords()
+{
+  while (!m_pendingRecords.isEmpty() && m_pendingRecords.first()->finished)
+  {
+    const std::shared_ptr<AsyncConversion> conversion = m_pendingRecords.takeFirst();
+
+    QStringList formatNames;
+    QStringList notations;
+    formatNames.reserve(conversion->options.size());
+    notations.reserve(conversion->options.size());
+    for (int i = 0; i < conversion->options.size(); ++i)
+    {
+      formatNames.append(conversion->options.at(i).name());
+      notations.append(conversion->notations.at(i));
+    }
+
+    if (conversion->capture)
+      m_captureHistory->append(conversion->point, formatNames, notations);
+
+    // the table converts the row later if its options changed in the meantime
+    if (conversion->track)
+      m_trackTable->append(conversion->point, formatNames == m_trackTable->formatNames() ? notations : QStringList());
+  }
+}
+
+/*!
+  \internal
+
+  Returns the notation of \a point for \a option from the result cache,
+  converting and caching it on a miss.
+ */
+QString CoordinateConversionController::cachedConversion(const CoordinateFormatOption& option, const Point& point) const
+{
+  QString notation;
+  if (m_resultCache.find(option, point, notation))
+    return notation;
+
+  notation = m_engine.convert(option, point);
+  if (!notation.isEmpty())
+    m_resultCache.insert(option, point, notation);
+
+  return notation;
+}
+
+/*!
+  \brief Converts each of \a points to every format in the options and
+  returns the notations as a table with one column per option and one
+  row per point.
+
+  The points are split into chunks which are converted in parallel on the
+  global thread pool, using the same per-format conversion as
+  \l convertPoint. This call blocks until every point has been converted.
+
+  \sa CoordinateConversionBatchResult, CoordinateConversionEngine::convertPoints
+ */
+CoordinateConversionBatchResult CoordinateConversionController::convertPoints(const QList<Point>& points) const
+{
+  return m_engine.convertPoints(points);
+}
+
+/*!
+  \brief Decodes each of \a notations with the \l inputFormat, or the
+  recognized format when \l autoDetectInputFormat is set, and converts it to
+  every format in the options.
+
+  The conversion runs on the calling thread, and several threads may call
+  this at once as long as the options are not modified in the meantime. This
+  makes it possible to stream large inputs through the controller in
+  independent chunks without a GeoView or QML engine. Rows whose notation
+  could not be decoded are listed in
+  \l CoordinateConversionBatchResult::errorRows and have empty notations.
+
+  \sa convertPoints, CoordinateConversionEngine::convertNotations
+ */
+CoordinateConversionBatchResult CoordinateConversionController::convertNotations(const QStringList& notations) const
+{
+  return m_engine.convertNotations(notations);
+}
+
+/*!
+  \brief Converts \a points in the background to every format in the options.
+
+  Each entry of \a points is a point (e.g. from \c Qt.point) whose x and y
+  are in the current spatial reference. Progress is reported through
+  \l batchConversionProgress and the table is delivered, in the form described
+  by \l CoordinateConversionBatchResult::toVariantMap, through
+  \l batchConversionCompleted.
+
+  Starting a new batch cancels any batch which is still running, which still
+  delivers its partial table.
+
+  \sa cancelBatchConversion
+ */
+void CoordinateConversionController::convertPoints(const QVariantList& points)
+{
+  cancelBatchConversion();
+
+  auto batch = std::make_shared<BatchConversion>();
+  batch->points.reserve(points.size());
+  for (const QVariant& point : points)
+  {
+    const QPointF xy = point.toPointF();
+    batch->points.append(Point(xy.x(), xy.y(), m_spatialReference));
+  }
+
+  batch->options = m_engine.options();
+  QStringList formatNames;
+  for (const CoordinateFormatOption& option : qAsConst(batch->options))
+    formatNames.append(option.name());
+
+  batch->result = CoordinateConversionBatchResult(formatNames, batch->points.size());
+  for (int column = 0; column < formatNames.size(); ++column)
+    batch->columns.append(batch->result.columnData(column));
+
+  batch->chunks = CoordinateConversionEngine::batchChunks(batch->points.size());
+
+  // each run has its own watcher, so a canceled run still reports its own
+  // partial table after a newer run has started
+  auto watcher = new QFutureWatcher<void>(this);
+  connect(watcher, &QFutureWatcher<void>::progressValueChanged, this, [this, batch](int completedChunks)
+  {
+    const int totalCount = batch->points.size();
+    emit batchConversionProgress(qMin(completedChunks * CoordinateConversionEngine::batchChunkSize, totalCount), totalCount);
+  });
+  connect(watcher, &QFutureWatcher<void>::finished, this, [this, watcher, batch]()
+  {
+    watcher->deleteLater();
+    if (m_batchWatcher == watcher)
+      m_batchWatcher = nullptr;
+
+    batch->result.m_canceled = watcher->isCanceled();
+    emit batchConversionCompleted(batch->result.toVariantMap());
+  });
+
+  m_batchWatcher = watcher;
+  watcher->setFuture(QtConcurrent::map(batch->chunks, [this, batch](const int& firstRow)
+  {
+    m_engine.convertBatchChunk(batch->options, batch->points, firstRow, batch->columns);
+  }));
+}
+
+/*!
+  \brief Cancels the background batch conversion started with \l convertPoints.
+
+  This returns at once. Chunks which are already being converted are allowed
+  to finish, and the partial table is then delivered through
+  \l batchConversionCompleted, with its \c canceled flag set.
+ */
+void CoordinateConversionController::cancelBatchConversion()
+{
+  if (!m_batchWatcher)
+    return;
+
+  m_batchWatcher->cancel();
+  m_batchWatcher = nullptr;
+}
+
+/*!
+  \brief Converts every point of the GPX, GeoJSON or CSV file
+  \a inputFileName in the background to every format in the options, and
+  writes the points with their notations to \a outputFileName.
+
+  Either name may be a local file URL. The format of each file is chosen
+  from its extension, so a GPX track can be written as GeoJSON or CSV and
+  the other way round. The input is streamed through a
+  PointStreamConverter, so memory use does not grow with the size of the
+  file. The outcome is delivered through \l fileConversionCompleted.
+
+  Starting a new file conversion cancels any which is still running, which
+  still reports its outcome.
+
+  \sa cancelFileConversion, PointStreamReader, PointStreamWriter
+ */
+void CoordinateConversionController::convertFile(const QString& inputFileName, const QString& outputFileName)
+{
+  cancelFileConversion();
+
+  // each run has its own watcher and flag, so a canceled run still reports
+  // its own outcome after a newer run has started
+  auto canceled = std::make_shared<std::atomic<bool>>(false);
+  auto watcher = new QFutureWatcher<PointStreamConverter::Result>(this);
+  connect(watcher, &QFutureWatcher<PointStreamConverter::Result>::finished, this, [this, watcher, canceled]()
+  {
+    watcher->deleteLater();
+    if (m_fileConversionCanceled == canceled)
+      m_fileConversionCanceled.reset();
+
+    const PointStreamConverter::Result result = watcher->result();
+    emit fileConversionCompleted(result.pointCount, result.canceled, result.errorString);
+  });
+
+  const QList<CoordinateFormatOption> options = m_engine.options();
+  const QString input = localFileName(inputFileName);
+  const QString output = localFileName(outputFileName);
+
+  m_fileConversionCanceled = canceled;
+
+  // the engine's batch conversions use the global pool, so the file is read there too
+  watcher->setFuture(QtConcurrent::run([this, options, input, output, canceled]()
+  {
+    return PointStreamConverter::convertFile(m_engine, options, input, output,
+                                             PointStreamConverter::defaultBatchSize, canceled.get());
+  }));
+}
+
+/*!
+  \brief Cancels the background file conversion started with
+  \l convertFile.
+
+  This returns at once. The conversion stops after the batch of points being
+  converted, leaving the output file incomplete, and
+  \l fileConversionCompleted is then emitted with \c canceled set.
+ */
+void CoordinateConversionController::cancelFileConversion()
+{
+  if (!m_fileConversionCanceled)
+    return;
+
+  *m_fileConversionCanceled = true;
+  m_fileConversionCanceled.reset();
+}
+
+/*!
+  \internal
+ */
+bool CoordinateConversionController::isInputFormat(const CoordinateFormatOption& option) const
+{
+  return option.formatId() == m_inputFormatId;
+}
+
+/*!
+  \internal
+
+  Returns the first option with the format \a formatId, or \c nullptr.
+ */
+CoordinateConversionOptions* CoordinateConversionController::optionForFormat(int formatId) const
+{
+  return m_optionsByFormatId.value(formatId, nullptr);
+}
+
+/*!
+  \internal
+
+  Indexes the options by format id, keeping the first option of each format
+  as the linear scans this replaces did.
+ */
+void CoordinateConversionController::rebuildFormatIndex()
+{
+  m_optionsByFormatId.clear();
   for (CoordinateConversionOptions* option : m_options)
   {
+    if (!m_optionsByFormatId.contains(option->formatId()))
+      m_optionsByFormatId.insert(option->formatId(), option);
+  }
+}
+
+/*!
+  \internal
+
+  Gives the engine a value snapshot of every option, in the same order.
+  Called whenever an option is added, removed or changed, so that the
+  engine's options and \c m_options always correspond by index.
+ */
+void CoordinateConversionController::updateEngineOptions()
+{
+  QList<CoordinateFormatOption> options;
+  options.reserve(m_options.size());
+  for (CoordinateConversionOptions* option : m_options)
+    options.append(option->formatOption());
+
+  m_engine.setOptions(options);
+  m_trackTable->setOptions(options);
+}
+
+/*!
+  \internal
+
+  Marks \a dirtyOption as needing conversion, or every option when it is
+  \c nullptr, and schedules a single conversion pass for the next turn of
+  the event loop. Changes made in the meantime are merged into that pass.
+ */
+void CoordinateConversionController::scheduleConversion(CoordinateConversionOptions* dirtyOption)
+{
+  if (dirtyOption)
+    m_dirtyOptions.insert(dirtyOption);
+  else
+    m_fullConversionPending = true;
+
+  if (m_conversionScheduled)
+    return;
+
+  m_conversionScheduled = true;
+  QTimer::singleShot(0, this, &CoordinateConversionController::runScheduledConversion);
+}
+
+/*!
+  \internal
+
+  Runs the pass scheduled by \l scheduleConversion. Only the rows of dirty
+  options are reconverted, unless the set of options itself changed, a
+  dirty row does not exist yet or conversions are asynchronous, in which
+  case every option is converted.
+ */
+void CoordinateConversionController::runScheduledConversion()
+{
+  m_conversionScheduled = false;
+
+  if (m_fullConversionPending)
+  {
+    convertPoint();
+    return;
+  }
+
+  if (m_dirtyOptions.isEmpty())
+    return;
+
+  const QSet<CoordinateConversionOptions*> dirtyOptions = std::move(m_dirtyOptions);
+  m_dirtyOptions.clear();
+
+  bool inputChanged = false;
+  QList<Result> results;
+  const QList<CoordinateFormatOption> options = m_engine.options();
+  for (int i = 0; i < m_options.size(); ++i)
+  {
+    if (!dirtyOptions.contains(m_options.at(i)))
+      continue;
+
+    const CoordinateFormatOption& option = options.at(i);
     if (isInputFormat(option))
     {
-      inputOption = option;
-      break;
+      inputChanged = true;
+      continue;
     }
+
+    if (m_runConversion)
+      results.append(Result(option.name(), cachedConversion(option, m_pointToConvert), option.outputMode()));
   }
 
-  if (inputOption == nullptr)
-    return Point();
+  if (!results.isEmpty())
+  {
+    if (m_asynchronous || !resultsInternal()->updateResults(std::move(results)))
+      convertPoint();
+  }
+
+  // pointToConvert is formatted with the input option
+  if (inputChanged)
+    emit pointToConvertChanged();
+}
+
+void CoordinateConversionController::setGeoView(QObject* geoView)
+{
+  if (!geoView)
+    return;
 
-  switch (inputOption->outputMode())
+  if (std::strcmp(geoView->metaObject()->className(), MapQuickView::staticMetaObject.className()) == 0)
   {
-  case CoordinateConversionOptions::CoordinateType::CoordinateTypeGars:
+    m_mapView = reinterpret_cast<MapQuickView*>(geoView);
+    m_sceneView = nullptr;
+    if (m_mapView)
+    {
+      setSpatialReference(m_mapView->spatialReference());
+      connect(m_mapView, &MapQuickView::mouseClicked, this, &CoordinateConversionController::onMouseClicked);
+      connect(m_mapView, &QQuickItem::windowChanged, this, &CoordinateConversionController::updateSchedulerWindow);
+    }
+  }
+  else if (std::strcmp(geoView->metaObject()->className(), SceneQuickView::staticMetaObject.className()) == 0)
   {
-    return CoordinateFormatter::fromGars(incomingNotation,
-                                         m_spatialReference,
-                                         inputOption->garsConvesrionMode());
+    m_sceneView = reinterpret_cast<SceneQuickView*>(geoView);
+    m_mapView = nullptr;
+    if (m_sceneView)
+    {
+      setSpatialReference(m_sceneView->spatialReference());
+      connect(m_sceneView, &SceneQuickView::mouseClicked, this, &CoordinateConversionController::onMouseClicked);
+      connect(m_sceneView, &QQuickItem::windowChanged, this, &CoordinateConversionController::updateSchedulerWindow);
+    }
   }
-  case CoordinateConversionOptions::CoordinateType::CoordinateTypeGeoRef:
+
+  updateSchedulerWindow();
+  watchViewBoundary();
+}
+
+/*!
+  \property CoordinateConversionController::results
+  \brief The conversion results as a list model.
+
+  The results are automatically updated as conversions are run.
+
+  \sa CoordinateConversionResults
+ */
+QAbstractListModel* CoordinateConversionController::results()
+{
+  return resultsInternal();
+}
+
+/*!
+  \internal
+ */
+CoordinateConversionResults* CoordinateConversionController::resultsInternal()
+{
+  if (!m_results)
   {
-    return CoordinateFormatter::fromGeoRef(incomingNotation,
-                                           m_spatialReference);
+    m_results = new CoordinateConversionResults(this);
+    connect(m_results, &CoordinateConversionResults::resultsChanged, this, &CoordinateConversionController::resultsChanged);
   }
-  case CoordinateConversionOptions::CoordinateType::CoordinateTypeLatLon:
+
+  return m_results;
+}
+
+bool CoordinateConversionController::setGeoViewInternal(GeoView* geoView)
+{
+  if (geoView == nullptr)
+    return false;
+
+  setSpatialReference(geoView->spatialReference());
+
+  m_sceneView = dynamic_cast<SceneQuickView*>(geoView);
+  m_mapView = dynamic_cast<MapQuickView*>(geoView);
+  updateSchedulerWindow();
+  watchViewBoundary();
+
+  return m_sceneView != nullptr || m_mapView != nullptr;
+}
+
+/*!
+  \internal
+
+  Paces frame-synced location conversions by the window showing the geoview.
+ */
+void CoordinateConversionController::updateSchedulerWindow()
+{
+  QQuickWindow* window = nullptr;
+  if (m_mapView)
+    window = m_mapView->window();
+  else if (m_sceneView)
+    window = m_sceneView->window();
+
+  m_locationScheduler->setWindow(window);
+  m_hoverScheduler->setWindow(window);
+}
+
+/*!
+  \internal
+
+  Drops the cached view boundary whenever the viewpoint or the size of the
+  current geoview changes.
+ */
+void CoordinateConversionController::watchViewBoundary()
+{
+  for (const QMetaObject::Connection& connection : m_viewBoundaryConnections)
+    disconnect(connection);
+
+  m_viewBoundaryConnections.clear();
+  invalidateViewBoundary();
+
+  QQuickItem* viewItem = nullptr;
+  if (m_mapView)
   {
-    return CoordinateFormatter::fromLatitudeLongitude(incomingNotation,
-                                                      m_spatialReference);
+    viewItem = m_mapView;
+    m_viewBoundaryConnections.append(connect(m_mapView, &MapQuickView::viewpointChanged,
+                                             this, &CoordinateConversionController::invalidateViewBoundary));
   }
-  case CoordinateConversionOptions::CoordinateType::CoordinateTypeMgrs:
+  else if (m_sceneView)
   {
-    return CoordinateFormatter::fromMgrs(incomingNotation,
-                                         m_spatialReference,
-                                         inputOption->mgrsConversionMode());
+    viewItem = m_sceneView;
+    m_viewBoundaryConnections.append(connect(m_sceneView, &SceneQuickView::viewpointChanged,
+                                             this, &CoordinateConversionController::invalidateViewBoundary));
   }
-  case CoordinateConversionOptions::CoordinateType::CoordinateTypeUsng:
+  else
   {
-    return CoordinateFormatter::fromUsng(incomingNotation,
-                                         m_spatialReference);
+    return;
   }
-  case CoordinateConversionOptions::CoordinateType::CoordinateTypeUtm:
+
+  m_viewBoundaryConnections.append(connect(viewItem, &QQuickItem::widthChanged,
+                                           this, &CoordinateConversionController::invalidateViewBoundary));
+  m_viewBoundaryConnections.append(connect(viewItem, &QQuickItem::heightChanged,
+                                           this, &CoordinateConversionController::invalidateViewBoundary));
+}
+
+/*!
+  \internal
+ */
+void CoordinateConversionController::invalidateViewBoundary()
+{
+  m_viewBoundaryValid = false;
+  m_projectedPointValid = false;
+}
+
+/*!
+  \brief Sets the spatial reference to \a spatialReference.
+  \note This property must be set before calling the \l convertNotation method.
+ */
+void CoordinateConversionController::setSpatialReference(const SpatialReference& spatialReference)
+{
+  m_spatialReference = spatialReference;
+  m_engine.setSpatialReference(spatialReference);
+}
+
+/*!
+  \brief Sets the point to be converted via the \l convertPoint method to \a point.
+  \note If the \l runConversion property is \c true, the conversion will be run immediately.
+ */
+void CoordinateConversionController::setPointToConvert(const Point& point)
+{
+  if (point == m_pointToConvert)
+    return;
+
+  m_pointToConvert = point;
+  m_projectedPointValid = false;
+
+  if (m_runConversion)
+    convertPoint();
+
+  emit pointToConvertChanged();
+}
+
+/*!
+  \brief Returns whether the tool is in capture mode.
+
+  If \c true, the tool will convert a point set via a mouse click.
+  If \c false, the too will use the app's current location as the target point.
+ */
+bool CoordinateConversionController::isCaptureMode() const
+{
+  return m_captureMode;
+}
+
+/*!
+  \brief Sets the tool's capture mode to \a captureMode.
+
+  \list
+    \li \c true = convert a point set via a mouse click.
+    \li \c false = use the app's current location as the target point.
+  \endlist
+ */
+void CoordinateConversionController::setCaptureMode(bool captureMode)
+{
+  if (captureMode == m_captureMode)
+    return;
+
+  m_captureMode = captureMode;
+
+  m_locationScheduler->discard();
+  setPointToConvert(Point());
+
+  emit captureModeChanged();
+}
+
+/*!
+  \brief Returns whether \l convertNotation recognizes the format of each
+  notation itself.
+
+  If \c false, notations are expected to be in the \l inputFormat.
+ */
+bool CoordinateConversionController::autoDetectInputFormat() const
+{
+  return m_autoDetectInputFormat;
+}
+
+/*!
+  \brief Sets whether \l convertNotation recognizes the format of each
+  notation to \a autoDetectInputFormat.
+
+  \sa detectFormats
+ */
+void CoordinateConversionController::setAutoDetectInputFormat(bool autoDetectInputFormat)
+{
+  if (autoDetectInputFormat == m_autoDetectInputFormat)
+    return;
+
+  m_autoDetectInputFormat = autoDetectInputFormat;
+  m_engine.setAutoDetectInputFormat(autoDetectInputFormat);
+
+  emit autoDetectInputFormatChanged();
+}
+
+/*!
+  \brief Returns the number of conversions served from the result cache.
+
+  While the point to convert moves by less than the precision of a format,
+  its notation is taken from a bounded cache rather than converted again.
+
+  \sa ConversionResultCache
+ */
+quint64 CoordinateConversionController::resultCacheHitCount() const
+{
+  return m_resultCache.hitCount();
+}
+
+/*!
+  \brief Returns the number of conversions which were not in the result cache.
+ */
+quint64 CoordinateConversionController::resultCacheMissCount() const
+{
+  return m_resultCache.missCount();
+}
+
+/*!
+  \brief Returns the settings given to the options this controller creates.
+
+  A controller starts with a copy of \l CoordinateFormatFactory::defaults()
+  taken when it is constructed, so later changes to those affect only new
+  controllers.
+
+  \sa CoordinateFormatDefaults
+ */
+CoordinateFormatDefaults CoordinateConversionController::formatDefaults() const
+{
+  return m_engine.formatDefaults();
+}
+
+/*!
+  \brief Sets the settings given to the options this controller creates to \a formatDefaults.
+
+  The options added by \l addCoordinateFormat, and those used to decode
+  recognized notations of a format with no option, are created from
+  \a formatDefaults. Existing options keep their settings.
+ */
+void CoordinateConversionController::setFormatDefaults(const CoordinateFormatDefaults& formatDefaults)
+{
+  m_engine.setFormatDefaults(formatDefaults);
+}
+
+/*!
+  \fn void CoordinateConversionController::onMouseClicked(QMouseEvent& mouseEvent);
+  \brief Handles the mouse click at \a mouseEvent .
+
+  If the tool is active and is in \l captureMode, the clicked location will be used
+  as the input for conversions.
+ */
+void CoordinateConversionController::onMouseClicked(QMouseEvent& mouseEvent )
+{
+  if (!isActive() || !isCaptureMode())
+    return;
+
+  Point point;
+  if (m_sceneView)
+    point = m_sceneView->screenToBaseSurface(mouseEvent .pos().x(), mouseEvent .pos().y());
+  else if (m_mapView)
+    point = m_mapView->screenToLocation(mouseEvent .pos().x(), mouseEvent .pos().y());
+  else
+    return;
+
+  if (m_asynchronous)
   {
-    return CoordinateFormatter::fromUtm(incomingNotation,
-                                        m_spatialReference,
-                                        inputOption->utmConversionMode());
-  }
-  default: {}
+    recordPointAsync(point, true, m_trackMode);
+    return;
   }
 
-  return Point();
+  setPointToConvert(point);
+  recordCapture(point);
+
+  if (m_trackMode)
+    recordTrackPoint(point);
 }
 
 /*!
-  \brief Converts the last point assigned with \l setPointToConvert to all the
-  notations specified in the options.
+  \internal
+
+  The asynchronous counterpart of \l setPointToConvert followed by
+  \l recordCapture and \l recordTrackPoint: \a point becomes the point to
+  convert, and a single conversion on the pool produces both its results and
+  the notations recorded in the \l captureHistory when \a capture is set
+  and in the \l trackTable when \a track is set. Nothing is converted on
+  the GUI thread.
  */
-void CoordinateConversionController::convertPoint()
+void CoordinateConversionController::recordPointAsync(const Point& point, bool capture, bool track)
 {
-  QList<Result> results;
-  for (CoordinateConversionOptions* option : m_options)
+  if (point.isEmpty())
   {
-    if (isInputFormat(option))
-      continue;
-
-    results.append(Result(option->name(), convertPointInternal(option, m_pointToConvert), option->outputMode()));
+    setPointToConvert(point);
+    return;
   }
 
-  if (results.isEmpty())
-    resultsInternal()->clearResults();
-  else
-    resultsInternal()->setResults(std::move(results));
+  const bool pointChanged = !(point == m_pointToConvert);
+  m_pointToConvert = point;
+  m_projectedPointValid = false;
+
+  // a full conversion covers every scheduled one
+  m_dirtyOptions.clear();
+  m_fullConversionPending = false;
+
+  startAsyncConversion(point, QString(), capture, track);
 
-  emit resultsChanged();
+  if (pointChanged)
+    emit pointToConvertChanged();
 }
 
 /*!
   \internal
+
+  Appends \a point and its notation in every format to the
+  \l captureHistory. The notations were just produced by the synchronous
+  conversion of the point, so they come from the result cache.
  */
-QString CoordinateConversionController::convertPointInternal(CoordinateConversionOptions* option,
-                                                             const Point& point) const
+void CoordinateConversionController::recordCapture(const Point& point)
 {
-  switch (option->outputMode())
-  {
-  case CoordinateConversionOptions::CoordinateType::CoordinateTypeGars:
-  {
-    return CoordinateFormatter::toGars(point);
-  }
-  case CoordinateConversionOptions::CoordinateType::CoordinateTypeGeoRef:
-  {
-    return CoordinateFormatter::toGeoRef(point, option->precision());
-  }
-  case CoordinateConversionOptions::CoordinateType::CoordinateTypeLatLon:
-  {
-    const auto format = static_cast<Esri::ArcGISRuntime::LatitudeLongitudeFormat>(option->latLonFormat());
-    return CoordinateFormatter::toLatitudeLongitude(point, format, option->decimalPlaces());
-  }
-  case CoordinateConversionOptions::CoordinateType::CoordinateTypeMgrs:
-  {
-    const auto conversionMode = static_cast<Esri::ArcGISRuntime::MgrsConversionMode>(option->mgrsConversionMode());
-    return CoordinateFormatter::toMgrs(point, conversionMode, option->decimalPlaces(), option->addSpaces());
-  }
-  case CoordinateConversionOptions::CoordinateType::CoordinateTypeUsng:
-  {
-    return CoordinateFormatter::toUsng(point, option->precision(), option->decimalPlaces());
-  }
-  case CoordinateConversionOptions::CoordinateType::CoordinateTypeUtm:
+  if (point.isEmpty())
+    return;
+
+  QStringList formatNames;
+  QStringList notations;
+  const QList<CoordinateFormatOption> options = m_engine.options();
+  formatNames.reserve(options.size());
+  notations.reserve(options.size());
+  for (const CoordinateFormatOption& option : options)
   {
-    const auto conversionMode = static_cast<Esri::ArcGISRuntime::UtmConversionMode>(option->utmConversionMode());
-    return CoordinateFormatter::toUtm(point, conversionMode, option->addSpaces());
-  }
-  default: {}
+    formatNames.append(option.name());
+    notations.append(cachedConversion(option, point));
   }
 
-  return QString();
+  m_captureHistory->append(point, formatNames, notations);
 }
 
 /*!
   \internal
+
+  Appends \a point as a new row of the \l trackTable. Only the new row is
+  converted, and after the synchronous conversion of the point its
+  notations come from the result cache.
  */
-bool CoordinateConversionController::isInputFormat(CoordinateConversionOptions* option) const
+void CoordinateConversionController::recordTrackPoint(const Point& point)
 {
-  return isFormat(option, m_inputFormat);
+  if (point.isEmpty())
+    return;
+
+  QStringList notations;
+  const QList<CoordinateFormatOption> options = m_engine.options();
+  notations.reserve(options.size());
+  for (const CoordinateFormatOption& option : options)
+    notations.append(cachedConversion(option, point));
+
+  m_trackTable->append(point, notations);
 }
 
 /*!
   \internal
+
+  Converts the location \a point passed on by the \l locationScheduler and,
+  in \l trackMode, appends it to the \l trackTable.
  */
-bool CoordinateConversionController::isFormat(CoordinateConversionOptions* option, const QString& formatName) const
+void CoordinateConversionController::onLocationPointReady(const Point& point)
 {
-  if (option == nullptr)
-    return false;
+  if (m_asynchronous && m_trackMode)
+  {
+    recordPointAsync(point, false, true);
+    return;
+  }
+
+  setPointToConvert(point);
 
-  return option->name().compare(formatName, Qt::CaseInsensitive) == 0;
+  if (m_trackMode)
+    recordTrackPoint(point);
 }
 
-void CoordinateConversionController::setGeoView(QObject* geoView)
+/*!
+  \fn void CoordinateConversionController::onLocationChanged(const Point& location);
+  \brief Handles the app's location update to \a location.
+
+  If the tool is active and is not in \l captureMode, the location will be used
+  as the input for conversions. Bursts of updates are coalesced by the
+  \l locationScheduler, which converts only the newest location.
+ */
+void CoordinateConversionController::onLocationChanged(const Point& location)
 {
-  if (!geoView)
-    return;
+  if (isActive() && !isCaptureMode() && !m_hoverMode)
+    m_locationScheduler->submit(location);
+}
 
-  if (std::strcmp(geoView->metaObject()->className(), MapQuickView::staticMetaObject.className()) == 0)
-  {
-    m_mapView = reinterpret_cast<MapQuickView*>(geoView);
-    m_sceneView = nullptr;
-    if (m_mapView)
-    {
-      setSpatialReference(m_mapView->spatialReference());
-      connect(m_mapView, &MapQuickView::mouseClicked, this, &CoordinateConversionController::onMouseClicked);
-    }
-  }
-  else if (std::strcmp(geoView->metaObject()->className(), SceneQuickView::staticMetaObject.className()) == 0)
+/*!
+  \brief Handles the mouse cursor moving over the GeoView to \a point.
+
+  If the tool is active and in \l hoverMode, \a point is handed to the
+  \l hoverScheduler, which passes on at most one point per rendered frame.
+ */
+void CoordinateConversionController::onMouseMovedPoint(const Point& point)
+{
+  if (isActive() && m_hoverMode && !point.isEmpty())
+    m_hoverScheduler->submit(point);
+}
+
+/*!
+  \internal
+
+  Converts \a point unless it lies in the same cell as the current
+  \l pointToConvert for every option, in which case none of the notations
+  would change, up to the rounding the result cache allows at cell edges.
+  Cells are those the result cache keys on, grid formats included; any
+  other format never shares a cell, so options with such a format always
+  convert.
+ */
+void CoordinateConversionController::onHoverPointReady(const Point& point)
+{
+  if (!m_options.isEmpty() && !m_pointToConvert.isEmpty())
   {
-    m_sceneView = reinterpret_cast<SceneQuickView*>(geoView);
-    m_mapView = nullptr;
-    if (m_sceneView)
+    bool sameCell = true;
+    const QList<CoordinateFormatOption> options = m_engine.options();
+    for (const CoordinateFormatOption& option : options)
     {
-      setSpatialReference(m_sceneView->spatialReference());
-      connect(m_sceneView, &SceneQuickView::mouseClicked, this, &CoordinateConversionController::onMouseClicked);
+      if (!m_resultCache.sameCell(option, point, m_pointToConvert))
+      {
+        sameCell = false;
+        break;
+      }
     }
+
+    if (sameCell)
+      return;
   }
 
+  setPointToConvert(point);
 }
 
 /*!
-  \property CoordinateConversionController::results
-  \brief The conversion results as a list model.
+  \property CoordinateConversionController::asynchronous
+  \brief Whether \l convertPoint and \l convertNotation run on worker threads.
 
-  The results are automatically updated as conversions are run.
+  When \c true, each conversion runs on a small pool of worker threads
+  against a snapshot of the options, and the \l results are updated when it
+  completes. A conversion requested while an earlier one is still running
+  supersedes it: only the results of the most recent request are applied.
 
-  \sa CoordinateConversionResults
+  The default is \c false, converting on the calling thread.
  */
-QAbstractListModel* CoordinateConversionController::results()
+bool CoordinateConversionController::isAsynchronous() const
 {
-  return resultsInternal();
+  return m_asynchronous;
 }
 
 /*!
-  \internal
+  \brief Sets whether conversions run on worker threads to \a asynchronous.
  */
-CoordinateConversionResults* CoordinateConversionController::resultsInternal()
+void CoordinateConversionController::setAsynchronous(bool asynchronous)
 {
-  if (!m_results)
-  {
-    m_results = new CoordinateConversionResults(this);
-    connect(m_results, &CoordinateConversionResults::resultsChanged, this, &CoordinateConversionController::resultsChanged);
-  }
+  if (asynchronous == m_asynchronous)
+    return;
 
-  return m_results;
-}
+  m_asynchronous = asynchronous;
 
-bool CoordinateConversionController::setGeoViewInternal(GeoView* geoView)
-{
-  if (geoView == nullptr)
-    return false;
+  // results of conversions started in the other mode are no longer wanted
+  ++m_conversionGeneration;
 
-  setSpatialReference(geoView->spatialReference());
+  emit asynchronousChanged();
+}
 
-  m_sceneView = dynamic_cast<SceneQuickView*>(geoView);
-  m_mapView = dynamic_cast<MapQuickView*>(geoView);
+/*!
+  \property CoordinateConversionController::locationScheduler
+  \brief The scheduler pacing conversions of live location updates.
 
-  return m_sceneView != nullptr || m_mapView != nullptr;
+  By default at most 10 locations are converted per second. Set its
+  \c maximumRate, or its \c frameSynced property to convert once per
+  rendered frame; its \c processedCount and \c droppedCount show how many
+  updates were converted and how many were coalesced away.
+
+  \sa ConversionScheduler
+ */
+ConversionScheduler* CoordinateConversionController::locationScheduler() const
+{
+  return m_locationScheduler;
 }
 
 /*!
-  \brief Sets the spatial reference to \a spatialReference.
-  \note This property must be set before calling the \l convertNotation method.
+  \property CoordinateConversionController::hoverMode
+  \brief Whether the point under the mouse cursor is converted as the
+  cursor moves over the GeoView.
+
+  Moves are paced by the \l hoverScheduler, and a move which stays within
+  the precision of every notation is not converted at all. While set, live
+  location updates are ignored. The default is \c false.
  */
-void CoordinateConversionController::setSpatialReference(const SpatialReference& spatialReference)
+bool CoordinateConversionController::isHoverMode() const
 {
-  m_spatialReference = spatialReference;
+  return m_hoverMode;
 }
 
 /*!
-  \brief Sets the point to be converted via the \l convertPoint method to \a point.
-  \note If the \l runConversion property is \c true, the conversion will be run immediately.
+  \brief Sets whether the point under the mouse cursor is converted to
+  \a hoverMode.
  */
-void CoordinateConversionController::setPointToConvert(const Point& point)
+void CoordinateConversionController::setHoverMode(bool hoverMode)
 {
-  if (point == m_pointToConvert)
+  if (hoverMode == m_hoverMode)
     return;
 
-  m_pointToConvert = point;
+  m_hoverMode = hoverMode;
 
-  if (m_runConversion)
-    convertPoint();
+  if (m_hoverMode)
+    m_locationScheduler->discard();
+  else
+    m_hoverScheduler->discard();
 
-  emit pointToConvertChanged();
+  emit hoverModeChanged();
 }
 
 /*!
-  \brief Returns whether the tool is in capture mode.
+  \property CoordinateConversionController::hoverScheduler
+  \brief The scheduler pacing conversions in \l hoverMode.
 
-  If \c true, the tool will convert a point set via a mouse click.
-  If \c false, the too will use the app's current location as the target point.
+  It is \c frameSynced, converting the newest cursor position at most once
+  per rendered frame of the GeoView's window.
+
+  \sa ConversionScheduler
  */
-bool CoordinateConversionController::isCaptureMode() const
+ConversionScheduler* CoordinateConversionController::hoverScheduler() const
 {
-  return m_captureMode;
+  return m_hoverScheduler;
 }
 
 /*!
-  \brief Sets the tool's capture mode to \a captureMode.
+  \property CoordinateConversionController::captureHistory
+  \brief The points captured in \l captureMode, with their notation in
+  every format, oldest first.
 
-  \list
-    \li \c true = convert a point set via a mouse click.
-    \li \c false = use the app's current location as the target point.
-  \endlist
+  The history keeps at most its \c capacity captures, dropping the oldest.
+
+  \sa CaptureHistoryModel
  */
-void CoordinateConversionController::setCaptureMode(bool captureMode)
+CaptureHistoryModel* CoordinateConversionController::captureHistory() const
 {
-  if (captureMode == m_captureMode)
-    return;
-
-  m_captureMode = captureMode;
+  return m_captureHistory;
+}
 
-  setPointToConvert(Point());
+/*!
+  \property CoordinateConversionController::trackMode
+  \brief Whether each point captured in \l captureMode, and each location
+  update otherwise, is appended to the \l trackTable.
 
-  emit captureModeChanged();
+  The default is \c false.
+ */
+bool CoordinateConversionController::isTrackMode() const
+{
+  return m_trackMode;
 }
 
 /*!
-  \fn void CoordinateConversionController::onMouseClicked(QMouseEvent& mouseEvent);
-  \brief Handles the mouse click at \a mouseEvent .
-
-  If the tool is active and is in \l captureMode, the clicked location will be used
-  as the input for conversions.
+  \brief Sets whether captured points and location updates are appended to
+  the \l trackTable to \a trackMode.
  */
-void CoordinateConversionController::onMouseClicked(QMouseEvent& mouseEvent )
+void CoordinateConversionController::setTrackMode(bool trackMode)
 {
-  if (!isActive() || !isCaptureMode())
+  if (trackMode == m_trackMode)
     return;
 
-  if (m_sceneView)
-    setPointToConvert(m_sceneView->screenToBaseSurface(mouseEvent .pos().x(), mouseEvent .pos().y()));
-  else if (m_mapView)
-    setPointToConvert(m_mapView->screenToLocation(mouseEvent .pos().x(), mouseEvent .pos().y()));
+  m_trackMode = trackMode;
+  emit trackModeChanged();
 }
 
 /*!
-  \fn void CoordinateConversionController::onLocationChanged(const Point& location);
-  \brief Handles the app's location update to \a location.
+  \property CoordinateConversionController::trackTable
+  \brief The points recorded in \l trackMode, oldest first, with one column
+  per format.
 
-  If the tool is active and is not in \l captureMode, the location will be used
-  as the input for conversions.
+  Changing the settings of a format only marks its column out of date; the
+  cells are converted again as views read them.
+
+  \sa TrackTableModel
  */
-void CoordinateConversionController::onLocationChanged(const Point& location)
+TrackTableModel* CoordinateConversionController::trackTable() const
 {
-  if (isActive() && !isCaptureMode())
-    setPointToConvert(location);
+  return m_trackTable;
 }
 
 /*!
@@ -448,6 +1479,8 @@ void CoordinateConversionController::setInputFormat(const QString& inputFormat)
     return;
 
   m_inputFormat = inputFormat;
+  m_inputFormatId = CoordinateFormatRegistry::formatId(inputFormat);
+  m_engine.setInputFormat(inputFormat);
 
   addCoordinateFormat(m_inputFormat);
 
@@ -472,6 +1505,44 @@ QStringList CoordinateConversionController::coordinateFormats() const
 void CoordinateConversionController::addOption(CoordinateConversionOptions* option)
 {
   m_options.append(option);
+  updateEngineOptions();
+  if (!m_optionsByFormatId.contains(option->formatId()))
+    m_optionsByFormatId.insert(option->formatId(), option);
+
+  connect(option, &CoordinateConversionOptions::nameChanged, this, &CoordinateConversionController::rebuildFormatIndex,
+          Qt::UniqueConnection);
+
+  // keep the engine's snapshot of the option current before anything converts with it
+  for (auto changed : {&CoordinateConversionOptions::nameChanged, &CoordinateConversionOptions::outputModeChanged,
+                       &CoordinateConversionOptions::addSpacesChanged, &CoordinateConversionOptions::precisionChanged,
+                       &CoordinateConversionOptions::decimalPlacesChanged, &CoordinateConversionOptions::mgrsConversionModeChanged,
+                       &CoordinateConversionOptions::latLonFormatChanged, &CoordinateConversionOptions::utmConversionModeChanged,
+                       &CoordinateConversionOptions::garsConversionModeChanged, &CoordinateConversionOptions::enuOriginLatitudeChanged,
+                       &CoordinateConversionOptions::enuOriginLongitudeChanged, &CoordinateConversionOptions::enuOriginHeightChanged,
+                       &CoordinateConversionOptions::levelChanged, &CoordinateConversionOptions::cellIdNotationChanged})
+  {
+    connect(option, changed, this, &CoordinateConversionController::updateEngineOptions, Qt::UniqueConnection);
+  }
+
+  // a renamed option may change which row it fills, or become the input format
+  connect(option, &CoordinateConversionOptions::nameChanged, this, [this]() { scheduleConversion(nullptr); });
+
+  // any other setting only changes the notation of this option's own row
+  const auto markDirty = [this, option]() { scheduleConversion(option); };
+  connect(option, &CoordinateConversionOptions::outputModeChanged, this, markDirty);
+  connect(option, &CoordinateConversionOptions::addSpacesChanged, this, markDirty);
+  connect(option, &CoordinateConversionOptions::precisionChanged, this, markDirty);
+  connect(option, &CoordinateConversionOptions::decimalPlacesChanged, this, markDirty);
+  connect(option, &CoordinateConversionOptions::mgrsConversionModeChanged, this, markDirty);
+  connect(option, &CoordinateConversionOptions::latLonFormatChanged, this, markDirty);
+  connect(option, &CoordinateConversionOptions::utmConversionModeChanged, this, markDirty);
+  connect(option, &CoordinateConversionOptions::garsConversionModeChanged, this, markDirty);
+  connect(option, &CoordinateConversionOptions::enuOriginLatitudeChanged, this, markDirty);
+  connect(option, &CoordinateConversionOptions::enuOriginLongitudeChanged, this, markDirty);
+  connect(option, &CoordinateConversionOptions::enuOriginHeightChanged, this, markDirty);
+  connect(option, &CoordinateConversionOptions::levelChanged, this, markDirty);
+  connect(option, &CoordinateConversionOptions::cellIdNotationChanged, this, markDirty);
+
   if (m_options.size() == 1)
     setInputFormat(option->name());
 
@@ -489,7 +1560,13 @@ void CoordinateConversionController::addOption(CoordinateConversionOptions* opti
  */
 void CoordinateConversionController::clearOptions()
 {
+  for (CoordinateConversionOptions* option : m_options)
+    disconnect(option, nullptr, this, nullptr);
+
   m_options.clear();
+  updateEngineOptions();
+  m_dirtyOptions.clear();
+  m_optionsByFormatId.clear();
   emit optionsChanged();
 }
 
@@ -522,13 +1599,11 @@ void CoordinateConversionController::setProperties(const QVariantMap& properties
  */
 QString CoordinateConversionController::pointToConvert() const
 {
-  for (CoordinateConversionOptions* option : m_options)
-  {
-    if (isInputFormat(option))
-      return convertPointInternal(option, m_pointToConvert);
-  }
+  const CoordinateFormatOption inputOption = m_engine.inputOption();
+  if (!inputOption.isValid())
+    return QString();
 
-  return QString();
+  return cachedConversion(inputOption, m_pointToConvert);
 }
 
 /*!
@@ -558,22 +1633,14 @@ void CoordinateConversionController::addCoordinateFormat(const QString& newForma
   if (!m_coordinateFormats.contains(newFormat))
     return;
 
-  auto it = m_options.cbegin();
-  const auto itEnd = m_options.cend();
-  for (; it != itEnd; ++it)
-  {
-    if (isFormat(*it, newFormat))
-      return;
-  }
+  if (optionForFormat(CoordinateFormatRegistry::findFormatId(newFormat)))
+    return;
 
-  CoordinateConversionOptions* option = CoordinateFormatFactory::createFormat(newFormat, this);
+  CoordinateConversionOptions* option = CoordinateFormatFactory::createFormat(newFormat, m_engine.formatDefaults(), this);
   if (!option)
     return;
 
   addOption(option);
-
-  if (m_runConversion)
-    convertPoint();
 }
 
 /*!
@@ -581,32 +1648,24 @@ void CoordinateConversionController::addCoordinateFormat(const QString& newForma
  */
 void CoordinateConversionController::removeCoordinateFormat(const QString& formatToRemove)
 {
-  if (formatToRemove.compare(m_inputFormat, Qt::CaseInsensitive) == 0)
+  const int formatId = CoordinateFormatRegistry::findFormatId(formatToRemove);
+  if (formatId == m_inputFormatId)
     return;
 
-  bool removed = false;
-  auto it = m_options.begin();
-  auto itEnd = m_options.end();
-  for (; it != itEnd; ++it)
-  {
-    const auto& option = *it;
-    if (isFormat(option, formatToRemove))
-    {
-      m_options.erase(it);
-      removed = true;
-      break;
-    }
-  }
-
-  if (!removed)
+  CoordinateConversionOptions* option = optionForFormat(formatId);
+  if (option == nullptr)
     return;
 
+  m_options.removeOne(option);
+  rebuildFormatIndex();
+  updateEngineOptions();
+
+  disconnect(option, nullptr, this, nullptr);
+  m_dirtyOptions.remove(option);
+
   if (m_results)
     m_results->removeResult(formatToRemove);
 
-  if(runConversion())
-    convertPoint();
-
   emit optionsChanged();
   emit pointToConvertChanged();
 }
@@ -637,55 +1696,16 @@ QPointF CoordinateConversionController::screenCoordinate() const
   // if we did not recieve a valid screen coordinate
   if (res.x() == 0.0 && res.y() == 0.0)
   {
-    // lambda to search for a valid geographic position for the top of the screen (e.g. to account for the horizon)
-    auto findValidTopPoint = [this, screenHeight](double x)
-    {
-      Point validTopPoint;
-      double lastValidY = screenHeight;
-      double testMinY = 1.0;
-      for (int attempt = 0; attempt < 16; ++attempt)
-      {
-        double testY = testMinY + ((lastValidY - testMinY) * 0.5);
-        auto newRes =  m_sceneView ? m_sceneView->screenToBaseSurface(x, testY) : m_mapView->screenToLocation(x, testY);
-        if (newRes.isValid() && !newRes.isEmpty())
-        {
-          validTopPoint = newRes;
-          if (std::abs(lastValidY - testY) < 1.0)
-            break;
-
-          lastValidY = testY;
-        }
-        else
-        {
-          testMinY = testY;
-        }
-      }
-
-      return validTopPoint;
-    };
+    const Polyline& boundary = viewBoundary(padding, screenWidth, screenHeight);
 
-    // otherwise build a polyline describing the extent of the screen
-    Point topLeft = m_sceneView ? m_sceneView->screenToBaseSurface(padding, padding) : m_mapView->screenToLocation(padding, padding);
-    if (topLeft.isEmpty() || !topLeft.isValid())
-      topLeft = findValidTopPoint(padding);
-
-    Point topRight = m_sceneView ? m_sceneView->screenToBaseSurface(screenWidth, padding) : m_mapView->screenToLocation(screenWidth, padding);
-    if (topRight.isEmpty() || !topRight.isValid())
-      findValidTopPoint(screenWidth);
-
-    Point lowerLeft = m_sceneView ? m_sceneView->screenToBaseSurface(padding, screenHeight) : m_mapView->screenToLocation(padding, screenHeight);
-    Point lowerRight = m_sceneView ? m_sceneView->screenToBaseSurface(screenWidth, screenHeight) : m_mapView->screenToLocation(screenWidth, screenHeight);
-
-    PolylineBuilder bldr(topLeft.spatialReference());
-    bldr.addPoint(topLeft);
-    bldr.addPoint(topRight);
-    bldr.addPoint(lowerRight);
-    bldr.addPoint(lowerLeft);
-    bldr.addPoint(topLeft);
-    const Polyline viewBoundary = bldr.toPolyline();
     // obtain the point on the view boundary polyline which is closest to the target point
-    Point projected = GeometryEngine::instance()->project(m_pointToConvert, topLeft.spatialReference());
-    const ProximityResult nearestCoordinateResult = GeometryEngine::instance()->nearestCoordinate(viewBoundary, projected);
+    if (!m_projectedPointValid)
+    {
+      m_projectedPointToConvert = GeometryEngine::instance()->project(m_pointToConvert, boundary.spatialReference());
+      m_projectedPointValid = true;
+    }
+
+    const ProximityResult nearestCoordinateResult = GeometryEngine::instance()->nearestCoordinate(boundary, m_projectedPointToConvert);
 
     res = m_sceneView ? m_sceneView->locationToScreen(nearestCoordinateResult.coordinate()).screenPoint() :
                         m_mapView->locationToScreen(nearestCoordinateResult.coordinate());
@@ -705,6 +1725,74 @@ QPointF CoordinateConversionController::screenCoordinate() const
   return res;
 }
 
+/*!
+  \internal
+
+  Returns the polyline around the visible part of the geoview, inset by
+  \a padding, building it only once per viewpoint and view size. For
+  scenes, the top corners are moved down to the horizon when the sky is
+  visible.
+ */
+const Polyline& CoordinateConversionController::viewBoundary(double padding, double screenWidth, double screenHeight) const
+{
+  if (m_viewBoundaryValid)
+    return m_viewBoundary;
+
+  Point topLeft = m_sceneView ? m_sceneView->screenToBaseSurface(padding, padding) : m_mapView->screenToLocation(padding, padding);
+  if (topLeft.isEmpty() || !topLeft.isValid())
+    topLeft = findValidTopPoint(padding, screenHeight);
+
+  Point topRight = m_sceneView ? m_sceneView->screenToBaseSurface(screenWidth, padding) : m_mapView->screenToLocation(screenWidth, padding);
+  if (topRight.isEmpty() || !topRight.isValid())
+    topRight = findValidTopPoint(screenWidth, screenHeight);
+
+  Point lowerLeft = m_sceneView ? m_sceneView->screenToBaseSurface(padding, screenHeight) : m_mapView->screenToLocation(padding, screenHeight);
+  Point lowerRight = m_sceneView ? m_sceneView->screenToBaseSurface(screenWidth, screenHeight) : m_mapView->screenToLocation(screenWidth, screenHeight);
+
+  PolylineBuilder bldr(topLeft.spatialReference());
+  bldr.addPoint(topLeft);
+  bldr.addPoint(topRight);
+  bldr.addPoint(lowerRight);
+  bldr.addPoint(lowerLeft);
+  bldr.addPoint(topLeft);
+  m_viewBoundary = bldr.toPolyline();
+  m_viewBoundaryValid = true;
+
+  return m_viewBoundary;
+}
+
+/*!
+  \internal
+
+  Searches for a valid geographic position at \a x towards the top of the
+  screen (e.g. to account for the horizon).
+ */
+Point CoordinateConversionController::findValidTopPoint(double x, double screenHeight) const
+{
+  Point validTopPoint;
+  double lastValidY = screenHeight;
+  double testMinY = 1.0;
+  for (int attempt = 0; attempt < 16; ++attempt)
+  {
+    double testY = testMinY + ((lastValidY - testMinY) * 0.5);
+    auto newRes =  m_sceneView ? m_sceneView->screenToBaseSurface(x, testY) : m_mapView->screenToLocation(x, testY);
+    if (newRes.isValid() && !newRes.isEmpty())
+    {
+      validTopPoint = newRes;
+      if (std::abs(lastValidY - testY) < 1.0)
+        break;
+
+      lastValidY = testY;
+    }
+    else
+    {
+      testMinY = testY;
+    }
+  }
+
+  return validTopPoint;
+}
+
 /*!
   \brief Zooms the current \l Esri::ArcGISRuntime::GeoView to the current input position.
  */
@@ -762,6 +1850,16 @@ void CoordinateConversionController::setRunConversion(bool runConversion)
   format is removed.
  */
 
+/*!
+  \fn void CoordinateConversionController::hoverModeChanged();
+  \brief Signal emitted when the \l hoverMode property changes.
+ */
+
+/*!
+  \fn void CoordinateConversionController::trackModeChanged();
+  \brief Signal emitted when the \l trackMode property changes.
+ */
+
 /*!
   \fn void CoordinateConversionController::resultsChanged();
   \brief Signal emitted when the \l results property changes.
@@ -792,6 +1890,38 @@ void CoordinateConversionController::setRunConversion(bool runConversion)
   \brief Signal emitted when the \l captureMode property changes.
  */
 
+/*!
+  \fn void CoordinateConversionController::autoDetectInputFormatChanged();
+  \brief Signal emitted when the \l autoDetectInputFormat property changes.
+ */
+
+/*!
+  \fn void CoordinateConversionController::asynchronousChanged();
+  \brief Signal emitted when the \l asynchronous property changes.
+ */
+
+/*!
+  \fn void CoordinateConversionController::batchConversionProgress(int convertedCount, int totalCount);
+  \brief Signal emitted as a background batch conversion progresses.
+
+  \a convertedCount of the \a totalCount points have been converted.
+ */
+
+/*!
+  \fn void CoordinateConversionController::batchConversionCompleted(const QVariantMap& results);
+  \brief Signal emitted when a background batch conversion finishes or is canceled.
+
+  \a results holds the table described by \l CoordinateConversionBatchResult::toVariantMap.
+ */
+
+/*!
+  \fn void CoordinateConversionController::fileConversionCompleted(qint64 pointCount, bool canceled, const QString& errorString);
+  \brief Signal emitted when a background file conversion finishes, fails or is canceled.
+
+  \a pointCount points were written. \a errorString describes why the
+  conversion failed, and is empty if it succeeded or was \a canceled.
+ */
+
 } // Toolkit
 } // ArcGISRuntime
 } // Esri
@@ -0,0 +1,1503 @@
+/*******************************************************************************
+ *  Copyright 2012-2018 Esri
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ******************************************************************************/
+
+#include "CoordinateConversionEngine.h"
+
+// toolkit headers
+#include "CoordinateConversionConstants.h"
+#include "CoordinateFormatFactory.h"
+#include "CoordinateFormatRegistry.h"
+#include "GarsCodec.h"
+#include "GeocentricConversion.h"
+#include "GeohashCodec.h"
+#include "GeorefCodec.h"
+#include "LatitudeLongitudeFormatter.h"
+#include "NotationRecognizer.h"
+#include "OpenLocationCodec.h"
+#include "S2CellCodec.h"
+#include "TransverseMercatorGrid.h"
+
+// C++ API headers
+#include "CoordinateFormatter.h"
+#include "GeometryEngine.h"
+#include "PolygonBuilder.h"
+
+// Qt headers
+#include <QtConcurrentMap>
+
+// STL headers
+#include <cstdint>
+#include <limits>
+
+/*!
+  \class Esri::ArcGISRuntime::Toolkit::CoordinateConversionEngine
+  \ingroup ToolCoordinateConversion
+  \inmodule ArcGISQtToolkit
+  \since Esri::ArcGISRuntime 100.4
+  \brief Converts between points and coordinate notations without a
+  QObject, GeoView or QML engine.
+
+  The engine holds a set of \l CoordinateFormatOption values, the input
+  format and the spatial reference that notations are decoded into, and
+  converts points and notations with them. It is what
+  \l CoordinateConversionController uses underneath, and it can be used on
+  its own by services and command line tools.
+
+  Conversions use the native codecs once they have produced the same
+  results as \c CoordinateFormatter, and \c CoordinateFormatter otherwise.
+  Every const method may be called from several threads at once, as long
+  as the option set and settings are not modified in the meantime.
+
+  \sa CoordinateConversionController
+ */
+
+namespace Esri
+{
+namespace ArcGISRuntime
+{
+namespace Toolkit
+{
+
+constexpr int CoordinateConversionEngine::batchChunkSize;
+
+namespace
+{
+
+// one native latitude-longitude gate key per style and decimal places setting
+constexpr int latLonDecimalPlacesCount = 17;
+constexpr int latLonGateKeyCount = 3 * latLonDecimalPlacesCount;
+
+// native grid gate keys: one per combination of the arguments passed to CoordinateFormatter
+constexpr int mgrsModeCount = 5;
+constexpr int gridPrecisionCount = TransverseMercatorGrid::maximumMgrsPrecision + 1;
+constexpr int mgrsEncodeKeys = 0;
+constexpr int usngEncodeKeys = mgrsEncodeKeys + mgrsModeCount * gridPrecisionCount * 2;
+constexpr int utmEncodeKeys = usngEncodeKeys + gridPrecisionCount * 2;
+constexpr int mgrsDecodeKeys = utmEncodeKeys + 2 * 2;
+constexpr int usngDecodeKey = mgrsDecodeKeys + mgrsModeCount;
+constexpr int utmDecodeKeys = usngDecodeKey + 1;
+constexpr int gridGateKeyCount = utmDecodeKeys + 2;
+
+// native GARS and GEOREF gate keys
+constexpr int garsEncodeKey = 0;
+constexpr int georefEncodeKeys = garsEncodeKey + 1;
+constexpr int garsDecodeKeys = georefEncodeKeys + GeorefCodec::maximumPrecision + 1;
+constexpr int georefDecodeKey = garsDecodeKeys + 2;
+constexpr int cellGateKeyCount = georefDecodeKey + 1;
+
+int mgrsModeIndex(MgrsConversionMode mode)
+{
+  switch (mode)
+  {
+  case MgrsConversionMode::New180InZone01:
+    return 1;
+  case MgrsConversionMode::New180InZone60:
+    return 2;
+  case MgrsConversionMode::Old180InZone01:
+    return 3;
+  case MgrsConversionMode::Old180InZone60:
+    return 4;
+  default:
+    return 0;
+  }
+}
+
+// Automatic follows the datum of the spatial reference; the native grid only
+// handles WGS 84 based references, for which it means 180 in zone 60
+bool mgrsZone60At180(MgrsConversionMode mode)
+{
+  return mode != MgrsConversionMode::New180InZone01 && mode != MgrsConversionMode::Old180InZone01;
+}
+
+TransverseMercatorGrid::ZoneIndicator utmZoneIndicator(UtmConversionMode mode)
+{
+  return mode == UtmConversionMode::NorthSouthIndicators ?
+        TransverseMercatorGrid::ZoneIndicator::Hemisphere : TransverseMercatorGrid::ZoneIndicator::LatitudeBand;
+}
+
+int gridPrecision(const CoordinateFormatOption& option)
+{
+  // the controller passes decimalPlaces as the MGRS precision
+  return option.outputMode() == CoordinateConversionOptions::CoordinateTypeMgrs ? option.decimalPlaces() : option.precision();
+}
+
+bool gridAddSpaces(const CoordinateFormatOption& option)
+{
+  return option.outputMode() == CoordinateConversionOptions::CoordinateTypeUsng ? option.decimalPlaces() != 0 : option.addSpaces();
+}
+
+// the grid gate key of the arguments CoordinateFormatter is called with; -1 if there is none
+int gridEncodeKey(const CoordinateFormatOption& option)
+{
+  const int precision = gridPrecision(option);
+  const int spacesIndex = gridAddSpaces(option) ? 1 : 0;
+  if (option.outputMode() == CoordinateConversionOptions::CoordinateTypeUtm)
+    return utmEncodeKeys + static_cast<int>(utmZoneIndicator(option.utmConversionMode())) * 2 + spacesIndex;
+  else if (precision < 0 || precision >= gridPrecisionCount)
+    return -1;
+  else if (option.outputMode() == CoordinateConversionOptions::CoordinateTypeMgrs)
+    return mgrsEncodeKeys + mgrsModeIndex(option.mgrsConversionMode()) * gridPrecisionCount * 2 + precision * 2 + spacesIndex;
+
+  return usngEncodeKeys + precision * 2 + spacesIndex;
+}
+
+bool gridZone60At180(const CoordinateFormatOption& option)
+{
+  return option.outputMode() != CoordinateConversionOptions::CoordinateTypeMgrs || mgrsZone60At180(option.mgrsConversionMode());
+}
+
+// writes the native notation of a grid position; 0 if it has none
+int formatGridPosition(const CoordinateFormatOption& option, const TransverseMercatorGrid::GridPosition& position, char* buffer)
+{
+  if (option.outputMode() == CoordinateConversionOptions::CoordinateTypeUtm)
+    return TransverseMercatorGrid::formatUtm(position, utmZoneIndicator(option.utmConversionMode()), gridAddSpaces(option), buffer);
+
+  const TransverseMercatorGrid::LetteringScheme scheme = option.outputMode() == CoordinateConversionOptions::CoordinateTypeMgrs ?
+        NativeConversionSupport::mgrsLetteringScheme(option.mgrsConversionMode()) : TransverseMercatorGrid::LetteringScheme::New;
+  return TransverseMercatorGrid::formatMgrs(position, scheme, gridPrecision(option), gridAddSpaces(option), buffer);
+}
+
+// the cell gate key of a GARS or GEOREF option; -1 if the native codecs do not support it
+int cellEncodeKey(const CoordinateFormatOption& option)
+{
+  if (option.outputMode() == CoordinateConversionOptions::CoordinateTypeGars)
+    return garsEncodeKey;
+
+  const int precision = option.precision();
+  return precision >= 0 && precision <= GeorefCodec::maximumPrecision ? georefEncodeKeys + precision : -1;
+}
+
+// returns the native notation once the gate trusts it in the point's region, otherwise the SDK's
+template <typename SdkConversion>
+QString checkedNotation(const NativeConversionGate& gate, int key, int region, const char* buffer, int length,
+                        SdkConversion sdkConversion)
+{
+  if (length <= 0)
+    return sdkConversion();
+
+  if (gate.isTrusted(key, region))
+    return QString::fromLatin1(buffer, length);
+
+  const QString notation = sdkConversion();
+  gate.recordComparison(key, region, notation == QLatin1String(buffer, length));
+  return notation;
+}
+
+// returns the natively decoded point once the gate trusts it in the point's region, otherwise the SDK's
+template <typename SdkConversion>
+Point checkedPoint(const NativeConversionGate& gate, int key, int region, bool decoded, const Point& nativePoint,
+                   SdkConversion sdkConversion)
+{
+  if (!decoded)
+    return sdkConversion();
+
+  if (gate.isTrusted(key, region))
+    return nativePoint;
+
+  const Point point = sdkConversion();
+  gate.recordComparison(key, region, NativeConversionSupport::sameLocation(point, nativePoint));
+  return point;
+}
+
+// the MGRS, USNG or UTM notation CoordinateFormatter writes for option
+QString sdkGridNotation(const CoordinateFormatOption& option, const Point& point)
+{
+  if (option.outputMode() == CoordinateConversionOptions::CoordinateTypeMgrs)
+    return CoordinateFormatter::toMgrs(point, option.mgrsConversionMode(), gridPrecision(option), gridAddSpaces(option));
+  else if (option.outputMode() == CoordinateConversionOptions::CoordinateTypeUsng)
+    return CoordinateFormatter::toUsng(point, gridPrecision(option), gridAddSpaces(option));
+
+  return CoordinateFormatter::toUtm(point, option.utmConversionMode(), gridAddSpaces(option));
+}
+
+// the GARS or GEOREF notation CoordinateFormatter writes for option
+QString sdkCellNotation(const CoordinateFormatOption& option, const Point& point)
+{
+  if (option.outputMode() == CoordinateConversionOptions::CoordinateTypeGars)
+    return CoordinateFormatter::toGars(point);
+
+  return CoordinateFormatter::toGeoRef(point, option.precision());
+}
+
+const QString& notationFormatName(NotationRecognizer::Notation notation)
+{
+  switch (notation)
+  {
+  case NotationRecognizer::Notation::DegreesDecimalMinutes:
+    return CoordinateConversionConstants::DEGREES_DECIMAL_MINUTES_FORMAT;
+  case NotationRecognizer::Notation::DegreesMinutesSeconds:
+    return CoordinateConversionConstants::DEGREES_MINUTES_SECONDS_FORMAT;
+  case NotationRecognizer::Notation::Mgrs:
+    return CoordinateConversionConstants::MGRS_FORMAT;
+  case NotationRecognizer::Notation::Usng:
+    return CoordinateConversionConstants::USNG_FORMAT;
+  case NotationRecognizer::Notation::Utm:
+    return CoordinateConversionConstants::UTM_FORMAT;
+  case NotationRecognizer::Notation::Gars:
+    return CoordinateConversionConstants::GARS_FORMAT;
+  case NotationRecognizer::Notation::GeoRef:
+    return CoordinateConversionConstants::GEOREF_FORMAT;
+  default:
+    return CoordinateConversionConstants::DECIMAL_DEGREES_FORMAT;
+  }
+}
+
+CoordinateConversionOptions::CoordinateType notationCoordinateType(NotationRecognizer::Notation notation)
+{
+  switch (notation)
+  {
+  case NotationRecognizer::Notation::Mgrs:
+    return CoordinateConversionOptions::CoordinateTypeMgrs;
+  case NotationRecognizer::Notation::Usng:
+    return CoordinateConversionOptions::CoordinateTypeUsng;
+  case NotationRecognizer::Notation::Utm:
+    return CoordinateConversionOptions::CoordinateTypeUtm;
+  case NotationRecognizer::Notation::Gars:
+    return CoordinateConversionOptions::CoordinateTypeGars;
+  case NotationRecognizer::Notation::GeoRef:
+    return CoordinateConversionOptions::CoordinateTypeGeoRef;
+  default:
+    return CoordinateConversionOptions::CoordinateTypeLatLon;
+  }
+}
+
+// the option used to decode a detected notation when none of the options match it
+CoordinateFormatOption detectionOption(NotationRecognizer::Notation notation, const CoordinateFormatDefaults& formatDefaults)
+{
+  CoordinateFormatOption option = CoordinateFormatFactory::createFormatOption(notationFormatName(notation), formatDefaults);
+  if (option.isValid())
+    return option;
+
+  option.setName(notationFormatName(notation));
+  option.setOutputMode(notationCoordinateType(notation));
+  return option;
+}
+
+bool isGeocentric(const CoordinateFormatOption& option)
+{
+  return option.outputMode() == CoordinateConversionOptions::CoordinateTypeEcef ||
+      option.outputMode() == CoordinateConversionOptions::CoordinateTypeEnu;
+}
+
+// geohashes and Open Location Codes
+bool isGeocode(const CoordinateFormatOption& option)
+{
+  return option.outputMode() == CoordinateConversionOptions::CoordinateTypeGeohash ||
+      option.outputMode() == CoordinateConversionOptions::CoordinateTypeOpenLocationCode;
+}
+
+// MGRS, USNG and UTM
+bool isGrid(const CoordinateFormatOption& option)
+{
+  return option.outputMode() == CoordinateConversionOptions::CoordinateTypeMgrs ||
+      option.outputMode() == CoordinateConversionOptions::CoordinateTypeUsng ||
+      option.outputMode() == CoordinateConversionOptions::CoordinateTypeUtm;
+}
+
+GeocentricConversion::EnuFrame enuFrame(const CoordinateFormatOption& option)
+{
+  return GeocentricConversion::enuFrame(option.enuOriginLatitude(), option.enuOriginLongitude(), option.enuOriginHeight());
+}
+
+// the id written in notation in the style of option
+bool parseCellId(const CoordinateFormatOption& option, const QString& notation, std::uint64_t& id)
+{
+  char buffer[2 * S2CellCodec::bufferSize];
+  const int length = NativeConversionSupport::toLatin1(notation, buffer, 2 * S2CellCodec::bufferSize);
+  if (length <= 0)
+    return false;
+
+  return option.cellIdNotation() == CoordinateConversionOptions::CellIdInteger ?
+        S2CellCodec::parseInteger(buffer, length, id) : S2CellCodec::parseToken(buffer, length, id);
+}
+
+QString formatCellId(const CoordinateFormatOption& option, std::uint64_t id)
+{
+  char buffer[S2CellCodec::bufferSize];
+  const int length = option.cellIdNotation() == CoordinateConversionOptions::CellIdInteger ?
+        S2CellCodec::formatInteger(id, buffer) : S2CellCodec::formatToken(id, buffer);
+  return QString::fromLatin1(buffer, length);
+}
+
+// the point at latitude and longitude in spatialReference
+Point geographicPoint(double latitude, double longitude, const SpatialReference& spatialReference)
+{
+  Point point;
+  if (NativeConversionSupport::fromGeographic(latitude, longitude, spatialReference, point))
+    return point;
+
+  return Point(GeometryEngine::project(Point(longitude, latitude, SpatialReference::wgs84()), spatialReference));
+}
+
+// the WGS 84 position of point, with its z value as the ellipsoidal height
+bool geodeticPosition(const Point& point, double& latitude, double& longitude, double& height)
+{
+  if (point.isEmpty())
+    return false;
+
+  if (!NativeConversionSupport::toGeographic(point, latitude, longitude))
+  {
+    const Point projected(GeometryEngine::project(point, SpatialReference::wgs84()));
+    if (projected.isEmpty())
+      return false;
+
+    latitude = projected.y();
+    longitude = projected.x();
+  }
+
+  height = point.hasZ() ? point.z() : 0.0;
+  return true;
+}
+
+// runs the recognizer over notation, mapping typographic minute and second marks to their ASCII forms
+int recognizeNotation(const QString& notation, NotationRecognizer::Candidate* candidates)
+{
+  QByteArray text;
+  text.reserve(notation.size());
+  for (const QChar character : notation)
+  {
+    const ushort unicode = character.unicode();
+    if (unicode == 0x2032 || unicode == 0x2019)
+      text.append('\'');
+    else if (unicode == 0x2033 || unicode == 0x201d)
+      text.append('"');
+    else if (unicode <= 0xff)
+      text.append(static_cast<char>(unicode));
+    else
+      return 0;
+  }
+
+  return NotationRecognizer::recognize(text.constData(), text.size(), candidates);
+}
+
+} // namespace
+
+/*!
+  \brief Constructs an engine with no options, taking the format defaults
+  from \l CoordinateFormatFactory::defaults().
+ */
+CoordinateConversionEngine::CoordinateConversionEngine() :
+  CoordinateConversionEngine(CoordinateFormatFactory::defaults())
+{
+}
+
+/*!
+  \brief Constructs an engine with no options and the given \a formatDefaults.
+ */
+CoordinateConversionEngine::CoordinateConversionEngine(const CoordinateFormatDefaults& formatDefaults) :
+  m_formatDefaults(formatDefaults),
+  m_latLonGate(latLonGateKeyCount),
+  m_gridGate(gridGateKeyCount),
+  m_cellGate(cellGateKeyCount)
+{
+}
+
+/*!
+  \brief The destructor.
+ */
+CoordinateConversionEngine::~CoordinateConversionEngine()
+{
+}
+
+/*!
+  \brief Returns the options, in the order their notations are produced.
+ */
+QList<CoordinateFormatOption> CoordinateConversionEngine::options() const
+{
+  return m_options;
+}
+
+/*!
+  \brief Sets the options to \a options.
+ */
+void CoordinateConversionEngine::setOptions(const QList<CoordinateFormatOption>& options)
+{
+  m_options = options;
+}
+
+/*!
+  \brief Appends \a option to the options.
+ */
+void CoordinateConversionEngine::addOption(const CoordinateFormatOption& option)
+{
+  m_options.append(option);
+}
+
+/*!
+  \brief Removes every option.
+ */
+void CoordinateConversionEngine::clearOptions()
+{
+  m_options.clear();
+}
+
+/*!
+  \brief Returns the name of the format notations are decoded from.
+ */
+QString CoordinateConversionEngine::inputFormat() const
+{
+  return m_inputFormat;
+}
+
+/*!
+  \brief Sets the name of the format notations are decoded from to
+  \a inputFormat.
+
+  Notations are decoded with the first option of that format.
+ */
+void CoordinateConversionEngine::setInputFormat(const QString& inputFormat)
+{
+  m_inputFormat = inputFormat;
+  m_inputFormatId = CoordinateFormatRegistry::formatId(inputFormat);
+}
+
+/*!
+  \brief Returns the first option of the \l inputFormat, or an invalid
+  option if there is none.
+ */
+CoordinateFormatOption CoordinateConversionEngine::inputOption() const
+{
+  for (const CoordinateFormatOption& option : m_options)
+  {
+    if (option.formatId() == m_inputFormatId)
+      return option;
+  }
+
+  return CoordinateFormatOption();
+}
+
+/*!
+  \brief Returns whether notations are decoded in the format recognized
+  from their text rather than the \l inputFormat.
+ */
+bool CoordinateConversionEngine::autoDetectInputFormat() const
+{
+  return m_autoDetectInputFormat;
+}
+
+/*!
+  \brief Sets whether notations are decoded in the format recognized from
+  their text to \a autoDetectInputFormat.
+ */
+void CoordinateConversionEngine::setAutoDetectInputFormat(bool autoDetectInputFormat)
+{
+  m_autoDetectInputFormat = autoDetectInputFormat;
+}
+
+/*!
+  \brief Returns the spatial reference notations are decoded into.
+ */
+SpatialReference CoordinateConversionEngine::spatialReference() const
+{
+  return m_spatialReference;
+}
+
+/*!
+  \brief Sets the spatial reference notations are decoded into to
+  \a spatialReference.
+ */
+void CoordinateConversionEngine::setSpatialReference(const SpatialReference& spatialReference)
+{
+  m_spatialReference = spatialReference;
+}
+
+/*!
+  \brief Returns the settings of the options used to decode recognized
+  notations of a format with no option.
+ */
+CoordinateFormatDefaults CoordinateConversionEngine::formatDefaults() const
+{
+  return m_formatDefaults;
+}
+
+/*!
+  \brief Sets the settings of the options used to decode recognized
+  notations of a format with no option to \a formatDefaults.
+ */
+void CoordinateConversionEngine::setFormatDefaults(const CoordinateFormatDefaults& formatDefaults)
+{
+  m_formatDefaults = formatDefaults;
+}
+
+/*!
+  \brief Returns the notation of \a point for each of the options, in order.
+ */
+QStringList CoordinateConversionEngine::convertPoint(const Point& point) const
+{
+  QStringList notations;
+  notations.reserve(m_options.size());
+  for (const CoordinateFormatOption& option : m_options)
+    notations.append(convert(option, point));
+
+  return notations;
+}
+
+/*!
+  \brief Decodes \a notation into the \l spatialReference, in the
+  \l inputFormat or the recognized format when \l autoDetectInputFormat is
+  set.
+
+  Returns an empty point if \a notation cannot be decoded.
+ */
+Point CoordinateConversionEngine::pointFromNotation(const QString& notation) const
+{
+  if (m_autoDetectInputFormat)
+    return detectedPointFromNotation(notation, m_options, m_formatDefaults, m_spatialReference);
+
+  const CoordinateFormatOption input = inputOption();
+  if (!input.isValid())
+    return Point();
+
+  return pointFromNotation(input, notation, m_spatialReference);
+}
+
+/*!
+  \brief Returns the first row of each chunk of \l batchChunkSize points
+  in a batch of \a rowCount points.
+ */
+QVector<int> CoordinateConversionEngine::batchChunks(int rowCount)
+{
+  QVector<int> chunks;
+  chunks.reserve((rowCount + batchChunkSize - 1) / batchChunkSize);
+  for (int row = 0; row < rowCount; row += batchChunkSize)
+    chunks.append(row);
+
+  return chunks;
+}
+
+/*!
+  \brief Decodes \a notation, written in the format described by \a option,
+  into \a spatialReference.
+
+  Returns an empty point if \a notation cannot be decoded.
+ */
+Point CoordinateConversionEngine::pointFromNotation(const CoordinateFormatOption& option, const QString& notation,
+                                                    const SpatialReference& spatialReference) const
+{
+  switch (option.outputMode())
+  {
+  case CoordinateConversionOptions::CoordinateType::CoordinateTypeGars:
+  case CoordinateConversionOptions::CoordinateType::CoordinateTypeGeoRef:
+  {
+    return cellPointFromNotation(option, notation, spatialReference);
+  }
+  case CoordinateConversionOptions::CoordinateType::CoordinateTypeLatLon:
+  {
+    return CoordinateFormatter::fromLatitudeLongitude(notation,
+                                                      spatialReference);
+  }
+  case CoordinateConversionOptions::CoordinateType::CoordinateTypeMgrs:
+  case CoordinateConversionOptions::CoordinateType::CoordinateTypeUsng:
+  case CoordinateConversionOptions::CoordinateType::CoordinateTypeUtm:
+  {
+    return gridPointFromNotation(option, notation, spatialReference);
+  }
+  case CoordinateConversionOptions::CoordinateType::CoordinateTypeEcef:
+  case CoordinateConversionOptions::CoordinateType::CoordinateTypeEnu:
+  {
+    return geocentricPointFromNotation(option, notation, spatialReference);
+  }
+  case CoordinateConversionOptions::CoordinateType::CoordinateTypeGeohash:
+  case CoordinateConversionOptions::CoordinateType::CoordinateTypeOpenLocationCode:
+  {
+    return geocodePointFromNotation(option, notation, spatialReference);
+  }
+  case CoordinateConversionOptions::CoordinateType::CoordinateTypeCellId:
+  {
+    return cellIdPointFromNotation(option, notation, spatialReference);
+  }
+  default: {}
+  }
+
+  return Point();
+}
+
+/*!
+  \brief Recognizes the format of \a notation and decodes it into
+  \a spatialReference with the first candidate format that succeeds.
+
+  Each candidate is decoded with the first of \a options of the same type,
+  so that settings such as the MGRS or GARS conversion mode are respected,
+  or with an option created from \a formatDefaults when there is none.
+ */
+Point CoordinateConversionEngine::detectedPointFromNotation(const QString& notation,
+                                                            const QList<CoordinateFormatOption>& options,
+                                                            const CoordinateFormatDefaults& formatDefaults,
+                                                            const SpatialReference& spatialReference) const
+{
+  NotationRecognizer::Candidate candidates[NotationRecognizer::notationCount];
+  const int candidateCount = recognizeNotation(notation, candidates);
+  for (int i = 0; i < candidateCount; ++i)
+  {
+    const CoordinateFormatOption::CoordinateType type = notationCoordinateType(candidates[i].notation);
+    const CoordinateFormatOption* option = nullptr;
+    for (const CoordinateFormatOption& candidateOption : options)
+    {
+      if (candidateOption.outputMode() == type)
+      {
+        option = &candidateOption;
+        break;
+      }
+    }
+
+    const Point point = option ? pointFromNotation(*option, notation, spatialReference) :
+                                 pointFromNotation(detectionOption(candidates[i].notation, formatDefaults), notation, spatialReference);
+    if (!point.isEmpty())
+      return point;
+  }
+
+  return Point();
+}
+
+/*!
+  \brief Returns the names of the formats \a notation could be written in,
+  most likely first.
+
+  The list is empty if \a notation does not look like any supported format.
+  More than one name is returned for ambiguous notations, such as MGRS and
+  USNG which share a syntax.
+ */
+QStringList CoordinateConversionEngine::detectFormats(const QString& notation) const
+{
+  NotationRecognizer::Candidate candidates[NotationRecognizer::notationCount];
+  const int candidateCount = recognizeNotation(notation, candidates);
+
+  QStringList formats;
+  formats.reserve(candidateCount);
+  for (int i = 0; i < candidateCount; ++i)
+    formats.append(notationFormatName(candidates[i].notation));
+
+  return formats;
+}
+
+/*!
+  \brief Returns the notation of \a point in the format described by
+  \a option, or an empty string if it cannot be converted.
+ */
+QString CoordinateConversionEngine::convert(const CoordinateFormatOption& option, const Point& point) const
+{
+  switch (option.outputMode())
+  {
+  case CoordinateConversionOptions::CoordinateType::CoordinateTypeGars:
+  case CoordinateConversionOptions::CoordinateType::CoordinateTypeGeoRef:
+  {
+    return toCellNotation(option, point);
+  }
+  case CoordinateConversionOptions::CoordinateType::CoordinateTypeLatLon:
+  {
+    return toLatitudeLongitude(option, point);
+  }
+  case CoordinateConversionOptions::CoordinateType::CoordinateTypeMgrs:
+  case CoordinateConversionOptions::CoordinateType::CoordinateTypeUsng:
+  case CoordinateConversionOptions::CoordinateType::CoordinateTypeUtm:
+  {
+    return toGridNotation(option, point);
+  }
+  case CoordinateConversionOptions::CoordinateType::CoordinateTypeEcef:
+  case CoordinateConversionOptions::CoordinateType::CoordinateTypeEnu:
+  {
+    return toGeocentricNotation(option, point);
+  }
+  case CoordinateConversionOptions::CoordinateType::CoordinateTypeGeohash:
+  case CoordinateConversionOptions::CoordinateType::CoordinateTypeOpenLocationCode:
+  {
+    return toGeocodeNotation(option, point);
+  }
+  case CoordinateConversionOptions::CoordinateType::CoordinateTypeCellId:
+  {
+    return toCellIdNotation(option, point);
+  }
+  default: {}
+  }
+
+  return QString();
+}
+
+/*!
+  \internal
+
+  Formats \a point as a latitude-longitude notation using \a option.
+
+  The native \l LatitudeLongitudeFormatter is used for WGS 84 and Web Mercator
+  points once it has produced output identical to
+  \c CoordinateFormatter::toLatitudeLongitude for the option's format and
+  decimal places. Until then both are run and the SDK result is returned.
+ */
+QString CoordinateConversionEngine::toLatitudeLongitude(const CoordinateFormatOption& option, const Point& point) const
+{
+  const auto format = static_cast<Esri::ArcGISRuntime::LatitudeLongitudeFormat>(option.latLonFormat());
+  const int decimalPlaces = option.decimalPlaces();
+
+  LatitudeLongitudeFormatter::Style style = LatitudeLongitudeFormatter::Style::DecimalDegrees;
+  switch (format)
+  {
+  case LatitudeLongitudeFormat::DegreesDecimalMinutes:
+    style = LatitudeLongitudeFormatter::Style::DegreesDecimalMinutes;
+    break;
+  case LatitudeLongitudeFormat::DegreesMinutesSeconds:
+    style = LatitudeLongitudeFormatter::Style::DegreesMinutesSeconds;
+    break;
+  default:
+    break;
+  }
+
+  const int gateKey = static_cast<int>(style) * latLonDecimalPlacesCount + decimalPlaces;
+  double latitude = 0.0;
+  double longitude = 0.0;
+  if (m_latLonGate.isRejected(gateKey) ||
+      !LatitudeLongitudeFormatter::supports(style, decimalPlaces) ||
+      !NativeConversionSupport::toGeographic(point, latitude, longitude))
+  {
+    return CoordinateFormatter::toLatitudeLongitude(point, format, decimalPlaces);
+  }
+
+  char buffer[LatitudeLongitudeFormatter::bufferSize];
+  const int length = LatitudeLongitudeFormatter::format(latitude, longitude, style, decimalPlaces, buffer);
+  return checkedNotation(m_latLonGate, gateKey, NativeConversionGate::regionAt(latitude, longitude), buffer, length,
+                         [&point, format, decimalPlaces]()
+  {
+    return CoordinateFormatter::toLatitudeLongitude(point, format, decimalPlaces);
+  });
+}
+
+/*!
+  \internal
+
+  Formats \a point as an MGRS, USNG or UTM notation using \a option.
+
+  The arguments given to \c CoordinateFormatter are unchanged; the native
+  \l TransverseMercatorGrid takes over for WGS 84 and Web Mercator points
+  within the UTM latitude limits once its output has matched the SDK's for
+  those arguments.
+ */
+QString CoordinateConversionEngine::toGridNotation(const CoordinateFormatOption& option, const Point& point) const
+{
+  auto sdkConversion = [&option, &point]()
+  {
+    return sdkGridNotation(option, point);
+  };
+
+  const int gateKey = gridEncodeKey(option);
+  double latitude = 0.0;
+  double longitude = 0.0;
+  TransverseMercatorGrid::GridPosition position;
+  if (m_gridGate.isRejected(gateKey) ||
+      !NativeConversionSupport::toGeographic(point, latitude, longitude) ||
+      !TransverseMercatorGrid::toGridPosition(latitude, longitude, gridZone60At180(option), position))
+  {
+    return sdkConversion();
+  }
+
+  char buffer[TransverseMercatorGrid::bufferSize];
+  const int length = formatGridPosition(option, position, buffer);
+
+  return checkedNotation(m_gridGate, gateKey, NativeConversionGate::regionAt(latitude, longitude), buffer, length,
+                         sdkConversion);
+}
+
+/*!
+  \internal
+
+  Converts the points from \a firstRow up to \a lastRow to MGRS, USNG or
+  UTM using \a option. The whole chunk is projected with
+  \l TransverseMercatorGrid::toGridPositions; the native notation is used
+  for the points in regions where the gate has verified the option's key,
+  except that the first of them is also converted by the SDK and compared.
+  Every other point goes through \c toGridNotation.
+ */
+void CoordinateConversionEngine::convertGridChunk(const CoordinateFormatOption& option, const QList<Point>& points,
+                                                  int firstRow, int lastRow, QString* notations) const
+{
+  const int gateKey = gridEncodeKey(option);
+  if (m_gridGate.isRejected(gateKey))
+  {
+    for (int row = firstRow; row < lastRow; ++row)
+      notations[row] = toGridNotation(option, points.at(row));
+
+    return;
+  }
+
+  double latitudes[batchChunkSize];
+  double longitudes[batchChunkSize];
+  bool valid[batchChunkSize];
+  const int count = lastRow - firstRow;
+  for (int i = 0; i < count; ++i)
+  {
+    valid[i] = NativeConversionSupport::toGeographic(points.at(firstRow + i), latitudes[i], longitudes[i]);
+    if (!valid[i])
+      latitudes[i] = longitudes[i] = 0.0;
+  }
+
+  TransverseMercatorGrid::GridPosition positions[batchChunkSize];
+  TransverseMercatorGrid::toGridPositions(latitudes, longitudes, count, gridZone60At180(option), positions);
+
+  // points outside the UTM limits, in other references or in unverified
+  // regions are left to toGridNotation
+  char buffer[TransverseMercatorGrid::bufferSize];
+  bool compared = false;
+  for (int i = 0; i < count; ++i)
+  {
+    const Point& point = points.at(firstRow + i);
+    const int length = valid[i] ? formatGridPosition(option, positions[i], buffer) : 0;
+    const int region = NativeConversionGate::regionAt(latitudes[i], longitudes[i]);
+    if (length <= 0 || !m_gridGate.isVerified(gateKey, region))
+    {
+      notations[firstRow + i] = toGridNotation(option, point);
+    }
+    else if (!compared)
+    {
+      compared = true;
+      notations[firstRow + i] = sdkGridNotation(option, point);
+      m_gridGate.recordComparison(gateKey, region, notations[firstRow + i] == QLatin1String(buffer, length));
+    }
+    else
+    {
+      notations[firstRow + i] = QString::fromLatin1(buffer, length);
+    }
+  }
+}
+
+/*!
+  \internal
+
+  Decodes the MGRS, USNG or UTM \a notation described by \a option into the
+  \a spatialReference, using the native \l TransverseMercatorGrid once it
+  has agreed with \c CoordinateFormatter.
+ */
+Point CoordinateConversionEngine::gridPointFromNotation(const CoordinateFormatOption& option, const QString& notation,
+                                                        const SpatialReference& spatialReference) const
+{
+  const CoordinateFormatOption::CoordinateType type = option.outputMode();
+  const MgrsConversionMode mgrsMode = option.mgrsConversionMode();
+  const UtmConversionMode utmMode = option.utmConversionMode();
+
+  auto sdkConversion = [type, &notation, &spatialReference, mgrsMode, utmMode]() -> Point
+  {
+    if (type == CoordinateConversionOptions::CoordinateTypeMgrs)
+      return CoordinateFormatter::fromMgrs(notation, spatialReference, mgrsMode);
+    else if (type == CoordinateConversionOptions::CoordinateTypeUsng)
+      return CoordinateFormatter::fromUsng(notation, spatialReference);
+
+    return CoordinateFormatter::fromUtm(notation, spatialReference, utmMode);
+  };
+
+  int gateKey = usngDecodeKey;
+  if (type == CoordinateConversionOptions::CoordinateTypeMgrs)
+    gateKey = mgrsDecodeKeys + mgrsModeIndex(mgrsMode);
+  else if (type == CoordinateConversionOptions::CoordinateTypeUtm)
+    gateKey = utmDecodeKeys + static_cast<int>(utmZoneIndicator(utmMode));
+
+  char buffer[TransverseMercatorGrid::bufferSize];
+  const int length = NativeConversionSupport::toLatin1(notation, buffer, TransverseMercatorGrid::bufferSize);
+  if (m_gridGate.isRejected(gateKey) || length <= 0)
+    return sdkConversion();
+
+  TransverseMercatorGrid::GridPosition position;
+  const TransverseMercatorGrid::LetteringScheme scheme = type == CoordinateConversionOptions::CoordinateTypeMgrs ?
+        NativeConversionSupport::mgrsLetteringScheme(mgrsMode) : TransverseMercatorGrid::LetteringScheme::New;
+  const bool parsed = type == CoordinateConversionOptions::CoordinateTypeUtm ?
+        TransverseMercatorGrid::parseUtm(buffer, length, utmZoneIndicator(utmMode), position) :
+        TransverseMercatorGrid::parseMgrs(buffer, length, scheme, position);
+
+  double latitude = 0.0;
+  double longitude = 0.0;
+  Point nativePoint;
+  const bool decoded = parsed &&
+      TransverseMercatorGrid::fromGridPosition(position, latitude, longitude) &&
+      NativeConversionSupport::fromGeographic(latitude, longitude, spatialReference, nativePoint);
+
+  return checkedPoint(m_gridGate, gateKey, NativeConversionGate::regionAt(latitude, longitude), decoded, nativePoint,
+                      sdkConversion);
+}
+
+/*!
+  \internal
+
+  Formats \a point as a GARS or GEOREF notation using \a option, with the
+  native \l GarsCodec or \l GeorefCodec once it has matched
+  \c CoordinateFormatter for the option's precision.
+ */
+QString CoordinateConversionEngine::toCellNotation(const CoordinateFormatOption& option, const Point& point) const
+{
+  const bool gars = option.outputMode() == CoordinateConversionOptions::CoordinateTypeGars;
+  const int precision = option.precision();
+
+  auto sdkConversion = [&option, &point]()
+  {
+    return sdkCellNotation(option, point);
+  };
+
+  const int gateKey = cellEncodeKey(option);
+  double latitude = 0.0;
+  double longitude = 0.0;
+  if (m_cellGate.isRejected(gateKey) ||
+      !NativeConversionSupport::toGeographic(point, latitude, longitude))
+  {
+    return sdkConversion();
+  }
+
+  char buffer[GeorefCodec::bufferSize];
+  const int length = gars ? GarsCodec::encode(latitude, longitude, buffer) :
+                            GeorefCodec::encode(latitude, longitude, precision, buffer);
+
+  return checkedNotation(m_cellGate, gateKey, NativeConversionGate::regionAt(latitude, longitude), buffer, length,
+                         sdkConversion);
+}
+
+/*!
+  \internal
+
+  Converts the points from \a firstRow up to \a lastRow to GARS or GEOREF
+  using \a option. The whole chunk is written by the batch encoders of the
+  native codecs; their notation is used for the points in regions where
+  the gate has verified the option's key, except that the first of them is
+  also converted by the SDK and compared. Every other point goes through
+  \c toCellNotation.
+ */
+void CoordinateConversionEngine::convertCellChunk(const CoordinateFormatOption& option, const QList<Point>& points,
+                                                  int firstRow, int lastRow, QString* notations) const
+{
+  const int gateKey = cellEncodeKey(option);
+  if (m_cellGate.isRejected(gateKey))
+  {
+    for (int row = firstRow; row < lastRow; ++row)
+      notations[row] = toCellNotation(option, points.at(row));
+
+    return;
+  }
+
+  double latitudes[batchChunkSize];
+  double longitudes[batchChunkSize];
+  const int count = lastRow - firstRow;
+  for (int i = 0; i < count; ++i)
+  {
+    if (!NativeConversionSupport::toGeographic(points.at(firstRow + i), latitudes[i], longitudes[i]))
+      latitudes[i] = longitudes[i] = std::numeric_limits<double>::quiet_NaN();
+  }
+
+  char buffer[batchChunkSize * GeorefCodec::bufferSize];
+  int length = GarsCodec::notationLength;
+  if (option.outputMode() == CoordinateConversionOptions::CoordinateTypeGars)
+    GarsCodec::encode(latitudes, longitudes, count, buffer);
+  else
+    length = GeorefCodec::encode(latitudes, longitudes, count, option.precision(), buffer);
+
+  // invalid points are written as spaces
+  bool compared = false;
+  for (int i = 0; i < count; ++i)
+  {
+    const Point& point = points.at(firstRow + i);
+    const char* notation = buffer + i * length;
+    const int region = NativeConversionGate::regionAt(latitudes[i], longitudes[i]);
+    if (notation[0] == ' ' || !m_cellGate.isVerified(gateKey, region))
+    {
+      notations[firstRow + i] = toCellNotation(option, point);
+    }
+    else if (!compared)
+    {
+      compared = true;
+      notations[firstRow + i] = sdkCellNotation(option, point);
+      m_cellGate.recordComparison(gateKey, region, notations[firstRow + i] == QLatin1String(notation, length));
+    }
+    else
+    {
+      notations[firstRow + i] = QString::fromLatin1(notation, length);
+    }
+  }
+}
+
+/*!
+  \internal
+
+  Decodes the GARS or GEOREF \a notation described by \a option into
+  \a spatialReference, using the native codecs once they have agreed with
+  \c CoordinateFormatter.
+ */
+Point CoordinateConversionEngine::cellPointFromNotation(const CoordinateFormatOption& option, const QString& notation,
+                                                        const SpatialReference& spatialReference) const
+{
+  const bool gars = option.outputMode() == CoordinateConversionOptions::CoordinateTypeGars;
+  const GarsConversionMode garsMode = option.garsConversionMode();
+
+  auto sdkConversion = [gars, &notation, &spatialReference, garsMode]() -> Point
+  {
+    if (gars)
+      return CoordinateFormatter::fromGars(notation, spatialReference, garsMode);
+
+    return CoordinateFormatter::fromGeoRef(notation, spatialReference);
+  };
+
+  const bool center = garsMode == GarsConversionMode::Center;
+  const int gateKey = gars ? garsDecodeKeys + (center ? 1 : 0) : georefDecodeKey;
+
+  char buffer[GeorefCodec::bufferSize];
+  const int length = NativeConversionSupport::toLatin1(notation, buffer, GeorefCodec::bufferSize);
+  if (m_cellGate.isRejected(gateKey) || length <= 0)
+    return sdkConversion();
+
+  double latitude = 0.0;
+  double longitude = 0.0;
+  const bool parsed = gars ?
+        GarsCodec::decode(buffer, length, center ? GarsCodec::CellPosition::Center : GarsCodec::CellPosition::LowerLeft,
+                          latitude, longitude) :
+        GeorefCodec::decode(buffer, length, latitude, longitude);
+
+  Point nativePoint;
+  const bool decoded = parsed && NativeConversionSupport::fromGeographic(latitude, longitude, spatialReference, nativePoint);
+
+  return checkedPoint(m_cellGate, gateKey, NativeConversionGate::regionAt(latitude, longitude), decoded, nativePoint,
+                      sdkConversion);
+}
+
+/*!
+  \internal
+
+  Formats \a point as an ECEF or ENU notation using \a option. There is no
+  SDK equivalent, so the native \l GeocentricConversion is always used; the
+  z value of \a point is taken as its height above the WGS 84 ellipsoid.
+ */
+QString CoordinateConversionEngine::toGeocentricNotation(const CoordinateFormatOption& option, const Point& point) const
+{
+  double latitude = 0.0;
+  double longitude = 0.0;
+  double height = 0.0;
+  if (!geodeticPosition(point, latitude, longitude, height))
+    return QString();
+
+  double x = 0.0;
+  double y = 0.0;
+  double z = 0.0;
+  GeocentricConversion::toEcef(latitude, longitude, height, x, y, z);
+  if (option.outputMode() == CoordinateConversionOptions::CoordinateTypeEnu)
+    GeocentricConversion::toEnu(enuFrame(option), x, y, z, x, y, z);
+
+  char buffer[GeocentricConversion::bufferSize];
+  const int length = GeocentricConversion::format(x, y, z, option.decimalPlaces(), option.addSpaces(), buffer);
+  return length > 0 ? QString::fromLatin1(buffer, length) : QString();
+}
+
+/*!
+  \internal
+
+  Decodes the ECEF or ENU \a notation described by \a option into
+  \a spatialReference, keeping the height as the z value of the point.
+ */
+Point CoordinateConversionEngine::geocentricPointFromNotation(const CoordinateFormatOption& option, const QString& notation,
+                                                              const SpatialReference& spatialReference) const
+{
+  char buffer[GeocentricConversion::bufferSize];
+  const int length = NativeConversionSupport::toLatin1(notation, buffer, GeocentricConversion::bufferSize);
+  double x = 0.0;
+  double y = 0.0;
+  double z = 0.0;
+  if (length <= 0 || !GeocentricConversion::parse(buffer, length, x, y, z))
+    return Point();
+
+  if (option.outputMode() == CoordinateConversionOptions::CoordinateTypeEnu)
+    GeocentricConversion::fromEnu(enuFrame(option), x, y, z, x, y, z);
+
+  double latitude = 0.0;
+  double longitude = 0.0;
+  double height = 0.0;
+  GeocentricConversion::fromEcef(x, y, z, latitude, longitude, height);
+
+  Point point;
+  if (NativeConversionSupport::fromGeographic(latitude, longitude, spatialReference, point))
+    return Point(point.x(), point.y(), height, spatialReference);
+
+  return Point(GeometryEngine::project(Point(longitude, latitude, height, SpatialReference::wgs84()), spatialReference));
+}
+
+/*!
+  \internal
+
+  Converts the points from \a firstRow up to \a lastRow to ECEF or ENU
+  notations using \a option. The positions are gathered into arrays first so
+  that the batch transforms of \l GeocentricConversion run over the whole
+  chunk at once; points which cannot be converted are left empty.
+ */
+void CoordinateConversionEngine::convertGeocentricChunk(const CoordinateFormatOption& option, const QList<Point>& points,
+                                                        int firstRow, int lastRow, QString* notations) const
+{
+  double latitudes[batchChunkSize];
+  double longitudes[batchChunkSize];
+  double heights[batchChunkSize];
+  bool valid[batchChunkSize];
+  const int count = lastRow - firstRow;
+  for (int i = 0; i < count; ++i)
+  {
+    valid[i] = geodeticPosition(points.at(firstRow + i), latitudes[i], longitudes[i], heights[i]);
+    if (!valid[i])
+      latitudes[i] = longitudes[i] = heights[i] = 0.0;
+  }
+
+  double x[batchChunkSize];
+  double y[batchChunkSize];
+  double z[batchChunkSize];
+  GeocentricConversion::toEcef(latitudes, longitudes, heights, count, x, y, z);
+  if (option.outputMode() == CoordinateConversionOptions::CoordinateTypeEnu)
+    GeocentricConversion::toEnu(enuFrame(option), x, y, z, count, x, y, z);
+
+  char buffer[GeocentricConversion::bufferSize];
+  for (int i = 0; i < count; ++i)
+  {
+    const int length = valid[i] ? GeocentricConversion::format(x[i], y[i], z[i], option.decimalPlaces(),
+                                                               option.addSpaces(), buffer) : 0;
+    notations[firstRow + i] = length > 0 ? QString::fromLatin1(buffer, length) : QString();
+  }
+}
+
+/*!
+  \internal
+
+  Formats \a point as a geohash or Open Location Code using \a option, with
+  the native \l GeohashCodec or \l OpenLocationCodec; the SDK has no
+  equivalent to compare against.
+ */
+QString CoordinateConversionEngine::toGeocodeNotation(const CoordinateFormatOption& option, const Point& point) const
+{
+  double latitude = 0.0;
+  double longitude = 0.0;
+  double height = 0.0;
+  if (!geodeticPosition(point, latitude, longitude, height))
+    return QString();
+
+  char buffer[OpenLocationCodec::bufferSize];
+  const int length = option.outputMode() == CoordinateConversionOptions::CoordinateTypeGeohash ?
+        GeohashCodec::encode(latitude, longitude, option.precision(), buffer) :
+        OpenLocationCodec::encode(latitude, longitude, option.precision(), buffer);
+  return length > 0 ? QString::fromLatin1(buffer, length) : QString();
+}
+
+/*!
+  \internal
+
+  Decodes the geohash or Open Location Code \a notation into the centre of
+  its cell in \a spatialReference.
+ */
+Point CoordinateConversionEngine::geocodePointFromNotation(const CoordinateFormatOption& option, const QString& notation,
+                                                           const SpatialReference& spatialReference) const
+{
+  // room for surrounding spaces
+  constexpr int bufferSize = 2 * OpenLocationCodec::bufferSize;
+  char buffer[bufferSize];
+  const int length = NativeConversionSupport::toLatin1(notation, buffer, bufferSize);
+  double latitude = 0.0;
+  double longitude = 0.0;
+  const bool decoded = length > 0 &&
+      (option.outputMode() == CoordinateConversionOptions::CoordinateTypeGeohash ?
+         GeohashCodec::decode(buffer, length, latitude, longitude) :
+         OpenLocationCodec::decode(buffer, length, latitude, longitude));
+  if (!decoded)
+    return Point();
+
+  return geographicPoint(latitude, longitude, spatialReference);
+}
+
+/*!
+  \internal
+
+  Converts the points from \a firstRow up to \a lastRow to geohashes or
+  Open Location Codes using \a option, with the batch encoders of the
+  native codecs. Points which cannot be converted are left empty.
+ */
+void CoordinateConversionEngine::convertGeocodeChunk(const CoordinateFormatOption& option, const QList<Point>& points,
+                                                     int firstRow, int lastRow, QString* notations) const
+{
+  double latitudes[batchChunkSize];
+  double longitudes[batchChunkSize];
+  const int count = lastRow - firstRow;
+  for (int i = 0; i < count; ++i)
+  {
+    double height = 0.0;
+    if (!geodeticPosition(points.at(firstRow + i), latitudes[i], longitudes[i], height))
+      latitudes[i] = longitudes[i] = std::numeric_limits<double>::quiet_NaN();
+  }
+
+  char buffer[batchChunkSize * OpenLocationCodec::bufferSize];
+  const int length = option.outputMode() == CoordinateConversionOptions::CoordinateTypeGeohash ?
+        GeohashCodec::encode(latitudes, longitudes, count, option.precision(), buffer) :
+        OpenLocationCodec::encode(latitudes, longitudes, count, option.precision(), buffer);
+
+  // invalid points are written as spaces
+  for (int i = 0; i < count; ++i)
+  {
+    const char* notation = buffer + i * length;
+    notations[firstRow + i] = length > 0 && notation[0] != ' ' ? QString::fromLatin1(notation, length) : QString();
+  }
+}
+
+/*!
+  \internal
+
+  Writes the id of the cell at the option's level holding \a point, using
+  the native \l S2CellCodec.
+ */
+QString CoordinateConversionEngine::toCellIdNotation(const CoordinateFormatOption& option, const Point& point) const
+{
+  double latitude = 0.0;
+  double longitude = 0.0;
+  double height = 0.0;
+  if (!geodeticPosition(point, latitude, longitude, height))
+    return QString();
+
+  const std::uint64_t id = S2CellCodec::cellId(latitude, longitude, option.level());
+  return id != 0 ? formatCellId(option, id) : QString();
+}
+
+/*!
+  \internal
+
+  Decodes the cell id \a notation into the centre of its cell in
+  \a spatialReference.
+ */
+Point CoordinateConversionEngine::cellIdPointFromNotation(const CoordinateFormatOption& option, const QString& notation,
+                                                          const SpatialReference& spatialReference) const
+{
+  std::uint64_t id = 0;
+  if (!parseCellId(option, notation, id))
+    return Point();
+
+  double latitude = 0.0;
+  double longitude = 0.0;
+  S2CellCodec::center(id, latitude, longitude);
+  return geographicPoint(latitude, longitude, spatialReference);
+}
+
+/*!
+  \brief Decodes the cell id \a notation, written as described by
+  \a option, into the polygon of its cell in \a spatialReference.
+
+  The polygon joins the four corners of the cell. Cell edges are great
+  circle arcs, so for cells of low levels the polygon is an approximation.
+  Corners are kept within 180 degrees of longitude of the first one, so
+  cells crossing the antimeridian are not drawn around the globe. Returns
+  an empty polygon if \a notation cannot be decoded.
+
+  \sa pointFromNotation
+ */
+Polygon CoordinateConversionEngine::cellIdPolygon(const CoordinateFormatOption& option, const QString& notation,
+                                                  const SpatialReference& spatialReference) const
+{
+  std::uint64_t id = 0;
+  if (!parseCellId(option, notation, id))
+    return Polygon();
+
+  double latitudes[4];
+  double longitudes[4];
+  S2CellCodec::vertices(id, latitudes, longitudes);
+
+  const SpatialReference wgs84 = SpatialReference::wgs84();
+  PolygonBuilder builder(wgs84);
+  for (int i = 0; i < 4; ++i)
+  {
+    double longitude = longitudes[i];
+    if (longitude - longitudes[0] > 180.0)
+      longitude -= 360.0;
+    else if (longitude - longitudes[0] < -180.0)
+      longitude += 360.0;
+
+    builder.addPoint(longitude, latitudes[i]);
+  }
+
+  const Polygon polygon = builder.toPolygon();
+  if (spatialReference.isEmpty() || spatialReference.wkid() == wgs84.wkid())
+    return polygon;
+
+  return Polygon(GeometryEngine::project(polygon, spatialReference));
+}
+
+/*!
+  \internal
+
+  Converts the points from \a firstRow up to \a lastRow to cell ids using
+  \a option, with the batch path of \l S2CellCodec. Points which cannot be
+  converted are left empty.
+ */
+void CoordinateConversionEngine::convertCellIdChunk(const CoordinateFormatOption& option, const QList<Point>& points,
+                                                    int firstRow, int lastRow, QString* notations) const
+{
+  double latitudes[batchChunkSize];
+  double longitudes[batchChunkSize];
+  const int count = lastRow - firstRow;
+  for (int i = 0; i < count; ++i)
+  {
+    double height = 0.0;
+    if (!geodeticPosition(points.at(firstRow + i), latitudes[i], longitudes[i], height))
+      latitudes[i] = longitudes[i] = std::numeric_limits<double>::quiet_NaN();
+  }
+
+  std::uint64_t ids[batchChunkSize];
+  S2CellCodec::cellIds(latitudes, longitudes, count, option.level(), ids);
+  for (int i = 0; i < count; ++i)
+    notations[firstRow + i] = ids[i] != 0 ? formatCellId(option, ids[i]) : QString();
+}
+
+/*!
+  \brief Converts each of \a points to every format in the options and
+  returns the notations as a table with one column per option and one
+  row per point.
+
+  The points are split into chunks which are converted in parallel on the
+  global thread pool, using the same per-format conversion as
+  \l convertPoint. This call blocks until every point has been converted.
+
+  \sa CoordinateConversionBatchResult
+ */
+CoordinateConversionBatchResult CoordinateConversionEngine::convertPoints(const QList<Point>& points) const
+{
+  return convertPoints(m_options, points);
+}
+
+/*!
+  \brief Converts each of \a points with each of \a options and returns the
+  notations as a table with one column per option and one row per point.
+
+  Like \l convert, this reads nothing but the native conversion support of
+  the engine, so it may be called from any thread with a snapshot of the
+  options taken beforehand.
+ */
+CoordinateConversionBatchResult CoordinateConversionEngine::convertPoints(const QList<CoordinateFormatOption>& options,
+                                                                          const QList<Point>& points) const
+{
+  QStringList formatNames;
+  for (const CoordinateFormatOption& option : options)
+    formatNames.append(option.name());
+
+  CoordinateConversionBatchResult batch(formatNames, points.size());
+  QVector<QString*> columns;
+  columns.reserve(formatNames.size());
+  for (int column = 0; column < formatNames.size(); ++column)
+    columns.append(batch.columnData(column));
+
+  QVector<int> chunks = batchChunks(points.size());
+  QtConcurrent::blockingMap(chunks, [this, &options, &points, &columns](const int& firstRow)
+  {
+    convertBatchChunk(options, points, firstRow, columns);
+  });
+
+  return batch;
+}
+
+/*!
+  \brief Decodes each of \a notations with the \l inputFormat, or the
+  recognized format when \l autoDetectInputFormat is set, and converts it to
+  every format in the options.
+
+  The conversion runs on the calling thread, and several threads may call
+  this at once as long as the options are not modified in the meantime. This
+  makes it possible to stream large inputs through the engine in
+  independent chunks without a GeoView or QML engine. Rows whose notation
+  could not be decoded are listed in
+  \l CoordinateConversionBatchResult::errorRows and have empty notations.
+
+  \sa convertPoints
+ */
+CoordinateConversionBatchResult CoordinateConversionEngine::convertNotations(const QStringList& notations) const
+{
+  QStringList formatNames;
+  for (const CoordinateFormatOption& option : m_options)
+    formatNames.append(option.name());
+
+  CoordinateConversionBatchResult batch(formatNames, notations.size());
+  const CoordinateFormatOption input = inputOption();
+  if (!m_autoDetectInputFormat && !input.isValid())
+  {
+    for (int row = 0; row < notations.size(); ++row)
+      batch.m_errorRows.append(row);
+
+    return batch;
+  }
+
+  QVector<QString*> columns;
+  columns.reserve(formatNames.size());
+  for (int column = 0; column < formatNames.size(); ++column)
+    columns.append(batch.columnData(column));
+
+  for (int row = 0; row < notations.size(); ++row)
+  {
+    const Point point = m_autoDetectInputFormat ?
+          detectedPointFromNotation(notations.at(row), m_options, m_formatDefaults, m_spatialReference) :
+          pointFromNotation(input, notations.at(row), m_spatialReference);
+    if (point.isEmpty())
+    {
+      batch.m_errorRows.append(row);
+      continue;
+    }
+
+    for (int column = 0; column < columns.size(); ++column)
+      columns.at(column)[row] = convert(m_options.at(column), point);
+  }
+
+  return batch;
+}
+
+/*!
+  \brief Converts the chunk of \a points starting at \a firstRow with each
+  of \a options, writing into the matching entry of \a columns.
+
+  Each column must hold a notation for every point. Chunks never overlap,
+  so several chunks of one batch can be converted at once without locking.
+ */
+void CoordinateConversionEngine::convertBatchChunk(const QList<CoordinateFormatOption>& options,
+                                                   const QList<Point>& points,
+                                                   int firstRow,
+                                                   const QVector<QString*>& columns) const
+{
+  const int lastRow = qMin(firstRow + batchChunkSize, points.size());
+  for (int column = 0; column < options.size(); ++column)
+  {
+    const CoordinateFormatOption& option = options.at(column);
+    QString* notations = columns.at(column);
+    if (isGeocentric(option))
+    {
+      convertGeocentricChunk(option, points, firstRow, lastRow, notations);
+      continue;
+    }
+
+    if (isGeocode(option))
+    {
+      convertGeocodeChunk(option, points, firstRow, lastRow, notations);
+      continue;
+    }
+
+    if (option.outputMode() == CoordinateConversionOptions::CoordinateTypeCellId)
+    {
+      convertCellIdChunk(option, points, firstRow, lastRow, notations);
+      continue;
+    }
+
+    if (isGrid(option))
+    {
+      convertGridChunk(option, points, firstRow, lastRow, notations);
+      continue;
+    }
+
+    if (option.outputMode() == CoordinateConversionOptions::CoordinateTypeGars ||
+        option.outputMode() == CoordinateConversionOptions::CoordinateTypeGeoRef)
+    {
+      convertCellChunk(option, points, firstRow, lastRow, notations);
+      continue;
+    }
+
+    for (int row = firstRow; row < lastRow; ++row)
+      notations[row] = convert(option, points.at(row));
+  }
+}
+
+} // Toolkit
+} // ArcGISRuntime
+} // Esri
@@ -17,6 +17,8 @@
 #include "CoordinateConversionConstants.h"
 #include "CoordinateConversionOptions.h"
 #include "CoordinateConversionController.h"
+#include "CoordinateFormatOption.h"
+#include "CoordinateFormatRegistry.h"
 
 namespace Esri
 {
@@ -78,6 +80,39 @@ namespace Toolkit
     \li \l utmConversionMode
   \row
     \li \l addSpaces
+  \row
+    \li {1, 3} ECEF (Earth-centred Earth-fixed X, Y and Z in metres)
+    \li \l name
+  \row
+    \li \l decimalPlaces (0 to 6)
+  \row
+    \li \l addSpaces
+  \row
+    \li {1, 4} ENU (local East, North and Up in metres)
+    \li \l name
+  \row
+    \li \l decimalPlaces (0 to 6)
+  \row
+    \li \l addSpaces
+  \row
+    \li \l enuOriginLatitude, \l enuOriginLongitude, \l enuOriginHeight
+  \row
+    \li {1, 2} Geohash
+    \li \l name
+  \row
+    \li \l precision (1 to 12)
+  \row
+    \li {1, 2} Open Location Code (Plus Code)
+    \li \l name
+  \row
+    \li \l precision (2, 4, 6, 8 or 10 to 15)
+  \row
+    \li {1, 3} S2 cell id
+    \li \l name
+  \row
+    \li \l level (0 to 30)
+  \row
+    \li \l cellIdNotation
   \endtable
 
   For more information see the API documentation for
@@ -130,14 +165,28 @@ QString CoordinateConversionOptions::name() const
 void CoordinateConversionOptions::setName(const QString& name)
 {
   m_name = name;
+  m_formatId = CoordinateFormatRegistry::formatId(name);
   emit nameChanged();
 }
 
+/*!
+  \brief Returns the id \l CoordinateFormatRegistry assigned to the \l name.
+
+  Options with names differing only in case share an id. An empty name has
+  the id \c CoordinateFormatRegistry::InvalidFormatId.
+ */
+int CoordinateConversionOptions::formatId() const
+{
+  return m_formatId;
+}
+
 /*!
   \property CoordinateConversionOptions::addSpaces
   \brief Whether the output notation format should use spaces.
 
-  This option only applies to the \c Mgrs, \c Usng, and \c Utm notation types.
+  This option only applies to the \c Mgrs, \c Usng, \c Utm, \c Ecef and
+  \c Enu notation types. ECEF and ENU coordinates are separated by a space,
+  or by a comma when this is \c false.
  */
 bool CoordinateConversionOptions::addSpaces() const
 {
@@ -164,10 +213,18 @@ void CoordinateConversionOptions::setAddSpaces(bool addSpaces)
   \li \c {0 to 9}
   \li \c 8
   \row
+  \li Geohash
+  \li \c {1 to 12} characters
+  \li \c 8
+  \row
   \li MGRS
   \li \c {0 to 8}
   \li \c 8
   \row
+  \li Open Location Code
+  \li \c {2, 4, 6, 8} or \c {10 to 15} digits
+  \li \c 8
+  \row
   \li USNG
   \li \c {0 to 8}
   \li \c 8
@@ -188,8 +245,9 @@ void CoordinateConversionOptions::setPrecision(int precision)
   \property CoordinateConversionOptions::decimalPlaces
   \brief The number of decimal places used in the notation.
 
-  This option only applies to the \c LatLon notation type.
-  Possible values are \c 0 to \c 16. The default value is \c 6.
+  This option applies to the \c LatLon notation type, where possible
+  values are \c 0 to \c 16, and to the \c Ecef and \c Enu types, where
+  they are \c 0 to \c 6. The default value is \c 6.
  */
 int CoordinateConversionOptions::decimalPlaces() const
 {
@@ -267,6 +325,144 @@ void CoordinateConversionOptions::setGarsConversionMode(GarsConversionMode conve
   emit garsConversionModeChanged();
 }
 
+/*!
+  \property CoordinateConversionOptions::enuOriginLatitude
+  \brief The WGS 84 latitude, in degrees, of the origin of ENU coordinates.
+
+  This option only applies to the \c Enu notation. The default value is \c 0.
+ */
+double CoordinateConversionOptions::enuOriginLatitude() const
+{
+  return m_enuOriginLatitude;
+}
+
+void CoordinateConversionOptions::setEnuOriginLatitude(double enuOriginLatitude)
+{
+  m_enuOriginLatitude = enuOriginLatitude;
+  emit enuOriginLatitudeChanged();
+}
+
+/*!
+  \property CoordinateConversionOptions::enuOriginLongitude
+  \brief The WGS 84 longitude, in degrees, of the origin of ENU coordinates.
+
+  This option only applies to the \c Enu notation. The default value is \c 0.
+ */
+double CoordinateConversionOptions::enuOriginLongitude() const
+{
+  return m_enuOriginLongitude;
+}
+
+void CoordinateConversionOptions::setEnuOriginLongitude(double enuOriginLongitude)
+{
+  m_enuOriginLongitude = enuOriginLongitude;
+  emit enuOriginLongitudeChanged();
+}
+
+/*!
+  \property CoordinateConversionOptions::enuOriginHeight
+  \brief The height above the WGS 84 ellipsoid, in metres, of the origin of
+  ENU coordinates.
+
+  This option only applies to the \c Enu notation. The default value is \c 0.
+ */
+double CoordinateConversionOptions::enuOriginHeight() const
+{
+  return m_enuOriginHeight;
+}
+
+void CoordinateConversionOptions::setEnuOriginHeight(double enuOriginHeight)
+{
+  m_enuOriginHeight = enuOriginHeight;
+  emit enuOriginHeightChanged();
+}
+
+/*!
+  \property CoordinateConversionOptions::level
+  \brief The level of the cell ids written, from \c 0 (a cube face) to
+  \c 30 (about a centimetre).
+
+  This option only applies to the \c CellId notation. The default value is
+  \c 16, cells of about 150 metres.
+ */
+int CoordinateConversionOptions::level() const
+{
+  return m_level;
+}
+
+void CoordinateConversionOptions::setLevel(int level)
+{
+  m_level = level;
+  emit levelChanged();
+}
+
+/*!
+  \property CoordinateConversionOptions::cellIdNotation
+  \brief Whether cell ids are written as S2 tokens or as decimal integers.
+
+  This option only applies to the \c CellId notation. The default value is
+  \c CellIdToken.
+ */
+CoordinateConversionOptions::CellIdNotation CoordinateConversionOptions::cellIdNotation() const
+{
+  return m_cellIdNotation;
+}
+
+void CoordinateConversionOptions::setCellIdNotation(CellIdNotation cellIdNotation)
+{
+  m_cellIdNotation = cellIdNotation;
+  emit cellIdNotationChanged();
+}
+
+/*!
+  \brief Returns a snapshot of these settings as a \l CoordinateFormatOption.
+
+  The snapshot does not follow later changes to this object, and can be
+  used on any thread.
+ */
+CoordinateFormatOption CoordinateConversionOptions::formatOption() const
+{
+  return CoordinateFormatOption(*this);
+}
+
+/*!
+  \brief Assigns every setting from \a formatOption.
+
+  Only the settings which differ are changed, so only their signals are
+  emitted.
+ */
+void CoordinateConversionOptions::setFormatOption(const CoordinateFormatOption& formatOption)
+{
+  if (formatOption.name() != m_name)
+    setName(formatOption.name());
+  if (formatOption.outputMode() != m_outputMode)
+    setOutputMode(formatOption.outputMode());
+  if (formatOption.addSpaces() != m_addSpaces)
+    setAddSpaces(formatOption.addSpaces());
+  if (formatOption.precision() != m_precision)
+    setPrecision(formatOption.precision());
+  if (formatOption.decimalPlaces() != m_decimalPlaces)
+    setDecimalPlaces(formatOption.decimalPlaces());
+  if (formatOption.mgrsConversionMode() != m_mgrsConversionMode)
+    setMgrsConversionMode(formatOption.mgrsConversionMode());
+  if (formatOption.latLonFormat() != m_latLonFormat)
+    setLatLonFormat(formatOption.latLonFormat());
+  if (formatOption.utmConversionMode() != m_utmConversionMode)
+    setUtmConversionMode(formatOption.utmConversionMode());
+  if (formatOption.garsConversionMode() != m_garsConvesrionMode)
+    setGarsConversionMode(formatOption.garsConversionMode());
+  if (formatOption.enuOriginLatitude() != m_enuOriginLatitude)
+    setEnuOriginLatitude(formatOption.enuOriginLatitude());
+  if (formatOption.enuOriginLongitude() != m_enuOriginLongitude)
+    setEnuOriginLongitude(formatOption.enuOriginLongitude());
+  if (formatOption.enuOriginHeight() != m_enuOriginHeight)
+    setEnuOriginHeight(formatOption.enuOriginHeight());
+  if (formatOption.level() != m_level)
+    setLevel(formatOption.level());
+  if (formatOption.cellIdNotation() != m_cellIdNotation)
+    setCellIdNotation(formatOption.cellIdNotation());
+}
+
 /*!
   \brief Returns the \l CoordinateType enum value corresponding to the enum's text representation, \a type.
  */
@@ -284,6 +480,16 @@ CoordinateConversionOptions::CoordinateType CoordinateConversionOptions::stringT
     return CoordinateType::CoordinateTypeUsng;
   else if (type.compare(CoordinateConversionConstants::UTM_FORMAT, Qt::CaseInsensitive) == 0)
     return CoordinateType::CoordinateTypeUtm;
+  else if (type.compare(CoordinateConversionConstants::ECEF_FORMAT, Qt::CaseInsensitive) == 0)
+    return CoordinateType::CoordinateTypeEcef;
+  else if (type.compare(CoordinateConversionConstants::ENU_FORMAT, Qt::CaseInsensitive) == 0)
+    return CoordinateType::CoordinateTypeEnu;
+  else if (type.compare(CoordinateConversionConstants::GEOHASH_FORMAT, Qt::CaseInsensitive) == 0)
+    return CoordinateType::CoordinateTypeGeohash;
+  else if (type.compare(CoordinateConversionConstants::OPEN_LOCATION_CODE_FORMAT, Qt::CaseInsensitive) == 0)
+    return CoordinateType::CoordinateTypeOpenLocationCode;
+  else if (type.compare(CoordinateConversionConstants::CELL_ID_FORMAT, Qt::CaseInsensitive) == 0)
+    return CoordinateType::CoordinateTypeCellId;
 
   return CoordinateType::CoordinateTypeLatLon;
 }
@@ -307,6 +513,16 @@ QString CoordinateConversionOptions::coordinateTypeToString(CoordinateType type)
     return CoordinateConversionConstants::USNG_FORMAT;
   case CoordinateType::CoordinateTypeUtm:
     return CoordinateConversionConstants::UTM_FORMAT;
+  case CoordinateType::CoordinateTypeEcef:
+    return CoordinateConversionConstants::ECEF_FORMAT;
+  case CoordinateType::CoordinateTypeEnu:
+    return CoordinateConversionConstants::ENU_FORMAT;
+  case CoordinateType::CoordinateTypeGeohash:
+    return CoordinateConversionConstants::GEOHASH_FORMAT;
+  case CoordinateType::CoordinateTypeOpenLocationCode:
+    return CoordinateConversionConstants::OPEN_LOCATION_CODE_FORMAT;
+  case CoordinateType::CoordinateTypeCellId:
+    return CoordinateConversionConstants::CELL_ID_FORMAT;
   default: {}
   }
 
@@ -325,7 +541,12 @@ QStringList CoordinateConversionOptions::coordinateTypeNames() const
         CoordinateConversionConstants::LATLON,
         CoordinateConversionConstants::MGRS_FORMAT,
         CoordinateConversionConstants::USNG_FORMAT,
-        CoordinateConversionConstants::UTM_FORMAT};
+        CoordinateConversionConstants::UTM_FORMAT,
+        CoordinateConversionConstants::ECEF_FORMAT,
+        CoordinateConversionConstants::ENU_FORMAT,
+        CoordinateConversionConstants::GEOHASH_FORMAT,
+        CoordinateConversionConstants::OPEN_LOCATION_CODE_FORMAT,
+        CoordinateConversionConstants::CELL_ID_FORMAT};
 }
 
 // enums
@@ -351,6 +572,32 @@ QStringList CoordinateConversionOptions::coordinateTypeNames() const
 
   \value CoordinateTypeUtm
          Universal Transverse Mercator (UTM)
+
+  \value CoordinateTypeEcef
+         Earth-centred Earth-fixed (ECEF) X, Y and Z in metres
+
+  \value CoordinateTypeEnu
+         Local East, North and Up in metres from the ENU origin
+
+  \value CoordinateTypeGeohash
+         Geohash
+
+  \value CoordinateTypeOpenLocationCode
+         Open Location Code (Plus Code)
+
+  \value CoordinateTypeCellId
+         Hierarchical 64-bit S2 cell id
+ */
+
+/*!
+  \enum CoordinateConversionOptions::CellIdNotation
+  \brief Enumerates the ways cell ids are written.
+
+  \value CellIdToken
+         The id in hexadecimal without trailing zeros, as S2 tokens are.
+
+  \value CellIdInteger
+         The id as an unsigned decimal integer.
  */
 
 /*!
@@ -17,6 +17,9 @@
 #include "CoordinateConversionResults.h"
 #include "CoordinateConversionOptions.h"
 
+// STL headers
+#include <algorithm>
+
 namespace Esri
 {
 namespace ArcGISRuntime
@@ -79,16 +82,125 @@ CoordinateConversionResults::~CoordinateConversionResults()
 
 /*!
   \internal
+
+  Replaces the rows with \a results, matching old and new rows by name.
+
+  Rows whose name is no longer present are removed, new names are inserted
+  and rows whose position changed are moved. Only rows whose notation or type
+  actually changed emit \c dataChanged, so views keep their delegates for
+  everything else. \l resultsChanged is emitted only if something changed.
  */
 void CoordinateConversionResults::setResults(QList<Result>&& results)
 {
-  // set the new results
-  beginResetModel();
-  m_results.clear();
-  m_results = std::move(results);
-  endResetModel();
+  int changeCount = 0;
+
+  // remove the rows which are not part of the new results
+  for (int row = m_results.size() - 1; row >= 0; --row)
+  {
+    const QString& name = m_results.at(row).m_name;
+    const bool kept = std::any_of(results.cbegin(), results.cend(), [&name](const Result& result)
+    {
+      return result.m_name == name;
+    });
+
+    if (kept)
+      continue;
+
+    beginRemoveRows(QModelIndex(), row, row);
+    m_results.removeAt(row);
+    endRemoveRows();
+    ++changeCount;
+  }
+
+  // every remaining row has a place in the new results: bring each into position
+  for (int row = 0; row < results.size(); ++row)
+  {
+    Result& result = results[row];
+    if (row < m_results.size() && m_results.at(row).m_name == result.m_name)
+    {
+      const Result& current = m_results.at(row);
+      if (current.m_notation != result.m_notation || current.m_type != result.m_type)
+      {
+        updateRow(row, std::move(result));
+        ++changeCount;
+      }
+      continue;
+    }
+
+    const int oldRow = indexOf(result.m_name, row + 1);
+    if (oldRow >= 0)
+    {
+      beginMoveRows(QModelIndex(), oldRow, oldRow, QModelIndex(), row);
+      m_results.move(oldRow, row);
+      endMoveRows();
+      ++changeCount;
+
+      const Result& current = m_results.at(row);
+      if (current.m_notation != result.m_notation || current.m_type != result.m_type)
+        updateRow(row, std::move(result));
+    }
+    else
+    {
+      beginInsertRows(QModelIndex(), row, row);
+      m_results.insert(row, std::move(result));
+      endInsertRows();
+      ++changeCount;
+    }
+  }
+
+  // rows left over from duplicated names
+  if (m_results.size() > results.size())
+  {
+    beginRemoveRows(QModelIndex(), results.size(), m_results.size() - 1);
+    changeCount += m_results.size() - results.size();
+    while (m_results.size() > results.size())
+      m_results.removeLast();
+    endRemoveRows();
+  }
+
+  setLastUpdateChangeCount(changeCount);
+  if (changeCount > 0)
+    emit resultsChanged();
+}
+
+/*!
+  \internal
+
+  Replaces the notation and type of the existing rows named in \a results,
+  leaving every other row untouched.
+
+  Returns \c false, without changing anything, if any of the results has no
+  row yet.
+ */
+bool CoordinateConversionResults::updateResults(QList<Result>&& results)
+{
+  QVector<int> rows;
+  rows.reserve(results.size());
+  for (const Result& result : results)
+  {
+    const int row = indexOf(result.m_name, 0);
+    if (row == -1)
+      return false;
+
+    rows.append(row);
+  }
+
+  int changeCount = 0;
+  for (int i = 0; i < results.size(); ++i)
+  {
+    const Result& current = m_results.at(rows.at(i));
+    if (current.m_notation == results.at(i).m_notation && current.m_type == results.at(i).m_type)
+      continue;
+
+    updateRow(rows.at(i), std::move(results[i]));
+    ++changeCount;
+  }
+
+  setLastUpdateChangeCount(changeCount);
+  if (changeCount > 0)
+    emit resultsChanged();
 
-  emit resultsChanged();
+  return true;
 }
 
 void CoordinateConversionResults::removeResult(const QString& name)
@@ -100,6 +212,7 @@ void CoordinateConversionResults::removeResult(const QString& name)
       beginRemoveRows(QModelIndex(), i, i);
       m_results.removeAt(i);
       endRemoveRows();
+      setLastUpdateChangeCount(1);
 
       break;
     }
@@ -108,18 +221,92 @@ void CoordinateConversionResults::removeResult(const QString& name)
 
 /*!
   \internal
+
+  Clears the notation of every row, keeping the rows themselves.
  */
 void CoordinateConversionResults::clearResults()
 {
-  if (m_results.isEmpty())
+  int changeCount = 0;
+  for (int row = 0; row < m_results.size(); ++row)
+  {
+    if (m_results.at(row).m_notation.isEmpty())
+      continue;
+
+    m_results[row].m_notation.clear();
+    const QModelIndex changedIndex = index(row);
+    emit dataChanged(changedIndex, changedIndex, { CoordinateConversionResultsNotationRole });
+    ++changeCount;
+  }
+
+  setLastUpdateChangeCount(changeCount);
+  if (changeCount > 0)
+    emit resultsChanged();
+}
+
+/*!
+  \internal
+
+  Returns the row of the first result named \a name at or after \a from,
+  or \c -1.
+ */
+int CoordinateConversionResults::indexOf(const QString& name, int from) const
+{
+  for (int row = from; row < m_results.size(); ++row)
+  {
+    if (m_results.at(row).m_name == name)
+      return row;
+  }
+
+  return -1;
+}
+
+/*!
+  \internal
+
+  Replaces the notation and type of \a row with those of \a result and
+  notifies views of the roles which changed.
+ */
+void CoordinateConversionResults::updateRow(int row, Result&& result)
+{
+  Result& current = m_results[row];
+  QVector<int> roles;
+  if (current.m_notation != result.m_notation)
+    roles.append(CoordinateConversionResultsNotationRole);
+  if (current.m_type != result.m_type)
+    roles.append(CoordinateConversionResultsCoordinateTypeRole);
+
+  current.m_notation = std::move(result.m_notation);
+  current.m_type = result.m_type;
+
+  const QModelIndex changedIndex = index(row);
+  emit dataChanged(changedIndex, changedIndex, roles);
+}
+
+/*!
+  \internal
+
+  Sets the count reported by \l lastUpdateChangeCount, emitting
+  \l lastUpdateChangeCountChanged if it differs from the previous one.
+ */
+void CoordinateConversionResults::setLastUpdateChangeCount(int changeCount)
+{
+  if (m_lastUpdateChangeCount == changeCount)
     return;
 
-  emit beginResetModel();
-  for (auto& result : m_results)
-    result.m_notation.clear();
-  endResetModel();
+  m_lastUpdateChangeCount = changeCount;
+  emit lastUpdateChangeCountChanged();
+}
 
-  emit resultsChanged();
+/*!
+  \brief Returns the number of rows inserted, removed, moved or changed by
+  the most recent update of the results.
+
+  A conversion which only changes a few notations reports only those rows,
+  which makes it possible to check how much delegate work each update causes.
+ */
+int CoordinateConversionResults::lastUpdateChangeCount() const
+{
+  return m_lastUpdateChangeCount;
 }
 
 /*!
@@ -202,6 +389,12 @@ Result::Result(const QString& name, const QString& notation, int type) :
   \brief Signal emitted when the results change.
  */
 
+/*!
+  \fn CoordinateConversionResults::lastUpdateChangeCountChanged()
+  \brief Signal emitted when \l lastUpdateChangeCount changes, including
+  when an update changes nothing after one which did.
+ */
+
 /*!
   \enum CoordinateConversionResults::CoordinateConversionResultsRoles
   \brief Enumeration of roles used to access results in the list model.
@@ -0,0 +1,360 @@
+/*******************************************************************************
+ *  Copyright 2012-2018 Esri
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ******************************************************************************/
+
+#include "CoordinateFormatDefaults.h"
+
+// C++ API headers
+#include "GeodatabaseTypes.h"
+
+namespace Esri
+{
+namespace ArcGISRuntime
+{
+namespace Toolkit
+{
+
+/*!
+  \class Esri::ArcGISRuntime::Toolkit::CoordinateFormatDefaults
+  \ingroup ToolCoordinateConversion
+  \inmodule ArcGISQtToolkit
+  \brief The settings given to the options created by \l CoordinateFormatFactory.
+  \since Esri::ArcGISRuntime 100.4
+
+  A CoordinateFormatDefaults cannot be changed once built: each \c with
+  function returns a copy with one setting changed. It is a small value, so
+  it can be copied into worker threads or captured by lambdas, and options
+  can be created from it on any thread without locking.
+
+  Each \l CoordinateConversionController holds its own defaults, so two
+  controllers can create differently configured options side by side.
+ */
+
+/*!
+  \brief Constructs the toolkit's built-in defaults.
+ */
+CoordinateFormatDefaults::CoordinateFormatDefaults() :
+  m_dmsDecimalPlaces(6),
+  m_usngPrecision(7),
+  m_usngSpaces(true),
+  m_mgrsConversionMode(MgrsConversionMode::Automatic),
+  m_utmConversionMode(UtmConversionMode::NorthSouthIndicators),
+  m_utmSpaces(true),
+  m_garsConversionMode(GarsConversionMode::Center),
+  m_enuOriginLatitude(0.0),
+  m_enuOriginLongitude(0.0),
+  m_enuOriginHeight(0.0),
+  m_geohashPrecision(9),
+  m_openLocationCodePrecision(10),
+  m_cellIdLevel(16),
+  m_cellIdNotation(CoordinateConversionOptions::CellIdToken)
+{
+}
+
+/*!
+  \brief Returns the decimal places of the seconds in degrees, minutes and seconds notations.
+
+  The default is 6.
+ */
+int CoordinateFormatDefaults::degreesMinutesSecondsDecimalPlaces() const
+{
+  return m_dmsDecimalPlaces;
+}
+
+/*!
+  \brief Returns the precision of USNG notations.
+
+  The default is 7.
+ */
+int CoordinateFormatDefaults::usngPrecision() const
+{
+  return m_usngPrecision;
+}
+
+/*!
+  \brief Returns whether USNG notations are written with spaces.
+
+  The default is \c true.
+ */
+bool CoordinateFormatDefaults::usngUseSpaces() const
+{
+  return m_usngSpaces;
+}
+
+/*!
+  \brief Returns the MGRS conversion mode.
+
+  The default is \c MgrsConversionMode::Automatic.
+ */
+MgrsConversionMode CoordinateFormatDefaults::mgrsConversionMode() const
+{
+  return m_mgrsConversionMode;
+}
+
+/*!
+  \brief Returns the UTM conversion mode.
+
+  The default is \c UtmConversionMode::NorthSouthIndicators.
+ */
+UtmConversionMode CoordinateFormatDefaults::utmConversionMode() const
+{
+  return m_utmConversionMode;
+}
+
+/*!
+  \brief Returns whether UTM notations are written with spaces.
+
+  The default is \c true.
+ */
+bool CoordinateFormatDefaults::utmUseSpaces() const
+{
+  return m_utmSpaces;
+}
+
+/*!
+  \brief Returns the GARS conversion mode.
+
+  The default is \c GarsConversionMode::Center.
+ */
+GarsConversionMode CoordinateFormatDefaults::garsConversionMode() const
+{
+  return m_garsConversionMode;
+}
+
+/*!
+  \brief Returns the latitude of the origin of ENU notations in WGS 84 degrees.
+
+  The default is 0.
+ */
+double CoordinateFormatDefaults::enuOriginLatitude() const
+{
+  return m_enuOriginLatitude;
+}
+
+/*!
+  \brief Returns the longitude of the origin of ENU notations in WGS 84 degrees.
+
+  The default is 0.
+ */
+double CoordinateFormatDefaults::enuOriginLongitude() const
+{
+  return m_enuOriginLongitude;
+}
+
+/*!
+  \brief Returns the ellipsoidal height of the origin of ENU notations in metres.
+
+  The default is 0.
+ */
+double CoordinateFormatDefaults::enuOriginHeight() const
+{
+  return m_enuOriginHeight;
+}
+
+/*!
+  \brief Returns the number of characters of geohashes.
+
+  The default is 9, cells of about 5 metres.
+ */
+int CoordinateFormatDefaults::geohashPrecision() const
+{
+  return m_geohashPrecision;
+}
+
+/*!
+  \brief Returns the number of digits of Open Location Codes.
+
+  The default is 10, cells of about 14 metres.
+ */
+int CoordinateFormatDefaults::openLocationCodePrecision() const
+{
+  return m_openLocationCodePrecision;
+}
+
+/*!
+  \brief Returns the level of cell ids.
+
+  The default is 16, cells of about 150 metres.
+ */
+int CoordinateFormatDefaults::cellIdLevel() const
+{
+  return m_cellIdLevel;
+}
+
+/*!
+  \brief Returns whether cell ids are written as tokens or integers.
+
+  The default is \c CoordinateConversionOptions::CellIdToken.
+ */
+CoordinateConversionOptions::CellIdNotation CoordinateFormatDefaults::cellIdNotation() const
+{
+  return m_cellIdNotation;
+}
+
+/*!
+  \brief Returns a copy with the decimal places of the seconds set to \a decimalPlaces.
+ */
+CoordinateFormatDefaults CoordinateFormatDefaults::withDegreesMinutesSecondsDecimalPlaces(int decimalPlaces) const
+{
+  CoordinateFormatDefaults defaults(*this);
+  defaults.m_dmsDecimalPlaces = decimalPlaces;
+  return defaults;
+}
+
+/*!
+  \brief Returns a copy with the USNG precision set to \a precision.
+ */
+CoordinateFormatDefaults CoordinateFormatDefaults::withUsngPrecision(int precision) const
+{
+  CoordinateFormatDefaults defaults(*this);
+  defaults.m_usngPrecision = precision;
+  return defaults;
+}
+
+/*!
+  \brief Returns a copy writing USNG notations with spaces if \a useSpaces is \c true.
+ */
+CoordinateFormatDefaults CoordinateFormatDefaults::withUsngUseSpaces(bool useSpaces) const
+{
+  CoordinateFormatDefaults defaults(*this);
+  defaults.m_usngSpaces = useSpaces;
+  return defaults;
+}
+
+/*!
+  \brief Returns a copy with the MGRS conversion mode set to \a conversionMode.
+ */
+CoordinateFormatDefaults CoordinateFormatDefaults::withMgrsConversionMode(MgrsConversionMode conversionMode) const
+{
+  CoordinateFormatDefaults defaults(*this);
+  defaults.m_mgrsConversionMode = conversionMode;
+  return defaults;
+}
+
+/*!
+  \brief Returns a copy with the UTM conversion mode set to \a conversionMode.
+ */
+CoordinateFormatDefaults CoordinateFormatDefaults::withUtmConversionMode(UtmConversionMode conversionMode) const
+{
+  CoordinateFormatDefaults defaults(*this);
+  defaults.m_utmConversionMode = conversionMode;
+  return defaults;
+}
+
+/*!
+  \brief Returns a copy writing UTM notations with spaces if \a useSpaces is \c true.
+ */
+CoordinateFormatDefaults CoordinateFormatDefaults::withUtmUseSpaces(bool useSpaces) const
+{
+  CoordinateFormatDefaults defaults(*this);
+  defaults.m_utmSpaces = useSpaces;
+  return defaults;
+}
+
+/*!
+  \brief Returns a copy with the GARS conversion mode set to \a conversionMode.
+ */
+CoordinateFormatDefaults CoordinateFormatDefaults::withGarsConversionMode(GarsConversionMode conversionMode) const
+{
+  CoordinateFormatDefaults defaults(*this);
+  defaults.m_garsConversionMode = conversionMode;
+  return defaults;
+}
+
+/*!
+  \brief Returns a copy with the origin of ENU notations set to \a latitude,
+  \a longitude and \a height.
+ */
+CoordinateFormatDefaults CoordinateFormatDefaults::withEnuOrigin(double latitude, double longitude, double height) const
+{
+  CoordinateFormatDefaults defaults(*this);
+  defaults.m_enuOriginLatitude = latitude;
+  defaults.m_enuOriginLongitude = longitude;
+  defaults.m_enuOriginHeight = height;
+  return defaults;
+}
+
+/*!
+  \brief Returns a copy with the number of characters of geohashes set to \a precision.
+ */
+CoordinateFormatDefaults CoordinateFormatDefaults::withGeohashPrecision(int precision) const
+{
+  CoordinateFormatDefaults defaults(*this);
+  defaults.m_geohashPrecision = precision;
+  return defaults;
+}
+
+/*!
+  \brief Returns a copy with the number of digits of Open Location Codes set to \a precision.
+ */
+CoordinateFormatDefaults CoordinateFormatDefaults::withOpenLocationCodePrecision(int precision) const
+{
+  CoordinateFormatDefaults defaults(*this);
+  defaults.m_openLocationCodePrecision = precision;
+  return defaults;
+}
+
+/*!
+  \brief Returns a copy with the level of cell ids set to \a level.
+ */
+CoordinateFormatDefaults CoordinateFormatDefaults::withCellIdLevel(int level) const
+{
+  CoordinateFormatDefaults defaults(*this);
+  defaults.m_cellIdLevel = level;
+  return defaults;
+}
+
+/*!
+  \brief Returns a copy writing cell ids as \a cellIdNotation.
+ */
+CoordinateFormatDefaults CoordinateFormatDefaults::withCellIdNotation(CoordinateConversionOptions::CellIdNotation cellIdNotation) const
+{
+  CoordinateFormatDefaults defaults(*this);
+  defaults.m_cellIdNotation = cellIdNotation;
+  return defaults;
+}
+
+/*!
+  \brief Returns whether every setting equals that of \a other.
+ */
+bool CoordinateFormatDefaults::operator==(const CoordinateFormatDefaults& other) const
+{
+  return m_dmsDecimalPlaces == other.m_dmsDecimalPlaces &&
+      m_usngPrecision == other.m_usngPrecision &&
+      m_usngSpaces == other.m_usngSpaces &&
+      m_mgrsConversionMode == other.m_mgrsConversionMode &&
+      m_utmConversionMode == other.m_utmConversionMode &&
+      m_utmSpaces == other.m_utmSpaces &&
+      m_garsConversionMode == other.m_garsConversionMode &&
+      m_enuOriginLatitude == other.m_enuOriginLatitude &&
+      m_enuOriginLongitude == other.m_enuOriginLongitude &&
+      m_enuOriginHeight == other.m_enuOriginHeight &&
+      m_geohashPrecision == other.m_geohashPrecision &&
+      m_openLocationCodePrecision == other.m_openLocationCodePrecision &&
+      m_cellIdLevel == other.m_cellIdLevel &&
+      m_cellIdNotation == other.m_cellIdNotation;
+}
+
+/*!
+  \brief Returns whether any setting differs from that of \a other.
+ */
+bool CoordinateFormatDefaults::operator!=(const CoordinateFormatDefaults& other) const
+{
+  return !(*this == other);
+}
+
+} // Toolkit
+} // ArcGISRuntime
+} // Esri
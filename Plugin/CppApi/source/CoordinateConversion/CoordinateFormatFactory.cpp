@@ -17,13 +17,16 @@
 #include "CoordinateFormatFactory.h"
 
 // toolkit headers
-#include "CoordinateConversionConstants.h"
 #include "CoordinateConversionOptions.h"
+#include "CoordinateFormatOption.h"
+#include "CoordinateFormatRegistry.h"
 
 // C++ API headers
 #include "GeodatabaseTypes.h"
 
 // Qt headers
+#include <QMutex>
+#include <QMutexLocker>
 #include <QObject>
 
 namespace Esri
@@ -33,134 +36,312 @@ namespace ArcGISRuntime
 namespace Toolkit
 {
 
-int CoordinateFormatFactory::DMS_DECIMALPLACES = 6;
-int CoordinateFormatFactory::USNG_PRECISION = 7;
-bool CoordinateFormatFactory::USNG_SPACES = true;
-MgrsConversionMode CoordinateFormatFactory::MGRS_CONVERSION_MODE = MgrsConversionMode::Automatic;
-UtmConversionMode CoordinateFormatFactory::UTM_CONVERSION_MODE = UtmConversionMode::NorthSouthIndicators;
-bool CoordinateFormatFactory::UTM_SPACES = true;
-GarsConversionMode CoordinateFormatFactory::GARS_CONVERSION_MODE = GarsConversionMode::Center;
+namespace
+{
+
+// the process wide defaults; only reached through processDefaults under the mutex
+struct ProcessDefaults
+{
+  QMutex mutex;
+  CoordinateFormatDefaults defaults;
+};
+
+// ECEF and ENU notations are in metres, so millimetres are enough
+constexpr int geocentricDecimalPlaces = 3;
+
+ProcessDefaults& processDefaults()
+{
+  static ProcessDefaults instance;
+  return instance;
+}
+
+} // namespace
 
 CoordinateConversionOptions* CoordinateFormatFactory::createFormat(const QString& formatName, QObject* parent)
 {
+  return createFormat(formatName, defaults(), parent);
+}
+
+CoordinateConversionOptions* CoordinateFormatFactory::createFormat(const QString& formatName,
+                                                                   const CoordinateFormatDefaults& defaults,
+                                                                   QObject* parent)
+{
+  const CoordinateFormatOption formatOption = createFormatOption(formatName, defaults);
+  if (!formatOption.isValid())
+    return nullptr;
+
   CoordinateConversionOptions* option = new CoordinateConversionOptions(parent);
-  option->setName(formatName);
+  option->setFormatOption(formatOption);
+  return option;
+}
 
-  if (formatName.compare(CoordinateConversionConstants::DEGREES_DECIMAL_MINUTES_FORMAT, Qt::CaseInsensitive) == 0)
+CoordinateFormatOption CoordinateFormatFactory::createFormatOption(const QString& formatName,
+                                                                   const CoordinateFormatDefaults& defaults)
+{
+  // names which are not formats are rejected before setName would intern them
+  const int formatId = CoordinateFormatRegistry::builtInFormatId(formatName);
+  if (formatId == CoordinateFormatRegistry::InvalidFormatId)
+    return CoordinateFormatOption();
+
+  CoordinateFormatOption option;
+  option.setName(formatName);
+
+  switch (formatId)
+  {
+  case CoordinateFormatRegistry::DegreesDecimalMinutesFormatId:
   {
-    option->setOutputMode(CoordinateConversionOptions::CoordinateType::CoordinateTypeLatLon);
-    option->setLatLonFormat(LatitudeLongitudeFormat::DegreesDecimalMinutes);
+    option.setOutputMode(CoordinateConversionOptions::CoordinateType::CoordinateTypeLatLon);
+    option.setLatLonFormat(LatitudeLongitudeFormat::DegreesDecimalMinutes);
+    break;
   }
-  else if (formatName.compare(CoordinateConversionConstants::USNG_FORMAT, Qt::CaseInsensitive) == 0)
+  case CoordinateFormatRegistry::UsngFormatId:
   {
-    option->setOutputMode(CoordinateConversionOptions::CoordinateType::CoordinateTypeUsng);
-    option->setPrecision(usngPrecision());
-    option->setAddSpaces(usngUseSpaces());
+    option.setOutputMode(CoordinateConversionOptions::CoordinateType::CoordinateTypeUsng);
+    option.setPrecision(defaults.usngPrecision());
+    option.setAddSpaces(defaults.usngUseSpaces());
+    break;
   }
-  else if (formatName.compare(CoordinateConversionConstants::UTM_FORMAT, Qt::CaseInsensitive) == 0)
+  case CoordinateFormatRegistry::UtmFormatId:
   {
-    option->setOutputMode(CoordinateConversionOptions::CoordinateType::CoordinateTypeUtm);
-    option->setUtmConversionMode(utmConversioMode());
-    option->setAddSpaces(utmUseSpaces());
+    option.setOutputMode(CoordinateConversionOptions::CoordinateType::CoordinateTypeUtm);
+    option.setUtmConversionMode(defaults.utmConversionMode());
+    option.setAddSpaces(defaults.utmUseSpaces());
+    break;
   }
-  else if (formatName.compare(CoordinateConversionConstants::DEGREES_MINUTES_SECONDS_FORMAT, Qt::CaseInsensitive) == 0)
+  case CoordinateFormatRegistry::DegreesMinutesSecondsFormatId:
   {
-    option->setOutputMode(CoordinateConversionOptions::CoordinateType::CoordinateTypeLatLon);
-    option->setLatLonFormat(LatitudeLongitudeFormat::DegreesMinutesSeconds);
-    option->setDecimalPlaces(degreesMinutesSecondsDecimalPlaces());
+    option.setOutputMode(CoordinateConversionOptions::CoordinateType::CoordinateTypeLatLon);
+    option.setLatLonFormat(LatitudeLongitudeFormat::DegreesMinutesSeconds);
+    option.setDecimalPlaces(defaults.degreesMinutesSecondsDecimalPlaces());
+    break;
   }
-  else if (formatName.compare(CoordinateConversionConstants::MGRS_FORMAT, Qt::CaseInsensitive) == 0)
+  case CoordinateFormatRegistry::MgrsFormatId:
   {
-    option->setOutputMode(CoordinateConversionOptions::CoordinateType::CoordinateTypeMgrs);
-    option->setMgrsConversionMode(mgrsConversionMode());
+    option.setOutputMode(CoordinateConversionOptions::CoordinateType::CoordinateTypeMgrs);
+    option.setMgrsConversionMode(defaults.mgrsConversionMode());
+    break;
   }
-  else if (formatName.compare(CoordinateConversionConstants::DECIMAL_DEGREES_FORMAT, Qt::CaseInsensitive) == 0)
+  case CoordinateFormatRegistry::DecimalDegreesFormatId:
   {
-    option->setOutputMode(CoordinateConversionOptions::CoordinateType::CoordinateTypeLatLon);
-    option->setLatLonFormat(LatitudeLongitudeFormat::DecimalDegrees);
+    option.setOutputMode(CoordinateConversionOptions::CoordinateType::CoordinateTypeLatLon);
+    option.setLatLonFormat(LatitudeLongitudeFormat::DecimalDegrees);
+    break;
   }
-  else if (formatName.compare(CoordinateConversionConstants::GARS_FORMAT, Qt::CaseInsensitive) == 0)
+  case CoordinateFormatRegistry::GarsFormatId:
   {
-    option->setOutputMode(CoordinateConversionOptions::CoordinateType::CoordinateTypeGars);
-    option->setGarsConversionMode(garsConversionMode());
+    option.setOutputMode(CoordinateConversionOptions::CoordinateType::CoordinateTypeGars);
+    option.setGarsConversionMode(defaults.garsConversionMode());
+    break;
   }
-  else
+  case CoordinateFormatRegistry::EcefFormatId:
   {
-    delete option;
-    return nullptr;
+    option.setOutputMode(CoordinateConversionOptions::CoordinateType::CoordinateTypeEcef);
+    option.setDecimalPlaces(geocentricDecimalPlaces);
+    break;
+  }
+  case CoordinateFormatRegistry::EnuFormatId:
+  {
+    option.setOutputMode(CoordinateConversionOptions::CoordinateType::CoordinateTypeEnu);
+    option.setDecimalPlaces(geocentricDecimalPlaces);
+    option.setEnuOriginLatitude(defaults.enuOriginLatitude());
+    option.setEnuOriginLongitude(defaults.enuOriginLongitude());
+    option.setEnuOriginHeight(defaults.enuOriginHeight());
+    break;
+  }
+  case CoordinateFormatRegistry::GeohashFormatId:
+  {
+    option.setOutputMode(CoordinateConversionOptions::CoordinateType::CoordinateTypeGeohash);
+    option.setPrecision(defaults.geohashPrecision());
+    break;
+  }
+  case CoordinateFormatRegistry::OpenLocationCodeFormatId:
+  {
+    option.setOutputMode(CoordinateConversionOptions::CoordinateType::CoordinateTypeOpenLocationCode);
+    option.setPrecision(defaults.openLocationCodePrecision());
+    break;
+  }
+  case CoordinateFormatRegistry::CellIdFormatId:
+  {
+    option.setOutputMode(CoordinateConversionOptions::CoordinateType::CoordinateTypeCellId);
+    option.setLevel(defaults.cellIdLevel());
+    option.setCellIdNotation(defaults.cellIdNotation());
+    break;
+  }
+  default:
+  {
+    return CoordinateFormatOption();
+  }
   }
 
   return option;
 }
 
+CoordinateFormatDefaults CoordinateFormatFactory::defaults()
+{
+  ProcessDefaults& instance = processDefaults();
+  QMutexLocker locker(&instance.mutex);
+  return instance.defaults;
+}
+
+void CoordinateFormatFactory::setDefaults(const CoordinateFormatDefaults& defaults)
+{
+  ProcessDefaults& instance = processDefaults();
+  QMutexLocker locker(&instance.mutex);
+  instance.defaults = defaults;
+}
+
 void CoordinateFormatFactory::setDegreesMinutesSecondsDecimalPlaces(int decimalPlaces)
 {
-  DMS_DECIMALPLACES = decimalPlaces;
+  ProcessDefaults& instance = processDefaults();
+  QMutexLocker locker(&instance.mutex);
+  instance.defaults = instance.defaults.withDegreesMinutesSecondsDecimalPlaces(decimalPlaces);
 }
 
 int CoordinateFormatFactory::degreesMinutesSecondsDecimalPlaces()
 {
-  return DMS_DECIMALPLACES;
+  return defaults().degreesMinutesSecondsDecimalPlaces();
 }
 
 void CoordinateFormatFactory::setUsngPrecision(int precision)
 {
-  USNG_PRECISION = precision;
+  ProcessDefaults& instance = processDefaults();
+  QMutexLocker locker(&instance.mutex);
+  instance.defaults = instance.defaults.withUsngPrecision(precision);
 }
 
 int CoordinateFormatFactory::usngPrecision()
 {
-  return USNG_PRECISION;
+  return defaults().usngPrecision();
 }
 
 void CoordinateFormatFactory::setUsngUseSpaces(bool useSpaces)
 {
-  USNG_SPACES = useSpaces;
+  ProcessDefaults& instance = processDefaults();
+  QMutexLocker locker(&instance.mutex);
+  instance.defaults = instance.defaults.withUsngUseSpaces(useSpaces);
 }
 
 bool CoordinateFormatFactory::usngUseSpaces()
 {
-  return USNG_SPACES;
+  return defaults().usngUseSpaces();
 }
 
 void CoordinateFormatFactory::setMgrsConversionMode(MgrsConversionMode conversionMode)
 {
-  MGRS_CONVERSION_MODE = conversionMode;
+  ProcessDefaults& instance = processDefaults();
+  QMutexLocker locker(&instance.mutex);
+  instance.defaults = instance.defaults.withMgrsConversionMode(conversionMode);
 }
 
 MgrsConversionMode CoordinateFormatFactory::mgrsConversionMode()
 {
-  return MGRS_CONVERSION_MODE;
+  return defaults().mgrsConversionMode();
 }
 
 void CoordinateFormatFactory::setUtmConversionMode(UtmConversionMode conversionMode)
 {
-  UTM_CONVERSION_MODE = conversionMode;
+  ProcessDefaults& instance = processDefaults();
+  QMutexLocker locker(&instance.mutex);
+  instance.defaults = instance.defaults.withUtmConversionMode(conversionMode);
 }
 
 UtmConversionMode CoordinateFormatFactory::utmConversioMode()
 {
-  return UTM_CONVERSION_MODE;
+  return defaults().utmConversionMode();
 }
 
 void CoordinateFormatFactory::setUtmUseSpaces(bool useSpaces)
 {
-  UTM_SPACES = useSpaces;
+  ProcessDefaults& instance = processDefaults();
+  QMutexLocker locker(&instance.mutex);
+  instance.defaults = instance.defaults.withUtmUseSpaces(useSpaces);
 }
 
 bool CoordinateFormatFactory::utmUseSpaces()
 {
-  return UTM_SPACES;
+  return defaults().utmUseSpaces();
 }
 
 void CoordinateFormatFactory::setGarsConversionMode(GarsConversionMode conversionMode)
 {
-  GARS_CONVERSION_MODE = conversionMode;
+  ProcessDefaults& instance = processDefaults();
+  QMutexLocker locker(&instance.mutex);
+  instance.defaults = instance.defaults.withGarsConversionMode(conversionMode);
 }
 
 GarsConversionMode CoordinateFormatFactory::garsConversionMode()
 {
-  return GARS_CONVERSION_MODE;
+  return defaults().garsConversionMode();
+}
+
+void CoordinateFormatFactory::setEnuOrigin(double latitude, double longitude, double height)
+{
+  ProcessDefaults& instance = processDefaults();
+  QMutexLocker locker(&instance.mutex);
+  instance.defaults = instance.defaults.withEnuOrigin(latitude, longitude, height);
+}
+
+double CoordinateFormatFactory::enuOriginLatitude()
+{
+  return defaults().enuOriginLatitude();
+}
+
+double CoordinateFormatFactory::enuOriginLongitude()
+{
+  return defaults().enuOriginLongitude();
+}
+
+double CoordinateFormatFactory::enuOriginHeight()
+{
+  return defaults().enuOriginHeight();
+}
+
+void CoordinateFormatFactory::setGeohashPrecision(int precision)
+{
+  ProcessDefaults& instance = processDefaults();
+  QMutexLocker locker(&instance.mutex);
+  instance.defaults = instance.defaults.withGeohashPrecision(precision);
+}
+
+int CoordinateFormatFactory::geohashPrecision()
+{
+  return defaults().geohashPrecision();
+}
+
+void CoordinateFormatFactory::setOpenLocationCodePrecision(int precision)
+{
+  ProcessDefaults& instance = processDefaults();
+  QMutexLocker locker(&instance.mutex);
+  instance.defaults = instance.defaults.withOpenLocationCodePrecision(precision);
+}
+
+int CoordinateFormatFactory::openLocationCodePrecision()
+{
+  return defaults().openLocationCodePrecision();
+}
+
+void CoordinateFormatFactory::setCellIdLevel(int level)
+{
+  ProcessDefaults& instance = processDefaults();
+  QMutexLocker locker(&instance.mutex);
+  instance.defaults = instance.defaults.withCellIdLevel(level);
+}
+
+int CoordinateFormatFactory::cellIdLevel()
+{
+  return defaults().cellIdLevel();
+}
+
+void CoordinateFormatFactory::setCellIdNotation(CoordinateConversionOptions::CellIdNotation cellIdNotation)
+{
+  ProcessDefaults& instance = processDefaults();
+  QMutexLocker locker(&instance.mutex);
+  instance.defaults = instance.defaults.withCellIdNotation(cellIdNotation);
+}
+
+CoordinateConversionOptions::CellIdNotation CoordinateFormatFactory::cellIdNotation()
+{
+  return defaults().cellIdNotation();
 }
 
 } // Toolkit
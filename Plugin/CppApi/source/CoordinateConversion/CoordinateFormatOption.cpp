@@ -0,0 +1,354 @@
+/*******************************************************************************
+ *  Copyright 2012-2018 Esri
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ******************************************************************************/
+
+#include "CoordinateFormatOption.h"
+
+// toolkit headers
+#include "CoordinateFormatRegistry.h"
+
+namespace Esri
+{
+namespace ArcGISRuntime
+{
+namespace Toolkit
+{
+
+/*!
+  \class Esri::ArcGISRuntime::Toolkit::CoordinateFormatOption
+  \ingroup ToolCoordinateConversion
+  \inmodule ArcGISQtToolkit
+  \brief The settings of one coordinate notation format, as a plain value.
+  \since Esri::ArcGISRuntime 100.4
+
+  CoordinateFormatOption holds the same settings as
+  \l CoordinateConversionOptions, without being a QObject. It is what
+  \l CoordinateConversionEngine converts with, so it can be copied freely
+  between threads and kept in containers by value.
+
+  Use \l CoordinateConversionOptions::formatOption to take a snapshot of a
+  QML option.
+ */
+
+/*!
+  \fn CoordinateFormatOption::CoordinateFormatOption()
+  \brief Constructs an option with no name and the default settings of
+  \l CoordinateConversionOptions.
+ */
+
+/*!
+  \brief Constructs a snapshot of the settings of \a options.
+ */
+CoordinateFormatOption::CoordinateFormatOption(const CoordinateConversionOptions& options) :
+  m_name(options.name()),
+  m_formatId(options.formatId()),
+  m_outputMode(options.outputMode()),
+  m_addSpaces(options.addSpaces()),
+  m_precision(options.precision()),
+  m_decimalPlaces(options.decimalPlaces()),
+  m_mgrsConversionMode(options.mgrsConversionMode()),
+  m_latLonFormat(options.latLonFormat()),
+  m_utmConversionMode(options.utmConversionMode()),
+  m_garsConversionMode(options.garsConvesrionMode()),
+  m_enuOriginLatitude(options.enuOriginLatitude()),
+  m_enuOriginLongitude(options.enuOriginLongitude()),
+  m_enuOriginHeight(options.enuOriginHeight()),
+  m_level(options.level()),
+  m_cellIdNotation(options.cellIdNotation())
+{
+}
+
+/*!
+  \brief Returns whether the option has a name.
+ */
+bool CoordinateFormatOption::isValid() const
+{
+  return m_formatId != CoordinateFormatRegistry::InvalidFormatId;
+}
+
+/*!
+  \brief Returns the name of the format.
+ */
+QString CoordinateFormatOption::name() const
+{
+  return m_name;
+}
+
+/*!
+  \brief Sets the name of the format to \a name.
+ */
+void CoordinateFormatOption::setName(const QString& name)
+{
+  m_name = name;
+  m_formatId = CoordinateFormatRegistry::formatId(name);
+}
+
+/*!
+  \brief Returns the id \l CoordinateFormatRegistry assigned to the name.
+ */
+int CoordinateFormatOption::formatId() const
+{
+  return m_formatId;
+}
+
+/*!
+  \brief Returns the type of notation produced.
+ */
+CoordinateFormatOption::CoordinateType CoordinateFormatOption::outputMode() const
+{
+  return m_outputMode;
+}
+
+/*!
+  \brief Sets the type of notation produced to \a outputMode.
+ */
+void CoordinateFormatOption::setOutputMode(CoordinateType outputMode)
+{
+  m_outputMode = outputMode;
+}
+
+/*!
+  \brief Returns whether grid notations are written with spaces.
+ */
+bool CoordinateFormatOption::addSpaces() const
+{
+  return m_addSpaces;
+}
+
+/*!
+  \brief Sets whether grid notations are written with spaces to \a addSpaces.
+ */
+void CoordinateFormatOption::setAddSpaces(bool addSpaces)
+{
+  m_addSpaces = addSpaces;
+}
+
+/*!
+  \brief Returns the precision of USNG, UTM and GEOREF notations.
+ */
+int CoordinateFormatOption::precision() const
+{
+  return m_precision;
+}
+
+/*!
+  \brief Sets the precision to \a precision.
+ */
+void CoordinateFormatOption::setPrecision(int precision)
+{
+  m_precision = precision;
+}
+
+/*!
+  \brief Returns the decimal places of latitude-longitude notations, and the
+  precision of MGRS notations.
+ */
+int CoordinateFormatOption::decimalPlaces() const
+{
+  return m_decimalPlaces;
+}
+
+/*!
+  \brief Sets the decimal places to \a decimalPlaces.
+ */
+void CoordinateFormatOption::setDecimalPlaces(int decimalPlaces)
+{
+  m_decimalPlaces = decimalPlaces;
+}
+
+/*!
+  \brief Returns the MGRS conversion mode.
+ */
+MgrsConversionMode CoordinateFormatOption::mgrsConversionMode() const
+{
+  return m_mgrsConversionMode;
+}
+
+/*!
+  \brief Sets the MGRS conversion mode to \a mgrsConversionMode.
+ */
+void CoordinateFormatOption::setMgrsConversionMode(MgrsConversionMode mgrsConversionMode)
+{
+  m_mgrsConversionMode = mgrsConversionMode;
+}
+
+/*!
+  \brief Returns the latitude-longitude format.
+ */
+LatitudeLongitudeFormat CoordinateFormatOption::latLonFormat() const
+{
+  return m_latLonFormat;
+}
+
+/*!
+  \brief Sets the latitude-longitude format to \a latLonFormat.
+ */
+void CoordinateFormatOption::setLatLonFormat(LatitudeLongitudeFormat latLonFormat)
+{
+  m_latLonFormat = latLonFormat;
+}
+
+/*!
+  \brief Returns the UTM conversion mode.
+ */
+UtmConversionMode CoordinateFormatOption::utmConversionMode() const
+{
+  return m_utmConversionMode;
+}
+
+/*!
+  \brief Sets the UTM conversion mode to \a utmConversionMode.
+ */
+void CoordinateFormatOption::setUtmConversionMode(UtmConversionMode utmConversionMode)
+{
+  m_utmConversionMode = utmConversionMode;
+}
+
+/*!
+  \brief Returns the GARS conversion mode.
+ */
+GarsConversionMode CoordinateFormatOption::garsConversionMode() const
+{
+  return m_garsConversionMode;
+}
+
+/*!
+  \brief Sets the GARS conversion mode to \a garsConversionMode.
+ */
+void CoordinateFormatOption::setGarsConversionMode(GarsConversionMode garsConversionMode)
+{
+  m_garsConversionMode = garsConversionMode;
+}
+
+/*!
+  \brief Returns the WGS 84 latitude, in degrees, of the origin of ENU
+  coordinates.
+ */
+double CoordinateFormatOption::enuOriginLatitude() const
+{
+  return m_enuOriginLatitude;
+}
+
+/*!
+  \brief Sets the latitude of the origin of ENU coordinates to
+  \a enuOriginLatitude.
+ */
+void CoordinateFormatOption::setEnuOriginLatitude(double enuOriginLatitude)
+{
+  m_enuOriginLatitude = enuOriginLatitude;
+}
+
+/*!
+  \brief Returns the WGS 84 longitude, in degrees, of the origin of ENU
+  coordinates.
+ */
+double CoordinateFormatOption::enuOriginLongitude() const
+{
+  return m_enuOriginLongitude;
+}
+
+/*!
+  \brief Sets the longitude of the origin of ENU coordinates to
+  \a enuOriginLongitude.
+ */
+void CoordinateFormatOption::setEnuOriginLongitude(double enuOriginLongitude)
+{
+  m_enuOriginLongitude = enuOriginLongitude;
+}
+
+/*!
+  \brief Returns the height above the WGS 84 ellipsoid, in metres, of the
+  origin of ENU coordinates.
+ */
+double CoordinateFormatOption::enuOriginHeight() const
+{
+  return m_enuOriginHeight;
+}
+
+/*!
+  \brief Sets the height of the origin of ENU coordinates to
+  \a enuOriginHeight.
+ */
+void CoordinateFormatOption::setEnuOriginHeight(double enuOriginHeight)
+{
+  m_enuOriginHeight = enuOriginHeight;
+}
+
+/*!
+  \brief Returns the level of cell ids.
+ */
+int CoordinateFormatOption::level() const
+{
+  return m_level;
+}
+
+/*!
+  \brief Sets the level of cell ids to \a level.
+ */
+void CoordinateFormatOption::setLevel(int level)
+{
+  m_level = level;
+}
+
+/*!
+  \brief Returns whether cell ids are written as tokens or integers.
+ */
+CoordinateFormatOption::CellIdNotation CoordinateFormatOption::cellIdNotation() const
+{
+  return m_cellIdNotation;
+}
+
+/*!
+  \brief Sets whether cell ids are written as tokens or integers to
+  \a cellIdNotation.
+ */
+void CoordinateFormatOption::setCellIdNotation(CellIdNotation cellIdNotation)
+{
+  m_cellIdNotation = cellIdNotation;
+}
+
+/*!
+  \brief Returns whether the name and every setting equal those of \a other.
+ */
+bool CoordinateFormatOption::operator==(const CoordinateFormatOption& other) const
+{
+  return m_formatId == other.m_formatId &&
+      m_name == other.m_name &&
+      m_outputMode == other.m_outputMode &&
+      m_addSpaces == other.m_addSpaces &&
+      m_precision == other.m_precision &&
+      m_decimalPlaces == other.m_decimalPlaces &&
+      m_mgrsConversionMode == other.m_mgrsConversionMode &&
+      m_latLonFormat == other.m_latLonFormat &&
+      m_utmConversionMode == other.m_utmConversionMode &&
+      m_garsConversionMode == other.m_garsConversionMode &&
+      m_enuOriginLatitude == other.m_enuOriginLatitude &&
+      m_enuOriginLongitude == other.m_enuOriginLongitude &&
+      m_enuOriginHeight == other.m_enuOriginHeight &&
+      m_level == other.m_level &&
+      m_cellIdNotation == other.m_cellIdNotation;
+}
+
+/*!
+  \brief Returns whether the name or any setting differs from that of \a other.
+ */
+bool CoordinateFormatOption::operator!=(const CoordinateFormatOption& other) const
+{
+  return !(*this == other);
+}
+
+} // Toolkit
+} // ArcGISRuntime
+} // Esri
@@ -0,0 +1,229 @@
+/*******************************************************************************
+ *  Copyright 2012-2018 Esri
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ******************************************************************************/
+
+#include "CoordinateFormatRegistry.h"
+
+// toolkit headers
+#include "CoordinateConversionConstants.h"
+
+// Qt headers
+#include <QHash>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QVector>
+
+namespace Esri
+{
+namespace ArcGISRuntime
+{
+namespace Toolkit
+{
+
+namespace
+{
+
+// custom names beyond this many are not interned, so that a long-running
+// process naming formats from untrusted input cannot grow the table forever
+constexpr int maximumCustomFormatCount = 4096;
+
+// the built-in names, in BuiltInFormatId order; never modified once built,
+// so it is read without a lock
+struct BuiltInFormats
+{
+  BuiltInFormats() :
+    names{ CoordinateConversionConstants::DECIMAL_DEGREES_FORMAT,
+           CoordinateConversionConstants::DEGREES_DECIMAL_MINUTES_FORMAT,
+           CoordinateConversionConstants::DEGREES_MINUTES_SECONDS_FORMAT,
+           CoordinateConversionConstants::MGRS_FORMAT,
+           CoordinateConversionConstants::USNG_FORMAT,
+           CoordinateConversionConstants::UTM_FORMAT,
+           CoordinateConversionConstants::GARS_FORMAT,
+           CoordinateConversionConstants::GEOREF_FORMAT,
+           CoordinateConversionConstants::ECEF_FORMAT,
+           CoordinateConversionConstants::ENU_FORMAT,
+           CoordinateConversionConstants::GEOHASH_FORMAT,
+           CoordinateConversionConstants::OPEN_LOCATION_CODE_FORMAT,
+           CoordinateConversionConstants::CELL_ID_FORMAT }
+  {
+  }
+
+  const QString names[CoordinateFormatRegistry::BuiltInFormatCount];
+};
+
+// created on first use, after the constants have been initialized
+const BuiltInFormats& builtInFormats()
+{
+  static const BuiltInFormats formats;
+  return formats;
+}
+
+// the custom names, numbered from BuiltInFormatCount
+struct FormatTable
+{
+  QMutex mutex;
+  QHash<QString, int> ids;
+  QVector<QString> names;
+};
+
+FormatTable& formatTable()
+{
+  static FormatTable table;
+  return table;
+}
+
+} // namespace
+
+/*!
+  \class Esri::ArcGISRuntime::Toolkit::CoordinateFormatRegistry
+  \ingroup ToolCoordinateConversion
+  \inmodule ArcGISQtToolkit
+  \brief Maps coordinate format names to compact integer ids.
+  \since Esri::ArcGISRuntime 100.4
+
+  Format names are compared case insensitively. Each distinct name is
+  interned once, when an option is named, and from then on formats are
+  identified by comparing integers. The formats named in
+  \l CoordinateConversionConstants have the fixed ids of
+  \l BuiltInFormatId; custom names are numbered after them in the order
+  they are first seen.
+
+  Built-in names are looked up in a constant table without locking; only
+  custom names go through the mutex-protected table, which holds at most
+  4096 of them.
+
+  The registry is safe to use from any thread.
+ */
+
+/*!
+  \brief Returns the id of \a formatName, interning it first if needed.
+
+  Returns \c InvalidFormatId for an empty name, and for a new custom name
+  once the table of custom names is full.
+ */
+int CoordinateFormatRegistry::formatId(const QString& formatName)
+{
+  const int builtInId = builtInFormatId(formatName);
+  if (builtInId != InvalidFormatId || formatName.isEmpty())
+    return builtInId;
+
+  const QString key = formatName.toCaseFolded();
+  FormatTable& table = formatTable();
+  QMutexLocker locker(&table.mutex);
+
+  auto it = table.ids.constFind(key);
+  if (it != table.ids.constEnd())
+    return it.value();
+
+  if (table.names.size() >= maximumCustomFormatCount)
+    return InvalidFormatId;
+
+  const int id = BuiltInFormatCount + table.names.size();
+  table.ids.insert(key, id);
+  table.names.append(formatName);
+  return id;
+}
+
+/*!
+  \brief Returns the id of \a formatName if it names one of the formats of
+  \l CoordinateConversionConstants, otherwise \c InvalidFormatId.
+
+  This never locks or interns anything.
+ */
+int CoordinateFormatRegistry::builtInFormatId(const QString& formatName)
+{
+  if (formatName.isEmpty())
+    return InvalidFormatId;
+
+  const BuiltInFormats& formats = builtInFormats();
+  for (int id = 0; id < BuiltInFormatCount; ++id)
+  {
+    if (formatName.compare(formats.names[id], Qt::CaseInsensitive) == 0)
+      return id;
+  }
+
+  return InvalidFormatId;
+}
+
+/*!
+  \brief Returns the id of \a formatName without interning it, or
+  \c InvalidFormatId if the name has not been seen.
+ */
+int CoordinateFormatRegistry::findFormatId(const QString& formatName)
+{
+  const int builtInId = builtInFormatId(formatName);
+  if (builtInId != InvalidFormatId || formatName.isEmpty())
+    return builtInId;
+
+  const QString key = formatName.toCaseFolded();
+  FormatTable& table = formatTable();
+  QMutexLocker locker(&table.mutex);
+
+  return table.ids.value(key, InvalidFormatId);
+}
+
+/*!
+  \brief Returns the name \a formatId was first interned with.
+ */
+QString CoordinateFormatRegistry::formatName(int formatId)
+{
+  if (formatId >= 0 && formatId < BuiltInFormatCount)
+    return builtInFormats().names[formatId];
+
+  FormatTable& table = formatTable();
+  QMutexLocker locker(&table.mutex);
+
+  const int customIndex = formatId - BuiltInFormatCount;
+  if (customIndex < 0 || customIndex >= table.names.size())
+    return QString();
+
+  return table.names.at(customIndex);
+}
+
+/*!
+  \brief Returns the number of interned formats, including the built-in ones.
+ */
+int CoordinateFormatRegistry::formatCount()
+{
+  FormatTable& table = formatTable();
+  QMutexLocker locker(&table.mutex);
+
+  return BuiltInFormatCount + table.names.size();
+}
+
+/*!
+  \enum CoordinateFormatRegistry::BuiltInFormatId
+  \brief The ids of the formats named in \l CoordinateConversionConstants.
+
+  \value InvalidFormatId No format.
+  \value DecimalDegreesFormatId Decimal degrees.
+  \value DegreesDecimalMinutesFormatId Degrees decimal minutes.
+  \value DegreesMinutesSecondsFormatId Degrees minutes seconds.
+  \value MgrsFormatId MGRS.
+  \value UsngFormatId USNG.
+  \value UtmFormatId UTM.
+  \value GarsFormatId GARS.
+  \value GeoRefFormatId GEOREF.
+  \value EcefFormatId Earth-centred Earth-fixed coordinates.
+  \value EnuFormatId Local East-North-Up coordinates.
+  \value GeohashFormatId Geohash.
+  \value OpenLocationCodeFormatId Open Location Code (Plus Code).
+  \value CellIdFormatId S2 cell id.
+  \value BuiltInFormatCount The number of built-in formats.
+ */
+
+} // Toolkit
+} // ArcGISRuntime
+} // Esri
@@ -0,0 +1,256 @@
+/*******************************************************************************
+ *  Copyright 2012-2018 Esri
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ******************************************************************************/
+
+#include "GarsCodec.h"
+
+// STL headers
+#include <cmath>
+
+namespace Esri
+{
+namespace ArcGISRuntime
+{
+namespace Toolkit
+{
+
+namespace
+{
+
+constexpr int letterCount = 24;
+constexpr char bandLetters[letterCount + 1] = "ABCDEFGHJKLMNPQRSTUVWXYZ";
+
+// everything is computed on the 5 minute grid: 12 columns and rows per degree
+constexpr int cellsPerDegree = 12;
+constexpr int maximumColumn = 360 * cellsPerDegree - 1;
+constexpr int maximumRow = 180 * cellsPerDegree - 1;
+
+// 5 minute cells per 30 minute cell and per 15 minute quadrant, along each axis
+constexpr int cellsPer30Minutes = 6;
+constexpr int cellsPer15Minutes = 3;
+
+// quadrant and keypad digits indexed by [row from the south][column from the west]
+constexpr char quadrantDigits[2][2] = { { '3', '4' }, { '1', '2' } };
+constexpr char keypadDigits[3][3] = { { '7', '8', '9' }, { '4', '5', '6' }, { '1', '2', '3' } };
+
+constexpr double halfDegree = 0.5;
+constexpr double quarterDegree = 0.25;
+constexpr double twelfthDegree = 1.0 / 12.0;
+
+// number of points indexed together by the batch path
+constexpr std::size_t batchBlockSize = 256;
+
+int clampedIndex(double value, int maximum)
+{
+  const int index = static_cast<int>(std::floor(value));
+  return index < 0 ? 0 : (index > maximum ? maximum : index);
+}
+
+void writeCell(int column, int row, char* out)
+{
+  const int longitudeBand = column / cellsPer30Minutes + 1;
+  const int latitudeBand = row / cellsPer30Minutes;
+
+  out[0] = static_cast<char>('0' + longitudeBand / 100);
+  out[1] = static_cast<char>('0' + longitudeBand / 10 % 10);
+  out[2] = static_cast<char>('0' + longitudeBand % 10);
+  out[3] = bandLetters[latitudeBand / letterCount];
+  out[4] = bandLetters[latitudeBand % letterCount];
+  out[5] = quadrantDigits[(row % cellsPer30Minutes) / cellsPer15Minutes][(column % cellsPer30Minutes) / cellsPer15Minutes];
+  out[6] = keypadDigits[row % cellsPer15Minutes][column % cellsPer15Minutes];
+}
+
+int letterIndex(char letter)
+{
+  if (letter >= 'a' && letter <= 'z')
+    letter = static_cast<char>(letter - 'a' + 'A');
+
+  for (int i = 0; i < letterCount; ++i)
+  {
+    if (bandLetters[i] == letter)
+      return i;
+  }
+
+  return -1;
+}
+
+} // namespace
+
+/*!
+  \class Esri::ArcGISRuntime::Toolkit::GarsCodec
+  \ingroup ToolCoordinateConversion
+  \inmodule ArcGISQtToolkit
+  \brief A native encoder and decoder for the Global Area Reference System.
+  \since Esri::ArcGISRuntime 100.4
+
+  GARS is pure arithmetic on latitude and longitude: each reference is a
+  30 minute cell (three digits and two letters), a 15 minute quadrant and a
+  5 minute keypad digit. Everything is derived from the integer column and
+  row of the 5 minute cell containing the point.
+
+  The batch \l encode overload works on contiguous latitude and longitude
+  arrays, computing the cell indices for a block of points in one loop
+  before writing any text, and produces fixed-width references suitable for
+  tagging large numbers of observations.
+ */
+
+/*!
+  \brief Writes the 7 character GARS reference for \a latitude and
+  \a longitude (WGS 84 degrees) into \a buffer.
+
+  Returns \l notationLength, or \c 0 if the coordinate is not valid.
+ */
+int GarsCodec::encode(double latitude, double longitude, char* buffer)
+{
+  if (!std::isfinite(latitude) || !std::isfinite(longitude) || latitude < -90.0 || latitude > 90.0)
+    return 0;
+
+  if (longitude < -180.0 || longitude > 180.0)
+    longitude = std::remainder(longitude, 360.0);
+
+  writeCell(clampedIndex((longitude + 180.0) * cellsPerDegree, maximumColumn),
+            clampedIndex((latitude + 90.0) * cellsPerDegree, maximumRow),
+            buffer);
+  return notationLength;
+}
+
+/*!
+  \brief Writes the GARS references for \a count points from \a latitudes
+  and \a longitudes into \a buffer.
+
+  \a buffer must hold \c {count * notationLength} characters; reference \c i
+  starts at \c {i * notationLength}. Invalid points are written as spaces.
+ */
+void GarsCodec::encode(const double* latitudes, const double* longitudes, std::size_t count, char* buffer)
+{
+  int columns[batchBlockSize];
+  int rows[batchBlockSize];
+  bool valid[batchBlockSize];
+
+  for (std::size_t blockStart = 0; blockStart < count; blockStart += batchBlockSize)
+  {
+    const std::size_t blockCount = (count - blockStart) < batchBlockSize ? (count - blockStart) : batchBlockSize;
+    const double* blockLatitudes = latitudes + blockStart;
+    const double* blockLongitudes = longitudes + blockStart;
+
+    for (std::size_t i = 0; i < blockCount; ++i)
+    {
+      double latitude = blockLatitudes[i];
+      double longitude = blockLongitudes[i];
+      valid[i] = latitude >= -90.0 && latitude <= 90.0 && std::isfinite(longitude);
+      latitude = valid[i] ? latitude : 0.0;
+      longitude = valid[i] ? longitude : 0.0;
+      if (longitude < -180.0 || longitude > 180.0)
+        longitude = std::remainder(longitude, 360.0);
+
+      columns[i] = clampedIndex((longitude + 180.0) * cellsPerDegree, maximumColumn);
+      rows[i] = clampedIndex((latitude + 90.0) * cellsPerDegree, maximumRow);
+    }
+
+    char* out = buffer + blockStart * notationLength;
+    for (std::size_t i = 0; i < blockCount; ++i, out += notationLength)
+    {
+      if (valid[i])
+      {
+        writeCell(columns[i], rows[i], out);
+      }
+      else
+      {
+        for (int c = 0; c < notationLength; ++c)
+          out[c] = ' ';
+      }
+    }
+  }
+}
+
+/*!
+  \brief Decodes the GARS reference in the first \a length characters of
+  \a text into \a latitude and \a longitude (WGS 84 degrees).
+
+  References of 5 (30 minute), 6 (15 minute) and 7 (5 minute) characters
+  are accepted. \a position selects the lower-left corner or the centre of
+  the referenced cell.
+ */
+bool GarsCodec::decode(const char* text, int length, CellPosition position, double& latitude, double& longitude)
+{
+  char characters[notationLength];
+  int count = 0;
+  for (int i = 0; i < length; ++i)
+  {
+    if (text[i] == ' ' || text[i] == '\t')
+      continue;
+
+    if (count == notationLength)
+      return false;
+
+    characters[count++] = text[i];
+  }
+
+  if (count < 5)
+    return false;
+
+  int longitudeBand = 0;
+  for (int i = 0; i < 3; ++i)
+  {
+    if (characters[i] < '0' || characters[i] > '9')
+      return false;
+
+    longitudeBand = longitudeBand * 10 + (characters[i] - '0');
+  }
+
+  const int firstLetter = letterIndex(characters[3]);
+  const int secondLetter = letterIndex(characters[4]);
+  const int latitudeBand = firstLetter * letterCount + secondLetter;
+  if (longitudeBand < 1 || longitudeBand > 720 || firstLetter < 0 || secondLetter < 0 || latitudeBand > 359)
+    return false;
+
+  longitude = -180.0 + (longitudeBand - 1) * halfDegree;
+  latitude = -90.0 + latitudeBand * halfDegree;
+  double cellSize = halfDegree;
+
+  if (count > 5)
+  {
+    const int quadrant = characters[5] - '1';
+    if (quadrant < 0 || quadrant > 3)
+      return false;
+
+    longitude += (quadrant % 2) * quarterDegree;
+    latitude += (quadrant < 2 ? 1 : 0) * quarterDegree;
+    cellSize = quarterDegree;
+  }
+
+  if (count > 6)
+  {
+    const int key = characters[6] - '1';
+    if (key < 0 || key > 8)
+      return false;
+
+    longitude += (key % 3) * twelfthDegree;
+    latitude += (2 - key / 3) * twelfthDegree;
+    cellSize = twelfthDegree;
+  }
+
+  if (position == CellPosition::Center)
+  {
+    longitude += 0.5 * cellSize;
+    latitude += 0.5 * cellSize;
+  }
+
+  return true;
+}
+
+} // Toolkit
+} // ArcGISRuntime
+} // Esri
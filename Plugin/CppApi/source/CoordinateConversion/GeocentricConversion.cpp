@@ -0,0 +1,443 @@
+/*******************************************************************************
+ *  Copyright 2012-2018 Esri
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ******************************************************************************/
+
+#include "GeocentricConversion.h"
+
+// STL headers
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+namespace Esri
+{
+namespace ArcGISRuntime
+{
+namespace Toolkit
+{
+
+namespace
+{
+
+constexpr double pi = 3.14159265358979323846;
+constexpr double degreesToRadians = pi / 180.0;
+constexpr double radiansToDegrees = 180.0 / pi;
+
+// WGS 84 ellipsoid
+constexpr double semiMajorAxis = 6378137.0;
+constexpr double flattening = 1.0 / 298.257223563;
+constexpr double semiMinorAxis = semiMajorAxis * (1.0 - flattening);
+constexpr double eccentricitySquared = flattening * (2.0 - flattening);
+constexpr double secondEccentricitySquared = eccentricitySquared / (1.0 - eccentricitySquared);
+
+// points per block of the batch toEcef and toEnu, sized for the stack
+constexpr std::size_t batchBlockSize = 256;
+
+// closer to the polar axis than this, a point is taken to be on it
+constexpr double polarAxisDistance = 1e-9;
+
+// the largest coordinate written, well beyond any orbit, so that the scaled
+// value always fits in 64 bits
+constexpr double largestFormattedValue = 1e12;
+
+// the most digits read from a number; later digits cannot change a double
+constexpr int maximumParsedDigits = 18;
+
+constexpr double powersOfTen[] = { 1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9,
+                                   1e10, 1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18 };
+
+char* writeNumber(char* out, double value, int decimalPlaces)
+{
+  const double scaled = std::floor(std::fabs(value) * powersOfTen[decimalPlaces] + 0.5);
+  std::uint64_t integer = static_cast<std::uint64_t>(scaled);
+  if (value < 0.0 && integer != 0)
+    *out++ = '-';
+
+  char digits[24];
+  int count = 0;
+  do
+  {
+    digits[count++] = static_cast<char>('0' + integer % 10);
+    integer /= 10;
+  }
+  while (integer != 0 || count <= decimalPlaces);
+
+  while (count > 0)
+  {
+    if (count == decimalPlaces)
+      *out++ = '.';
+
+    *out++ = digits[--count];
+  }
+
+  return out;
+}
+
+bool isSeparator(char c)
+{
+  return c == ' ' || c == '\t' || c == ',';
+}
+
+bool isDigit(char c)
+{
+  return c >= '0' && c <= '9';
+}
+
+// reads a decimal number without an exponent, advancing position past it
+bool readNumber(const char* text, int length, int& position, double& value)
+{
+  bool negative = false;
+  if (position < length && (text[position] == '-' || text[position] == '+'))
+    negative = text[position++] == '-';
+
+  std::uint64_t mantissa = 0;
+  int digitCount = 0; // significant digits in the mantissa
+  int fractionDigits = 0;
+  bool seenPoint = false;
+  bool seenDigit = false;
+  for (; position < length; ++position)
+  {
+    const char c = text[position];
+    if (c == '.' && !seenPoint)
+    {
+      seenPoint = true;
+      continue;
+    }
+
+    if (!isDigit(c))
+      break;
+
+    seenDigit = true;
+    if (digitCount == maximumParsedDigits || fractionDigits == maximumParsedDigits)
+    {
+      // integers this long are far too large; fraction digits this far down cannot matter
+      if (!seenPoint)
+        return false;
+
+      continue;
+    }
+
+    mantissa = mantissa * 10 + static_cast<std::uint64_t>(c - '0');
+    if (mantissa != 0)
+      ++digitCount;
+    if (seenPoint)
+      ++fractionDigits;
+  }
+
+  if (!seenDigit)
+    return false;
+
+  value = static_cast<double>(mantissa) / powersOfTen[fractionDigits];
+  if (negative)
+    value = -value;
+
+  return true;
+}
+
+} // namespace
+
+/*!
+  \class Esri::ArcGISRuntime::Toolkit::GeocentricConversion
+  \ingroup ToolCoordinateConversion
+  \inmodule ArcGISQtToolkit
+  \internal
+  \brief Native WGS 84 conversions between geodetic, Earth-centred
+  Earth-fixed (ECEF) and local East-North-Up (ENU) coordinates.
+  \since Esri::ArcGISRuntime 100.4
+
+  Geodetic positions are latitude and longitude in degrees and ellipsoidal
+  height in metres. ECEF and ENU coordinates are in metres; an ENU frame is
+  tangent to the ellipsoid at its origin.
+
+  ECEF to geodetic uses Heikkinen's closed form, so it needs no iteration
+  and is exact to well below a millimetre for points near the Earth.
+
+  The batch \l toEcef and \l toEnu work over plain arrays in fixed-size
+  blocks. \l toEcef takes the sines, cosines and square roots in a scalar
+  pass and then forms the coordinates in a call-free one; \l toEnu copies
+  the offsets from the origin into local arrays and then rotates them. The
+  compiler can vectorize the call-free loops (GCC does at -O3; its -O2 cost
+  model leaves them scalar).
+ */
+
+/*!
+  \brief Returns the ENU frame with its origin at \a latitude and
+  \a longitude (degrees) and \a height (metres).
+ */
+GeocentricConversion::EnuFrame GeocentricConversion::enuFrame(double latitude, double longitude, double height)
+{
+  EnuFrame frame;
+  toEcef(latitude, longitude, height, frame.originX, frame.originY, frame.originZ);
+
+  const double phi = latitude * degreesToRadians;
+  const double lambda = longitude * degreesToRadians;
+  frame.sinLatitude = std::sin(phi);
+  frame.cosLatitude = std::cos(phi);
+  frame.sinLongitude = std::sin(lambda);
+  frame.cosLongitude = std::cos(lambda);
+  return frame;
+}
+
+/*!
+  \brief Converts \a latitude and \a longitude (degrees) and \a height
+  (metres) to the ECEF coordinates \a x, \a y and \a z.
+ */
+void GeocentricConversion::toEcef(double latitude, double longitude, double height, double& x, double& y, double& z)
+{
+  toEcef(&latitude, &longitude, &height, 1, &x, &y, &z);
+}
+
+/*!
+  \brief Converts \a count positions from \a latitudes, \a longitudes and
+  \a heights to ECEF coordinates in \a x, \a y and \a z.
+
+  \a heights may be \c nullptr for positions on the ellipsoid.
+ */
+void GeocentricConversion::toEcef(const double* latitudes, const double* longitudes, const double* heights,
+                                  std::size_t count, double* x, double* y, double* z)
+{
+  double sinPhi[batchBlockSize];
+  double cosPhi[batchBlockSize];
+  double sinLambda[batchBlockSize];
+  double cosLambda[batchBlockSize];
+  double radius[batchBlockSize];
+
+  for (std::size_t start = 0; start < count; start += batchBlockSize)
+  {
+    const std::size_t blockCount = std::min(batchBlockSize, count - start);
+
+    // every library call, sqrt included, stays in this pass: with errno
+    // handling they all keep a loop from vectorizing
+    for (std::size_t i = 0; i < blockCount; ++i)
+    {
+      const double phi = latitudes[start + i] * degreesToRadians;
+      const double lambda = longitudes[start + i] * degreesToRadians;
+      sinPhi[i] = std::sin(phi);
+      cosPhi[i] = std::cos(phi);
+      sinLambda[i] = std::sin(lambda);
+      cosLambda[i] = std::cos(lambda);
+
+      // radius of curvature in the prime vertical
+      radius[i] = semiMajorAxis / std::sqrt(1.0 - eccentricitySquared * sinPhi[i] * sinPhi[i]);
+    }
+
+    double* const blockX = x + start;
+    double* const blockY = y + start;
+    double* const blockZ = z + start;
+    if (heights)
+    {
+      const double* const blockHeights = heights + start;
+      for (std::size_t i = 0; i < blockCount; ++i)
+      {
+        blockX[i] = (radius[i] + blockHeights[i]) * cosPhi[i] * cosLambda[i];
+        blockY[i] = (radius[i] + blockHeights[i]) * cosPhi[i] * sinLambda[i];
+        blockZ[i] = (radius[i] * (1.0 - eccentricitySquared) + blockHeights[i]) * sinPhi[i];
+      }
+    }
+    else
+    {
+      for (std::size_t i = 0; i < blockCount; ++i)
+      {
+        blockX[i] = radius[i] * cosPhi[i] * cosLambda[i];
+        blockY[i] = radius[i] * cosPhi[i] * sinLambda[i];
+        blockZ[i] = radius[i] * (1.0 - eccentricitySquared) * sinPhi[i];
+      }
+    }
+  }
+}
+
+/*!
+  \brief Converts the ECEF coordinates \a x, \a y and \a z to \a latitude
+  and \a longitude (degrees) and \a height (metres).
+ */
+void GeocentricConversion::fromEcef(double x, double y, double z, double& latitude, double& longitude, double& height)
+{
+  const double p = std::sqrt(x * x + y * y);
+  if (p < polarAxisDistance)
+  {
+    latitude = z < 0.0 ? -90.0 : 90.0;
+    longitude = 0.0;
+    height = std::fabs(z) - semiMinorAxis;
+    return;
+  }
+
+  constexpr double a2 = semiMajorAxis * semiMajorAxis;
+  constexpr double b2 = semiMinorAxis * semiMinorAxis;
+  constexpr double e2 = eccentricitySquared;
+  constexpr double e4 = e2 * e2;
+
+  const double z2 = z * z;
+  const double p2 = p * p;
+  const double f = 54.0 * b2 * z2;
+  const double g = p2 + (1.0 - e2) * z2 - e2 * (a2 - b2);
+  const double c = e4 * f * p2 / (g * g * g);
+  const double s = std::cbrt(1.0 + c + std::sqrt(c * c + 2.0 * c));
+  const double k = s + 1.0 + 1.0 / s;
+  const double pk = f / (3.0 * k * k * g * g);
+  const double q = std::sqrt(1.0 + 2.0 * e4 * pk);
+  const double r0 = -(pk * e2 * p) / (1.0 + q) +
+      std::sqrt(0.5 * a2 * (1.0 + 1.0 / q) - pk * (1.0 - e2) * z2 / (q * (1.0 + q)) - 0.5 * pk * p2);
+  const double pe = p - e2 * r0;
+  const double u = std::sqrt(pe * pe + z2);
+  const double v = std::sqrt(pe * pe + (1.0 - e2) * z2);
+  const double z0 = b2 * z / (semiMajorAxis * v);
+
+  latitude = std::atan((z + secondEccentricitySquared * z0) / p) * radiansToDegrees;
+  longitude = std::atan2(y, x) * radiansToDegrees;
+  height = u * (1.0 - b2 / (semiMajorAxis * v));
+}
+
+/*!
+  \brief Converts the ECEF coordinates \a x, \a y and \a z to \a east,
+  \a north and \a up in \a frame.
+ */
+void GeocentricConversion::toEnu(const EnuFrame& frame, double x, double y, double z,
+                                 double& east, double& north, double& up)
+{
+  toEnu(frame, &x, &y, &z, 1, &east, &north, &up);
+}
+
+/*!
+  \brief Converts \a count ECEF coordinates from \a x, \a y and \a z to
+  \a east, \a north and \a up in \a frame. The outputs may be the input
+  arrays, converting them in place.
+ */
+void GeocentricConversion::toEnu(const EnuFrame& frame, const double* x, const double* y, const double* z,
+                                 std::size_t count, double* east, double* north, double* up)
+{
+  const double sinPhi = frame.sinLatitude;
+  const double cosPhi = frame.cosLatitude;
+  const double sinLambda = frame.sinLongitude;
+  const double cosLambda = frame.cosLongitude;
+
+  double dx[batchBlockSize];
+  double dy[batchBlockSize];
+  double dz[batchBlockSize];
+
+  for (std::size_t start = 0; start < count; start += batchBlockSize)
+  {
+    const std::size_t blockCount = std::min(batchBlockSize, count - start);
+
+    // the offsets are taken into local arrays first: the outputs may be the
+    // inputs, and checking six arrays against each other at run time is
+    // more than the compiler will do before giving up on vectorizing
+    for (std::size_t i = 0; i < blockCount; ++i)
+    {
+      dx[i] = x[start + i] - frame.originX;
+      dy[i] = y[start + i] - frame.originY;
+      dz[i] = z[start + i] - frame.originZ;
+    }
+
+    double* const blockEast = east + start;
+    double* const blockNorth = north + start;
+    double* const blockUp = up + start;
+    for (std::size_t i = 0; i < blockCount; ++i)
+    {
+      blockEast[i] = -sinLambda * dx[i] + cosLambda * dy[i];
+      blockNorth[i] = -sinPhi * cosLambda * dx[i] - sinPhi * sinLambda * dy[i] + cosPhi * dz[i];
+      blockUp[i] = cosPhi * cosLambda * dx[i] + cosPhi * sinLambda * dy[i] + sinPhi * dz[i];
+    }
+  }
+}
+
+/*!
+  \brief Converts \a east, \a north and \a up in \a frame to the ECEF
+  coordinates \a x, \a y and \a z.
+ */
+void GeocentricConversion::fromEnu(const EnuFrame& frame, double east, double north, double up,
+                                   double& x, double& y, double& z)
+{
+  const double sinPhi = frame.sinLatitude;
+  const double cosPhi = frame.cosLatitude;
+  const double sinLambda = frame.sinLongitude;
+  const double cosLambda = frame.cosLongitude;
+
+  x = frame.originX - sinLambda * east - sinPhi * cosLambda * north + cosPhi * cosLambda * up;
+  y = frame.originY + cosLambda * east - sinPhi * sinLambda * north + cosPhi * sinLambda * up;
+  z = frame.originZ + cosPhi * north + sinPhi * up;
+}
+
+/*!
+  \brief Writes \a first, \a second and \a third with \a decimalPlaces
+  decimal places into \a buffer, separated by a space if \a addSpaces is
+  \c true and by a comma otherwise.
+
+  Returns the number of characters written, or \c 0 if \a decimalPlaces is
+  out of range or a value is too large. \a buffer must hold at least
+  \l bufferSize characters.
+ */
+int GeocentricConversion::format(double first, double second, double third, int decimalPlaces, bool addSpaces,
+                                 char* buffer)
+{
+  if (decimalPlaces < 0 || decimalPlaces > maximumDecimalPlaces)
+    return 0;
+
+  const double values[3] = { first, second, third };
+  char* out = buffer;
+  for (int i = 0; i < 3; ++i)
+  {
+    // also rejects NaN
+    if (!(std::fabs(values[i]) <= largestFormattedValue))
+      return 0;
+
+    if (i > 0)
+      *out++ = addSpaces ? ' ' : ',';
+
+    out = writeNumber(out, values[i], decimalPlaces);
+  }
+
+  return static_cast<int>(out - buffer);
+}
+
+/*!
+  \brief Reads three decimal numbers from the first \a length characters of
+  \a text into \a first, \a second and \a third.
+
+  The numbers may be separated by spaces, tabs, commas or a mix of them.
+  Returns \c false if \a text does not hold exactly three numbers.
+ */
+bool GeocentricConversion::parse(const char* text, int length, double& first, double& second, double& third)
+{
+  double* values[3] = { &first, &second, &third };
+  int position = 0;
+  for (int i = 0; i < 3; ++i)
+  {
+    const int start = position;
+    while (position < length && isSeparator(text[position]))
+      ++position;
+
+    // numbers must be separated, and a comma may appear only once between two
+    if (i > 0 && position == start)
+      return false;
+
+    int commas = 0;
+    for (int j = start; j < position; ++j)
+      commas += text[j] == ',' ? 1 : 0;
+    if (commas > (i > 0 ? 1 : 0))
+      return false;
+
+    if (!readNumber(text, length, position, *values[i]))
+      return false;
+  }
+
+  while (position < length && (text[position] == ' ' || text[position] == '\t'))
+    ++position;
+
+  return position == length;
+}
+
+} // Toolkit
+} // ArcGISRuntime
+} // Esri
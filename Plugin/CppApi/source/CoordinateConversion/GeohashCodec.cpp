@@ -0,0 +1,345 @@
+/*******************************************************************************
+ *  Copyright 2012-2018 Esri
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ******************************************************************************/
+
+
+#include "GeohashCodec.h"
+
+// STL headers
+#include <cmath>
+#include <cstdint>
+#include <limits>
+
+namespace Esri
+{
+namespace ArcGISRuntime
+{
+namespace Toolkit
+{
+
+namespace
+{
+
+constexpr char base32[] = "0123456789bcdefghjkmnpqrstuvwxyz";
+constexpr int bitsPerCharacter = 5;
+
+// decode table entry of characters outside the alphabet; the bit survives ORing valid entries together
+constexpr unsigned char invalidCharacter = 0x80;
+
+// number of points indexed together by the batch paths
+constexpr std::size_t batchBlockSize = 256;
+
+struct DecodeTable
+{
+  DecodeTable()
+  {
+    for (unsigned char& value : values)
+      value = invalidCharacter;
+
+    for (int i = 0; i < 32; ++i)
+    {
+      const char c = base32[i];
+      values[static_cast<unsigned char>(c)] = static_cast<unsigned char>(i);
+      if (c >= 'a' && c <= 'z')
+        values[static_cast<unsigned char>(c - 'a' + 'A')] = static_cast<unsigned char>(i);
+    }
+  }
+
+  unsigned char values[256];
+};
+
+const DecodeTable& decodeTable()
+{
+  static const DecodeTable table;
+  return table;
+}
+
+// how the bits of a geohash of some precision split between longitude and latitude
+struct Layout
+{
+  int longitudeShift;
+  int latitudeShift;
+  double longitudeCells;
+  double latitudeCells;
+};
+
+Layout layout(int precision)
+{
+  const int bits = bitsPerCharacter * precision;
+
+  // the first (most significant) bit is a longitude bit, so longitude takes
+  // the odd positions when the bit count is even
+  Layout result;
+  result.longitudeShift = 1 - (bits & 1);
+  result.latitudeShift = bits & 1;
+  result.longitudeCells = std::ldexp(1.0, (bits + 1) / 2);
+  result.latitudeCells = std::ldexp(1.0, bits / 2);
+  return result;
+}
+
+// spreads the low 32 bits of value into the even bits of the result
+std::uint64_t spread(std::uint64_t value)
+{
+  value &= 0x00000000ffffffffULL;
+  value = (value | (value << 16)) & 0x0000ffff0000ffffULL;
+  value = (value | (value << 8)) & 0x00ff00ff00ff00ffULL;
+  value = (value | (value << 4)) & 0x0f0f0f0f0f0f0f0fULL;
+  value = (value | (value << 2)) & 0x3333333333333333ULL;
+  value = (value | (value << 1)) & 0x5555555555555555ULL;
+  return value;
+}
+
+// the inverse of spread: gathers the even bits of value
+std::uint64_t compact(std::uint64_t value)
+{
+  value &= 0x5555555555555555ULL;
+  value = (value | (value >> 1)) & 0x3333333333333333ULL;
+  value = (value | (value >> 2)) & 0x0f0f0f0f0f0f0f0fULL;
+  value = (value | (value >> 4)) & 0x00ff00ff00ff00ffULL;
+  value = (value | (value >> 8)) & 0x0000ffff0000ffffULL;
+  value = (value | (value >> 16)) & 0x00000000ffffffffULL;
+  return value;
+}
+
+// the index of the cell holding shifted (0 to range) among cells equal cells
+std::uint64_t cellIndex(double shifted, double range, double cells)
+{
+  double index = std::floor(shifted / range * cells);
+  index = index < 0.0 ? 0.0 : (index > cells - 1.0 ? cells - 1.0 : index);
+  return static_cast<std::uint64_t>(index);
+}
+
+std::uint64_t interleave(double latitude, double longitude, const Layout& bits)
+{
+  return (spread(cellIndex(longitude + 180.0, 360.0, bits.longitudeCells)) << bits.longitudeShift) |
+      (spread(cellIndex(latitude + 90.0, 180.0, bits.latitudeCells)) << bits.latitudeShift);
+}
+
+void writeGeohash(std::uint64_t code, int precision, char* out)
+{
+  for (int i = precision - 1; i >= 0; --i)
+  {
+    out[i] = base32[code & 31];
+    code >>= bitsPerCharacter;
+  }
+}
+
+void cellBounds(std::uint64_t code, const Layout& bits, double& south, double& west, double& north, double& east)
+{
+  const double longitudeSize = 360.0 / bits.longitudeCells;
+  const double latitudeSize = 180.0 / bits.latitudeCells;
+  west = -180.0 + static_cast<double>(compact(code >> bits.longitudeShift)) * longitudeSize;
+  south = -90.0 + static_cast<double>(compact(code >> bits.latitudeShift)) * latitudeSize;
+  east = west + longitudeSize;
+  north = south + latitudeSize;
+}
+
+} // namespace
+
+/*!
+  \class Esri::ArcGISRuntime::Toolkit::GeohashCodec
+  \ingroup ToolCoordinateConversion
+  \inmodule ArcGISQtToolkit
+  \brief A native encoder and decoder for geohashes.
+  \since Esri::ArcGISRuntime 100.4
+
+  A geohash interleaves the bits of the longitude and latitude cell indices,
+  longitude first, and writes them five at a time in a base 32 alphabet.
+  Each character of \c precision narrows the cell by a factor of 32, up to
+  \l maximumPrecision characters.
+
+  The cell indices are interleaved with shifts and masks rather than by
+  bisecting the coordinate bit by bit, so the batch \l encode and
+  \l decode overloads run without branches over contiguous arrays. Decoding
+  returns either the centre of the cell or its bounds.
+ */
+
+/*!
+  \brief Writes the geohash of \a latitude and \a longitude (WGS 84 degrees)
+  with \a precision characters into \a buffer.
+
+  Returns the number of characters written, or \c 0 if the coordinate or
+  \a precision is not valid.
+ */
+int GeohashCodec::encode(double latitude, double longitude, int precision, char* buffer)
+{
+  if (precision < 1 || precision > maximumPrecision ||
+      !std::isfinite(latitude) || !std::isfinite(longitude) || latitude < -90.0 || latitude > 90.0)
+  {
+    return 0;
+  }
+
+  if (longitude < -180.0 || longitude > 180.0)
+    longitude = std::remainder(longitude, 360.0);
+
+  writeGeohash(interleave(latitude, longitude, layout(precision)), precision, buffer);
+  return precision;
+}
+
+/*!
+  \brief Writes the geohashes of \a count points from \a latitudes and
+  \a longitudes into \a buffer.
+
+  Every geohash is \a precision characters long and geohash \c i starts at
+  \c {i * precision}; invalid points are written as spaces. Returns
+  \a precision, or \c 0 if it is not valid.
+ */
+int GeohashCodec::encode(const double* latitudes, const double* longitudes, std::size_t count, int precision, char* buffer)
+{
+  if (precision < 1 || precision > maximumPrecision)
+    return 0;
+
+  const Layout bits = layout(precision);
+  std::uint64_t codes[batchBlockSize];
+  bool valid[batchBlockSize];
+
+  for (std::size_t blockStart = 0; blockStart < count; blockStart += batchBlockSize)
+  {
+    const std::size_t blockCount = (count - blockStart) < batchBlockSize ? (count - blockStart) : batchBlockSize;
+    const double* blockLatitudes = latitudes + blockStart;
+    const double* blockLongitudes = longitudes + blockStart;
+
+    for (std::size_t i = 0; i < blockCount; ++i)
+    {
+      double latitude = blockLatitudes[i];
+      double longitude = blockLongitudes[i];
+      valid[i] = latitude >= -90.0 && latitude <= 90.0 && std::isfinite(longitude);
+      latitude = valid[i] ? latitude : 0.0;
+      longitude = valid[i] ? longitude : 0.0;
+      if (longitude < -180.0 || longitude > 180.0)
+        longitude = std::remainder(longitude, 360.0);
+
+      codes[i] = interleave(latitude, longitude, bits);
+    }
+
+    char* out = buffer + blockStart * precision;
+    for (std::size_t i = 0; i < blockCount; ++i, out += precision)
+    {
+      if (valid[i])
+      {
+        writeGeohash(codes[i], precision, out);
+      }
+      else
+      {
+        for (int c = 0; c < precision; ++c)
+          out[c] = ' ';
+      }
+    }
+  }
+
+  return precision;
+}
+
+/*!
+  \brief Decodes the geohash in the first \a length characters of \a text
+  into the \a latitude and \a longitude (WGS 84 degrees) of the centre of
+  its cell.
+ */
+bool GeohashCodec::decode(const char* text, int length, double& latitude, double& longitude)
+{
+  double south = 0.0;
+  double west = 0.0;
+  double north = 0.0;
+  double east = 0.0;
+  if (!decode(text, length, south, west, north, east))
+    return false;
+
+  latitude = 0.5 * (south + north);
+  longitude = 0.5 * (west + east);
+  return true;
+}
+
+/*!
+  \brief Decodes the geohash in the first \a length characters of \a text
+  into the bounds of its cell: \a south, \a west, \a north and \a east in
+  WGS 84 degrees.
+
+  Spaces and tabs are ignored and letters may be in either case.
+ */
+bool GeohashCodec::decode(const char* text, int length, double& south, double& west, double& north, double& east)
+{
+  const DecodeTable& table = decodeTable();
+  std::uint64_t code = 0;
+  int precision = 0;
+  for (int i = 0; i < length; ++i)
+  {
+    const char c = text[i];
+    if (c == ' ' || c == '\t')
+      continue;
+
+    const unsigned char value = table.values[static_cast<unsigned char>(c)];
+    if (value == invalidCharacter || precision == maximumPrecision)
+      return false;
+
+    code = (code << bitsPerCharacter) | value;
+    ++precision;
+  }
+
+  if (precision == 0)
+    return false;
+
+  cellBounds(code, layout(precision), south, west, north, east);
+  return true;
+}
+
+/*!
+  \brief Decodes \a count geohashes of \a precision characters from
+  \a buffer into the centres of their cells in \a latitudes and
+  \a longitudes.
+
+  Geohash \c i starts at \c {i * precision}, as written by the batch
+  \l encode. Geohashes holding a character outside the alphabet decode to
+  NaN. Returns the number of geohashes decoded, or \c 0 if \a precision is
+  not valid.
+ */
+std::size_t GeohashCodec::decode(const char* buffer, std::size_t count, int precision, double* latitudes, double* longitudes)
+{
+  if (precision < 1 || precision > maximumPrecision)
+    return 0;
+
+  const DecodeTable& table = decodeTable();
+  const Layout bits = layout(precision);
+  const double nan = std::numeric_limits<double>::quiet_NaN();
+  std::size_t decoded = 0;
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    const char* text = buffer + i * precision;
+    std::uint64_t code = 0;
+    unsigned char invalid = 0;
+    for (int c = 0; c < precision; ++c)
+    {
+      const unsigned char value = table.values[static_cast<unsigned char>(text[c])];
+      invalid |= value;
+      code = (code << bitsPerCharacter) | (value & 31u);
+    }
+
+    double south = 0.0;
+    double west = 0.0;
+    double north = 0.0;
+    double east = 0.0;
+    cellBounds(code, bits, south, west, north, east);
+
+    const bool valid = (invalid & invalidCharacter) == 0;
+    latitudes[i] = valid ? 0.5 * (south + north) : nan;
+    longitudes[i] = valid ? 0.5 * (west + east) : nan;
+    decoded += valid ? 1 : 0;
+  }
+
+  return decoded;
+}
+
+} // Toolkit
+} // ArcGISRuntime
+} // Esri
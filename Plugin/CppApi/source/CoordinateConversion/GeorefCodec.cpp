@@ -0,0 +1,284 @@
+/*******************************************************************************
+ *  Copyright 2012-2018 Esri
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ******************************************************************************/
+
+#include "GeorefCodec.h"
+
+// STL headers
+#include <cmath>
+#include <cstdint>
+
+namespace Esri
+{
+namespace ArcGISRuntime
+{
+namespace Toolkit
+{
+
+namespace
+{
+
+// 15 degree tiles: 24 longitude letters, 12 latitude letters
+constexpr char tileLetters[] = "ABCDEFGHJKLMNPQRSTUVWXYZ";
+constexpr int longitudeTileCount = 24;
+constexpr int latitudeTileCount = 12;
+
+// 1 degree letters within a tile
+constexpr char degreeLetters[] = "ABCDEFGHJKLMNPQ";
+constexpr int degreesPerTile = 15;
+
+constexpr double minutesPerDegree = 60.0;
+
+// number of points indexed together by the batch path
+constexpr std::size_t batchBlockSize = 256;
+
+struct CellIndex
+{
+  int degree;
+  std::int64_t minutes;
+};
+
+// splits a shifted coordinate (0 to 360 or 0 to 180) into whole degrees and
+// minutes truncated to precision digits
+CellIndex cellIndex(double shifted, int maximumDegree, int precision)
+{
+  int degree = static_cast<int>(std::floor(shifted));
+  degree = degree < 0 ? 0 : (degree > maximumDegree ? maximumDegree : degree);
+
+  // minutes in units of the last digit: 10 minutes at precision 1, 1 minute at 2, ...
+  const double unitsPerMinute = std::pow(10.0, precision - 2);
+  const std::int64_t maximumMinutes = static_cast<std::int64_t>(std::ceil(minutesPerDegree * unitsPerMinute)) - 1;
+  std::int64_t minutes = static_cast<std::int64_t>(std::floor((shifted - degree) * minutesPerDegree * unitsPerMinute));
+  minutes = minutes < 0 ? 0 : (minutes > maximumMinutes ? maximumMinutes : minutes);
+
+  return CellIndex{degree, minutes};
+}
+
+char* writeDigits(char* out, std::int64_t value, int width)
+{
+  for (int i = width - 1; i >= 0; --i)
+  {
+    out[i] = static_cast<char>('0' + value % 10);
+    value /= 10;
+  }
+
+  return out + width;
+}
+
+int writeReference(const CellIndex& longitude, const CellIndex& latitude, int precision, char* buffer)
+{
+  char* out = buffer;
+  *out++ = tileLetters[longitude.degree / degreesPerTile];
+  *out++ = tileLetters[latitude.degree / degreesPerTile];
+  *out++ = degreeLetters[longitude.degree % degreesPerTile];
+  *out++ = degreeLetters[latitude.degree % degreesPerTile];
+
+  if (precision > 0)
+  {
+    out = writeDigits(out, longitude.minutes, precision);
+    out = writeDigits(out, latitude.minutes, precision);
+  }
+
+  return static_cast<int>(out - buffer);
+}
+
+int letterIndex(const char* letters, int letterCount, char letter)
+{
+  if (letter >= 'a' && letter <= 'z')
+    letter = static_cast<char>(letter - 'a' + 'A');
+
+  for (int i = 0; i < letterCount; ++i)
+  {
+    if (letters[i] == letter)
+      return i;
+  }
+
+  return -1;
+}
+
+} // namespace
+
+/*!
+  \class Esri::ArcGISRuntime::Toolkit::GeorefCodec
+  \ingroup ToolCoordinateConversion
+  \inmodule ArcGISQtToolkit
+  \brief A native encoder and decoder for the World Geographic Reference System.
+  \since Esri::ArcGISRuntime 100.4
+
+  A GEOREF reference is two letters for the 15 degree tile, two letters for
+  the degree within the tile and then the longitude and latitude minutes,
+  each truncated to \c precision digits: 1 digit is tens of minutes, 2 digits
+  whole minutes, 3 digits tenths of minutes and so on up to
+  \l maximumPrecision.
+
+  The batch \l encode overload produces fixed-width references for
+  contiguous latitude and longitude arrays.
+ */
+
+/*!
+  \brief Returns the number of characters in a reference with \a precision
+  digits per coordinate.
+ */
+int GeorefCodec::notationLength(int precision)
+{
+  return 4 + 2 * precision;
+}
+
+/*!
+  \brief Writes the GEOREF reference for \a latitude and \a longitude (WGS 84
+  degrees), with \a precision digits of minutes per coordinate, into
+  \a buffer.
+
+  Returns the number of characters written, or \c 0 if the coordinate or
+  \a precision is not valid.
+ */
+int GeorefCodec::encode(double latitude, double longitude, int precision, char* buffer)
+{
+  if (precision < 0 || precision > maximumPrecision ||
+      !std::isfinite(latitude) || !std::isfinite(longitude) || latitude < -90.0 || latitude > 90.0)
+  {
+    return 0;
+  }
+
+  if (longitude < -180.0 || longitude > 180.0)
+    longitude = std::remainder(longitude, 360.0);
+
+  return writeReference(cellIndex(longitude + 180.0, longitudeTileCount * degreesPerTile - 1, precision),
+                        cellIndex(latitude + 90.0, latitudeTileCount * degreesPerTile - 1, precision),
+                        precision, buffer);
+}
+
+/*!
+  \brief Writes the GEOREF references for \a count points from \a latitudes
+  and \a longitudes into \a buffer.
+
+  Every reference is \l notationLength(\a precision) characters long and
+  reference \c i starts at \c {i * notationLength(precision)}; invalid points
+  are written as spaces. Returns the length of each reference, or \c 0 if
+  \a precision is not valid.
+ */
+int GeorefCodec::encode(const double* latitudes, const double* longitudes, std::size_t count, int precision, char* buffer)
+{
+  if (precision < 0 || precision > maximumPrecision)
+    return 0;
+
+  const int length = notationLength(precision);
+  CellIndex longitudeCells[batchBlockSize];
+  CellIndex latitudeCells[batchBlockSize];
+  bool valid[batchBlockSize];
+
+  for (std::size_t blockStart = 0; blockStart < count; blockStart += batchBlockSize)
+  {
+    const std::size_t blockCount = (count - blockStart) < batchBlockSize ? (count - blockStart) : batchBlockSize;
+    const double* blockLatitudes = latitudes + blockStart;
+    const double* blockLongitudes = longitudes + blockStart;
+
+    for (std::size_t i = 0; i < blockCount; ++i)
+    {
+      double latitude = blockLatitudes[i];
+      double longitude = blockLongitudes[i];
+      valid[i] = latitude >= -90.0 && latitude <= 90.0 && std::isfinite(longitude);
+      latitude = valid[i] ? latitude : 0.0;
+      longitude = valid[i] ? longitude : 0.0;
+      if (longitude < -180.0 || longitude > 180.0)
+        longitude = std::remainder(longitude, 360.0);
+
+      longitudeCells[i] = cellIndex(longitude + 180.0, longitudeTileCount * degreesPerTile - 1, precision);
+      latitudeCells[i] = cellIndex(latitude + 90.0, latitudeTileCount * degreesPerTile - 1, precision);
+    }
+
+    char* out = buffer + blockStart * length;
+    for (std::size_t i = 0; i < blockCount; ++i, out += length)
+    {
+      if (valid[i])
+      {
+        writeReference(longitudeCells[i], latitudeCells[i], precision, out);
+      }
+      else
+      {
+        for (int c = 0; c < length; ++c)
+          out[c] = ' ';
+      }
+    }
+  }
+
+  return length;
+}
+
+/*!
+  \brief Decodes the GEOREF reference in the first \a length characters of
+  \a text into the \a latitude and \a longitude (WGS 84 degrees) of the
+  centre of the referenced cell.
+ */
+bool GeorefCodec::decode(const char* text, int length, double& latitude, double& longitude)
+{
+  char letters[4];
+  char digits[2 * maximumPrecision];
+  int letterCount = 0;
+  int digitCount = 0;
+  for (int i = 0; i < length; ++i)
+  {
+    const char c = text[i];
+    if (c == ' ' || c == '\t')
+      continue;
+
+    if (letterCount < 4)
+    {
+      letters[letterCount++] = c;
+    }
+    else
+    {
+      if (c < '0' || c > '9' || digitCount == 2 * maximumPrecision)
+        return false;
+
+      digits[digitCount++] = c;
+    }
+  }
+
+  if (letterCount < 4 || digitCount % 2 != 0)
+    return false;
+
+  const int longitudeTile = letterIndex(tileLetters, longitudeTileCount, letters[0]);
+  const int latitudeTile = letterIndex(tileLetters, latitudeTileCount, letters[1]);
+  const int longitudeDegree = letterIndex(degreeLetters, degreesPerTile, letters[2]);
+  const int latitudeDegree = letterIndex(degreeLetters, degreesPerTile, letters[3]);
+  if (longitudeTile < 0 || latitudeTile < 0 || longitudeDegree < 0 || latitudeDegree < 0)
+    return false;
+
+  const int precision = digitCount / 2;
+  std::int64_t longitudeMinutes = 0;
+  std::int64_t latitudeMinutes = 0;
+  for (int i = 0; i < precision; ++i)
+  {
+    longitudeMinutes = longitudeMinutes * 10 + (digits[i] - '0');
+    latitudeMinutes = latitudeMinutes * 10 + (digits[precision + i] - '0');
+  }
+
+  // the size of the referenced cell in degrees: a whole degree without digits
+  const double minutesPerUnit = std::pow(10.0, 2 - precision);
+  const double cellSize = precision == 0 ? 1.0 : minutesPerUnit / minutesPerDegree;
+
+  longitude = -180.0 + longitudeTile * degreesPerTile + longitudeDegree +
+      static_cast<double>(longitudeMinutes) * minutesPerUnit / minutesPerDegree + 0.5 * cellSize;
+  latitude = -90.0 + latitudeTile * degreesPerTile + latitudeDegree +
+      static_cast<double>(latitudeMinutes) * minutesPerUnit / minutesPerDegree + 0.5 * cellSize;
+
+  return latitude <= 90.0 && (longitudeMinutes * minutesPerUnit) < minutesPerDegree &&
+      (latitudeMinutes * minutesPerUnit) < minutesPerDegree;
+}
+
+} // Toolkit
+} // ArcGISRuntime
+} // Esri
@@ -0,0 +1,558 @@
+/*******************************************************************************
+ *  Copyright 2012-2018 Esri
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ******************************************************************************/
+
+#include "GridOverlayController.h"
+
+// toolkit headers
+#include "CoordinateConversionConstants.h"
+#include "NativeConversionSupport.h"
+#include "ToolManager.h"
+#include "ToolResourceProvider.h"
+
+// C++ API headers
+#include "GeometryEngine.h"
+#include "Graphic.h"
+#include "GraphicsOverlay.h"
+#include "MapQuickView.h"
+#include "Part.h"
+#include "PartCollection.h"
+#include "PolylineBuilder.h"
+#include "SimpleLineSymbol.h"
+#include "TextSymbol.h"
+
+// Qt headers
+#include <QColor>
+#include <QSet>
+#include <QTimer>
+
+// STL headers
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+/*!
+  \class Esri::ArcGISRuntime::Toolkit::GridOverlayController
+  \ingroup ToolCoordinateConversion
+  \inmodule ArcGISQtToolkit
+  \since Esri::ArcGISRuntime 100.4
+  \brief Draws the MGRS, USNG or UTM grid over the visible area of a map.
+
+  The grid is drawn in a graphics overlay added to the map view: the zone
+  and latitude band boundaries at every scale, and the 100 km square lines
+  and finer lines as the view zooms in. The level of detail is chosen so
+  that about 20 lines cross the view.
+
+  The geometry is generated by \l GridOverlayGenerator in tiles, which are
+  cached. When the view pans only the tiles coming into view are added to
+  the overlay, mostly from the cache, and those leaving it are removed.
+
+  Scene views are not supported.
+ */
+
+namespace Esri
+{
+namespace ArcGISRuntime
+{
+namespace Toolkit
+{
+
+namespace
+{
+
+constexpr int wgs84Wkid = 4326;
+constexpr double metresPerDegree = 111320.0;
+constexpr double degreesToRadians = 3.14159265358979323846 / 180.0;
+
+// the most tiles displayed at levels 1 and above; the level is lowered until the view fits
+constexpr std::size_t maximumVisibleTiles = 64;
+
+// zone labels are left out when more zones than this are visible
+constexpr std::size_t maximumLabelledZones = 120;
+
+// the tile cache is bounded by the number of vertices it holds
+constexpr int tileCacheVertices = 200000;
+
+constexpr float labelSize = 11.0f;
+
+const QColor lineColors[GridOverlayGenerator::maximumLevel + 1] =
+{
+  QColor(255, 128, 0), QColor(0, 96, 255), QColor(0, 160, 96),
+  QColor(0, 160, 96), QColor(0, 160, 96), QColor(0, 160, 96)
+};
+
+const float lineWidths[GridOverlayGenerator::maximumLevel + 1] = { 2.0f, 1.5f, 1.0f, 1.0f, 1.0f, 1.0f };
+
+// returns the longitude in [-180, 180)
+double normalizedLongitude(double longitude)
+{
+  longitude = std::fmod(longitude + 180.0, 360.0);
+  if (longitude < 0.0)
+    longitude += 360.0;
+
+  return longitude - 180.0;
+}
+
+} // namespace
+
+/*!
+  \brief Constructor taking an optional \a parent.
+ */
+GridOverlayController::GridOverlayController(QObject* parent) :
+  AbstractTool(parent),
+  m_tileCache(tileCacheVertices),
+  m_gridFormat(CoordinateConversionConstants::MGRS_FORMAT)
+{
+  ToolManager::instance().addTool(this);
+  m_active = true;
+
+  m_graphicsOverlay = new GraphicsOverlay(this);
+  for (int level = 0; level <= GridOverlayGenerator::maximumLevel; ++level)
+    m_lineSymbols.append(new SimpleLineSymbol(SimpleLineSymbolStyle::Solid, lineColors[level], lineWidths[level], this));
+
+  connect(ToolResourceProvider::instance(), &ToolResourceProvider::geoViewChanged, this, [this]()
+  {
+    setGeoViewInternal(ToolResourceProvider::instance()->geoView());
+  });
+
+  setGeoViewInternal(ToolResourceProvider::instance()->geoView());
+}
+
+/*!
+  \brief The destructor.
+ */
+GridOverlayController::~GridOverlayController()
+{
+  clearGrid();
+  attachToMapView(nullptr);
+}
+
+/*!
+  \brief Sets the map view the grid is drawn over to \a geoView.
+
+  Views other than a MapQuickView are ignored.
+ */
+void GridOverlayController::setGeoView(QObject* geoView)
+{
+  if (!geoView || std::strcmp(geoView->metaObject()->className(), MapQuickView::staticMetaObject.className()) != 0)
+    return;
+
+  attachToMapView(reinterpret_cast<MapQuickView*>(geoView));
+}
+
+/*!
+  \internal
+ */
+bool GridOverlayController::setGeoViewInternal(GeoView* geoView)
+{
+  MapQuickView* mapView = dynamic_cast<MapQuickView*>(geoView);
+  if (!mapView)
+    return false;
+
+  attachToMapView(mapView);
+  return true;
+}
+
+/*!
+  \internal
+
+  Moves the grid overlay to \a mapView, or just removes it if \a mapView is \c nullptr.
+ */
+void GridOverlayController::attachToMapView(MapQuickView* mapView)
+{
+  if (mapView == m_mapView)
+    return;
+
+  for (const QMetaObject::Connection& connection : m_viewConnections)
+    disconnect(connection);
+
+  m_viewConnections.clear();
+
+  if (m_mapView)
+    m_mapView->graphicsOverlays()->removeOne(m_graphicsOverlay);
+
+  m_mapView = mapView;
+  if (!m_mapView)
+    return;
+
+  m_mapView->graphicsOverlays()->append(m_graphicsOverlay);
+  m_viewConnections.append(connect(m_mapView, &MapQuickView::viewpointChanged, this, &GridOverlayController::scheduleUpdate));
+  m_viewConnections.append(connect(m_mapView, &QQuickItem::widthChanged, this, &GridOverlayController::scheduleUpdate));
+  m_viewConnections.append(connect(m_mapView, &QQuickItem::heightChanged, this, &GridOverlayController::scheduleUpdate));
+  m_viewConnections.append(connect(m_mapView, &QObject::destroyed, this, [this]()
+  {
+    m_mapView = nullptr;
+    m_viewConnections.clear();
+  }));
+
+  scheduleUpdate();
+}
+
+/*!
+  \brief Returns the name of this tool.
+ */
+QString GridOverlayController::toolName() const
+{
+  return "GridOverlay";
+}
+
+/*!
+  \brief Shows the grid if \a active is \c true and hides it otherwise.
+ */
+void GridOverlayController::setActive(bool active)
+{
+  if (active == m_active)
+    return;
+
+  m_graphicsOverlay->setVisible(active);
+  AbstractTool::setActive(active);
+
+  if (active)
+    scheduleUpdate();
+}
+
+/*!
+  \property GridOverlayController::gridFormat
+  \brief The grid drawn: \c MGRS, \c USNG or \c UTM.
+
+  MGRS and USNG label the 100 km squares with their two letters; UTM labels
+  them, like the finer lines, with their principal digits. The default is
+  MGRS.
+ */
+QString GridOverlayController::gridFormat() const
+{
+  return m_gridFormat;
+}
+
+/*!
+  \brief Sets the grid drawn to \a gridFormat.
+ */
+void GridOverlayController::setGridFormat(const QString& gridFormat)
+{
+  QString format;
+  if (gridFormat.compare(CoordinateConversionConstants::MGRS_FORMAT, Qt::CaseInsensitive) == 0)
+    format = CoordinateConversionConstants::MGRS_FORMAT;
+  else if (gridFormat.compare(CoordinateConversionConstants::USNG_FORMAT, Qt::CaseInsensitive) == 0)
+    format = CoordinateConversionConstants::USNG_FORMAT;
+  else if (gridFormat.compare(CoordinateConversionConstants::UTM_FORMAT, Qt::CaseInsensitive) == 0)
+    format = CoordinateConversionConstants::UTM_FORMAT;
+
+  if (format.isEmpty() || format == m_gridFormat)
+    return;
+
+  // only the labels of level 1 differ, but regenerating everything keeps this simple
+  m_gridFormat = format;
+  clearGrid();
+  m_tileCache.clear();
+  emit gridFormatChanged();
+
+  scheduleUpdate();
+}
+
+/*!
+  \property GridOverlayController::mgrsConversionMode
+  \brief The MGRS conversion mode of the option the grid is shown for.
+
+  The old modes label the 100 km squares with the AL lettering scheme and
+  every other mode with the AA scheme, matching the notations of that
+  option. Bind it to the \c mgrsConversionMode of the active MGRS option.
+  The default is \c MgrsConversionMode::Automatic.
+ */
+MgrsConversionMode GridOverlayController::mgrsConversionMode() const
+{
+  return m_mgrsConversionMode;
+}
+
+/*!
+  \brief Sets the MGRS conversion mode to \a mgrsConversionMode.
+ */
+void GridOverlayController::setMgrsConversionMode(MgrsConversionMode mgrsConversionMode)
+{
+  if (mgrsConversionMode == m_mgrsConversionMode)
+    return;
+
+  const bool relabel = NativeConversionSupport::mgrsLetteringScheme(mgrsConversionMode) !=
+      NativeConversionSupport::mgrsLetteringScheme(m_mgrsConversionMode);
+  m_mgrsConversionMode = mgrsConversionMode;
+  emit mgrsConversionModeChanged();
+
+  if (!relabel)
+    return;
+
+  clearGrid();
+  m_tileCache.clear();
+  scheduleUpdate();
+}
+
+/*!
+  \property GridOverlayController::level
+  \brief The level of detail drawn for the visible area.
+
+  Level 0 draws the zone and latitude band boundaries only, level 1 adds the
+  100 km squares and each further level lines ten times closer together.
+ */
+int GridOverlayController::level() const
+{
+  return m_level;
+}
+
+/*!
+  \property GridOverlayController::vertexCount
+  \brief The number of grid line vertices in the overlay.
+ */
+int GridOverlayController::vertexCount() const
+{
+  return m_vertexCount;
+}
+
+/*!
+  \internal
+
+  Coalesces the viewpoint changes of one event loop pass into a single update.
+ */
+void GridOverlayController::scheduleUpdate()
+{
+  if (m_updateScheduled || !m_active)
+    return;
+
+  m_updateScheduled = true;
+  QTimer::singleShot(0, this, &GridOverlayController::updateGrid);
+}
+
+/*!
+  \internal
+
+  Works out the tiles covering the visible area and brings the overlay in
+  line with them, adding and removing only the tiles which changed.
+ */
+void GridOverlayController::updateGrid()
+{
+  m_updateScheduled = false;
+  if (!m_mapView || !m_active)
+    return;
+
+  const Polygon visibleArea = m_mapView->visibleArea();
+  if (visibleArea.isEmpty())
+    return;
+
+  const Envelope extent = GeometryEngine::project(visibleArea, SpatialReference(wgs84Wkid)).extent();
+  if (extent.isEmpty())
+    return;
+
+  const double south = extent.yMin();
+  const double north = extent.yMax();
+  double west = -180.0;
+  double east = 180.0;
+  if (extent.xMax() - extent.xMin() < 360.0)
+  {
+    west = normalizedLongitude(extent.xMin());
+    east = normalizedLongitude(extent.xMax());
+  }
+
+  // the width across the middle of the view
+  const double middleLatitude = 0.5 * (qBound(-90.0, south, 90.0) + qBound(-90.0, north, 90.0));
+  const double width = (extent.xMax() - extent.xMin()) * metresPerDegree * std::cos(middleLatitude * degreesToRadians);
+
+  std::vector<GridOverlayGenerator::TileKey> zoneTiles;
+  GridOverlayGenerator::visibleTiles(south, west, north, east, 0, 60 * 20, zoneTiles);
+
+  std::vector<GridOverlayGenerator::TileKey> gridTiles;
+  int level = GridOverlayGenerator::levelForWidth(width);
+  while (level > 0 && !GridOverlayGenerator::visibleTiles(south, west, north, east, level, maximumVisibleTiles, gridTiles))
+    --level;
+
+  if (level == 0)
+    gridTiles.clear();
+
+  QSet<GridOverlayGenerator::TileKey> visible;
+  for (const GridOverlayGenerator::TileKey& key : zoneTiles)
+    visible.insert(key);
+
+  for (const GridOverlayGenerator::TileKey& key : gridTiles)
+    visible.insert(key);
+
+  const QList<GridOverlayGenerator::TileKey> displayed = m_displayedTiles.keys();
+  for (const GridOverlayGenerator::TileKey& key : displayed)
+  {
+    if (!visible.contains(key))
+      removeTile(key);
+  }
+
+  const bool labelZones = zoneTiles.size() <= maximumLabelledZones;
+  for (const GridOverlayGenerator::TileKey& key : zoneTiles)
+    showTile(key, labelZones);
+
+  for (const GridOverlayGenerator::TileKey& key : gridTiles)
+    showTile(key, true);
+
+  if (level != m_level)
+  {
+    m_level = level;
+    emit levelChanged();
+  }
+}
+
+/*!
+  \internal
+
+  Returns the geometry of the tile \a key, generating it on a cache miss.
+ */
+const GridOverlayController::CachedTile* GridOverlayController::cachedTile(const GridOverlayGenerator::TileKey& key)
+{
+  if (const CachedTile* tile = m_tileCache.object(key))
+    return tile;
+
+  GridOverlayGenerator::Tile generated;
+  const bool squareIdentifiers = m_gridFormat != CoordinateConversionConstants::UTM_FORMAT;
+
+  // USNG always uses the AA scheme
+  const TransverseMercatorGrid::LetteringScheme scheme = m_gridFormat == CoordinateConversionConstants::MGRS_FORMAT ?
+        NativeConversionSupport::mgrsLetteringScheme(m_mgrsConversionMode) : TransverseMercatorGrid::LetteringScheme::New;
+  GridOverlayGenerator::generateTile(key, squareIdentifiers, scheme, generated);
+
+  const SpatialReference wgs84(wgs84Wkid);
+  CachedTile* tile = new CachedTile;
+  tile->vertexCount = static_cast<int>(generated.vertices.size());
+
+  PolylineBuilder builder(wgs84);
+  for (std::size_t line = 0; line < generated.lineStarts.size(); ++line)
+  {
+    const std::size_t end = line + 1 < generated.lineStarts.size() ? generated.lineStarts[line + 1] : generated.vertices.size();
+    Part* part = new Part(wgs84, &builder);
+    for (std::size_t i = generated.lineStarts[line]; i < end; ++i)
+      part->addPoint(Point(generated.vertices[i].longitude, generated.vertices[i].latitude, wgs84));
+
+    builder.parts()->addPart(part);
+  }
+
+  tile->lines = builder.toPolyline();
+
+  for (const GridOverlayGenerator::Label& label : generated.labels)
+  {
+    tile->labelPositions.append(Point(label.position.longitude, label.position.latitude, wgs84));
+    tile->labelTexts.append(QString::fromLatin1(label.text, label.length));
+  }
+
+  // a tile larger than the whole cache is deleted by insert
+  if (!m_tileCache.insert(key, tile, qMax(1, tile->vertexCount)))
+    return nullptr;
+
+  return m_tileCache.object(key);
+}
+
+/*!
+  \internal
+
+  Adds the graphics of the tile \a key to the overlay, with its labels if
+  \a labelled is \c true. A tile already shown is only updated if its
+  labelling changed.
+ */
+void GridOverlayController::showTile(const GridOverlayGenerator::TileKey& key, bool labelled)
+{
+  auto it = m_displayedTiles.constFind(key);
+  if (it != m_displayedTiles.constEnd())
+  {
+    // the tile is shown already; only a change of labelling needs it rebuilt
+    if (it->labelled == labelled)
+      return;
+
+    removeTile(key);
+  }
+
+  // valid until the next tile is generated, which may evict it
+  const CachedTile* tile = cachedTile(key);
+  if (!tile)
+    return;
+
+  DisplayedTile displayed;
+  displayed.vertexCount = tile->vertexCount;
+  displayed.labelled = labelled;
+
+  Graphic* lines = new Graphic(tile->lines, m_lineSymbols.at(key.level), this);
+  displayed.graphics.append(lines);
+
+  if (labelled)
+  {
+    const QColor& color = lineColors[key.level];
+    for (int i = 0; i < tile->labelPositions.size(); ++i)
+    {
+      TextSymbol* symbol = new TextSymbol(tile->labelTexts.at(i), color, labelSize,
+                                          HorizontalAlignment::Center, VerticalAlignment::Middle, this);
+      displayed.symbols.append(symbol);
+      displayed.graphics.append(new Graphic(tile->labelPositions.at(i), symbol, this));
+    }
+  }
+
+  for (Graphic* graphic : displayed.graphics)
+    m_graphicsOverlay->graphics()->append(graphic);
+
+  m_vertexCount += displayed.vertexCount;
+  m_displayedTiles.insert(key, displayed);
+  emit vertexCountChanged();
+}
+
+/*!
+  \internal
+
+  Removes the graphics of the tile \a key from the overlay.
+ */
+void GridOverlayController::removeTile(const GridOverlayGenerator::TileKey& key)
+{
+  auto it = m_displayedTiles.find(key);
+  if (it == m_displayedTiles.end())
+    return;
+
+  for (Graphic* graphic : it->graphics)
+  {
+    m_graphicsOverlay->graphics()->removeOne(graphic);
+    delete graphic;
+  }
+
+  qDeleteAll(it->symbols);
+  m_vertexCount -= it->vertexCount;
+  m_displayedTiles.erase(it);
+  emit vertexCountChanged();
+}
+
+/*!
+  \internal
+
+  Removes every tile from the overlay.
+ */
+void GridOverlayController::clearGrid()
+{
+  const QList<GridOverlayGenerator::TileKey> displayed = m_displayedTiles.keys();
+  for (const GridOverlayGenerator::TileKey& key : displayed)
+    removeTile(key);
+}
+
+/*!
+  \fn void GridOverlayController::gridFormatChanged();
+  \brief Signal emitted when the \l gridFormat changes.
+ */
+
+/*!
+  \fn void GridOverlayController::levelChanged();
+  \brief Signal emitted when the \l level of detail drawn changes.
+ */
+
+/*!
+  \fn void GridOverlayController::vertexCountChanged();
+  \brief Signal emitted when the number of vertices in the overlay changes.
+ */
+
+} // Toolkit
+} // ArcGISRuntime
+} // Esri
@@ -0,0 +1,532 @@
+/*******************************************************************************
+ *  Copyright 2012-2018 Esri
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ******************************************************************************/
+
+#include "GridOverlayGenerator.h"
+
+// STL headers
+#include <algorithm>
+#include <cmath>
+#include <tuple>
+
+namespace Esri
+{
+namespace ArcGISRuntime
+{
+namespace Toolkit
+{
+
+namespace
+{
+
+using GridPosition = TransverseMercatorGrid::GridPosition;
+
+constexpr double minimumLatitude = -80.0;
+constexpr double maximumLatitude = 84.0;
+constexpr int bandCount = TransverseMercatorGrid::bandCount;
+
+constexpr double falseNorthingSouth = 10000000.0;
+constexpr double squareSize = 100000.0;
+
+// samples along each grid line of a tile, and bisection steps locating a zone edge between two of them
+constexpr int segmentsPerLine = 10;
+constexpr int edgeBisections = 12;
+
+// points sampled along each edge of a visible cell to bound its eastings and northings
+constexpr int edgeSamples = 5;
+
+GridPosition gridPosition(int zone, double easting, double signedNorthing)
+{
+  GridPosition position;
+  position.zone = zone;
+  position.north = signedNorthing >= 0.0;
+  position.easting = easting;
+  position.northing = position.north ? signedNorthing : signedNorthing + falseNorthingSouth;
+  return position;
+}
+
+double signedNorthing(const GridPosition& position)
+{
+  return position.north ? position.northing : position.northing - falseNorthingSouth;
+}
+
+// converts a grid position of zone to a vertex, returning whether it lies within the zone
+bool locate(int zone, double easting, double northing, GridOverlayGenerator::Vertex& vertex)
+{
+  if (!TransverseMercatorGrid::fromGridPosition(gridPosition(zone, easting, northing), vertex.latitude, vertex.longitude))
+    return false;
+
+  double west = 0.0;
+  double east = 0.0;
+  return TransverseMercatorGrid::zoneLongitudes(zone, vertex.latitude, west, east) &&
+      vertex.longitude >= west && vertex.longitude <= east;
+}
+
+GridOverlayGenerator::Vertex vertexAt(double latitude, double longitude)
+{
+  GridOverlayGenerator::Vertex vertex;
+  vertex.latitude = latitude;
+  vertex.longitude = longitude;
+  return vertex;
+}
+
+void startLine(GridOverlayGenerator::Tile& tile)
+{
+  // drop a line which ended up with a single vertex
+  if (!tile.lineStarts.empty() && tile.vertices.size() - tile.lineStarts.back() < 2)
+    tile.vertices.resize(tile.lineStarts.back());
+  else
+    tile.lineStarts.push_back(tile.vertices.size());
+}
+
+void finishTile(GridOverlayGenerator::Tile& tile)
+{
+  if (!tile.lineStarts.empty() && tile.vertices.size() - tile.lineStarts.back() < 2)
+  {
+    tile.vertices.resize(tile.lineStarts.back());
+    tile.lineStarts.pop_back();
+  }
+}
+
+// appends the parts of the straight grid line from (easting0, northing0) to
+// (easting1, northing1) which lie inside zone, cut exactly at the zone edges
+void traceLine(int zone, double easting0, double northing0, double easting1, double northing1,
+               GridOverlayGenerator::Tile& tile)
+{
+  bool lineOpen = false;
+  bool previousInside = false;
+  double previousFraction = 0.0;
+  GridOverlayGenerator::Vertex previous;
+
+  for (int i = 0; i <= segmentsPerLine; ++i)
+  {
+    const double fraction = static_cast<double>(i) / segmentsPerLine;
+    GridOverlayGenerator::Vertex vertex;
+    const bool inside = locate(zone, easting0 + fraction * (easting1 - easting0),
+                               northing0 + fraction * (northing1 - northing0), vertex);
+
+    if (i > 0 && inside != previousInside)
+    {
+      double insideFraction = previousInside ? previousFraction : fraction;
+      double outsideFraction = previousInside ? fraction : previousFraction;
+      GridOverlayGenerator::Vertex edge = previousInside ? previous : vertex;
+      for (int step = 0; step < edgeBisections; ++step)
+      {
+        const double middle = 0.5 * (insideFraction + outsideFraction);
+        GridOverlayGenerator::Vertex middleVertex;
+        if (locate(zone, easting0 + middle * (easting1 - easting0), northing0 + middle * (northing1 - northing0), middleVertex))
+        {
+          insideFraction = middle;
+          edge = middleVertex;
+        }
+        else
+        {
+          outsideFraction = middle;
+        }
+      }
+
+      if (previousInside)
+      {
+        tile.vertices.push_back(edge);
+        lineOpen = false;
+      }
+      else
+      {
+        startLine(tile);
+        tile.vertices.push_back(edge);
+        lineOpen = true;
+      }
+    }
+
+    if (inside)
+    {
+      if (!lineOpen)
+      {
+        startLine(tile);
+        lineOpen = true;
+      }
+
+      tile.vertices.push_back(vertex);
+    }
+
+    previous = vertex;
+    previousInside = inside;
+    previousFraction = fraction;
+  }
+}
+
+void addLabel(GridOverlayGenerator::Tile& tile, const GridOverlayGenerator::Vertex& position, const char* text, int length)
+{
+  GridOverlayGenerator::Label label;
+  label.position = position;
+  label.length = length < GridOverlayGenerator::labelSize ? length : GridOverlayGenerator::labelSize;
+  std::copy(text, text + label.length, label.text);
+  tile.labels.push_back(label);
+}
+
+// writes value as width zero-padded digits
+int writeDigits(char* out, long long value, int width)
+{
+  for (int i = width - 1; i >= 0; --i)
+  {
+    out[i] = static_cast<char>('0' + value % 10);
+    value /= 10;
+  }
+
+  return width;
+}
+
+void generateZoneTile(const GridOverlayGenerator::TileKey& key, GridOverlayGenerator::Tile& tile)
+{
+  const int band = key.row;
+  double south = 0.0;
+  double north = 0.0;
+  if (!TransverseMercatorGrid::bandLatitudes(band, south, north))
+    return;
+
+  double west = 0.0;
+  double east = 0.0;
+  if (!TransverseMercatorGrid::zoneLongitudes(key.zone, 0.5 * (south + north), west, east))
+    return;
+
+  // the west and south edges; the east and north ones belong to the neighbouring cells
+  const GridOverlayGenerator::Vertex edges[][2] =
+  {
+    { vertexAt(south, west), vertexAt(north, west) },
+    { vertexAt(south, west), vertexAt(south, east) },
+    { vertexAt(north, west), vertexAt(north, east) }
+  };
+  const int edgeCount = band == bandCount - 1 ? 3 : 2;
+  for (int i = 0; i < edgeCount; ++i)
+  {
+    tile.lineStarts.push_back(tile.vertices.size());
+    tile.vertices.push_back(edges[i][0]);
+    tile.vertices.push_back(edges[i][1]);
+  }
+
+  char text[GridOverlayGenerator::labelSize];
+  int length = writeDigits(text, key.zone, 2);
+  text[length++] = TransverseMercatorGrid::bandLetter(band);
+
+  addLabel(tile, vertexAt(0.5 * (south + north), 0.5 * (west + east)), text, length);
+}
+
+void generateGridTile(const GridOverlayGenerator::TileKey& key, bool squareIdentifiers,
+                      TransverseMercatorGrid::LetteringScheme scheme, GridOverlayGenerator::Tile& tile)
+{
+  const double spacing = GridOverlayGenerator::spacing(key.level);
+  const double tileSize = spacing * GridOverlayGenerator::linesPerTile;
+  const double easting0 = key.column * tileSize;
+  const double northing0 = key.row * tileSize;
+
+  // the west and south lines of each cell; the tile's east and north edges belong to its neighbours
+  for (int i = 0; i < GridOverlayGenerator::linesPerTile; ++i)
+  {
+    const double easting = easting0 + i * spacing;
+    traceLine(key.zone, easting, northing0, easting, northing0 + tileSize, tile);
+  }
+
+  for (int i = 0; i < GridOverlayGenerator::linesPerTile; ++i)
+  {
+    const double northing = northing0 + i * spacing;
+    traceLine(key.zone, easting0, northing, easting0 + tileSize, northing, tile);
+  }
+
+  finishTile(tile);
+
+  if (squareIdentifiers && key.level == 1)
+  {
+    // the two letters of each 100 km square, at its centre
+    for (int column = 0; column < GridOverlayGenerator::linesPerTile; ++column)
+    {
+      for (int row = 0; row < GridOverlayGenerator::linesPerTile; ++row)
+      {
+        GridOverlayGenerator::Vertex centre;
+        if (!locate(key.zone, easting0 + (column + 0.5) * spacing, northing0 + (row + 0.5) * spacing, centre))
+          continue;
+
+        GridPosition position;
+        char buffer[TransverseMercatorGrid::bufferSize];
+        if (!TransverseMercatorGrid::toZonePosition(centre.latitude, centre.longitude, key.zone, position))
+          continue;
+
+        const int length = TransverseMercatorGrid::formatMgrs(position, scheme, 0, false, buffer);
+        if (length >= 2)
+          addLabel(tile, centre, buffer + length - 2, 2);
+      }
+    }
+
+    return;
+  }
+
+  // the principal digits of each line, next to where it enters the tile
+  const int width = key.level == 1 ? 1 : 2;
+  long long modulus = 1;
+  for (int i = 0; i < width; ++i)
+    modulus *= 10;
+
+  for (int i = 0; i < GridOverlayGenerator::linesPerTile; ++i)
+  {
+    char text[GridOverlayGenerator::labelSize];
+
+    const double easting = easting0 + i * spacing;
+    GridOverlayGenerator::Vertex position;
+    if (easting >= 0.0 && locate(key.zone, easting, northing0 + 0.5 * spacing, position))
+    {
+      const long long value = static_cast<long long>(std::floor(easting / spacing + 0.5)) % modulus;
+      addLabel(tile, position, text, writeDigits(text, value, width));
+    }
+
+    const double northing = northing0 + i * spacing;
+    if (locate(key.zone, easting0 + 0.5 * spacing, northing, position))
+    {
+      const double falseNorthing = northing >= 0.0 ? northing : northing + falseNorthingSouth;
+      const long long value = static_cast<long long>(std::floor(falseNorthing / spacing + 0.5)) % modulus;
+      addLabel(tile, position, text, writeDigits(text, value, width));
+    }
+  }
+}
+
+// adds the tiles of level covering the given part of one latitude band cell of zone
+bool addCellTiles(int zone, double south, double west, double north, double east, int level,
+                  std::size_t maximumTileCount, std::vector<GridOverlayGenerator::TileKey>& tiles)
+{
+  double minimumEasting = 0.0;
+  double maximumEasting = 0.0;
+  double minimumNorthing = 0.0;
+  double maximumNorthing = 0.0;
+  bool any = false;
+
+  for (int side = 0; side < 4; ++side)
+  {
+    for (int i = 0; i <= edgeSamples; ++i)
+    {
+      const double fraction = static_cast<double>(i) / edgeSamples;
+      double latitude = 0.0;
+      double longitude = 0.0;
+      switch (side)
+      {
+      case 0:
+        latitude = south;
+        longitude = west + fraction * (east - west);
+        break;
+      case 1:
+        latitude = north;
+        longitude = west + fraction * (east - west);
+        break;
+      case 2:
+        latitude = south + fraction * (north - south);
+        longitude = west;
+        break;
+      default:
+        latitude = south + fraction * (north - south);
+        longitude = east;
+        break;
+      }
+
+      GridPosition position;
+      if (!TransverseMercatorGrid::toZonePosition(latitude, longitude, zone, position))
+        continue;
+
+      const double northing = signedNorthing(position);
+      minimumEasting = any ? std::min(minimumEasting, position.easting) : position.easting;
+      maximumEasting = any ? std::max(maximumEasting, position.easting) : position.easting;
+      minimumNorthing = any ? std::min(minimumNorthing, northing) : northing;
+      maximumNorthing = any ? std::max(maximumNorthing, northing) : northing;
+      any = true;
+    }
+  }
+
+  if (!any)
+    return true;
+
+  const double tileSize = GridOverlayGenerator::spacing(level) * GridOverlayGenerator::linesPerTile;
+  const int firstColumn = static_cast<int>(std::floor(minimumEasting / tileSize));
+  const int lastColumn = static_cast<int>(std::floor(maximumEasting / tileSize));
+  const int firstRow = static_cast<int>(std::floor(minimumNorthing / tileSize));
+  const int lastRow = static_cast<int>(std::floor(maximumNorthing / tileSize));
+
+  const double tileCount = (lastColumn - firstColumn + 1.0) * (lastRow - firstRow + 1.0);
+  if (tiles.size() + tileCount > maximumTileCount)
+    return false;
+
+  for (int column = firstColumn; column <= lastColumn; ++column)
+  {
+    for (int row = firstRow; row <= lastRow; ++row)
+    {
+      GridOverlayGenerator::TileKey key;
+      key.zone = zone;
+      key.level = level;
+      key.column = column;
+      key.row = row;
+      tiles.push_back(key);
+    }
+  }
+
+  return true;
+}
+
+bool keyLess(const GridOverlayGenerator::TileKey& key1, const GridOverlayGenerator::TileKey& key2)
+{
+  return std::tie(key1.zone, key1.level, key1.column, key1.row) < std::tie(key2.zone, key2.level, key2.column, key2.row);
+}
+
+} // namespace
+
+/*!
+  \class Esri::ArcGISRuntime::Toolkit::GridOverlayGenerator
+  \ingroup ToolCoordinateConversion
+  \inmodule ArcGISQtToolkit
+  \brief Generates the lines and labels of the UTM, MGRS and USNG grids.
+  \since Esri::ArcGISRuntime 100.4
+
+  The grid is cut into tiles which can be generated, cached and displayed
+  independently. Level 0 tiles hold the boundary of one zone within one
+  latitude band, with its zone and band label. Level 1 tiles hold the
+  100 km square lines of a 1000 km square of one zone, and each further
+  level lines ten times closer together in a tile ten times smaller.
+
+  Grid lines are traced in the zone's own eastings and northings and cut at
+  the zone edges, including the Norway and Svalbard exceptions. Each tile
+  holds at most \l linesPerTile lines in each direction, sampled at a fixed
+  number of points, so its size does not depend on the level.
+ */
+
+/*!
+  \brief Returns the distance in metres between the grid lines of \a level.
+ */
+double GridOverlayGenerator::spacing(int level)
+{
+  double spacing = squareSize;
+  for (int i = 1; i < level; ++i)
+    spacing /= 10.0;
+
+  return spacing;
+}
+
+/*!
+  \brief Returns the finest level which draws at most
+  \l maximumLinesAcross lines across a view \a widthInMetres wide, or \c 0
+  if even the 100 km squares are too dense.
+ */
+int GridOverlayGenerator::levelForWidth(double widthInMetres)
+{
+  for (int level = maximumLevel; level >= 1; --level)
+  {
+    if (widthInMetres / spacing(level) <= maximumLinesAcross)
+      return level;
+  }
+
+  return 0;
+}
+
+/*!
+  \brief Fills \a tiles with the tiles of \a level covering the area
+  between \a south, \a west, \a north and \a east (WGS 84 degrees).
+
+  An area crossing the antimeridian has \a west greater than \a east.
+  Returns \c false, leaving \a tiles incomplete, if more than
+  \a maximumTileCount tiles would be needed.
+ */
+bool GridOverlayGenerator::visibleTiles(double south, double west, double north, double east, int level,
+                                        std::size_t maximumTileCount, std::vector<TileKey>& tiles)
+{
+  tiles.clear();
+  south = std::max(south, minimumLatitude);
+  north = std::min(north, maximumLatitude);
+  if (south >= north || level < 0 || level > maximumLevel)
+    return true;
+
+  // split an area crossing the antimeridian in two
+  double westBounds[2] = { west, -180.0 };
+  double eastBounds[2] = { east, east };
+  int rangeCount = 1;
+  if (west > east)
+  {
+    eastBounds[0] = 180.0;
+    rangeCount = 2;
+  }
+
+  for (int zone = 1; zone <= 60; ++zone)
+  {
+    for (int band = 0; band < bandCount; ++band)
+    {
+      double bandSouth = 0.0;
+      double bandNorth = 0.0;
+      TransverseMercatorGrid::bandLatitudes(band, bandSouth, bandNorth);
+      const double cellSouth = std::max(south, bandSouth);
+      const double cellNorth = std::min(north, bandNorth);
+      if (cellSouth >= cellNorth)
+        continue;
+
+      double zoneWest = 0.0;
+      double zoneEast = 0.0;
+      if (!TransverseMercatorGrid::zoneLongitudes(zone, 0.5 * (bandSouth + bandNorth), zoneWest, zoneEast))
+        continue;
+
+      for (int range = 0; range < rangeCount; ++range)
+      {
+        const double cellWest = std::max(westBounds[range], zoneWest);
+        const double cellEast = std::min(eastBounds[range], zoneEast);
+        if (cellWest >= cellEast)
+          continue;
+
+        if (level == 0)
+        {
+          if (tiles.size() >= maximumTileCount)
+            return false;
+
+          TileKey key;
+          key.zone = zone;
+          key.row = band;
+          tiles.push_back(key);
+          break;
+        }
+
+        if (!addCellTiles(zone, cellSouth, cellWest, cellNorth, cellEast, level, maximumTileCount, tiles))
+          return false;
+      }
+    }
+  }
+
+  // cells of the same zone share tiles
+  std::sort(tiles.begin(), tiles.end(), keyLess);
+  tiles.erase(std::unique(tiles.begin(), tiles.end()), tiles.end());
+  return true;
+}
+
+/*!
+  \brief Generates the lines and labels of the tile \a key into \a tile.
+
+  Level 1 tiles are labelled with the letters of each 100 km square, in
+  \a scheme, when \a squareIdentifiers is \c true. Otherwise, and at finer
+  levels, each line is labelled with its principal digits.
+ */
+void GridOverlayGenerator::generateTile(const TileKey& key, bool squareIdentifiers,
+                                        TransverseMercatorGrid::LetteringScheme scheme, Tile& tile)
+{
+  tile = Tile();
+  if (key.zone < 1 || key.zone > 60 || key.level < 0 || key.level > maximumLevel)
+    return;
+
+  if (key.level == 0)
+    generateZoneTile(key, tile);
+  else
+    generateGridTile(key, squareIdentifiers, scheme, tile);
+}
+
+} // Toolkit
+} // ArcGISRuntime
+} // Esri
@@ -0,0 +1,165 @@
+/*******************************************************************************
+ *  Copyright 2012-2018 Esri
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ******************************************************************************/
+
+#include "LatitudeLongitudeFormatter.h"
+
+// STL headers
+#include <cmath>
+#include <cstdint>
+
+namespace Esri
+{
+namespace ArcGISRuntime
+{
+namespace Toolkit
+{
+
+namespace
+{
+
+constexpr std::uint64_t powersOfTen[] =
+{
+  1ULL, 10ULL, 100ULL, 1000ULL, 10000ULL, 100000ULL, 1000000ULL, 10000000ULL,
+  100000000ULL, 1000000000ULL, 10000000000ULL, 100000000000ULL, 1000000000000ULL,
+  10000000000000ULL, 100000000000000ULL, 1000000000000000ULL, 10000000000000000ULL
+};
+
+// the smallest whole unit of each style (degrees, minutes, seconds) per degree
+constexpr std::uint64_t unitsPerDegree[] = { 1, 60, 3600 };
+
+// the most decimal places for which 180 degrees, counted in the smallest
+// fractional unit of each style, still fits in 64 bits
+constexpr int maximumDecimalPlaces[] = { 16, 14, 13 };
+
+// writes value as exactly width zero-padded digits
+char* writeDigits(char* out, std::uint64_t value, int width)
+{
+  for (int i = width - 1; i >= 0; --i)
+  {
+    out[i] = static_cast<char>('0' + value % 10);
+    value /= 10;
+  }
+
+  return out + width;
+}
+
+char* writeFraction(char* out, std::uint64_t fraction, int decimalPlaces)
+{
+  if (decimalPlaces == 0)
+    return out;
+
+  *out++ = '.';
+  return writeDigits(out, fraction, decimalPlaces);
+}
+
+char* writeCoordinate(char* out, double degrees, int degreeDigits, char positive, char negative,
+                      LatitudeLongitudeFormatter::Style style, int decimalPlaces)
+{
+  const int styleIndex = static_cast<int>(style);
+  const std::uint64_t fractionScale = powersOfTen[decimalPlaces];
+  const std::uint64_t scale = unitsPerDegree[styleIndex] * fractionScale;
+
+  // round once, in the smallest unit, so that carries propagate into minutes and degrees
+  const std::uint64_t total = static_cast<std::uint64_t>(std::fabs(degrees) * static_cast<double>(scale) + 0.5);
+
+  out = writeDigits(out, total / scale, degreeDigits);
+  const std::uint64_t remainder = total % scale;
+
+  switch (style)
+  {
+  case LatitudeLongitudeFormatter::Style::DecimalDegrees:
+  {
+    out = writeFraction(out, remainder, decimalPlaces);
+    break;
+  }
+  case LatitudeLongitudeFormatter::Style::DegreesDecimalMinutes:
+  {
+    *out++ = ' ';
+    out = writeDigits(out, remainder / fractionScale, 2);
+    out = writeFraction(out, remainder % fractionScale, decimalPlaces);
+    break;
+  }
+  case LatitudeLongitudeFormatter::Style::DegreesMinutesSeconds:
+  {
+    const std::uint64_t minuteScale = 60 * fractionScale;
+    *out++ = ' ';
+    out = writeDigits(out, remainder / minuteScale, 2);
+    *out++ = ' ';
+    out = writeDigits(out, (remainder % minuteScale) / fractionScale, 2);
+    out = writeFraction(out, remainder % fractionScale, decimalPlaces);
+    break;
+  }
+  }
+
+  *out++ = (degrees < 0.0 && total != 0) ? negative : positive;
+  return out;
+}
+
+} // namespace
+
+/*!
+  \class Esri::ArcGISRuntime::Toolkit::LatitudeLongitudeFormatter
+  \ingroup ToolCoordinateConversion
+  \inmodule ArcGISQtToolkit
+  \brief A native formatter for latitude-longitude notations.
+  \since Esri::ArcGISRuntime 100.4
+
+  Produces the decimal degrees, degrees decimal minutes and degrees minutes
+  seconds notations for WGS 84 coordinates without allocating: all digits are
+  generated from a single rounded integer into a caller supplied buffer of at
+  least \l bufferSize characters.
+
+  The coordinate conversion controller uses this in place of
+  \c CoordinateFormatter::toLatitudeLongitude once its output has been
+  checked against the SDK for the format and decimal places in use.
+ */
+
+/*!
+  \brief Returns whether \a style can be formatted natively with \a decimalPlaces.
+ */
+bool LatitudeLongitudeFormatter::supports(Style style, int decimalPlaces)
+{
+  return decimalPlaces >= 0 && decimalPlaces <= maximumDecimalPlaces[static_cast<int>(style)];
+}
+
+/*!
+  \brief Writes the notation for \a latitude and \a longitude (in WGS 84
+  degrees) in \a style with \a decimalPlaces into \a buffer.
+
+  Returns the number of characters written, or \c 0 if the coordinate or
+  the options are not supported. The buffer is not null terminated.
+ */
+int LatitudeLongitudeFormatter::format(double latitude, double longitude, Style style, int decimalPlaces, char* buffer)
+{
+  if (!supports(style, decimalPlaces) || !std::isfinite(latitude) || !std::isfinite(longitude))
+    return 0;
+
+  if (latitude < -90.0 || latitude > 90.0)
+    return 0;
+
+  if (longitude < -180.0 || longitude > 180.0)
+    longitude = std::remainder(longitude, 360.0);
+
+  char* out = writeCoordinate(buffer, latitude, 2, 'N', 'S', style, decimalPlaces);
+  *out++ = ' ';
+  out = writeCoordinate(out, longitude, 3, 'E', 'W', style, decimalPlaces);
+
+  return static_cast<int>(out - buffer);
+}
+
+} // Toolkit
+} // ArcGISRuntime
+} // Esri
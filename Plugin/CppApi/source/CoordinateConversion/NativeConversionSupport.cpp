@@ -0,0 +1,339 @@
+/*******************************************************************************
+ *  Copyright 2012-2018 Esri
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ******************************************************************************/
+
+#include "NativeConversionSupport.h"
+
+// C++ API headers
+#include "Point.h"
+#include "SpatialReference.h"
+
+// Qt headers
+#include <QString>
+
+// STL headers
+#include <cmath>
+
+namespace Esri
+{
+namespace ArcGISRuntime
+{
+namespace Toolkit
+{
+
+namespace
+{
+
+constexpr int wgs84Wkid = 4326;
+constexpr int webMercatorWkid = 3857;
+constexpr int webMercatorAuxiliarySphereWkid = 102100;
+constexpr int webMercatorAuxiliarySphereLegacyWkid = 102113;
+
+constexpr double webMercatorRadius = 6378137.0;
+constexpr double radiansToDegrees = 57.295779513082320876798;
+constexpr double halfPi = 1.57079632679489661923;
+constexpr double quarterPi = 0.78539816339744830962;
+
+// largest difference at which a native and an SDK decoded point are considered the same
+constexpr double geographicTolerance = 1e-8;
+constexpr double projectedTolerance = 1e-3;
+
+bool isWebMercator(int wkid)
+{
+  return wkid == webMercatorWkid || wkid == webMercatorAuxiliarySphereWkid || wkid == webMercatorAuxiliarySphereLegacyWkid;
+}
+
+// number of matching comparisons in a region before a native path is trusted there
+constexpr int requiredMatches = 32;
+
+// region boundaries: latitude rows split at the equator, at the UTM limits
+// and around the Norway and Svalbard zone exceptions, and 45 degree columns
+// with the antimeridian on the edge of the outer two
+constexpr double regionRowLatitudes[] = { -80.0, -40.0, 0.0, 40.0, 56.0, 72.0, 84.0 };
+constexpr int regionColumns = 8;
+constexpr double regionColumnWidth = 360.0 / regionColumns;
+
+// a trusted key is still compared with the SDK once in this many uses
+constexpr unsigned trustedSampleInterval = 64;
+
+} // namespace
+
+/*!
+  \class Esri::ArcGISRuntime::Toolkit::NativeConversionSupport
+  \ingroup ToolCoordinateConversion
+  \inmodule ArcGISQtToolkit
+  \internal
+  \brief Helpers shared by the native coordinate notation kernels.
+ */
+
+/*!
+  \internal
+
+  Sets \a latitude and \a longitude to the WGS 84 degrees of \a point without
+  calling the geometry engine. Only WGS 84 and Web Mercator points are
+  handled; returns \c false for any other spatial reference so that the
+  caller falls back to the SDK.
+ */
+bool NativeConversionSupport::toGeographic(const Point& point, double& latitude, double& longitude)
+{
+  if (point.isEmpty())
+    return false;
+
+  const int wkid = point.spatialReference().wkid();
+  if (wkid == wgs84Wkid)
+  {
+    latitude = point.y();
+    longitude = point.x();
+    return true;
+  }
+
+  if (isWebMercator(wkid))
+  {
+    longitude = point.x() / webMercatorRadius * radiansToDegrees;
+    latitude = (2.0 * std::atan(std::exp(point.y() / webMercatorRadius)) - halfPi) * radiansToDegrees;
+    return true;
+  }
+
+  return false;
+}
+
+/*!
+  \internal
+
+  Sets \a point to \a latitude and \a longitude (WGS 84 degrees) in
+  \a spatialReference. Only WGS 84 and Web Mercator are handled; returns
+  \c false for any other spatial reference.
+ */
+bool NativeConversionSupport::fromGeographic(double latitude, double longitude, const SpatialReference& spatialReference,
+                                             Point& point)
+{
+  const int wkid = spatialReference.wkid();
+  if (wkid == wgs84Wkid)
+  {
+    point = Point(longitude, latitude, spatialReference);
+    return true;
+  }
+
+  if (isWebMercator(wkid))
+  {
+    const double x = webMercatorRadius * longitude / radiansToDegrees;
+    const double y = webMercatorRadius * std::log(std::tan(quarterPi + 0.5 * latitude / radiansToDegrees));
+    point = Point(x, y, spatialReference);
+    return true;
+  }
+
+  return false;
+}
+
+/*!
+  \internal
+
+  Returns whether \a point1 and \a point2 are in the same spatial reference
+  and agree to within a tolerance suitable for comparing decoded notations.
+ */
+bool NativeConversionSupport::sameLocation(const Point& point1, const Point& point2)
+{
+  if (point1.isEmpty() || point2.isEmpty() ||
+      point1.spatialReference().wkid() != point2.spatialReference().wkid())
+  {
+    return false;
+  }
+
+  const double tolerance = point1.spatialReference().wkid() == wgs84Wkid ? geographicTolerance : projectedTolerance;
+  return std::fabs(point1.x() - point2.x()) <= tolerance && std::fabs(point1.y() - point2.y()) <= tolerance;
+}
+
+/*!
+  \internal
+
+  Returns the MGRS lettering scheme that \a mode stands for. Automatic
+  follows the datum of the spatial reference; the native kernels only
+  handle WGS 84 based references, for which it means the AA scheme.
+ */
+TransverseMercatorGrid::LetteringScheme NativeConversionSupport::mgrsLetteringScheme(MgrsConversionMode mode)
+{
+  return (mode == MgrsConversionMode::Old180InZone01 || mode == MgrsConversionMode::Old180InZone60) ?
+        TransverseMercatorGrid::LetteringScheme::Old : TransverseMercatorGrid::LetteringScheme::New;
+}
+
+/*!
+  \internal
+
+  Copies \a text into \a buffer for the native parsers. Returns the number
+  of characters copied, or \c -1 if \a text does not fit in \a bufferSize
+  characters or is not plain Latin-1.
+ */
+int NativeConversionSupport::toLatin1(const QString& text, char* buffer, int bufferSize)
+{
+  const int length = text.size();
+  if (length > bufferSize)
+    return -1;
+
+  const QChar* characters = text.constData();
+  for (int i = 0; i < length; ++i)
+  {
+    const ushort unicode = characters[i].unicode();
+    if (unicode > 0xff)
+      return -1;
+
+    buffer[i] = static_cast<char>(unicode);
+  }
+
+  return length;
+}
+
+/*!
+  \class Esri::ArcGISRuntime::Toolkit::NativeConversionGate
+  \ingroup ToolCoordinateConversion
+  \inmodule ArcGISQtToolkit
+  \internal
+  \brief Decides when a native kernel's output may replace the SDK's.
+
+  Each combination of options a kernel supports is identified by a small
+  integer key, and the globe is divided into \l regionCount regions. Until
+  a key is verified in the region of a point the caller produces both
+  results, returns the SDK's and records whether they were identical. After
+  enough matches in a region the native result is used on its own there,
+  so that agreement over one area never vouches for another, and in
+  particular not for the zone exceptions, the poles or the antimeridian.
+
+  A verified key is still reported as untrusted by \l isTrusted once in
+  every 64 uses so that single conversions keep comparing; batch callers
+  use \l isVerified and compare a point of every chunk themselves. A
+  single mismatch, anywhere and at any time, rejects the key so that it
+  always goes through the SDK.
+
+  All state is held in atomics so the gate can be shared by the threads of
+  a batch conversion.
+ */
+
+constexpr int NativeConversionGate::regionCount;
+
+/*!
+  \internal
+ */
+NativeConversionGate::NativeConversionGate(int keyCount) :
+  m_keyCount(keyCount),
+  m_matches(new std::atomic<int>[keyCount * regionCount]),
+  m_rejected(new std::atomic<bool>[keyCount]),
+  m_trustedUses(new std::atomic<unsigned>[keyCount])
+{
+  for (int i = 0; i < m_keyCount * regionCount; ++i)
+    m_matches[i].store(0);
+
+  for (int key = 0; key < m_keyCount; ++key)
+  {
+    m_rejected[key].store(false);
+    m_trustedUses[key].store(0);
+  }
+}
+
+/*!
+  \internal
+ */
+NativeConversionGate::~NativeConversionGate()
+{
+}
+
+/*!
+  \internal
+
+  Returns the region of \a latitude and \a longitude (WGS 84 degrees).
+  Values outside the valid ranges are put in the nearest region.
+ */
+int NativeConversionGate::regionAt(double latitude, double longitude)
+{
+  int row = 0;
+  for (double rowLatitude : regionRowLatitudes)
+    row += latitude >= rowLatitude ? 1 : 0;
+
+  // also puts NaN in the first column
+  const double column = std::floor((longitude + 180.0) / regionColumnWidth);
+  int columnIndex = 0;
+  if (column >= regionColumns - 1)
+    columnIndex = regionColumns - 1;
+  else if (column > 0.0)
+    columnIndex = static_cast<int>(column);
+
+  return row * regionColumns + columnIndex;
+}
+
+/*!
+  \internal
+
+  Returns whether the native result for \a key may be used without
+  comparing it in \a region. Once in every 64 calls for a key this returns
+  \c false even when the key is verified, so that the caller keeps
+  comparing.
+ */
+bool NativeConversionGate::isTrusted(int key, int region) const
+{
+  if (!isVerified(key, region))
+    return false;
+
+  // keep sampling, so that an input the first matches did not cover still
+  // switches the key back to the SDK
+  return m_trustedUses[key].fetch_add(1, std::memory_order_relaxed) % trustedSampleInterval != 0;
+}
+
+/*!
+  \internal
+
+  Returns whether \a key has matched the SDK often enough in \a region and
+  never differed from it anywhere.
+ */
+bool NativeConversionGate::isVerified(int key, int region) const
+{
+  if (isRejected(key) || region < 0 || region >= regionCount)
+    return false;
+
+  return m_matches[key * regionCount + region].load(std::memory_order_relaxed) >= requiredMatches;
+}
+
+/*!
+  \internal
+ */
+bool NativeConversionGate::isRejected(int key) const
+{
+  return key < 0 || key >= m_keyCount || m_rejected[key].load(std::memory_order_relaxed);
+}
+
+/*!
+  \internal
+
+  Records whether the native and SDK results for \a key in \a region
+  were \a matched.
+ */
+void NativeConversionGate::recordComparison(int key, int region, bool matched) const
+{
+  if (key < 0 || key >= m_keyCount || region < 0 || region >= regionCount)
+    return;
+
+  if (!matched)
+  {
+    m_rejected[key].store(true, std::memory_order_relaxed);
+    return;
+  }
+
+  std::atomic<int>& matches = m_matches[key * regionCount + region];
+  int count = matches.load(std::memory_order_relaxed);
+  while (count < requiredMatches && !matches.compare_exchange_weak(count, count + 1, std::memory_order_relaxed))
+  {
+  }
+}
+
+} // Toolkit
+} // ArcGISRuntime
+} // Esri
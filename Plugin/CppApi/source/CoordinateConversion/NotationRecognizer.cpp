@@ -0,0 +1,563 @@
+/*******************************************************************************
+ *  Copyright 2012-2018 Esri
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ******************************************************************************/
+
+#include "NotationRecognizer.h"
+
+namespace Esri
+{
+namespace ArcGISRuntime
+{
+namespace Toolkit
+{
+
+namespace
+{
+
+enum CharacterClass : unsigned char
+{
+  Invalid,
+  Digit,
+  Letter,
+  Separator,
+  DecimalPoint,
+  SignCharacter,
+  SymbolCharacter
+};
+
+// the class of every Latin-1 character, so that tokenizing is a single table lookup per character
+struct CharacterTable
+{
+  CharacterTable()
+  {
+    for (int c = 0; c < 256; ++c)
+      classes[c] = Invalid;
+
+    for (int c = '0'; c <= '9'; ++c)
+      classes[c] = Digit;
+
+    for (int c = 'A'; c <= 'Z'; ++c)
+    {
+      classes[c] = Letter;
+      classes[c - 'A' + 'a'] = Letter;
+    }
+
+    for (const char* c = " \t\r\n,;/"; *c; ++c)
+      classes[static_cast<unsigned char>(*c)] = Separator;
+
+    classes[static_cast<unsigned char>('.')] = DecimalPoint;
+    classes[static_cast<unsigned char>('+')] = SignCharacter;
+    classes[static_cast<unsigned char>('-')] = SignCharacter;
+
+    // degree, ordinal indicator, minute and second marks
+    for (const char* c = "'\":`\xb0\xba\xb4"; *c; ++c)
+      classes[static_cast<unsigned char>(*c)] = SymbolCharacter;
+  }
+
+  CharacterClass classes[256];
+};
+
+const CharacterTable characterTable;
+
+enum class TokenKind
+{
+  Number,
+  Word,
+  Sign,
+  Symbol
+};
+
+constexpr int maximumTokens = 16;
+constexpr int maximumWordLength = 4;
+constexpr long long maximumIntegerValue = 1000000000LL;
+
+struct Token
+{
+  TokenKind kind = TokenKind::Number;
+  int length = 0;              // digits, excluding any decimal point, or letters
+  bool hasPoint = false;
+  long long integerValue = 0;  // the digits before the decimal point, capped
+  char letters[maximumWordLength] = {};
+  char sign = 0;
+};
+
+struct Tokens
+{
+  Token items[maximumTokens];
+  int count = 0;
+  bool separated = false;      // whether any separator appeared between tokens
+};
+
+Token* startToken(Tokens& tokens, TokenKind kind)
+{
+  if (tokens.count == maximumTokens)
+    return nullptr;
+
+  Token* token = &tokens.items[tokens.count++];
+  token->kind = kind;
+  return token;
+}
+
+bool tokenize(const char* text, int length, Tokens& tokens)
+{
+  Token* current = nullptr;
+  for (int i = 0; i < length; ++i)
+  {
+    const unsigned char c = static_cast<unsigned char>(text[i]);
+    switch (characterTable.classes[c])
+    {
+    case Invalid:
+      return false;
+    case Separator:
+      if (tokens.count > 0)
+        tokens.separated = true;
+      current = nullptr;
+      break;
+    case Digit:
+      if (!current || current->kind != TokenKind::Number)
+      {
+        current = startToken(tokens, TokenKind::Number);
+        if (!current)
+          return false;
+      }
+      if (!current->hasPoint && current->integerValue < maximumIntegerValue)
+        current->integerValue = current->integerValue * 10 + (c - '0');
+      ++current->length;
+      break;
+    case DecimalPoint:
+      if (!current || current->kind != TokenKind::Number)
+      {
+        current = startToken(tokens, TokenKind::Number);
+        if (!current)
+          return false;
+      }
+      if (current->hasPoint)
+        return false;
+      current->hasPoint = true;
+      break;
+    case Letter:
+      if (!current || current->kind != TokenKind::Word)
+      {
+        current = startToken(tokens, TokenKind::Word);
+        if (!current)
+          return false;
+      }
+      if (current->length < maximumWordLength)
+        current->letters[current->length] = static_cast<char>(c >= 'a' ? c - 'a' + 'A' : c);
+      ++current->length;
+      break;
+    case SignCharacter:
+      current = startToken(tokens, TokenKind::Sign);
+      if (!current)
+        return false;
+      current->sign = static_cast<char>(c);
+      current = nullptr;
+      break;
+    case SymbolCharacter:
+      if (!startToken(tokens, TokenKind::Symbol))
+        return false;
+      current = nullptr;
+      break;
+    }
+  }
+
+  for (int i = 0; i < tokens.count; ++i)
+  {
+    if (tokens.items[i].kind == TokenKind::Number && tokens.items[i].length == 0)
+      return false;
+  }
+
+  return tokens.count > 0;
+}
+
+bool isInteger(const Token& token, int minimumDigits, int maximumDigits)
+{
+  return token.kind == TokenKind::Number && !token.hasPoint &&
+      token.length >= minimumDigits && token.length <= maximumDigits;
+}
+
+bool isWord(const Token& token, int length)
+{
+  return token.kind == TokenKind::Word && token.length == length;
+}
+
+// letters used by the grids, which skip I and O
+bool isGridLetter(char letter, char last)
+{
+  return letter >= 'A' && letter <= last && letter != 'I' && letter != 'O';
+}
+
+bool isLatitudeBand(char letter)
+{
+  return isGridLetter(letter, 'X') && letter >= 'C';
+}
+
+// the integer value of the leading two digits of a run of digits
+int leadingTwoDigits(const char* text, int digitCount)
+{
+  if (digitCount < 2)
+    return 0;
+
+  return (text[0] - '0') * 10 + (text[1] - '0');
+}
+
+int garsScore(const Tokens& tokens)
+{
+  if (tokens.count < 2 || tokens.count > 3)
+    return 0;
+
+  const Token& cell = tokens.items[0];
+  const Token& band = tokens.items[1];
+  if (!isInteger(cell, 3, 3) || cell.integerValue < 1 || cell.integerValue > 720 ||
+      !isWord(band, 2) || !isGridLetter(band.letters[0], 'Q') || !isGridLetter(band.letters[1], 'Z'))
+  {
+    return 0;
+  }
+
+  if (tokens.count == 3)
+  {
+    const Token& keys = tokens.items[2];
+    if (!isInteger(keys, 1, 2))
+      return 0;
+
+    const long long quadrant = keys.length == 2 ? keys.integerValue / 10 : keys.integerValue;
+    const long long keypad = keys.length == 2 ? keys.integerValue % 10 : 1;
+    if (quadrant < 1 || quadrant > 4 || keypad < 1)
+      return 0;
+  }
+
+  return 95;
+}
+
+int georefScore(const Tokens& tokens, const char* digits, int digitCount)
+{
+  if (tokens.count < 1 || tokens.count > 3 || !isWord(tokens.items[0], 4))
+    return 0;
+
+  const char* letters = tokens.items[0].letters;
+  if (!isGridLetter(letters[0], 'Z') || !isGridLetter(letters[1], 'M') ||
+      !isGridLetter(letters[2], 'Q') || !isGridLetter(letters[3], 'Q'))
+  {
+    return 0;
+  }
+
+  if (tokens.count == 2 && (!isInteger(tokens.items[1], 2, 18) || tokens.items[1].length % 2 != 0))
+    return 0;
+
+  if (tokens.count == 3 && (!isInteger(tokens.items[1], 1, 9) || !isInteger(tokens.items[2], 1, 9) ||
+                            tokens.items[1].length != tokens.items[2].length))
+  {
+    return 0;
+  }
+
+  // both minute values must be below 60
+  const int precision = digitCount / 2;
+  if (precision >= 2 && (leadingTwoDigits(digits, digitCount) >= 60 ||
+                         leadingTwoDigits(digits + precision, digitCount - precision) >= 60))
+  {
+    return 0;
+  }
+
+  return 95;
+}
+
+// the index of the first token after the zone and letters of an MGRS or UTM
+// notation, or -1 if the tokens do not start that way
+int gridDigitsStart(const Tokens& tokens, bool mgrs)
+{
+  int index = 0;
+  bool polar = false;
+  if (tokens.count > 0 && isInteger(tokens.items[0], 1, 2))
+  {
+    if (tokens.items[0].integerValue < 1 || tokens.items[0].integerValue > 60)
+      return -1;
+
+    index = 1;
+  }
+  else
+  {
+    polar = true;
+  }
+
+  if (index >= tokens.count || tokens.items[index].kind != TokenKind::Word)
+    return -1;
+
+  const Token& first = tokens.items[index];
+  if (!mgrs)
+  {
+    if (polar || first.length != 1 || !(isLatitudeBand(first.letters[0]) || first.letters[0] == 'S'))
+      return -1;
+
+    return index + 1;
+  }
+
+  char letters[3];
+  if (first.length == 3)
+  {
+    letters[0] = first.letters[0];
+    letters[1] = first.letters[1];
+    letters[2] = first.letters[2];
+    ++index;
+  }
+  else if (first.length == 1 && index + 1 < tokens.count && isWord(tokens.items[index + 1], 2))
+  {
+    letters[0] = first.letters[0];
+    letters[1] = tokens.items[index + 1].letters[0];
+    letters[2] = tokens.items[index + 1].letters[1];
+    index += 2;
+  }
+  else
+  {
+    return -1;
+  }
+
+  const bool validBand = polar ? (letters[0] == 'A' || letters[0] == 'B' || letters[0] == 'Y' || letters[0] == 'Z') :
+                                 isLatitudeBand(letters[0]);
+  if (!validBand || !isGridLetter(letters[1], 'Z') || !isGridLetter(letters[2], 'V'))
+    return -1;
+
+  return index;
+}
+
+bool mgrsDigits(const Tokens& tokens, int start)
+{
+  const int remaining = tokens.count - start;
+  if (remaining == 0)
+    return true;
+
+  if (remaining == 1)
+    return isInteger(tokens.items[start], 2, 10) && tokens.items[start].length % 2 == 0;
+
+  return remaining == 2 && isInteger(tokens.items[start], 1, 5) && isInteger(tokens.items[start + 1], 1, 5) &&
+      tokens.items[start].length == tokens.items[start + 1].length;
+}
+
+int utmScore(const Tokens& tokens)
+{
+  const int start = gridDigitsStart(tokens, false);
+  if (start < 0)
+    return 0;
+
+  const int remaining = tokens.count - start;
+  if (remaining == 1 && isInteger(tokens.items[start], 13, 13))
+    return 85;
+
+  // easting and northing in metres, optionally with decimals
+  if (remaining == 2 &&
+      tokens.items[start].kind == TokenKind::Number && tokens.items[start + 1].kind == TokenKind::Number &&
+      tokens.items[start].integerValue < 1000000 && tokens.items[start + 1].integerValue < 10000000)
+  {
+    return 90;
+  }
+
+  return 0;
+}
+
+// scores the latitude-longitude notations and writes them into scores, indexed by notation
+void latitudeLongitudeScores(const Tokens& tokens, int* scores)
+{
+  int numberIndices[6];
+  int numberCount = 0;
+  char hemispheres[2];
+  int hemispherePositions[2];  // the number of numbers before each hemisphere letter
+  int hemisphereCount = 0;
+  bool hasSymbols = false;
+  bool hasSigns = false;
+
+  for (int i = 0; i < tokens.count; ++i)
+  {
+    const Token& token = tokens.items[i];
+    switch (token.kind)
+    {
+    case TokenKind::Number:
+      if (numberCount == 6)
+        return;
+      numberIndices[numberCount++] = i;
+      break;
+    case TokenKind::Word:
+    {
+      const char letter = token.letters[0];
+      if (token.length != 1 || hemisphereCount == 2 ||
+          (letter != 'N' && letter != 'S' && letter != 'E' && letter != 'W'))
+      {
+        return;
+      }
+      hemispheres[hemisphereCount] = letter;
+      hemispherePositions[hemisphereCount] = numberCount;
+      ++hemisphereCount;
+      break;
+    }
+    case TokenKind::Sign:
+      // a sign must be followed directly by a number
+      if (i + 1 >= tokens.count || tokens.items[i + 1].kind != TokenKind::Number)
+        return;
+      hasSigns = true;
+      break;
+    case TokenKind::Symbol:
+      hasSymbols = true;
+      break;
+    }
+  }
+
+  if (numberCount != 2 && numberCount != 4 && numberCount != 6)
+    return;
+
+  if (hemisphereCount == 1 || (hemisphereCount == 2 && hasSigns))
+    return;
+
+  const int perCoordinate = numberCount / 2;
+  bool latitudeFirst = true;
+  if (hemisphereCount == 2)
+  {
+    const bool leading = hemispherePositions[0] == 0 && hemispherePositions[1] == perCoordinate;
+    const bool trailing = hemispherePositions[0] == perCoordinate && hemispherePositions[1] == numberCount;
+    const bool firstIsLatitude = hemispheres[0] == 'N' || hemispheres[0] == 'S';
+    const bool secondIsLatitude = hemispheres[1] == 'N' || hemispheres[1] == 'S';
+    if ((!leading && !trailing) || firstIsLatitude == secondIsLatitude)
+      return;
+
+    latitudeFirst = firstIsLatitude;
+  }
+
+  for (int coordinate = 0; coordinate < 2; ++coordinate)
+  {
+    for (int part = 0; part < perCoordinate; ++part)
+    {
+      const Token& number = tokens.items[numberIndices[coordinate * perCoordinate + part]];
+      const bool last = part == perCoordinate - 1;
+      if (number.hasPoint && !last)
+        return;
+
+      if (part == 0)
+      {
+        const bool latitude = (coordinate == 0) == latitudeFirst;
+        if (number.integerValue > (latitude ? 90 : 180))
+          return;
+      }
+      else if (number.integerValue >= 60)
+      {
+        return;
+      }
+    }
+  }
+
+  int score = hemisphereCount == 2 ? 90 : (hasSigns || hasSymbols || tokens.items[numberIndices[perCoordinate - 1]].hasPoint ? 75 : 60);
+  if (hasSymbols && score < 95)
+    score += 5;
+
+  const NotationRecognizer::Notation notation = numberCount == 2 ? NotationRecognizer::Notation::DecimalDegrees :
+                                                (numberCount == 4 ? NotationRecognizer::Notation::DegreesDecimalMinutes :
+                                                                    NotationRecognizer::Notation::DegreesMinutesSeconds);
+  scores[static_cast<int>(notation)] = score;
+}
+
+} // namespace
+
+/*!
+  \class Esri::ArcGISRuntime::Toolkit::NotationRecognizer
+  \ingroup ToolCoordinateConversion
+  \inmodule ArcGISQtToolkit
+  \brief Classifies a coordinate notation without knowing its format.
+  \since Esri::ArcGISRuntime 100.4
+
+  The text is read once, looking each character up in a class table to split
+  it into numbers, words, signs and symbols. The few tokens this produces are
+  then matched against the shape of each supported notation: decimal
+  degrees, degrees decimal minutes, degrees minutes seconds, MGRS, USNG,
+  UTM, GARS and GEOREF. The cost is linear in the length of the text.
+
+  Every notation whose shape fits is returned as a candidate with a score,
+  best first, so that ambiguous input (for example MGRS and USNG, which
+  share a syntax) can be resolved by trying the candidates in turn.
+ */
+
+/*!
+  \brief Classifies the first \a length Latin-1 characters of \a text and
+  writes the matching notations into \a candidates, which must hold
+  \l notationCount entries.
+
+  Returns the number of candidates written, best first. \c 0 means the text
+  does not look like any supported notation.
+ */
+int NotationRecognizer::recognize(const char* text, int length, Candidate* candidates)
+{
+  Tokens tokens;
+  if (!tokenize(text, length, tokens))
+    return 0;
+
+  // the digits of the notation without separators, for the checks which look inside numbers
+  char digits[32];
+  int digitCount = 0;
+  for (int i = 0; i < length && digitCount < 32; ++i)
+  {
+    if (characterTable.classes[static_cast<unsigned char>(text[i])] == Digit)
+      digits[digitCount++] = text[i];
+  }
+
+  int scores[notationCount] = {};
+  scores[static_cast<int>(Notation::Gars)] = garsScore(tokens);
+  scores[static_cast<int>(Notation::GeoRef)] = georefScore(tokens, digits, digitCount);
+  scores[static_cast<int>(Notation::Utm)] = utmScore(tokens);
+
+  const int mgrsStart = gridDigitsStart(tokens, true);
+  if (mgrsStart >= 0 && mgrsDigits(tokens, mgrsStart))
+  {
+    // the two share a syntax; USNG is usually written with spaces, MGRS without
+    scores[static_cast<int>(Notation::Mgrs)] = tokens.separated ? 85 : 88;
+    scores[static_cast<int>(Notation::Usng)] = tokens.separated ? 88 : 85;
+  }
+
+  latitudeLongitudeScores(tokens, scores);
+
+  int count = 0;
+  for (int i = 0; i < notationCount; ++i)
+  {
+    if (scores[i] == 0)
+      continue;
+
+    // insertion keeps equal scores in declaration order
+    int position = count;
+    while (position > 0 && candidates[position - 1].score < scores[i])
+    {
+      candidates[position] = candidates[position - 1];
+      --position;
+    }
+
+    candidates[position].notation = static_cast<Notation>(i);
+    candidates[position].score = scores[i];
+    ++count;
+  }
+
+  return count;
+}
+
+/*!
+  \brief Classifies \a count texts, where text \c i is the first
+  \c {lengths[i]} characters of \c {texts[i]}.
+
+  The candidates for text \c i are written from
+  \c {candidates[i * notationCount]} and their number into
+  \c {candidateCounts[i]}.
+ */
+void NotationRecognizer::recognize(const char* const* texts, const int* lengths, std::size_t count,
+                                   Candidate* candidates, int* candidateCounts)
+{
+  for (std::size_t i = 0; i < count; ++i)
+    candidateCounts[i] = recognize(texts[i], lengths[i], candidates + i * notationCount);
+}
+
+} // Toolkit
+} // ArcGISRuntime
+} // Esri
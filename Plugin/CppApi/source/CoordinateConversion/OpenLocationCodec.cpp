@@ -0,0 +1,450 @@
+/*******************************************************************************
+ *  Copyright 2012-2018 Esri
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ******************************************************************************/
+
+
+#include "OpenLocationCodec.h"
+
+// STL headers
+#include <cmath>
+#include <cstdint>
+#include <limits>
+
+namespace Esri
+{
+namespace ArcGISRuntime
+{
+namespace Toolkit
+{
+
+namespace
+{
+
+constexpr char alphabet[] = "23456789CFGHJMPQRVWX";
+constexpr int base = 20;
+
+constexpr char separator = '+';
+constexpr char padding = '0';
+constexpr int separatorPosition = 8;
+
+// the grid digits after the pairs split each cell into 5 rows and 4 columns
+constexpr int gridDigitCount = OpenLocationCodec::maximumPrecision - OpenLocationCodec::pairPrecision;
+constexpr int gridRows = 5;
+constexpr int gridColumns = 4;
+
+// coordinates are handled as integers in units of the smallest cell
+constexpr std::int64_t pairUnitsPerDegree = 8000;
+constexpr std::int64_t gridRowsPower = 3125;    // gridRows ^ gridDigitCount
+constexpr std::int64_t gridColumnsPower = 1024; // gridColumns ^ gridDigitCount
+constexpr std::int64_t latitudeUnitsPerDegree = pairUnitsPerDegree * gridRowsPower;
+constexpr std::int64_t longitudeUnitsPerDegree = pairUnitsPerDegree * gridColumnsPower;
+constexpr std::int64_t latitudeUnits = 180 * latitudeUnitsPerDegree;
+constexpr std::int64_t longitudeUnits = 360 * longitudeUnitsPerDegree;
+
+// the first digits of a valid code cover at most 180 and 360 degrees
+constexpr int firstLatitudeDigitCount = 9;
+constexpr int firstLongitudeDigitCount = 18;
+
+// decode table entry of characters outside the alphabet; the bit survives ORing valid entries together
+constexpr unsigned char invalidCharacter = 0x80;
+
+// number of points indexed together by the batch paths
+constexpr std::size_t batchBlockSize = 256;
+
+struct DecodeTable
+{
+  DecodeTable()
+  {
+    for (unsigned char& value : values)
+      value = invalidCharacter;
+
+    for (int i = 0; i < base; ++i)
+    {
+      const char c = alphabet[i];
+      values[static_cast<unsigned char>(c)] = static_cast<unsigned char>(i);
+      if (c >= 'A' && c <= 'Z')
+        values[static_cast<unsigned char>(c - 'A' + 'a')] = static_cast<unsigned char>(i);
+    }
+  }
+
+  unsigned char values[256];
+};
+
+const DecodeTable& decodeTable()
+{
+  static const DecodeTable table;
+  return table;
+}
+
+// the coordinate in whole units, rounded first so that values such as 0.1
+// are not pushed into the cell below by the representation error
+std::int64_t units(double shifted, std::int64_t unitsPerDegree)
+{
+  return static_cast<std::int64_t>(std::floor(std::round(shifted * unitsPerDegree * 1e6) / 1e6));
+}
+
+struct CellIndex
+{
+  std::int64_t latitude;
+  std::int64_t longitude;
+};
+
+CellIndex cellIndex(double latitude, double longitude)
+{
+  std::int64_t latitudeIndex = units(latitude + 90.0, latitudeUnitsPerDegree);
+  latitudeIndex = latitudeIndex < 0 ? 0 : (latitudeIndex > latitudeUnits - 1 ? latitudeUnits - 1 : latitudeIndex);
+
+  std::int64_t longitudeIndex = units(longitude + 180.0, longitudeUnitsPerDegree) % longitudeUnits;
+  longitudeIndex = longitudeIndex < 0 ? longitudeIndex + longitudeUnits : longitudeIndex;
+
+  return CellIndex{latitudeIndex, longitudeIndex};
+}
+
+// writes the digits of index into digits: latitude and longitude pairs, then grid digits
+void interleave(CellIndex index, char* digits)
+{
+  for (int i = OpenLocationCodec::maximumPrecision - 1; i >= OpenLocationCodec::pairPrecision; --i)
+  {
+    digits[i] = alphabet[(index.latitude % gridRows) * gridColumns + index.longitude % gridColumns];
+    index.latitude /= gridRows;
+    index.longitude /= gridColumns;
+  }
+
+  for (int i = OpenLocationCodec::pairPrecision - 2; i >= 0; i -= 2)
+  {
+    digits[i] = alphabet[index.latitude % base];
+    digits[i + 1] = alphabet[index.longitude % base];
+    index.latitude /= base;
+    index.longitude /= base;
+  }
+}
+
+int writeCode(const char* digits, int precision, char* buffer)
+{
+  char* out = buffer;
+  for (int i = 0; i < separatorPosition; ++i)
+    *out++ = i < precision ? digits[i] : padding;
+
+  *out++ = separator;
+  for (int i = separatorPosition; i < precision; ++i)
+    *out++ = digits[i];
+
+  return static_cast<int>(out - buffer);
+}
+
+// the bounds of the cell given by the first digitCount of digits (values, not characters)
+void cellBounds(const unsigned char* values, int digitCount, double& south, double& west, double& north, double& east)
+{
+  std::int64_t latitudeIndex = 0;
+  std::int64_t longitudeIndex = 0;
+  for (int i = 0; i < OpenLocationCodec::pairPrecision; i += 2)
+  {
+    latitudeIndex = latitudeIndex * base + (i < digitCount ? values[i] : 0);
+    longitudeIndex = longitudeIndex * base + (i + 1 < digitCount ? values[i + 1] : 0);
+  }
+
+  for (int i = OpenLocationCodec::pairPrecision; i < OpenLocationCodec::maximumPrecision; ++i)
+  {
+    const int value = i < digitCount ? values[i] : 0;
+    latitudeIndex = latitudeIndex * gridRows + value / gridColumns;
+    longitudeIndex = longitudeIndex * gridColumns + value % gridColumns;
+  }
+
+  // the size of the cell in units
+  std::int64_t latitudeSize = 1;
+  std::int64_t longitudeSize = 1;
+  for (int i = digitCount; i < OpenLocationCodec::maximumPrecision; ++i)
+  {
+    if (i < OpenLocationCodec::pairPrecision)
+    {
+      latitudeSize *= (i % 2 == 0) ? base : 1;
+      longitudeSize *= (i % 2 == 1) ? base : 1;
+    }
+    else
+    {
+      latitudeSize *= gridRows;
+      longitudeSize *= gridColumns;
+    }
+  }
+
+  south = static_cast<double>(latitudeIndex) / latitudeUnitsPerDegree - 90.0;
+  west = static_cast<double>(longitudeIndex) / longitudeUnitsPerDegree - 180.0;
+  north = static_cast<double>(latitudeIndex + latitudeSize) / latitudeUnitsPerDegree - 90.0;
+  east = static_cast<double>(longitudeIndex + longitudeSize) / longitudeUnitsPerDegree - 180.0;
+}
+
+} // namespace
+
+/*!
+  \class Esri::ArcGISRuntime::Toolkit::OpenLocationCodec
+  \ingroup ToolCoordinateConversion
+  \inmodule ArcGISQtToolkit
+  \brief A native encoder and decoder for Open Location Codes (Plus Codes).
+  \since Esri::ArcGISRuntime 100.4
+
+  A full Open Location Code interleaves base 20 latitude and longitude
+  digits in pairs, up to \l pairPrecision digits, then refines the cell
+  with up to five grid digits of 5 rows by 4 columns each. A \c + separator
+  follows the eighth digit; shorter codes are padded with zeros up to it.
+
+  The coordinates are turned into integer indices of the smallest cell
+  first, so every code length is produced by the same fixed sequence of
+  divisions, and the batch \l encode and \l decode overloads run over
+  contiguous arrays without branching per point. Decoding returns either
+  the centre of the cell or its bounds.
+
+  Codes shortened against a reference location are not supported.
+ */
+
+/*!
+  \brief Returns whether \a precision is a valid code length: 2, 4, 6, 8, or
+  10 to 15 digits.
+ */
+bool OpenLocationCodec::isValidPrecision(int precision)
+{
+  return precision >= minimumPrecision && precision <= maximumPrecision &&
+      (precision >= pairPrecision || precision % 2 == 0);
+}
+
+/*!
+  \brief Returns the number of characters in a code of \a precision digits,
+  counting the separator and any padding.
+ */
+int OpenLocationCodec::notationLength(int precision)
+{
+  return (precision < separatorPosition ? separatorPosition : precision) + 1;
+}
+
+/*!
+  \brief Writes the Open Location Code of \a latitude and \a longitude
+  (WGS 84 degrees) with \a precision digits into \a buffer.
+
+  Returns the number of characters written, or \c 0 if the coordinate or
+  \a precision is not valid.
+ */
+int OpenLocationCodec::encode(double latitude, double longitude, int precision, char* buffer)
+{
+  if (!isValidPrecision(precision) ||
+      !std::isfinite(latitude) || !std::isfinite(longitude) || latitude < -90.0 || latitude > 90.0)
+  {
+    return 0;
+  }
+
+  if (longitude < -180.0 || longitude > 180.0)
+    longitude = std::remainder(longitude, 360.0);
+
+  char digits[maximumPrecision];
+  interleave(cellIndex(latitude, longitude), digits);
+  return writeCode(digits, precision, buffer);
+}
+
+/*!
+  \brief Writes the Open Location Codes of \a count points from
+  \a latitudes and \a longitudes into \a buffer.
+
+  Every code is \l notationLength(\a precision) characters long and code
+  \c i starts at \c {i * notationLength(precision)}; invalid points are
+  written as spaces. Returns the length of each code, or \c 0 if
+  \a precision is not valid.
+ */
+int OpenLocationCodec::encode(const double* latitudes, const double* longitudes, std::size_t count, int precision,
+                              char* buffer)
+{
+  if (!isValidPrecision(precision))
+    return 0;
+
+  const int length = notationLength(precision);
+  CellIndex cells[batchBlockSize];
+  bool valid[batchBlockSize];
+
+  for (std::size_t blockStart = 0; blockStart < count; blockStart += batchBlockSize)
+  {
+    const std::size_t blockCount = (count - blockStart) < batchBlockSize ? (count - blockStart) : batchBlockSize;
+    const double* blockLatitudes = latitudes + blockStart;
+    const double* blockLongitudes = longitudes + blockStart;
+
+    for (std::size_t i = 0; i < blockCount; ++i)
+    {
+      double latitude = blockLatitudes[i];
+      double longitude = blockLongitudes[i];
+      valid[i] = latitude >= -90.0 && latitude <= 90.0 && std::isfinite(longitude);
+      latitude = valid[i] ? latitude : 0.0;
+      longitude = valid[i] ? longitude : 0.0;
+      if (longitude < -180.0 || longitude > 180.0)
+        longitude = std::remainder(longitude, 360.0);
+
+      cells[i] = cellIndex(latitude, longitude);
+    }
+
+    char* out = buffer + blockStart * length;
+    char digits[maximumPrecision];
+    for (std::size_t i = 0; i < blockCount; ++i, out += length)
+    {
+      if (valid[i])
+      {
+        interleave(cells[i], digits);
+        writeCode(digits, precision, out);
+      }
+      else
+      {
+        for (int c = 0; c < length; ++c)
+          out[c] = ' ';
+      }
+    }
+  }
+
+  return length;
+}
+
+/*!
+  \brief Decodes the full Open Location Code in the first \a length
+  characters of \a text into the \a latitude and \a longitude (WGS 84
+  degrees) of the centre of its cell.
+ */
+bool OpenLocationCodec::decode(const char* text, int length, double& latitude, double& longitude)
+{
+  double south = 0.0;
+  double west = 0.0;
+  double north = 0.0;
+  double east = 0.0;
+  if (!decode(text, length, south, west, north, east))
+    return false;
+
+  latitude = 0.5 * (south + north);
+  longitude = 0.5 * (west + east);
+  return true;
+}
+
+/*!
+  \brief Decodes the full Open Location Code in the first \a length
+  characters of \a text into the bounds of its cell: \a south, \a west,
+  \a north and \a east in WGS 84 degrees.
+
+  Spaces and tabs are ignored and letters may be in either case.
+ */
+bool OpenLocationCodec::decode(const char* text, int length, double& south, double& west, double& north, double& east)
+{
+  const DecodeTable& table = decodeTable();
+  unsigned char values[maximumPrecision];
+  int digitCount = 0;
+  int position = 0;
+  int paddingStart = -1;
+  bool separated = false;
+  for (int i = 0; i < length; ++i)
+  {
+    const char c = text[i];
+    if (c == ' ' || c == '\t')
+      continue;
+
+    if (c == separator)
+    {
+      if (position != separatorPosition)
+        return false;
+
+      separated = true;
+    }
+    else if (c == padding)
+    {
+      // padding starts on a pair boundary and runs up to the separator
+      if (separated || (paddingStart < 0 && (position % 2 != 0 || position == 0)))
+        return false;
+
+      if (paddingStart < 0)
+        paddingStart = position;
+    }
+    else
+    {
+      const unsigned char value = table.values[static_cast<unsigned char>(c)];
+      if (value == invalidCharacter || paddingStart >= 0 || digitCount == maximumPrecision)
+        return false;
+
+      values[digitCount++] = value;
+    }
+
+    ++position;
+  }
+
+  // at least two digits after the separator, and none after padding
+  const int extraDigits = digitCount - separatorPosition;
+  if (!separated || (paddingStart < 0 && digitCount < separatorPosition) || extraDigits == 1 ||
+      (paddingStart >= 0 && extraDigits > 0))
+  {
+    return false;
+  }
+
+  if (values[0] >= firstLatitudeDigitCount || values[1] >= firstLongitudeDigitCount)
+    return false;
+
+  cellBounds(values, digitCount, south, west, north, east);
+  return true;
+}
+
+/*!
+  \brief Decodes \a count Open Location Codes of \a precision digits from
+  \a buffer into the centres of their cells in \a latitudes and
+  \a longitudes.
+
+  Code \c i starts at \c {i * notationLength(precision)}, as written by the
+  batch \l encode. Codes holding a character outside the alphabet, or
+  without the separator and padding where they belong, decode to NaN.
+  Returns the number of codes decoded, or \c 0 if \a precision is not
+  valid.
+ */
+std::size_t OpenLocationCodec::decode(const char* buffer, std::size_t count, int precision, double* latitudes,
+                                      double* longitudes)
+{
+  if (!isValidPrecision(precision))
+    return 0;
+
+  const DecodeTable& table = decodeTable();
+  const int length = notationLength(precision);
+  const double nan = std::numeric_limits<double>::quiet_NaN();
+  unsigned char values[maximumPrecision];
+  std::size_t decoded = 0;
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    const char* text = buffer + i * length;
+    unsigned char invalid = 0;
+    for (int digit = 0; digit < precision; ++digit)
+    {
+      const unsigned char value = table.values[static_cast<unsigned char>(text[digit < separatorPosition ? digit : digit + 1])];
+      invalid |= value;
+      values[digit] = value & 31u;
+    }
+
+    for (int c = precision; c < separatorPosition; ++c)
+      invalid |= text[c] == padding ? 0 : invalidCharacter;
+
+    invalid |= text[separatorPosition] == separator ? 0 : invalidCharacter;
+    invalid |= values[0] < firstLatitudeDigitCount && values[1] < firstLongitudeDigitCount ? 0 : invalidCharacter;
+
+    double south = 0.0;
+    double west = 0.0;
+    double north = 0.0;
+    double east = 0.0;
+    cellBounds(values, precision, south, west, north, east);
+
+    const bool valid = (invalid & invalidCharacter) == 0;
+    latitudes[i] = valid ? 0.5 * (south + north) : nan;
+    longitudes[i] = valid ? 0.5 * (west + east) : nan;
+    decoded += valid ? 1 : 0;
+  }
+
+  return decoded;
+}
+
+} // Toolkit
+} // ArcGISRuntime
+} // Esri
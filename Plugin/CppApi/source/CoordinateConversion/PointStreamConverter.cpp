@@ -0,0 +1,166 @@
+/*******************************************************************************
+ *  Copyright 2012-2018 Esri
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ******************************************************************************/
+
+#include "PointStreamConverter.h"
+
+// toolkit headers
+#include "CoordinateConversionEngine.h"
+#include "PointStreamReader.h"
+#include "PointStreamWriter.h"
+
+// Qt headers
+#include <QFile>
+
+namespace Esri
+{
+namespace ArcGISRuntime
+{
+namespace Toolkit
+{
+
+/*!
+  \class Esri::ArcGISRuntime::Toolkit::PointStreamConverter
+  \ingroup ToolCoordinateConversion
+  \inmodule ArcGISQtToolkit
+  \brief Converts a stream of points to a stream of points with their
+  notations.
+  \since Esri::ArcGISRuntime 100.4
+
+  Points are read a batch at a time, converted in parallel by
+  CoordinateConversionEngine::convertPoints and written before the next
+  batch is read. At most one batch of points and notations is held at once,
+  so a track of millions of points converts in the memory of a single batch.
+
+  \sa PointStreamReader, PointStreamWriter
+ */
+
+constexpr int PointStreamConverter::defaultBatchSize;
+
+/*!
+  \brief Reads every point from \a reader, converts it with each of
+  \a options using \a engine and writes it with its notations to \a writer.
+
+  Points are converted \a batchSize at a time. If \a canceled is not null
+  and becomes \c true, the conversion stops after the current batch and the
+  output is left incomplete.
+
+  This may be called from any thread, as the options are given explicitly.
+ */
+PointStreamConverter::Result PointStreamConverter::convert(const CoordinateConversionEngine& engine,
+                                                           const QList<CoordinateFormatOption>& options,
+                                                           PointStreamReader& reader, PointStreamWriter& writer,
+                                                           int batchSize, const std::atomic<bool>* canceled)
+{
+  Result result;
+  batchSize = qMax(1, batchSize);
+
+  QStringList formatNames;
+  for (const CoordinateFormatOption& option : options)
+    formatNames.append(option.name());
+
+  if (!writer.writeHeader(formatNames))
+  {
+    result.errorString = writer.errorString();
+    return result;
+  }
+
+  QList<Point> points;
+  points.reserve(batchSize);
+  while (reader.readPoints(batchSize, points) > 0)
+  {
+    if (!writer.writePoints(points, engine.convertPoints(options, points)))
+    {
+      result.errorString = writer.errorString();
+      return result;
+    }
+
+    result.pointCount += points.size();
+    points.clear();
+
+    if (canceled && canceled->load())
+    {
+      result.canceled = true;
+      return result;
+    }
+  }
+
+  if (reader.hasError())
+  {
+    result.errorString = reader.errorString();
+    return result;
+  }
+
+  if (!writer.writeFooter())
+    result.errorString = writer.errorString();
+
+  return result;
+}
+
+/*!
+  \brief Converts the points of the file \a inputFileName with each of
+  \a options, writing them with their notations to \a outputFileName.
+
+  The format of each file is chosen from its extension by
+  \l pointFileFormat.
+
+  \sa convert
+ */
+PointStreamConverter::Result PointStreamConverter::convertFile(const CoordinateConversionEngine& engine,
+                                                               const QList<CoordinateFormatOption>& options,
+                                                               const QString& inputFileName,
+                                                               const QString& outputFileName,
+                                                               int batchSize, const std::atomic<bool>* canceled)
+{
+  Result result;
+
+  QFile input(inputFileName);
+  std::unique_ptr<PointStreamReader> reader = PointStreamReader::create(pointFileFormat(inputFileName), &input);
+  if (!reader)
+  {
+    result.errorString = QStringLiteral("Unknown point file format: %1").arg(inputFileName);
+    return result;
+  }
+
+  QFile output(outputFileName);
+  std::unique_ptr<PointStreamWriter> writer = PointStreamWriter::create(pointFileFormat(outputFileName), &output);
+  if (!writer)
+  {
+    result.errorString = QStringLiteral("Unknown point file format: %1").arg(outputFileName);
+    return result;
+  }
+
+  if (!input.open(QIODevice::ReadOnly))
+  {
+    result.errorString = QStringLiteral("Could not open %1: %2").arg(inputFileName, input.errorString());
+    return result;
+  }
+
+  if (!output.open(QIODevice::WriteOnly | QIODevice::Truncate))
+  {
+    result.errorString = QStringLiteral("Could not open %1: %2").arg(outputFileName, output.errorString());
+    return result;
+  }
+
+  result = convert(engine, options, *reader, *writer, batchSize, canceled);
+  if (result.errorString.isEmpty() && !output.flush())
+    result.errorString = output.errorString();
+
+  return result;
+}
+
+} // Toolkit
+} // ArcGISRuntime
+} // Esri
@@ -0,0 +1,610 @@
+/*******************************************************************************
+ *  Copyright 2012-2018 Esri
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ******************************************************************************/
+
+#include "PointStreamReader.h"
+
+// C++ API headers
+#include "SpatialReference.h"
+
+// Qt headers
+#include <QFileInfo>
+#include <QIODevice>
+#include <QVector>
+#include <QXmlStreamReader>
+
+namespace Esri
+{
+namespace ArcGISRuntime
+{
+namespace Toolkit
+{
+
+namespace
+{
+
+// bytes read from the device at a time by the GeoJSON reader
+constexpr int readBlockSize = 64 * 1024;
+
+// the longest CSV line, number or object member name read
+constexpr qint64 maximumLineLength = 1024 * 1024;
+constexpr int maximumTokenLength = 64;
+
+// splits a CSV line on commas, honouring double quoted fields
+QList<QByteArray> csvFields(const QByteArray& line)
+{
+  QList<QByteArray> fields;
+  QByteArray field;
+  bool quoted = false;
+  for (int i = 0; i < line.size(); ++i)
+  {
+    const char c = line.at(i);
+    if (c == '"')
+    {
+      // a doubled quote inside a quoted field is a literal quote
+      if (quoted && i + 1 < line.size() && line.at(i + 1) == '"')
+      {
+        field.append('"');
+        ++i;
+      }
+      else
+      {
+        quoted = !quoted;
+      }
+
+      continue;
+    }
+
+    if (c == ',' && !quoted)
+    {
+      fields.append(field.trimmed());
+      field.clear();
+      continue;
+    }
+
+    field.append(c);
+  }
+
+  fields.append(field.trimmed());
+  return fields;
+}
+
+bool fieldToDouble(const QList<QByteArray>& fields, int column, double& value)
+{
+  if (column >= fields.size())
+    return false;
+
+  bool ok = false;
+  value = fields.at(column).toDouble(&ok);
+  return ok;
+}
+
+class GpxPointReader : public PointStreamReader
+{
+public:
+  explicit GpxPointReader(QIODevice* device) :
+    PointStreamReader(device),
+    m_xml(device),
+    m_wgs84(SpatialReference::wgs84())
+  {
+  }
+
+  // waypoints, route points and track points, in document order
+  int readPoints(int maximumCount, QList<Point>& points) override
+  {
+    if (hasError())
+      return 0;
+
+    int count = 0;
+    while (count < maximumCount && !m_xml.atEnd())
+    {
+      if (m_xml.readNext() != QXmlStreamReader::StartElement)
+        continue;
+
+      const QStringRef name = m_xml.name();
+      if (name != QLatin1String("trkpt") && name != QLatin1String("wpt") && name != QLatin1String("rtept"))
+        continue;
+
+      const QXmlStreamAttributes attributes = m_xml.attributes();
+      bool latitudeOk = false;
+      bool longitudeOk = false;
+      const double latitude = attributes.value(QLatin1String("lat")).toDouble(&latitudeOk);
+      const double longitude = attributes.value(QLatin1String("lon")).toDouble(&longitudeOk);
+      if (!latitudeOk || !longitudeOk)
+      {
+        setErrorString(QStringLiteral("Line %1: the %2 has no valid lat and lon attributes")
+                       .arg(m_xml.lineNumber()).arg(name.toString()));
+        return count;
+      }
+
+      points.append(Point(longitude, latitude, m_wgs84));
+      ++count;
+    }
+
+    if (m_xml.hasError())
+      setErrorString(QStringLiteral("Line %1: %2").arg(m_xml.lineNumber()).arg(m_xml.errorString()));
+
+    return count;
+  }
+
+private:
+  QXmlStreamReader m_xml;
+  SpatialReference m_wgs84;
+};
+
+// scans the JSON text for the positions of every "coordinates" member,
+// whatever the geometry type, without building a document
+class GeoJsonPointReader : public PointStreamReader
+{
+public:
+  explicit GeoJsonPointReader(QIODevice* device) :
+    PointStreamReader(device),
+    m_wgs84(SpatialReference::wgs84())
+  {
+  }
+
+  int readPoints(int maximumCount, QList<Point>& points) override
+  {
+    if (hasError())
+      return 0;
+
+    int count = 0;
+    char c = 0;
+    while (count < maximumCount && nextByte(c))
+    {
+      switch (c)
+      {
+      case ' ':
+      case '\t':
+      case '\r':
+      case '\n':
+      case ':':
+        break;
+      case ',':
+        if (!m_stack.isEmpty() && m_stack.last().object)
+          m_stack.last().expectingKey = true;
+        break;
+      case '{':
+      {
+        Container object;
+        object.object = true;
+        object.expectingKey = true;
+        m_stack.append(object);
+        break;
+      }
+      case '[':
+      {
+        // arrays nested in a "coordinates" member are positions or lists of them
+        Container array;
+        if (!m_stack.isEmpty())
+        {
+          const Container& parent = m_stack.last();
+          array.coordinates = parent.object ? parent.key == "coordinates" : parent.coordinates;
+        }
+        m_stack.append(array);
+        break;
+      }
+      case '}':
+      case ']':
+      {
+        if (m_stack.isEmpty() || m_stack.last().object != (c == '}'))
+        {
+          fail(QStringLiteral("unmatched '%1'").arg(QLatin1Char(c)));
+          return count;
+        }
+
+        const Container closed = m_stack.takeLast();
+        if (closed.coordinates && closed.numberCount >= 2)
+        {
+          points.append(Point(closed.x, closed.y, m_wgs84));
+          ++count;
+        }
+        break;
+      }
+      case '"':
+      {
+        Container* container = m_stack.isEmpty() ? nullptr : &m_stack.last();
+        const bool isKey = container && container->object && container->expectingKey;
+        if (!readString(isKey ? &container->key : nullptr))
+          return count;
+
+        if (isKey)
+          container->expectingKey = false;
+        break;
+      }
+      default:
+        if (c == '-' || (c >= '0' && c <= '9'))
+        {
+          double value = 0.0;
+          if (!readNumber(c, value))
+            return count;
+
+          if (!m_stack.isEmpty() && m_stack.last().coordinates)
+          {
+            Container& position = m_stack.last();
+            if (position.numberCount == 0)
+              position.x = value;
+            else if (position.numberCount == 1)
+              position.y = value;
+            ++position.numberCount;
+          }
+        }
+        else if (c >= 'a' && c <= 'z')
+        {
+          // true, false or null
+          while (nextByte(c))
+          {
+            if (c < 'a' || c > 'z')
+            {
+              --m_position;
+              break;
+            }
+          }
+        }
+        else
+        {
+          fail(QStringLiteral("unexpected character '%1'").arg(QLatin1Char(c)));
+          return count;
+        }
+      }
+    }
+
+    if (count < maximumCount && !hasError() && !m_stack.isEmpty())
+      fail(QStringLiteral("the text ends inside an object or array"));
+
+    return count;
+  }
+
+private:
+  struct Container
+  {
+    bool object = false;
+    bool expectingKey = false; // an object waiting for the name of its next member
+    bool coordinates = false;  // an array within a "coordinates" member
+    QByteArray key;            // the name of the member being read
+    int numberCount = 0;
+    double x = 0.0;
+    double y = 0.0;
+  };
+
+  bool nextByte(char& c)
+  {
+    if (m_position == m_buffer.size())
+    {
+      if (m_ended)
+        return false;
+
+      m_consumed += m_buffer.size();
+      m_buffer.resize(readBlockSize);
+      const qint64 readCount = device()->read(m_buffer.data(), readBlockSize);
+      m_buffer.resize(static_cast<int>(qMax<qint64>(0, readCount)));
+      m_position = 0;
+
+      if (readCount < 0)
+        fail(device()->errorString());
+
+      if (readCount <= 0)
+      {
+        m_ended = true;
+        return false;
+      }
+    }
+
+    c = m_buffer.at(m_position++);
+    return true;
+  }
+
+  // reads the rest of a string, keeping the start of it in value if not null
+  bool readString(QByteArray* value)
+  {
+    if (value)
+      value->clear();
+
+    char c = 0;
+    while (nextByte(c))
+    {
+      if (c == '"')
+        return true;
+
+      if (c == '\\' && !nextByte(c))
+        break;
+
+      if (value && value->size() < maximumTokenLength)
+        value->append(c);
+    }
+
+    fail(QStringLiteral("the text ends inside a string"));
+    return false;
+  }
+
+  bool readNumber(char first, double& value)
+  {
+    char text[maximumTokenLength + 1];
+    int length = 0;
+    text[length++] = first;
+
+    char c = 0;
+    while (nextByte(c))
+    {
+      if ((c < '0' || c > '9') && c != '.' && c != 'e' && c != 'E' && c != '+' && c != '-')
+      {
+        --m_position;
+        break;
+      }
+
+      if (length == maximumTokenLength)
+      {
+        fail(QStringLiteral("a number is too long"));
+        return false;
+      }
+
+      text[length++] = c;
+    }
+
+    text[length] = '\0';
+    bool ok = false;
+    value = QByteArray::fromRawData(text, length).toDouble(&ok);
+    if (!ok)
+      fail(QStringLiteral("invalid number %1").arg(QLatin1String(text)));
+
+    return ok;
+  }
+
+  void fail(const QString& message)
+  {
+    if (!hasError())
+      setErrorString(QStringLiteral("Byte %1: %2").arg(m_consumed + m_position).arg(message));
+  }
+
+  SpatialReference m_wgs84;
+  QByteArray m_buffer;
+  int m_position = 0;
+  qint64 m_consumed = 0;
+  bool m_ended = false;
+  QVector<Container> m_stack;
+};
+
+// rows of x (longitude) and y (latitude) fields, with an optional header
+// naming the columns; without one the first two columns are used
+class CsvPointReader : public PointStreamReader
+{
+public:
+  explicit CsvPointReader(QIODevice* device) :
+    PointStreamReader(device),
+    m_wgs84(SpatialReference::wgs84())
+  {
+  }
+
+  int readPoints(int maximumCount, QList<Point>& points) override
+  {
+    if (hasError())
+      return 0;
+
+    int count = 0;
+    while (count < maximumCount)
+    {
+      const QByteArray line = device()->readLine(maximumLineLength);
+      if (line.isEmpty())
+        break;
+
+      ++m_lineNumber;
+      if (!line.endsWith('\n') && !device()->atEnd())
+      {
+        setErrorString(QStringLiteral("Line %1: the line is too long").arg(m_lineNumber));
+        return count;
+      }
+
+      const QByteArray text = line.trimmed();
+      if (text.isEmpty())
+        continue;
+
+      const QList<QByteArray> fields = csvFields(text);
+      double x = 0.0;
+      double y = 0.0;
+      const bool parsed = fieldToDouble(fields, m_xColumn, x) && fieldToDouble(fields, m_yColumn, y);
+
+      if (!m_firstLineRead)
+      {
+        m_firstLineRead = true;
+        if (!parsed)
+        {
+          if (!findColumns(fields))
+          {
+            setErrorString(QStringLiteral("Line 1: the header has no x and y or longitude and latitude columns"));
+            return count;
+          }
+
+          continue;
+        }
+      }
+
+      if (!parsed)
+      {
+        setErrorString(QStringLiteral("Line %1: the x and y fields are not numbers").arg(m_lineNumber));
+        return count;
+      }
+
+      points.append(Point(x, y, m_wgs84));
+      ++count;
+    }
+
+    return count;
+  }
+
+private:
+  bool findColumns(const QList<QByteArray>& header)
+  {
+    static const QList<QByteArray> xNames{"x", "lon", "long", "lng", "longitude"};
+    static const QList<QByteArray> yNames{"y", "lat", "latitude"};
+
+    m_xColumn = -1;
+    m_yColumn = -1;
+    for (int column = 0; column < header.size(); ++column)
+    {
+      const QByteArray name = header.at(column).toLower();
+      if (m_xColumn < 0 && xNames.contains(name))
+        m_xColumn = column;
+      else if (m_yColumn < 0 && yNames.contains(name))
+        m_yColumn = column;
+    }
+
+    return m_xColumn >= 0 && m_yColumn >= 0;
+  }
+
+  SpatialReference m_wgs84;
+  int m_xColumn = 0;
+  int m_yColumn = 1;
+  bool m_firstLineRead = false;
+  qint64 m_lineNumber = 0;
+};
+
+} // namespace
+
+/*!
+  \brief Returns the point file format of \a fileName, from its extension.
+
+  \list
+    \li \c .gpx is \c PointFileFormat::Gpx.
+    \li \c .geojson and \c .json are \c PointFileFormat::GeoJson.
+    \li \c .csv and \c .txt are \c PointFileFormat::Csv.
+  \endlist
+
+  Any other extension is \c PointFileFormat::Unknown.
+ */
+PointFileFormat pointFileFormat(const QString& fileName)
+{
+  const QString suffix = QFileInfo(fileName).suffix().toLower();
+  if (suffix == QLatin1String("gpx"))
+    return PointFileFormat::Gpx;
+
+  if (suffix == QLatin1String("geojson") || suffix == QLatin1String("json"))
+    return PointFileFormat::GeoJson;
+
+  if (suffix == QLatin1String("csv") || suffix == QLatin1String("txt"))
+    return PointFileFormat::Csv;
+
+  return PointFileFormat::Unknown;
+}
+
+/*!
+  \class Esri::ArcGISRuntime::Toolkit::PointStreamReader
+  \ingroup ToolCoordinateConversion
+  \inmodule ArcGISQtToolkit
+  \brief Reads the points of a GPX, GeoJSON or CSV stream a batch at a time.
+  \since Esri::ArcGISRuntime 100.4
+
+  Each call to \l readPoints reads only as far into the stream as the
+  points it returns, so memory use depends on the batch size and not on
+  the size of the stream. No DOM, JSON document or QVariant tree is built.
+  Points are in WGS 84.
+
+  \list
+    \li GPX: every \c wpt, \c rtept and \c trkpt element, in document
+        order, read with QXmlStreamReader.
+    \li GeoJSON: every position within a \c coordinates member, whatever
+        the geometry type, in document order.
+    \li CSV: one point per row. If the first row is not numeric it is a
+        header, and the columns named \c x, \c lon, \c long, \c lng or
+        \c longitude and \c y, \c lat or \c latitude are used. Otherwise
+        the first two columns are x and y. Quoted fields may not contain
+        line breaks.
+  \endlist
+
+  \sa PointStreamWriter, PointStreamConverter
+ */
+
+/*!
+  \brief Returns a reader of \a format reading from \a device, or
+  \c nullptr if \a format is \c PointFileFormat::Unknown.
+
+  \a device must be open for reading and must outlive the reader.
+ */
+std::unique_ptr<PointStreamReader> PointStreamReader::create(PointFileFormat format, QIODevice* device)
+{
+  switch (format)
+  {
+  case PointFileFormat::Gpx:
+    return std::unique_ptr<PointStreamReader>(new GpxPointReader(device));
+  case PointFileFormat::GeoJson:
+    return std::unique_ptr<PointStreamReader>(new GeoJsonPointReader(device));
+  case PointFileFormat::Csv:
+    return std::unique_ptr<PointStreamReader>(new CsvPointReader(device));
+  default:
+    break;
+  }
+
+  return nullptr;
+}
+
+/*!
+  \brief Constructor taking the \a device read from.
+ */
+PointStreamReader::PointStreamReader(QIODevice* device) :
+  m_device(device)
+{
+}
+
+/*!
+  \brief The destructor.
+ */
+PointStreamReader::~PointStreamReader()
+{
+}
+
+/*!
+  \fn int PointStreamReader::readPoints(int maximumCount, QList<Point>& points);
+  \brief Appends up to \a maximumCount points read from the stream to
+  \a points and returns the number appended.
+
+  Fewer points are returned only at the end of the stream or when it cannot
+  be read, which \l hasError tells apart.
+ */
+
+/*!
+  \brief Returns whether the stream could not be read.
+ */
+bool PointStreamReader::hasError() const
+{
+  return !m_errorString.isEmpty();
+}
+
+/*!
+  \brief Returns a description of why the stream could not be read, or an
+  empty string.
+ */
+QString PointStreamReader::errorString() const
+{
+  return m_errorString;
+}
+
+/*!
+  \brief Returns the device read from.
+ */
+QIODevice* PointStreamReader::device() const
+{
+  return m_device;
+}
+
+/*!
+  \brief Records \a errorString as the reason the stream could not be read.
+ */
+void PointStreamReader::setErrorString(const QString& errorString)
+{
+  m_errorString = errorString;
+}
+
+} // Toolkit
+} // ArcGISRuntime
+} // Esri
@@ -0,0 +1,412 @@
+/*******************************************************************************
+ *  Copyright 2012-2018 Esri
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ******************************************************************************/
+
+#include "PointStreamWriter.h"
+
+// Qt headers
+#include <QIODevice>
+
+namespace Esri
+{
+namespace ArcGISRuntime
+{
+namespace Toolkit
+{
+
+namespace
+{
+
+// decimal places of the written coordinates, about 0.1 mm at the equator
+constexpr int coordinateDecimals = 9;
+
+// the GPX element holding the notations of a point, inside its extensions
+const char notationElement[] = "notation";
+
+void appendCoordinate(QByteArray& output, double value)
+{
+  output.append(QByteArray::number(value, 'f', coordinateDecimals));
+}
+
+void appendXmlText(QByteArray& output, const QString& text)
+{
+  output.append(text.toHtmlEscaped().toUtf8());
+}
+
+void appendJsonString(QByteArray& output, const QString& text)
+{
+  output.append('"');
+  for (const char c : text.toUtf8())
+  {
+    switch (c)
+    {
+    case '"':
+      output.append("\\\"");
+      break;
+    case '\\':
+      output.append("\\\\");
+      break;
+    case '\n':
+      output.append("\\n");
+      break;
+    case '\r':
+      output.append("\\r");
+      break;
+    case '\t':
+      output.append("\\t");
+      break;
+    default:
+      if (static_cast<unsigned char>(c) < 0x20)
+        output.append("\\u00").append(QByteArray::number(static_cast<int>(c), 16).rightJustified(2, '0'));
+      else
+        output.append(c);
+    }
+  }
+  output.append('"');
+}
+
+void appendCsvField(QByteArray& output, const QString& text)
+{
+  const QByteArray field = text.toUtf8();
+  if (field.indexOf(',') == -1 && field.indexOf('"') == -1 && field.indexOf('\n') == -1)
+  {
+    output.append(field);
+    return;
+  }
+
+  QByteArray escaped = field;
+  escaped.replace("\"", "\"\"");
+  output.append('"');
+  output.append(escaped);
+  output.append('"');
+}
+
+// a single track segment, each point holding its notations as extensions
+class GpxPointWriter : public PointStreamWriter
+{
+public:
+  explicit GpxPointWriter(QIODevice* device) :
+    PointStreamWriter(device)
+  {
+  }
+
+protected:
+  void appendHeader(QByteArray& output) override
+  {
+    output.append("<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+                  "<gpx version=\"1.1\" creator=\"ArcGIS Runtime Toolkit\" xmlns=\"http://www.topografix.com/GPX/1/1\">\n"
+                  "<trk>\n<trkseg>\n");
+  }
+
+  void appendPoint(QByteArray& output, const Point& point, const CoordinateConversionBatchResult& notations,
+                   int row) override
+  {
+    output.append("<trkpt lat=\"");
+    appendCoordinate(output, point.y());
+    output.append("\" lon=\"");
+    appendCoordinate(output, point.x());
+    output.append("\">");
+
+    if (notations.columnCount() > 0)
+    {
+      output.append("<extensions>");
+      for (int column = 0; column < notations.columnCount(); ++column)
+      {
+        output.append('<').append(notationElement).append(" format=\"");
+        appendXmlText(output, formatNames().at(column));
+        output.append("\">");
+        appendXmlText(output, notations.notation(row, column));
+        output.append("</").append(notationElement).append('>');
+      }
+      output.append("</extensions>");
+    }
+
+    output.append("</trkpt>\n");
+  }
+
+  void appendFooter(QByteArray& output) override
+  {
+    output.append("</trkseg>\n</trk>\n</gpx>\n");
+  }
+};
+
+// a FeatureCollection of Point features, one property per format
+class GeoJsonPointWriter : public PointStreamWriter
+{
+public:
+  explicit GeoJsonPointWriter(QIODevice* device) :
+    PointStreamWriter(device)
+  {
+  }
+
+protected:
+  void appendHeader(QByteArray& output) override
+  {
+    output.append("{\"type\":\"FeatureCollection\",\"features\":[");
+  }
+
+  void appendPoint(QByteArray& output, const Point& point, const CoordinateConversionBatchResult& notations,
+                   int row) override
+  {
+    output.append(m_pointCount++ == 0 ? "\n" : ",\n");
+    output.append("{\"type\":\"Feature\",\"geometry\":{\"type\":\"Point\",\"coordinates\":[");
+    appendCoordinate(output, point.x());
+    output.append(',');
+    appendCoordinate(output, point.y());
+    output.append("]},\"properties\":{");
+
+    for (int column = 0; column < notations.columnCount(); ++column)
+    {
+      if (column > 0)
+        output.append(',');
+
+      appendJsonString(output, formatNames().at(column));
+      output.append(':');
+
+      // a point which could not be converted has a null notation
+      const QString notation = notations.notation(row, column);
+      if (notation.isEmpty())
+        output.append("null");
+      else
+        appendJsonString(output, notation);
+    }
+
+    output.append("}}");
+  }
+
+  void appendFooter(QByteArray& output) override
+  {
+    output.append("\n]}\n");
+  }
+
+private:
+  qint64 m_pointCount = 0;
+};
+
+// x and y columns followed by one column per format
+class CsvPointWriter : public PointStreamWriter
+{
+public:
+  explicit CsvPointWriter(QIODevice* device) :
+    PointStreamWriter(device)
+  {
+  }
+
+protected:
+  void appendHeader(QByteArray& output) override
+  {
+    output.append("x,y");
+    for (const QString& formatName : formatNames())
+    {
+      output.append(',');
+      appendCsvField(output, formatName);
+    }
+    output.append('\n');
+  }
+
+  void appendPoint(QByteArray& output, const Point& point, const CoordinateConversionBatchResult& notations,
+                   int row) override
+  {
+    appendCoordinate(output, point.x());
+    output.append(',');
+    appendCoordinate(output, point.y());
+    for (int column = 0; column < notations.columnCount(); ++column)
+    {
+      output.append(',');
+      appendCsvField(output, notations.notation(row, column));
+    }
+    output.append('\n');
+  }
+
+  void appendFooter(QByteArray&) override
+  {
+  }
+};
+
+} // namespace
+
+/*!
+  \class Esri::ArcGISRuntime::Toolkit::PointStreamWriter
+  \ingroup ToolCoordinateConversion
+  \inmodule ArcGISQtToolkit
+  \brief Writes points and their notations to a GPX, GeoJSON or CSV stream
+  a batch at a time.
+  \since Esri::ArcGISRuntime 100.4
+
+  Each batch is formatted into one buffer and written to the device before
+  the next one, so memory use depends on the batch size and not on the
+  number of points written. Points must be in WGS 84.
+
+  \list
+    \li GPX: a track with a single segment. Each \c trkpt holds a
+        \c notation element per format, with a \c format attribute naming
+        it, in its \c extensions.
+    \li GeoJSON: a \c FeatureCollection of \c Point features, with the
+        notation in each format as a property named after the format. A
+        notation which could not be produced is \c null.
+    \li CSV: \c x and \c y columns followed by a column per format, with a
+        header row naming them.
+  \endlist
+
+  \sa PointStreamReader, PointStreamConverter
+ */
+
+/*!
+  \brief Returns a writer of \a format writing to \a device, or \c nullptr
+  if \a format is \c PointFileFormat::Unknown.
+
+  \a device must be open for writing and must outlive the writer.
+ */
+std::unique_ptr<PointStreamWriter> PointStreamWriter::create(PointFileFormat format, QIODevice* device)
+{
+  switch (format)
+  {
+  case PointFileFormat::Gpx:
+    return std::unique_ptr<PointStreamWriter>(new GpxPointWriter(device));
+  case PointFileFormat::GeoJson:
+    return std::unique_ptr<PointStreamWriter>(new GeoJsonPointWriter(device));
+  case PointFileFormat::Csv:
+    return std::unique_ptr<PointStreamWriter>(new CsvPointWriter(device));
+  default:
+    break;
+  }
+
+  return nullptr;
+}
+
+/*!
+  \brief Constructor taking the \a device written to.
+ */
+PointStreamWriter::PointStreamWriter(QIODevice* device) :
+  m_device(device)
+{
+}
+
+/*!
+  \brief The destructor.
+ */
+PointStreamWriter::~PointStreamWriter()
+{
+}
+
+/*!
+  \brief Writes the start of the stream, for notations in the formats named
+  \a formatNames.
+
+  Call this once, before the first call to \l writePoints. Returns \c false
+  if the device could not be written to.
+ */
+bool PointStreamWriter::writeHeader(const QStringList& formatNames)
+{
+  m_formatNames = formatNames;
+
+  QByteArray output;
+  appendHeader(output);
+  return write(output);
+}
+
+/*!
+  \brief Writes each of \a points with the notations in the same row of
+  \a notations.
+
+  The columns of \a notations must be in the order of the format names
+  given to \l writeHeader. Returns \c false if the device could not be
+  written to.
+ */
+bool PointStreamWriter::writePoints(const QList<Point>& points, const CoordinateConversionBatchResult& notations)
+{
+  QByteArray output;
+  output.reserve(points.size() * (64 + 32 * notations.columnCount()));
+  for (int row = 0; row < points.size(); ++row)
+    appendPoint(output, points.at(row), notations, row);
+
+  return write(output);
+}
+
+/*!
+  \brief Writes the end of the stream.
+
+  Call this once, after the last call to \l writePoints. Returns \c false
+  if the device could not be written to.
+ */
+bool PointStreamWriter::writeFooter()
+{
+  QByteArray output;
+  appendFooter(output);
+  return write(output);
+}
+
+/*!
+  \brief Returns whether the device could not be written to.
+ */
+bool PointStreamWriter::hasError() const
+{
+  return !m_errorString.isEmpty();
+}
+
+/*!
+  \brief Returns a description of why the device could not be written to,
+  or an empty string.
+ */
+QString PointStreamWriter::errorString() const
+{
+  return m_errorString;
+}
+
+/*!
+  \brief Returns the names of the formats given to \l writeHeader.
+ */
+const QStringList& PointStreamWriter::formatNames() const
+{
+  return m_formatNames;
+}
+
+/*!
+  \fn void PointStreamWriter::appendHeader(QByteArray& output);
+  \brief Appends the start of the stream to \a output.
+ */
+
+/*!
+  \fn void PointStreamWriter::appendPoint(QByteArray& output, const Point& point, const CoordinateConversionBatchResult& notations, int row);
+  \brief Appends \a point, with the notations at \a row of \a notations,
+  to \a output.
+ */
+
+/*!
+  \fn void PointStreamWriter::appendFooter(QByteArray& output);
+  \brief Appends the end of the stream to \a output.
+ */
+
+/*!
+  \internal
+ */
+bool PointStreamWriter::write(const QByteArray& output)
+{
+  if (hasError())
+    return false;
+
+  if (output.isEmpty() || m_device->write(output) == output.size())
+    return true;
+
+  m_errorString = m_device->errorString();
+  if (m_errorString.isEmpty())
+    m_errorString = QStringLiteral("The output could not be written");
+
+  return false;
+}
+
+} // Toolkit
+} // ArcGISRuntime
+} // Esri
@@ -0,0 +1,480 @@
+/*******************************************************************************
+ *  Copyright 2012-2018 Esri
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ******************************************************************************/
+
+
+#include "S2CellCodec.h"
+
+// STL headers
+#include <cmath>
+
+namespace Esri
+{
+namespace ArcGISRuntime
+{
+namespace Toolkit
+{
+
+namespace
+{
+
+constexpr double degreesToRadians = 0.017453292519943295769;
+constexpr double radiansToDegrees = 57.295779513082320876798;
+
+constexpr int faceBits = 3;
+constexpr int faceCount = 6;
+constexpr int positionBits = 2 * S2CellCodec::maximumLevel + 1;
+
+// leaf cells per face side
+constexpr int limitIJ = 1 << S2CellCodec::maximumLevel;
+
+// the Hilbert curve is walked four levels (8 bits of position) at a time
+constexpr int lookupBits = 4;
+constexpr int lookupMask = (1 << lookupBits) - 1;
+constexpr int lookupSize = 1 << (2 * lookupBits + 2);
+constexpr int swapMask = 1;
+constexpr int invertMask = 2;
+
+// the (i, j) quadrant of each curve position, and the orientation change, per orientation
+constexpr int positionToIJ[4][4] = {{0, 1, 3, 2}, {0, 2, 3, 1}, {3, 2, 0, 1}, {3, 1, 0, 2}};
+constexpr int positionToOrientation[4] = {swapMask, 0, 0, invertMask | swapMask};
+
+// the axes and signs of (u, v) on each face: u = sign * p[axis] / p[face % 3]
+constexpr int uAxis[faceCount] = {1, 0, 0, 2, 2, 1};
+constexpr double uSign[faceCount] = {1.0, -1.0, -1.0, 1.0, 1.0, -1.0};
+constexpr int vAxis[faceCount] = {2, 2, 1, 1, 0, 0};
+constexpr double vSign[faceCount] = {1.0, 1.0, -1.0, 1.0, -1.0, -1.0};
+
+// number of points projected together by the batch path
+constexpr std::size_t batchBlockSize = 256;
+
+// maps (i, j, orientation) to (position, orientation) for lookupBits levels and back
+struct HilbertTables
+{
+  HilbertTables()
+  {
+    for (int orientation = 0; orientation <= (swapMask | invertMask); ++orientation)
+      initialize(0, 0, 0, orientation, 0, orientation);
+  }
+
+  void initialize(int level, int i, int j, int originalOrientation, int position, int orientation)
+  {
+    if (level == lookupBits)
+    {
+      const int ij = (i << lookupBits) + j;
+      positions[(ij << 2) + originalOrientation] = static_cast<std::uint16_t>((position << 2) + orientation);
+      ijs[(position << 2) + originalOrientation] = static_cast<std::uint16_t>((ij << 2) + orientation);
+      return;
+    }
+
+    const int* quadrants = positionToIJ[orientation];
+    for (int quadrant = 0; quadrant < 4; ++quadrant)
+    {
+      initialize(level + 1, (i << 1) + (quadrants[quadrant] >> 1), (j << 1) + (quadrants[quadrant] & 1),
+                 originalOrientation, (position << 2) + quadrant, orientation ^ positionToOrientation[quadrant]);
+    }
+  }
+
+  std::uint16_t positions[lookupSize];
+  std::uint16_t ijs[lookupSize];
+};
+
+const HilbertTables& hilbertTables()
+{
+  static const HilbertTables tables;
+  return tables;
+}
+
+struct FaceIJ
+{
+  int face;
+  int i;
+  int j;
+};
+
+// the quadratic projection S2 uses to even out cell areas
+double uvToSt(double u)
+{
+  const double root = 0.5 * std::sqrt(1.0 + 3.0 * std::fabs(u));
+  return u >= 0.0 ? root : 1.0 - root;
+}
+
+double stToUv(double s)
+{
+  return s >= 0.5 ? (4.0 * s * s - 1.0) / 3.0 : (1.0 - 4.0 * (1.0 - s) * (1.0 - s)) / 3.0;
+}
+
+int stToIJ(double s)
+{
+  double ij = std::floor(s * limitIJ);
+  ij = ij < 0.0 ? 0.0 : (ij > limitIJ - 1.0 ? limitIJ - 1.0 : ij);
+  return static_cast<int>(ij);
+}
+
+FaceIJ faceIJ(double latitude, double longitude)
+{
+  const double phi = latitude * degreesToRadians;
+  const double lambda = longitude * degreesToRadians;
+  const double cosPhi = std::cos(phi);
+  const double p[3] = {cosPhi * std::cos(lambda), cosPhi * std::sin(lambda), std::sin(phi)};
+
+  const double ax = std::fabs(p[0]);
+  const double ay = std::fabs(p[1]);
+  const double az = std::fabs(p[2]);
+  int axis = ax > ay ? (ax > az ? 0 : 2) : (ay > az ? 1 : 2);
+  const int face = axis + (p[axis] < 0.0 ? 3 : 0);
+
+  const double u = uSign[face] * p[uAxis[face]] / p[axis];
+  const double v = vSign[face] * p[vAxis[face]] / p[axis];
+  return FaceIJ{face, stToIJ(uvToSt(u)), stToIJ(uvToSt(v))};
+}
+
+std::uint64_t leafId(const FaceIJ& cell, const HilbertTables& tables)
+{
+  std::uint64_t position = static_cast<std::uint64_t>(cell.face) << (positionBits - 1);
+  int bits = cell.face & swapMask;
+  for (int k = 7; k >= 0; --k)
+  {
+    bits += ((cell.i >> (k * lookupBits)) & lookupMask) << (lookupBits + 2);
+    bits += ((cell.j >> (k * lookupBits)) & lookupMask) << 2;
+    bits = tables.positions[bits];
+    position |= static_cast<std::uint64_t>(bits >> 2) << (k * 2 * lookupBits);
+    bits &= swapMask | invertMask;
+  }
+
+  return position * 2 + 1;
+}
+
+std::uint64_t lowestBitForLevel(int level)
+{
+  return std::uint64_t(1) << (2 * (S2CellCodec::maximumLevel - level));
+}
+
+std::uint64_t parentId(std::uint64_t id, int level)
+{
+  const std::uint64_t lowestBit = lowestBitForLevel(level);
+  return (id & (~lowestBit + 1)) | lowestBit;
+}
+
+FaceIJ toFaceIJ(std::uint64_t id)
+{
+  const HilbertTables& tables = hilbertTables();
+  FaceIJ cell{static_cast<int>(id >> positionBits), 0, 0};
+  int bits = cell.face & swapMask;
+  for (int k = 7; k >= 0; --k)
+  {
+    const int levels = k == 7 ? S2CellCodec::maximumLevel - 7 * lookupBits : lookupBits;
+    bits += static_cast<int>((id >> (k * 2 * lookupBits + 1)) & ((std::uint64_t(1) << (2 * levels)) - 1)) << 2;
+    bits = tables.ijs[bits];
+    cell.i += (bits >> (lookupBits + 2)) << (k * lookupBits);
+    cell.j += ((bits >> 2) & lookupMask) << (k * lookupBits);
+    bits &= swapMask | invertMask;
+  }
+
+  return cell;
+}
+
+void toGeographic(int face, double s, double t, double& latitude, double& longitude)
+{
+  const double u = stToUv(s);
+  const double v = stToUv(t);
+  double p[3];
+  switch (face)
+  {
+  case 0:
+    p[0] = 1.0; p[1] = u; p[2] = v;
+    break;
+  case 1:
+    p[0] = -u; p[1] = 1.0; p[2] = v;
+    break;
+  case 2:
+    p[0] = -u; p[1] = -v; p[2] = 1.0;
+    break;
+  case 3:
+    p[0] = -1.0; p[1] = -v; p[2] = -u;
+    break;
+  case 4:
+    p[0] = v; p[1] = -1.0; p[2] = -u;
+    break;
+  default:
+    p[0] = v; p[1] = u; p[2] = -1.0;
+    break;
+  }
+
+  latitude = std::atan2(p[2], std::sqrt(p[0] * p[0] + p[1] * p[1])) * radiansToDegrees;
+  longitude = std::atan2(p[1], p[0]) * radiansToDegrees;
+}
+
+bool isValidCoordinate(double latitude, double longitude)
+{
+  return latitude >= -90.0 && latitude <= 90.0 && std::isfinite(longitude);
+}
+
+} // namespace
+
+/*!
+  \class Esri::ArcGISRuntime::Toolkit::S2CellCodec
+  \ingroup ToolCoordinateConversion
+  \inmodule ArcGISQtToolkit
+  \brief A native encoder and decoder for hierarchical 64-bit cell ids.
+  \since Esri::ArcGISRuntime 100.4
+
+  Cell ids follow the layout of the S2 geometry library, so they can be
+  joined against ids produced elsewhere. The sphere is projected onto the
+  six faces of a cube with S2's quadratic projection, and each face is
+  divided into a quadtree of up to \l maximumLevel levels. An id holds the
+  face in its top 3 bits, the position of the cell along a Hilbert curve
+  over the face, and a trailing 1 bit whose position gives the level. The
+  ids of the cells within a cell therefore form a contiguous range.
+
+  Ids are written either as decimal integers or as S2 tokens: the id in
+  lowercase hexadecimal without trailing zeros.
+
+  The Hilbert curve is walked with lookup tables, four levels per step,
+  and the batch \l cellIds overload projects contiguous arrays of points
+  without branching before looking their positions up.
+ */
+
+/*!
+  \brief Returns the id of the cell at \a level holding \a latitude and
+  \a longitude (WGS 84 degrees), or \c 0 if the coordinate or \a level is
+  not valid.
+ */
+std::uint64_t S2CellCodec::cellId(double latitude, double longitude, int level)
+{
+  if (level < 0 || level > maximumLevel || !isValidCoordinate(latitude, longitude))
+    return 0;
+
+  return parentId(leafId(faceIJ(latitude, longitude), hilbertTables()), level);
+}
+
+/*!
+  \brief Writes the ids of the cells at \a level holding \a count points
+  from \a latitudes and \a longitudes into \a ids.
+
+  Invalid points get the id \c 0. Every id is \c 0 if \a level is not
+  valid.
+ */
+void S2CellCodec::cellIds(const double* latitudes, const double* longitudes, std::size_t count, int level,
+                          std::uint64_t* ids)
+{
+  const bool validLevel = level >= 0 && level <= maximumLevel;
+  const HilbertTables& tables = hilbertTables();
+  FaceIJ cells[batchBlockSize];
+  bool valid[batchBlockSize];
+
+  for (std::size_t blockStart = 0; blockStart < count; blockStart += batchBlockSize)
+  {
+    const std::size_t blockCount = (count - blockStart) < batchBlockSize ? (count - blockStart) : batchBlockSize;
+    const double* blockLatitudes = latitudes + blockStart;
+    const double* blockLongitudes = longitudes + blockStart;
+
+    for (std::size_t i = 0; i < blockCount; ++i)
+    {
+      valid[i] = validLevel && isValidCoordinate(blockLatitudes[i], blockLongitudes[i]);
+      cells[i] = faceIJ(valid[i] ? blockLatitudes[i] : 0.0, valid[i] ? blockLongitudes[i] : 0.0);
+    }
+
+    std::uint64_t* blockIds = ids + blockStart;
+    const int parentLevel = validLevel ? level : maximumLevel;
+    for (std::size_t i = 0; i < blockCount; ++i)
+      blockIds[i] = valid[i] ? parentId(leafId(cells[i], tables), parentLevel) : 0;
+  }
+}
+
+/*!
+  \brief Returns whether \a id is a valid cell id: a face below 6 and a
+  trailing 1 bit at a level position.
+ */
+bool S2CellCodec::isValid(std::uint64_t id)
+{
+  const std::uint64_t lowestBit = id & (~id + 1);
+  return (id >> positionBits) < static_cast<std::uint64_t>(faceCount) && (lowestBit & 0x1555555555555555ULL) != 0;
+}
+
+/*!
+  \brief Returns the level of the valid cell \a id.
+ */
+int S2CellCodec::level(std::uint64_t id)
+{
+  int level = maximumLevel;
+  for (; level > 0 && (id & 1) == 0; --level)
+    id >>= 2;
+
+  return level;
+}
+
+/*!
+  \brief Sets \a latitude and \a longitude to the WGS 84 degrees of the
+  centre of the valid cell \a id.
+ */
+void S2CellCodec::center(std::uint64_t id, double& latitude, double& longitude)
+{
+  const FaceIJ cell = toFaceIJ(id);
+  const int size = 1 << (maximumLevel - level(id));
+  const double s = ((cell.i & -size) + 0.5 * size) / limitIJ;
+  const double t = ((cell.j & -size) + 0.5 * size) / limitIJ;
+  toGeographic(cell.face, s, t, latitude, longitude);
+}
+
+/*!
+  \brief Writes the WGS 84 degrees of the four corners of the valid cell
+  \a id, counterclockwise, into \a latitudes and \a longitudes.
+
+  The edges of a cell are great circle arcs, so a polygon drawn straight
+  between the corners in degrees is an approximation for large cells.
+ */
+void S2CellCodec::vertices(std::uint64_t id, double* latitudes, double* longitudes)
+{
+  const FaceIJ cell = toFaceIJ(id);
+  const int size = 1 << (maximumLevel - level(id));
+  const double s0 = static_cast<double>(cell.i & -size) / limitIJ;
+  const double t0 = static_cast<double>(cell.j & -size) / limitIJ;
+  const double s1 = s0 + static_cast<double>(size) / limitIJ;
+  const double t1 = t0 + static_cast<double>(size) / limitIJ;
+  toGeographic(cell.face, s0, t0, latitudes[0], longitudes[0]);
+  toGeographic(cell.face, s1, t0, latitudes[1], longitudes[1]);
+  toGeographic(cell.face, s1, t1, latitudes[2], longitudes[2]);
+  toGeographic(cell.face, s0, t1, latitudes[3], longitudes[3]);
+}
+
+/*!
+  \brief Writes \a id as an S2 token into \a buffer and returns the number
+  of characters written. The invalid id \c 0 is written as \c X.
+ */
+int S2CellCodec::formatToken(std::uint64_t id, char* buffer)
+{
+  if (id == 0)
+  {
+    buffer[0] = 'X';
+    return 1;
+  }
+
+  static const char hexDigits[] = "0123456789abcdef";
+  int length = 16;
+  while ((id & 0xf) == 0)
+  {
+    id >>= 4;
+    --length;
+  }
+
+  for (int i = length - 1; i >= 0; --i)
+  {
+    buffer[i] = hexDigits[id & 0xf];
+    id >>= 4;
+  }
+
+  return length;
+}
+
+/*!
+  \brief Writes \a id as a decimal integer into \a buffer and returns the
+  number of characters written.
+ */
+int S2CellCodec::formatInteger(std::uint64_t id, char* buffer)
+{
+  char digits[bufferSize];
+  int length = 0;
+  do
+  {
+    digits[length++] = static_cast<char>('0' + id % 10);
+    id /= 10;
+  }
+  while (id != 0);
+
+  for (int i = 0; i < length; ++i)
+    buffer[i] = digits[length - 1 - i];
+
+  return length;
+}
+
+/*!
+  \brief Parses the S2 token in the first \a length characters of \a text
+  into \a id.
+
+  Spaces and tabs are ignored and hexadecimal digits may be in either case.
+  Returns \c false unless the token is a valid cell id.
+ */
+bool S2CellCodec::parseToken(const char* text, int length, std::uint64_t& id)
+{
+  std::uint64_t value = 0;
+  int digitCount = 0;
+  for (int i = 0; i < length; ++i)
+  {
+    const char c = text[i];
+    if (c == ' ' || c == '\t')
+      continue;
+
+    int digit = -1;
+    if (c >= '0' && c <= '9')
+      digit = c - '0';
+    else if (c >= 'a' && c <= 'f')
+      digit = c - 'a' + 10;
+    else if (c >= 'A' && c <= 'F')
+      digit = c - 'A' + 10;
+
+    if (digit < 0 || digitCount == 16)
+      return false;
+
+    value = (value << 4) | static_cast<std::uint64_t>(digit);
+    ++digitCount;
+  }
+
+  if (digitCount == 0)
+    return false;
+
+  id = value << (4 * (16 - digitCount));
+  return isValid(id);
+}
+
+/*!
+  \brief Parses the decimal integer in the first \a length characters of
+  \a text into \a id.
+
+  Spaces and tabs are ignored. Returns \c false unless the integer is a
+  valid cell id.
+ */
+bool S2CellCodec::parseInteger(const char* text, int length, std::uint64_t& id)
+{
+  constexpr std::uint64_t largest = ~std::uint64_t(0);
+  std::uint64_t value = 0;
+  int digitCount = 0;
+  for (int i = 0; i < length; ++i)
+  {
+    const char c = text[i];
+    if (c == ' ' || c == '\t')
+      continue;
+
+    if (c < '0' || c > '9')
+      return false;
+
+    const std::uint64_t digit = static_cast<std::uint64_t>(c - '0');
+    if (value > (largest - digit) / 10)
+      return false;
+
+    value = value * 10 + digit;
+    ++digitCount;
+  }
+
+  if (digitCount == 0)
+    return false;
+
+  id = value;
+  return isValid(id);
+}
+
+} // Toolkit
+} // ArcGISRuntime
+} // Esri
@@ -0,0 +1,339 @@
+/*******************************************************************************
+ *  Copyright 2012-2018 Esri
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ******************************************************************************/
+
+#include "TrackTableModel.h"
+
+// toolkit headers
+#include "CoordinateConversionEngine.h"
+
+// STL headers
+#include <utility>
+
+namespace Esri
+{
+namespace ArcGISRuntime
+{
+namespace Toolkit
+{
+
+/*!
+  \class Esri::ArcGISRuntime::Toolkit::TrackTableModel
+  \ingroup ToolCoordinateConversion
+  \inmodule ArcGISQtToolkit
+  \brief A table of captured points with one column per output format.
+  \since Esri::ArcGISRuntime 100.4
+
+  Each row is a captured point and each column holds its notation in one of
+  the formats of the CoordinateConversionController. The points are kept in
+  one contiguous array and each column in another, so appending a row only
+  stores the new point and its notations.
+
+  When the settings of a format change, only that column is marked out of
+  date. Its cells are converted again as views read them, so a view showing
+  a few rows of a long track only converts those rows.
+
+  The following roles are available:
+  \table
+    \header
+        \li Role
+        \li Type
+        \li Description
+    \row
+        \li notation
+        \li QString
+        \li The notation of the point in the format of the column. This is
+            also the display role.
+    \row
+        \li x
+        \li double
+        \li The x coordinate of the captured point.
+    \row
+        \li y
+        \li double
+        \li The y coordinate of the captured point.
+  \endtable
+ */
+
+/*!
+  \brief Constructor taking the \a engine used to convert out of date cells
+  and an optional \a parent.
+
+  The \a engine must outlive the model.
+ */
+TrackTableModel::TrackTableModel(const CoordinateConversionEngine& engine, QObject* parent) :
+  QAbstractTableModel(parent),
+  m_engine(engine)
+{
+  setupRoles();
+}
+
+/*!
+  \brief The destructor.
+ */
+TrackTableModel::~TrackTableModel()
+{
+}
+
+/*!
+  \property TrackTableModel::count
+  \brief The number of rows in the table.
+ */
+int TrackTableModel::count() const
+{
+  return m_points.size();
+}
+
+/*!
+  \property TrackTableModel::formatNames
+  \brief The names of the formats shown in the columns, in column order.
+ */
+QStringList TrackTableModel::formatNames() const
+{
+  QStringList names;
+  names.reserve(m_columns.size());
+  for (const Column& column : m_columns)
+    names.append(column.option.name());
+
+  return names;
+}
+
+/*!
+  \brief Removes every row from the table.
+ */
+void TrackTableModel::clear()
+{
+  if (m_points.isEmpty())
+    return;
+
+  beginResetModel();
+  m_points.clear();
+  for (Column& column : m_columns)
+  {
+    column.notations.clear();
+    column.stale.clear();
+  }
+  endResetModel();
+
+  emit countChanged();
+}
+
+/*!
+  \brief Sets the formats of the columns to \a options.
+
+  If the formats are the same as before, in the same order, only the columns
+  whose settings changed are marked out of date. Otherwise the columns are
+  rebuilt and every cell is converted again as it is read.
+ */
+void TrackTableModel::setOptions(const QList<CoordinateFormatOption>& options)
+{
+  bool sameColumns = options.size() == m_columns.size();
+  for (int i = 0; sameColumns && i < options.size(); ++i)
+    sameColumns = options.at(i).formatId() == m_columns.at(i).option.formatId();
+
+  if (!sameColumns)
+  {
+    beginResetModel();
+    m_columns.clear();
+    m_columns.reserve(options.size());
+    for (const CoordinateFormatOption& option : options)
+    {
+      Column column;
+      column.option = option;
+      column.notations.resize(m_points.size());
+      column.stale.fill(true, m_points.size());
+      m_columns.append(std::move(column));
+    }
+    endResetModel();
+
+    emit formatNamesChanged();
+    return;
+  }
+
+  for (int i = 0; i < options.size(); ++i)
+  {
+    Column& column = m_columns[i];
+    if (column.option == options.at(i))
+      continue;
+
+    column.option = options.at(i);
+    column.stale.fill(true);
+
+    if (!m_points.isEmpty())
+      emit dataChanged(index(0, i), index(m_points.size() - 1, i));
+
+    emit headerDataChanged(Qt::Horizontal, i, i);
+  }
+}
+
+/*!
+  \brief Appends \a point as the last row, with its \a notations in the
+  format of each column.
+
+  If \a notations does not hold one notation per column, the new cells are
+  converted when they are read.
+ */
+void TrackTableModel::append(const Point& point, const QStringList& notations)
+{
+  const int row = m_points.size();
+  const bool converted = notations.size() == m_columns.size();
+
+  beginInsertRows(QModelIndex(), row, row);
+  m_points.append(point);
+  for (int i = 0; i < m_columns.size(); ++i)
+  {
+    Column& column = m_columns[i];
+    column.notations.append(converted ? notations.at(i) : QString());
+    column.stale.append(!converted);
+  }
+  endInsertRows();
+
+  emit countChanged();
+}
+
+/*!
+  \brief Returns the point at \a row.
+ */
+Point TrackTableModel::point(int row) const
+{
+  if (row < 0 || row >= m_points.size())
+    return Point();
+
+  return m_points.at(row);
+}
+
+/*!
+  \internal
+ */
+int TrackTableModel::rowCount(const QModelIndex& parent) const
+{
+  if (parent.isValid())
+    return 0;
+
+  return m_points.size();
+}
+
+/*!
+  \internal
+ */
+int TrackTableModel::columnCount(const QModelIndex& parent) const
+{
+  if (parent.isValid())
+    return 0;
+
+  return m_columns.size();
+}
+
+/*!
+  \internal
+ */
+QVariant TrackTableModel::data(const QModelIndex& index, int role) const
+{
+  const int row = index.row();
+  const int column = index.column();
+  if (row < 0 || row >= m_points.size() || column < 0 || column >= m_columns.size())
+    return QVariant();
+
+  switch (role)
+  {
+  case Qt::DisplayRole:
+  case TrackTableNotationRole:
+    return QVariant(notation(row, column));
+  case TrackTableXRole:
+    return QVariant(m_points.at(row).x());
+  case TrackTableYRole:
+    return QVariant(m_points.at(row).y());
+  default:
+    break;
+  }
+
+  return QVariant();
+}
+
+/*!
+  \internal
+ */
+QVariant TrackTableModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+  if (role != Qt::DisplayRole)
+    return QVariant();
+
+  if (orientation == Qt::Vertical)
+    return QVariant(section + 1);
+
+  if (section < 0 || section >= m_columns.size())
+    return QVariant();
+
+  return QVariant(m_columns.at(section).option.name());
+}
+
+/*!
+  \internal
+ */
+QHash<int, QByteArray> TrackTableModel::roleNames() const
+{
+  return m_roles;
+}
+
+/*!
+  \internal
+
+  Returns the notation at \a row in \a column, converting it first if it is
+  out of date.
+ */
+const QString& TrackTableModel::notation(int row, int column) const
+{
+  Column& cells = m_columns[column];
+  if (cells.stale.at(row))
+  {
+    cells.notations[row] = m_engine.convert(cells.option, m_points.at(row));
+    cells.stale[row] = false;
+  }
+
+  return cells.notations.at(row);
+}
+
+/*!
+  \internal
+ */
+void TrackTableModel::setupRoles()
+{
+  m_roles[TrackTableNotationRole] = "notation";
+  m_roles[TrackTableXRole] = "x";
+  m_roles[TrackTableYRole] = "y";
+}
+
+/*!
+  \fn void TrackTableModel::countChanged();
+  \brief Signal emitted when the number of rows changes.
+ */
+
+/*!
+  \fn void TrackTableModel::formatNamesChanged();
+  \brief Signal emitted when the columns are rebuilt for a new set of formats.
+ */
+
+/*!
+  \enum TrackTableModel::TrackTableRoles
+  \brief Enumeration of roles used to access cells in the table model.
+
+  \value TrackTableNotationRole The notation in the format of the column.
+  \value TrackTableXRole The x coordinate of the captured point.
+  \value TrackTableYRole The y coordinate of the captured point.
+ */
+
+} // Toolkit
+} // ArcGISRuntime
+} // Esri
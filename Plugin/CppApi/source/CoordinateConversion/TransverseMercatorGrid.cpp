@@ -0,0 +1,844 @@
+/*******************************************************************************
+ *  Copyright 2012-2018 Esri
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ******************************************************************************/
+
+#include "TransverseMercatorGrid.h"
+
+// STL headers
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+namespace Esri
+{
+namespace ArcGISRuntime
+{
+namespace Toolkit
+{
+
+namespace
+{
+
+constexpr double pi = 3.14159265358979323846;
+constexpr double degreesToRadians = pi / 180.0;
+constexpr double radiansToDegrees = 180.0 / pi;
+
+// WGS 84 ellipsoid and UTM projection parameters
+constexpr double semiMajorAxis = 6378137.0;
+constexpr double flattening = 1.0 / 298.257223563;
+constexpr double eccentricitySquared = flattening * (2.0 - flattening);
+constexpr double scaleFactor = 0.9996;
+constexpr double falseEasting = 500000.0;
+constexpr double falseNorthingSouth = 10000000.0;
+
+// Krüger series to sixth order in the third flattening
+constexpr double n1 = flattening / (2.0 - flattening);
+constexpr double n2 = n1 * n1;
+constexpr double n3 = n2 * n1;
+constexpr double n4 = n3 * n1;
+constexpr double n5 = n4 * n1;
+constexpr double n6 = n5 * n1;
+
+constexpr double scaledRectifyingRadius =
+    scaleFactor * semiMajorAxis / (1.0 + n1) * (1.0 + n2 / 4.0 + n4 / 64.0 + n6 / 256.0);
+
+constexpr int seriesOrder = 6;
+
+constexpr double alpha[seriesOrder] =
+{
+  n1 / 2.0 - 2.0 * n2 / 3.0 + 5.0 * n3 / 16.0 + 41.0 * n4 / 180.0 - 127.0 * n5 / 288.0 + 7891.0 * n6 / 37800.0,
+  13.0 * n2 / 48.0 - 3.0 * n3 / 5.0 + 557.0 * n4 / 1440.0 + 281.0 * n5 / 630.0 - 1983433.0 * n6 / 1935360.0,
+  61.0 * n3 / 240.0 - 103.0 * n4 / 140.0 + 15061.0 * n5 / 26880.0 + 167603.0 * n6 / 181440.0,
+  49561.0 * n4 / 161280.0 - 179.0 * n5 / 168.0 + 6601661.0 * n6 / 7257600.0,
+  34729.0 * n5 / 80640.0 - 3418889.0 * n6 / 1995840.0,
+  212378941.0 * n6 / 319334400.0
+};
+
+constexpr double beta[seriesOrder] =
+{
+  n1 / 2.0 - 2.0 * n2 / 3.0 + 37.0 * n3 / 96.0 - n4 / 360.0 - 81.0 * n5 / 512.0 + 96199.0 * n6 / 604800.0,
+  n2 / 48.0 + n3 / 15.0 - 437.0 * n4 / 1440.0 + 46.0 * n5 / 105.0 - 1118711.0 * n6 / 3870720.0,
+  17.0 * n3 / 480.0 - 37.0 * n4 / 840.0 - 209.0 * n5 / 4480.0 + 5569.0 * n6 / 90720.0,
+  4397.0 * n4 / 161280.0 - 11.0 * n5 / 504.0 - 830251.0 * n6 / 7257600.0,
+  4583.0 * n5 / 161280.0 - 108847.0 * n6 / 3991680.0,
+  20648693.0 * n6 / 638668800.0
+};
+
+// UTM covers 80S to 84N; the polar caps use UPS, which is left to the SDK
+constexpr double minimumLatitude = -80.0;
+constexpr double maximumLatitude = 84.0;
+
+constexpr double bandHeight = 8.0;
+constexpr int bandCount = TransverseMercatorGrid::bandCount;
+constexpr char latitudeBands[bandCount + 1] = "CDEFGHJKLMNPQRSTUVWX";
+
+// 100 km column letters repeat every three zones, indexed by zone % 3
+constexpr char columnLetters[3][9] = { "STUVWXYZ", "ABCDEFGH", "JKLMNPQR" };
+
+constexpr int rowLetterCount = 20;
+constexpr char rowLetters[rowLetterCount + 1] = "ABCDEFGHJKLMNPQRSTUV";
+
+// even zones start their rows five letters later; the AL scheme shifts all rows by ten
+constexpr int evenZoneRowOffset = 5;
+constexpr int oldSchemeRowOffset = 10;
+
+// rows repeat every 20 letters, i.e. every 2000 km of northing
+constexpr double rowCycle = 2000000.0;
+constexpr double squareSize = 100000.0;
+
+struct ZoneException
+{
+  double minimumLatitude;
+  double maximumLatitude;
+  double minimumLongitude;
+  double maximumLongitude;
+  int zone;
+};
+
+// the south-west Norway and Svalbard exceptions to the regular 6 degree zones
+constexpr ZoneException zoneExceptions[] =
+{
+  { 56.0, 64.0,  3.0, 12.0, 32 },
+  { 72.0, 84.0,  0.0,  9.0, 31 },
+  { 72.0, 84.0,  9.0, 21.0, 33 },
+  { 72.0, 84.0, 21.0, 33.0, 35 },
+  { 72.0, 84.0, 33.0, 42.0, 37 }
+};
+
+// number of points projected together by the batch path
+constexpr std::size_t batchBlockSize = 256;
+
+const double eccentricity = std::sqrt(eccentricitySquared);
+
+int bandIndex(double latitude)
+{
+  const int index = static_cast<int>(std::floor((latitude - minimumLatitude) / bandHeight));
+  return index < 0 ? 0 : (index >= bandCount ? bandCount - 1 : index);
+}
+
+int findLetter(const char* letters, char letter)
+{
+  for (int i = 0; letters[i] != '\0'; ++i)
+  {
+    if (letters[i] == letter)
+      return i;
+  }
+
+  return -1;
+}
+
+double centralMeridian(int zone)
+{
+  return zone * 6.0 - 183.0;
+}
+
+// fills in everything except the easting and northing and returns the
+// longitude relative to the zone's central meridian, in degrees
+bool assignZone(double latitude, double longitude, bool zone60At180, TransverseMercatorGrid::GridPosition& position,
+                double& relativeLongitude)
+{
+  if (!std::isfinite(latitude) || !std::isfinite(longitude) ||
+      latitude < minimumLatitude || latitude > maximumLatitude)
+  {
+    return false;
+  }
+
+  if (longitude < -180.0 || longitude > 180.0)
+    longitude = std::remainder(longitude, 360.0);
+
+  int zone = 0;
+  if (longitude == 180.0)
+    zone = zone60At180 ? 60 : 1;
+  else
+    zone = static_cast<int>(std::floor((longitude + 180.0) / 6.0)) + 1;
+
+  zone = zone < 1 ? 1 : (zone > 60 ? 60 : zone);
+
+  for (const ZoneException& exception : zoneExceptions)
+  {
+    if (latitude >= exception.minimumLatitude && latitude < exception.maximumLatitude &&
+        longitude >= exception.minimumLongitude && longitude < exception.maximumLongitude)
+    {
+      zone = exception.zone;
+      break;
+    }
+  }
+
+  relativeLongitude = longitude - centralMeridian(zone);
+  if (relativeLongitude > 180.0)
+    relativeLongitude -= 360.0;
+  else if (relativeLongitude < -180.0)
+    relativeLongitude += 360.0;
+
+  position.zone = zone;
+  position.band = latitudeBands[bandIndex(latitude)];
+  position.north = latitude >= 0.0;
+  return true;
+}
+
+// Krüger forward projection of count points, at most batchBlockSize; angles
+// in radians, results in metres without false origins. The transcendental
+// functions are evaluated in a scalar first pass; the series is expanded with
+// double angle recurrences so that the second pass is call-free arithmetic
+// over the arrays, which GCC vectorizes at -O3.
+void projectBlock(const double* latitudes, const double* relativeLongitudes, std::size_t count, double* x, double* y)
+{
+  double xiPrime[batchBlockSize];
+  double etaPrime[batchBlockSize];
+  double sinXi[batchBlockSize];
+  double cosXi[batchBlockSize];
+  double sinhEta[batchBlockSize];
+  double coshEta[batchBlockSize];
+
+  // every library call, sqrt included, stays in this pass: with errno
+  // handling they all keep a loop from vectorizing
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    const double tau = std::tan(latitudes[i]);
+    const double sigma = std::sinh(eccentricity * std::atanh(eccentricity * tau / std::sqrt(1.0 + tau * tau)));
+    const double tauPrime = tau * std::sqrt(1.0 + sigma * sigma) - sigma * std::sqrt(1.0 + tau * tau);
+    const double cosLongitude = std::cos(relativeLongitudes[i]);
+    const double radius = std::sqrt(tauPrime * tauPrime + cosLongitude * cosLongitude);
+    xiPrime[i] = std::atan2(tauPrime, cosLongitude);
+    sinXi[i] = tauPrime / radius;
+    cosXi[i] = cosLongitude / radius;
+    sinhEta[i] = std::sin(relativeLongitudes[i]) / radius;
+    coshEta[i] = std::sqrt(1.0 + sinhEta[i] * sinhEta[i]);
+    etaPrime[i] = std::asinh(sinhEta[i]);
+  }
+
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    // the double angles, then each further multiple by angle addition
+    const double sin2Xi = 2.0 * sinXi[i] * cosXi[i];
+    const double cos2Xi = cosXi[i] * cosXi[i] - sinXi[i] * sinXi[i];
+    const double sinh2Eta = 2.0 * sinhEta[i] * coshEta[i];
+    const double cosh2Eta = coshEta[i] * coshEta[i] + sinhEta[i] * sinhEta[i];
+
+    double sinMultiple = sin2Xi;
+    double cosMultiple = cos2Xi;
+    double sinhMultiple = sinh2Eta;
+    double coshMultiple = cosh2Eta;
+    double xi = xiPrime[i];
+    double eta = etaPrime[i];
+    for (int j = 0; j < seriesOrder; ++j)
+    {
+      xi += alpha[j] * sinMultiple * coshMultiple;
+      eta += alpha[j] * cosMultiple * sinhMultiple;
+
+      const double nextSin = sinMultiple * cos2Xi + cosMultiple * sin2Xi;
+      const double nextCos = cosMultiple * cos2Xi - sinMultiple * sin2Xi;
+      const double nextSinh = sinhMultiple * cosh2Eta + coshMultiple * sinh2Eta;
+      const double nextCosh = coshMultiple * cosh2Eta + sinhMultiple * sinh2Eta;
+      sinMultiple = nextSin;
+      cosMultiple = nextCos;
+      sinhMultiple = nextSinh;
+      coshMultiple = nextCosh;
+    }
+
+    x[i] = scaledRectifyingRadius * eta;
+    y[i] = scaledRectifyingRadius * xi;
+  }
+}
+
+void project(double latitude, double relativeLongitude, double& x, double& y)
+{
+  projectBlock(&latitude, &relativeLongitude, 1, &x, &y);
+}
+
+char* writeDigits(char* out, std::uint64_t value, int width)
+{
+  for (int i = width - 1; i >= 0; --i)
+  {
+    out[i] = static_cast<char>('0' + value % 10);
+    value /= 10;
+  }
+
+  return out + width;
+}
+
+char toUpper(char c)
+{
+  return (c >= 'a' && c <= 'z') ? static_cast<char>(c - 'a' + 'A') : c;
+}
+
+bool isDigit(char c)
+{
+  return c >= '0' && c <= '9';
+}
+
+bool isSpace(char c)
+{
+  return c == ' ' || c == '\t';
+}
+
+// a minimal cursor over the notation being parsed
+struct Reader
+{
+  const char* current;
+  const char* end;
+
+  void skipSpaces()
+  {
+    while (current != end && isSpace(*current))
+      ++current;
+  }
+
+  bool atEnd()
+  {
+    skipSpaces();
+    return current == end;
+  }
+
+  char letter()
+  {
+    skipSpaces();
+    return current != end ? toUpper(*current++) : '\0';
+  }
+
+  // reads a run of up to maximumDigits digits, returning the number of digits read
+  int digits(std::uint64_t& value, int maximumDigits)
+  {
+    skipSpaces();
+    int count = 0;
+    value = 0;
+    while (current != end && isDigit(*current) && count < maximumDigits)
+    {
+      value = value * 10 + static_cast<std::uint64_t>(*current++ - '0');
+      ++count;
+    }
+
+    return count;
+  }
+
+  bool zone(int& zone)
+  {
+    std::uint64_t value = 0;
+    const int count = digits(value, 2);
+    zone = static_cast<int>(value);
+    return count > 0 && zone >= 1 && zone <= 60;
+  }
+};
+
+int rowOffset(int zone, TransverseMercatorGrid::LetteringScheme scheme)
+{
+  return (zone % 2 == 0 ? evenZoneRowOffset : 0) +
+         (scheme == TransverseMercatorGrid::LetteringScheme::Old ? oldSchemeRowOffset : 0);
+}
+
+} // namespace
+
+/*!
+  \class Esri::ArcGISRuntime::Toolkit::TransverseMercatorGrid
+  \ingroup ToolCoordinateConversion
+  \inmodule ArcGISQtToolkit
+  \brief A native encoder and decoder for the UTM, MGRS and USNG grids.
+  \since Esri::ArcGISRuntime 100.4
+
+  Points are projected with the sixth order Krüger series on the WGS 84
+  ellipsoid. The zone, the Norway and Svalbard exceptions, the latitude bands
+  and the AA and AL 100 km square letters all come from compile-time tables.
+
+  Only the UTM latitude range (80S to 84N) is handled; polar UPS references
+  are left to \c CoordinateFormatter. USNG uses the MGRS notation with the
+  AA lettering scheme.
+
+  \l toGridPositions projects arrays of points in fixed-size blocks. The
+  zone lookup and the transcendental functions are scalar passes over the
+  block; the Krüger series, expanded with double angle recurrences, is a
+  call-free loop over the block's arrays which the compiler can vectorize
+  (GCC does at -O3; its -O2 cost model leaves the loop scalar).
+ */
+
+/*!
+  \brief Projects \a latitude and \a longitude (WGS 84 degrees) into its UTM
+  zone, storing the result in \a position.
+
+  A longitude of exactly 180 degrees is placed in zone 60 if \a zone60At180
+  is \c true and in zone 1 otherwise. Returns \c false outside the UTM
+  latitude limits.
+ */
+bool TransverseMercatorGrid::toGridPosition(double latitude, double longitude, bool zone60At180, GridPosition& position)
+{
+  double relativeLongitude = 0.0;
+  if (!assignZone(latitude, longitude, zone60At180, position, relativeLongitude))
+  {
+    position = GridPosition();
+    return false;
+  }
+
+  double x = 0.0;
+  double y = 0.0;
+  project(latitude * degreesToRadians, relativeLongitude * degreesToRadians, x, y);
+
+  position.easting = x + falseEasting;
+  position.northing = position.north ? y : y + falseNorthingSouth;
+  return true;
+}
+
+/*!
+  \brief Projects \a count points from \a latitudes and \a longitudes into
+  \a positions.
+
+  Points outside the UTM latitude limits get a zone of \c 0.
+ */
+void TransverseMercatorGrid::toGridPositions(const double* latitudes, const double* longitudes, std::size_t count,
+                                             bool zone60At180, GridPosition* positions)
+{
+  double phi[batchBlockSize];
+  double lambda[batchBlockSize];
+  double x[batchBlockSize];
+  double y[batchBlockSize];
+
+  for (std::size_t blockStart = 0; blockStart < count; blockStart += batchBlockSize)
+  {
+    const std::size_t blockCount = (count - blockStart) < batchBlockSize ? (count - blockStart) : batchBlockSize;
+
+    // zone and band lookup: table driven, may branch
+    for (std::size_t i = 0; i < blockCount; ++i)
+    {
+      GridPosition& position = positions[blockStart + i];
+      double relativeLongitude = 0.0;
+      if (!assignZone(latitudes[blockStart + i], longitudes[blockStart + i], zone60At180, position, relativeLongitude))
+      {
+        position = GridPosition();
+        phi[i] = 0.0;
+        lambda[i] = 0.0;
+        continue;
+      }
+
+      phi[i] = latitudes[blockStart + i] * degreesToRadians;
+      lambda[i] = relativeLongitude * degreesToRadians;
+    }
+
+    projectBlock(phi, lambda, blockCount, x, y);
+
+    for (std::size_t i = 0; i < blockCount; ++i)
+    {
+      GridPosition& position = positions[blockStart + i];
+      if (position.zone == 0)
+        continue;
+
+      position.easting = x[i] + falseEasting;
+      position.northing = position.north ? y[i] : y[i] + falseNorthingSouth;
+    }
+  }
+}
+
+/*!
+  \brief Projects \a latitude and \a longitude (WGS 84 degrees) into
+  \a zone, whichever zone the point actually lies in, storing the result in
+  \a position.
+
+  Grid lines are drawn by following a zone's eastings and northings a little
+  past its edges. Returns \c false outside the UTM latitude limits or for an
+  invalid zone.
+ */
+bool TransverseMercatorGrid::toZonePosition(double latitude, double longitude, int zone, GridPosition& position)
+{
+  double relativeLongitude = 0.0;
+  if (zone < 1 || zone > 60 || !assignZone(latitude, longitude, true, position, relativeLongitude))
+  {
+    position = GridPosition();
+    return false;
+  }
+
+  relativeLongitude = std::remainder(longitude - centralMeridian(zone), 360.0);
+
+  double x = 0.0;
+  double y = 0.0;
+  project(latitude * degreesToRadians, relativeLongitude * degreesToRadians, x, y);
+
+  position.zone = zone;
+  position.easting = x + falseEasting;
+  position.northing = position.north ? y : y + falseNorthingSouth;
+  return true;
+}
+
+/*!
+  \brief Converts \a position back to \a latitude and \a longitude in WGS 84 degrees.
+
+  Returns \c false if the position has no valid zone.
+ */
+bool TransverseMercatorGrid::fromGridPosition(const GridPosition& position, double& latitude, double& longitude)
+{
+  if (position.zone < 1 || position.zone > 60)
+    return false;
+
+  const double xi = (position.north ? position.northing : position.northing - falseNorthingSouth) / scaledRectifyingRadius;
+  const double eta = (position.easting - falseEasting) / scaledRectifyingRadius;
+
+  double xiPrime = xi;
+  double etaPrime = eta;
+  for (int j = 1; j <= seriesOrder; ++j)
+  {
+    xiPrime -= beta[j - 1] * std::sin(2.0 * j * xi) * std::cosh(2.0 * j * eta);
+    etaPrime -= beta[j - 1] * std::cos(2.0 * j * xi) * std::sinh(2.0 * j * eta);
+  }
+
+  const double sinhEtaPrime = std::sinh(etaPrime);
+  const double sinXiPrime = std::sin(xiPrime);
+  const double cosXiPrime = std::cos(xiPrime);
+  const double tauPrime = sinXiPrime / std::sqrt(sinhEtaPrime * sinhEtaPrime + cosXiPrime * cosXiPrime);
+
+  // Newton-Raphson on the conformal latitude
+  double tau = tauPrime;
+  for (int iteration = 0; iteration < 10; ++iteration)
+  {
+    const double sigma = std::sinh(eccentricity * std::atanh(eccentricity * tau / std::sqrt(1.0 + tau * tau)));
+    const double tauIPrime = tau * std::sqrt(1.0 + sigma * sigma) - sigma * std::sqrt(1.0 + tau * tau);
+    const double deltaTau = (tauPrime - tauIPrime) / std::sqrt(1.0 + tauIPrime * tauIPrime) *
+                            (1.0 + (1.0 - eccentricitySquared) * tau * tau) /
+                            ((1.0 - eccentricitySquared) * std::sqrt(1.0 + tau * tau));
+    tau += deltaTau;
+    if (std::fabs(deltaTau) < 1e-12)
+      break;
+  }
+
+  latitude = std::atan(tau) * radiansToDegrees;
+  longitude = centralMeridian(position.zone) + std::atan2(sinhEtaPrime, cosXiPrime) * radiansToDegrees;
+  if (longitude > 180.0)
+    longitude -= 360.0;
+  else if (longitude < -180.0)
+    longitude += 360.0;
+
+  return true;
+}
+
+/*!
+  \brief Returns the letter of latitude \a band, counted from \c 0 for C
+  in the south, or \c 0 if there is no such band.
+ */
+char TransverseMercatorGrid::bandLetter(int band)
+{
+  return band >= 0 && band < bandCount ? latitudeBands[band] : 0;
+}
+
+/*!
+  \brief Sets \a south and \a north to the latitudes bounding \a band,
+  counted from \c 0 for C in the south.
+
+  Returns \c false if there is no such band.
+ */
+bool TransverseMercatorGrid::bandLatitudes(int band, double& south, double& north)
+{
+  if (band < 0 || band >= bandCount)
+    return false;
+
+  south = minimumLatitude + band * bandHeight;
+  north = band == bandCount - 1 ? maximumLatitude : south + bandHeight;
+  return true;
+}
+
+/*!
+  \brief Sets \a west and \a east to the longitudes bounding \a zone at
+  \a latitude, taking the Norway and Svalbard exceptions into account.
+
+  Returns \c false outside the UTM latitude limits, or where the zone does
+  not exist at that latitude (zones 32, 34 and 36 in band X).
+ */
+bool TransverseMercatorGrid::zoneLongitudes(int zone, double latitude, double& west, double& east)
+{
+  if (zone < 1 || zone > 60 || !std::isfinite(latitude) || latitude < minimumLatitude || latitude > maximumLatitude)
+    return false;
+
+  west = centralMeridian(zone) - 3.0;
+  east = west + 6.0;
+
+  for (const ZoneException& exception : zoneExceptions)
+  {
+    if (exception.zone == zone && latitude >= exception.minimumLatitude && latitude < exception.maximumLatitude)
+    {
+      west = exception.minimumLongitude;
+      east = exception.maximumLongitude;
+    }
+  }
+
+  // the widened zones take their longitudes from their neighbours
+  for (const ZoneException& exception : zoneExceptions)
+  {
+    if (exception.zone == zone || latitude < exception.minimumLatitude || latitude >= exception.maximumLatitude ||
+        exception.minimumLongitude >= east || exception.maximumLongitude <= west)
+    {
+      continue;
+    }
+
+    if (exception.minimumLongitude <= west)
+      west = std::max(west, exception.maximumLongitude);
+    if (exception.maximumLongitude >= east)
+      east = std::min(east, exception.minimumLongitude);
+  }
+
+  return west < east;
+}
+
+/*!
+  \brief Finds the cell of the UTM notation of \a position: its easting and
+  northing rounded to the metre.
+
+  Returns \c false if \a position is not valid.
+ */
+bool TransverseMercatorGrid::utmCell(const GridPosition& position, std::int64_t& column, std::int64_t& row)
+{
+  if (position.zone < 1 || position.zone > 60)
+    return false;
+
+  column = static_cast<std::int64_t>(std::floor(position.easting + 0.5));
+  row = static_cast<std::int64_t>(std::floor(position.northing + 0.5));
+  return true;
+}
+
+/*!
+  \brief Finds the cell of the MGRS notation of \a position with
+  \a precision digits.
+
+  \a column and \a row count cells of the notation's resolution from the
+  origin of the zone, so they hold both the 100 km square and the digits
+  within it. Returns \c false if \a position or \a precision is not valid.
+ */
+bool TransverseMercatorGrid::mgrsCell(const GridPosition& position, int precision, std::int64_t& column, std::int64_t& row)
+{
+  if (position.zone < 1 || position.zone > 60 || precision < 0 || precision > maximumMgrsPrecision)
+    return false;
+
+  const std::int64_t squareColumn = static_cast<std::int64_t>(std::floor(position.easting / squareSize));
+  const std::int64_t squareRow = static_cast<std::int64_t>(std::floor(position.northing / squareSize));
+  if (squareColumn < 1 || squareColumn > 8 || squareRow < 0)
+    return false;
+
+  // scale the offset within the square to the requested digits; the small
+  // bias keeps values such as 89585.0 from truncating to 89584, and the
+  // clamp keeps it from carrying into the next square
+  const double digitsPerMetre = std::pow(10.0, precision - 5);
+  const std::int64_t cellsPerSquare = static_cast<std::int64_t>(std::llround(squareSize * digitsPerMetre));
+  const double eastingInSquare = position.easting - squareColumn * squareSize;
+  const double northingInSquare = position.northing - squareRow * squareSize;
+  const std::int64_t easting = static_cast<std::int64_t>(std::floor(eastingInSquare * digitsPerMetre + 1e-6));
+  const std::int64_t northing = static_cast<std::int64_t>(std::floor(northingInSquare * digitsPerMetre + 1e-6));
+
+  column = squareColumn * cellsPerSquare + std::min(easting, cellsPerSquare - 1);
+  row = squareRow * cellsPerSquare + std::min(northing, cellsPerSquare - 1);
+  return true;
+}
+
+/*!
+  \brief Writes the UTM notation of \a position into \a buffer.
+
+  The zone is followed by the latitude band or the hemisphere, according to
+  \a indicator, then the easting and northing rounded to the metre. Returns
+  the number of characters written, or \c 0 if \a position is not valid.
+ */
+int TransverseMercatorGrid::formatUtm(const GridPosition& position, ZoneIndicator indicator, bool addSpaces, char* buffer)
+{
+  std::int64_t easting = 0;
+  std::int64_t northing = 0;
+  if (!utmCell(position, easting, northing))
+    return 0;
+
+  char* out = writeDigits(buffer, static_cast<std::uint64_t>(position.zone), 2);
+  if (indicator == ZoneIndicator::LatitudeBand)
+    *out++ = position.band;
+  else
+    *out++ = position.north ? 'N' : 'S';
+
+  if (addSpaces)
+    *out++ = ' ';
+
+  out = writeDigits(out, static_cast<std::uint64_t>(easting), 6);
+
+  if (addSpaces)
+    *out++ = ' ';
+
+  out = writeDigits(out, static_cast<std::uint64_t>(northing), 7);
+  return static_cast<int>(out - buffer);
+}
+
+/*!
+  \brief Writes the MGRS notation of \a position into \a buffer.
+
+  The 100 km square letters follow \a scheme, and the easting and northing
+  within the square are truncated to \a precision digits (0 to 8). Returns the
+  number of characters written, or \c 0 if \a position or \a precision is not
+  valid.
+ */
+int TransverseMercatorGrid::formatMgrs(const GridPosition& position, LetteringScheme scheme, int precision, bool addSpaces,
+                                       char* buffer)
+{
+  std::int64_t cellColumn = 0;
+  std::int64_t cellRow = 0;
+  if (!mgrsCell(position, precision, cellColumn, cellRow))
+    return 0;
+
+  std::int64_t cellsPerSquare = 1;
+  for (int digit = 0; digit < precision; ++digit)
+    cellsPerSquare *= 10;
+
+  const int column = static_cast<int>(cellColumn / cellsPerSquare);
+  const int row = static_cast<int>(cellRow / cellsPerSquare);
+
+  char* out = writeDigits(buffer, static_cast<std::uint64_t>(position.zone), 2);
+  *out++ = position.band;
+
+  if (addSpaces)
+    *out++ = ' ';
+
+  *out++ = columnLetters[position.zone % 3][column - 1];
+  *out++ = rowLetters[(row + rowOffset(position.zone, scheme)) % rowLetterCount];
+
+  if (precision == 0)
+    return static_cast<int>(out - buffer);
+
+  if (addSpaces)
+    *out++ = ' ';
+
+  out = writeDigits(out, static_cast<std::uint64_t>(cellColumn % cellsPerSquare), precision);
+
+  if (addSpaces)
+    *out++ = ' ';
+
+  out = writeDigits(out, static_cast<std::uint64_t>(cellRow % cellsPerSquare), precision);
+  return static_cast<int>(out - buffer);
+}
+
+/*!
+  \brief Parses the UTM notation in the first \a length characters of \a text
+  into \a position.
+
+  \a indicator determines whether the letter after the zone is a latitude
+  band or a hemisphere. The easting and northing may be separated by spaces
+  or written as a single run of digits.
+ */
+bool TransverseMercatorGrid::parseUtm(const char* text, int length, ZoneIndicator indicator, GridPosition& position)
+{
+  Reader reader{text, text + length};
+  position = GridPosition();
+
+  if (!reader.zone(position.zone))
+    return false;
+
+  const char letter = reader.letter();
+  if (indicator == ZoneIndicator::LatitudeBand)
+  {
+    if (findLetter(latitudeBands, letter) < 0)
+      return false;
+
+    position.band = letter;
+    position.north = letter >= 'N';
+  }
+  else
+  {
+    if (letter != 'N' && letter != 'S')
+      return false;
+
+    position.north = letter == 'N';
+  }
+
+  std::uint64_t easting = 0;
+  std::uint64_t northing = 0;
+  const int eastingDigits = reader.digits(easting, 6);
+  const int northingDigits = reader.digits(northing, 8);
+  if (eastingDigits == 0 || northingDigits == 0 || !reader.atEnd())
+    return false;
+
+  position.easting = static_cast<double>(easting);
+  position.northing = static_cast<double>(northing);
+  return true;
+}
+
+/*!
+  \brief Parses the MGRS or USNG notation in the first \a length characters
+  of \a text into \a position, using the 100 km lettering \a scheme.
+
+  The position is the south-west corner of the referenced cell. The northing
+  is resolved from the row letter using the latitude band.
+ */
+bool TransverseMercatorGrid::parseMgrs(const char* text, int length, LetteringScheme scheme, GridPosition& position)
+{
+  Reader reader{text, text + length};
+  position = GridPosition();
+
+  if (!reader.zone(position.zone))
+    return false;
+
+  const char band = reader.letter();
+  const int bandNumber = findLetter(latitudeBands, band);
+  if (bandNumber < 0)
+    return false;
+
+  position.band = band;
+  position.north = band >= 'N';
+
+  const int column = findLetter(columnLetters[position.zone % 3], reader.letter());
+  const int rowLetter = findLetter(rowLetters, reader.letter());
+  if (column < 0 || rowLetter < 0)
+    return false;
+
+  // the easting and northing are either one run of digits or two runs of equal length
+  std::uint64_t first = 0;
+  std::uint64_t second = 0;
+  const int firstDigits = reader.digits(first, 2 * maximumMgrsPrecision);
+  int precision = 0;
+  std::uint64_t easting = 0;
+  std::uint64_t northing = 0;
+  if (reader.atEnd())
+  {
+    if (firstDigits % 2 != 0)
+      return false;
+
+    precision = firstDigits / 2;
+    std::uint64_t divisor = 1;
+    for (int i = 0; i < precision; ++i)
+      divisor *= 10;
+
+    easting = first / divisor;
+    northing = first % divisor;
+  }
+  else
+  {
+    const int secondDigits = reader.digits(second, maximumMgrsPrecision);
+    if (firstDigits != secondDigits || firstDigits > maximumMgrsPrecision || !reader.atEnd())
+      return false;
+
+    precision = firstDigits;
+    easting = first;
+    northing = second;
+  }
+
+  const double metresPerDigit = std::pow(10.0, 5 - precision);
+  position.easting = (column + 1) * squareSize + static_cast<double>(easting) * metresPerDigit;
+
+  const int row = (rowLetter - rowOffset(position.zone, scheme) + 2 * rowLetterCount) % rowLetterCount;
+  double northingValue = row * squareSize + static_cast<double>(northing) * metresPerDigit;
+
+  // lift the northing into the 2000 km cycle which contains the latitude band;
+  // the band's southern edge is lowest on the central meridian, and the slack
+  // allows for squares which straddle that edge
+  double x = 0.0;
+  double bandMinimumNorthing = 0.0;
+  project((minimumLatitude + 8.0 * bandNumber) * degreesToRadians, 0.0, x, bandMinimumNorthing);
+  if (!position.north)
+    bandMinimumNorthing += falseNorthingSouth;
+
+  constexpr double bandSlack = 2.0 * squareSize;
+  while (northingValue < bandMinimumNorthing - bandSlack)
+    northingValue += rowCycle;
+
+  position.northing = northingValue;
+  return true;
+}
+
+} // Toolkit
+} // ArcGISRuntime
+} // Esri
@@ -0,0 +1,157 @@
+/*******************************************************************************
+ *  Copyright 2012-2018 Esri
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ******************************************************************************/
+
+#include "EngineCommandLine.h"
+
+// toolkit headers
+#include "CoordinateConversionConstants.h"
+#include "CoordinateConversionEngine.h"
+#include "CoordinateConversionOptions.h"
+#include "CoordinateFormatFactory.h"
+
+// C++ API headers
+#include "SpatialReference.h"
+
+// Qt headers
+#include <QCommandLineParser>
+#include <QTextStream>
+
+namespace Esri
+{
+namespace ArcGISRuntime
+{
+namespace Toolkit
+{
+
+namespace
+{
+
+// applies a FORMAT.property=value assignment to the matching option
+bool applySetting(const QString& setting, const QList<CoordinateConversionOptions*>& options)
+{
+  const int separator = setting.indexOf(QLatin1Char('.'));
+  const int equals = setting.indexOf(QLatin1Char('='), separator + 1);
+  if (separator <= 0 || equals <= separator + 1)
+    return false;
+
+  const QString formatName = setting.left(separator);
+  const QByteArray property = setting.mid(separator + 1, equals - separator - 1).toLatin1();
+  const QString value = setting.mid(equals + 1);
+
+  for (CoordinateConversionOptions* option : options)
+  {
+    if (option->name().compare(formatName, Qt::CaseInsensitive) == 0)
+      return option->setProperty(property.constData(), value);
+  }
+
+  return false;
+}
+
+} // namespace
+
+EngineCommandLine::EngineCommandLine(const QString& inputFormatDescription) :
+  m_inputFormatOption(QStringList{QStringLiteral("i"), QStringLiteral("input-format")}, inputFormatDescription,
+                      QStringLiteral("format"), CoordinateConversionConstants::DECIMAL_DEGREES_FORMAT),
+  m_formatsOption(QStringList{QStringLiteral("f"), QStringLiteral("formats")},
+                  QStringLiteral("Comma separated output formats. Defaults to %1.").arg(defaultFormats().join(QStringLiteral(", "))),
+                  QStringLiteral("formats")),
+  m_autoDetectOption(QStringLiteral("auto-detect"),
+                     QStringLiteral("Recognize the format of each notation instead of using the input format.")),
+  m_setOption(QStringLiteral("set"),
+              QStringLiteral("Set an option property of a format, e.g. MGRS.precision=3. May be repeated."),
+              QStringLiteral("format.property=value"))
+{
+}
+
+void EngineCommandLine::addOptions(QCommandLineParser& parser) const
+{
+  parser.addOptions({m_inputFormatOption, m_formatsOption, m_autoDetectOption, m_setOption});
+}
+
+bool EngineCommandLine::configureEngine(const QCommandLineParser& parser, bool useInputFormat,
+                                        CoordinateConversionEngine& engine, QObject* optionParent) const
+{
+  // the same options, with the same defaults, as the coordinate conversion tool
+  engine.setSpatialReference(SpatialReference::wgs84());
+
+  QStringList formats;
+  if (parser.isSet(m_formatsOption))
+  {
+    for (const QString& format : parser.value(m_formatsOption).split(QLatin1Char(','), QString::SkipEmptyParts))
+      formats.append(format.trimmed());
+  }
+  else
+  {
+    formats = defaultFormats();
+  }
+
+  const bool autoDetect = parser.isSet(m_autoDetectOption);
+  const QString inputFormat = parser.value(m_inputFormatOption);
+  if (useInputFormat && !autoDetect && !formats.contains(inputFormat, Qt::CaseInsensitive))
+    formats.prepend(inputFormat);
+
+  // QML style options, so that --set can assign their properties by name
+  QList<CoordinateConversionOptions*> options;
+  for (const QString& format : formats)
+  {
+    CoordinateConversionOptions* option = CoordinateFormatFactory::createFormat(format, engine.formatDefaults(), optionParent);
+    if (!option)
+    {
+      errorStream() << "Unknown format: " << format << endl;
+      return false;
+    }
+
+    options.append(option);
+  }
+
+  for (const QString& setting : parser.values(m_setOption))
+  {
+    if (!applySetting(setting, options))
+    {
+      errorStream() << "Invalid setting: " << setting << endl;
+      return false;
+    }
+  }
+
+  for (const CoordinateConversionOptions* option : options)
+    engine.addOption(option->formatOption());
+
+  if (!autoDetect)
+    engine.setInputFormat(inputFormat);
+  engine.setAutoDetectInputFormat(autoDetect);
+  return true;
+}
+
+QStringList EngineCommandLine::defaultFormats()
+{
+  return QStringList{CoordinateConversionConstants::DECIMAL_DEGREES_FORMAT,
+                     CoordinateConversionConstants::DEGREES_DECIMAL_MINUTES_FORMAT,
+                     CoordinateConversionConstants::DEGREES_MINUTES_SECONDS_FORMAT,
+                     CoordinateConversionConstants::MGRS_FORMAT,
+                     CoordinateConversionConstants::USNG_FORMAT,
+                     CoordinateConversionConstants::UTM_FORMAT,
+                     CoordinateConversionConstants::GARS_FORMAT};
+}
+
+QTextStream& EngineCommandLine::errorStream()
+{
+  static QTextStream stream(stderr);
+  return stream;
+}
+
+} // Toolkit
+} // ArcGISRuntime
+} // Esri
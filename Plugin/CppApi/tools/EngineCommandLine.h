@@ -0,0 +1,70 @@
+/*******************************************************************************
+ *  Copyright 2012-2018 Esri
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ******************************************************************************/
+
+#ifndef ENGINECOMMANDLINE_H
+#define ENGINECOMMANDLINE_H
+
+// Qt headers
+#include <QCommandLineOption>
+#include <QList>
+#include <QStringList>
+
+class QCommandLineParser;
+class QObject;
+class QTextStream;
+
+namespace Esri
+{
+namespace ArcGISRuntime
+{
+namespace Toolkit
+{
+
+class CoordinateConversionEngine;
+
+// The command line options shared by the conversion tools, which choose the
+// formats of an engine and their settings: --input-format, --formats,
+// --auto-detect and --set.
+class EngineCommandLine
+{
+public:
+  explicit EngineCommandLine(const QString& inputFormatDescription);
+
+  void addOptions(QCommandLineParser& parser) const;
+
+  // sets up engine from the parsed options; the input format is only added
+  // to the formats when useInputFormat is set. Errors are reported on
+  // errorStream.
+  bool configureEngine(const QCommandLineParser& parser, bool useInputFormat, CoordinateConversionEngine& engine,
+                       QObject* optionParent) const;
+
+  // the formats converted when --formats is not given
+  static QStringList defaultFormats();
+
+  static QTextStream& errorStream();
+
+private:
+  QCommandLineOption m_inputFormatOption;
+  QCommandLineOption m_formatsOption;
+  QCommandLineOption m_autoDetectOption;
+  QCommandLineOption m_setOption;
+};
+
+} // Toolkit
+} // ArcGISRuntime
+} // Esri
+
+#endif // ENGINECOMMANDLINE_H